@@ -389,38 +389,52 @@ public:
         }
     };
 
-    static void CompleteCallback(napi_env env, NapiCallback::Base *jsCb)
+    static bool ScheduleOnJsThread(napi_env env, const std::function<void()> &flush)
     {
-        ON_SCOPE_EXIT(0) {
-            delete jsCb;
-        };
-
         uv_loop_s *loop = nullptr;
         napi_get_uv_event_loop(env, &loop);
-        CHECK_AND_RETURN_LOG(loop != nullptr, "Fail to napi_get_uv_event_loop");
+        CHECK_AND_RETURN_RET_LOG(loop != nullptr, false, "Fail to napi_get_uv_event_loop");
 
         uv_work_t *work = new(std::nothrow) uv_work_t;
-        CHECK_AND_RETURN_LOG(work != nullptr, "Fail to new uv_work_t");
+        CHECK_AND_RETURN_RET_LOG(work != nullptr, false, "Fail to new uv_work_t");
+        auto *task = new(std::nothrow) std::function<void()>(flush);
+        if (task == nullptr) {
+            MEDIA_LOGE("Fail to new flush task");
+            delete work;
+            return false;
+        }
 
-        work->data = reinterpret_cast<void *>(jsCb);
+        work->data = reinterpret_cast<void *>(task);
         // async callback, jsWork and jsWork->data should be heap object.
         int ret = uv_queue_work_with_qos(loop, work, [] (uv_work_t *work) {}, [] (uv_work_t *work, int status) {
             CHECK_AND_RETURN_LOG(work != nullptr, "Work thread is nullptr");
             (void)status;
-            NapiCallback::Base *cb = reinterpret_cast<NapiCallback::Base *>(work->data);
-            if (cb != nullptr) {
-                MEDIA_LOGD("JsCallBack %{public}s, uv_queue_work_with_qos start", cb->callbackName.c_str());
-                cb->UvWork();
-                delete cb;
+            auto *task = reinterpret_cast<std::function<void()> *>(work->data);
+            if (task != nullptr) {
+                (*task)();
+                delete task;
             }
             delete work;
         }, uv_qos_user_initiated);
         if (ret != 0) {
             MEDIA_LOGE("Failed to execute libuv work queue");
-            delete jsCb;
+            delete task;
             delete work;
+            return false;
         }
-        CANCEL_SCOPE_EXIT_GUARD(0);
+        return true;
+    }
+
+    // a non empty coalesceKey lets a newer event of the same kind replace this one if it is not delivered yet
+    static void CompleteCallback(const std::shared_ptr<AVPlayerEventBatcher> &batcher, NapiCallback::Base *jsCb,
+        const std::string &coalesceKey = "")
+    {
+        std::shared_ptr<NapiCallback::Base> cb(jsCb);
+        CHECK_AND_RETURN_LOG(batcher != nullptr, "batcher is nullptr");
+        batcher->Post([cb]() {
+            MEDIA_LOGD("JsCallBack %{public}s, uv_queue_work_with_qos start", cb->callbackName.c_str());
+            cb->UvWork();
+        }, coalesceKey);
     }
 
     struct TrackChange : public Base {
@@ -569,6 +583,9 @@ AVPlayerCallback::AVPlayerCallback(napi_env env, AVPlayerNotify *listener)
     : env_(env), listener_(listener)
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instance create", FAKE_POINTER(this));
+    eventBatcher_ = std::make_shared<AVPlayerEventBatcher>([env](const std::function<void()> &flush) {
+        return NapiCallback::ScheduleOnJsThread(env, flush);
+    });
     onInfoFuncs_ = {
         { INFO_TYPE_STATE_CHANGE,
             [this](const int32_t extra, const Format &infoBody) { OnStateChangeCb(extra, infoBody); } },
@@ -644,7 +661,7 @@ void AVPlayerCallback::OnAudioDeviceChangeCb(const int32_t extra, const Format &
     cb->deviceInfo = deviceInfo;
     cb->reason = reason;
 
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 AVPlayerCallback::~AVPlayerCallback()
@@ -683,7 +700,7 @@ void AVPlayerCallback::OnErrorCb(MediaServiceExtErrCodeAPI9 errorCode, const std
     cb->callbackName = AVPlayerEvent::EVENT_ERROR;
     cb->errorCode = errorCode;
     cb->errorMsg = message;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnInfo(PlayerOnInfoType type, int32_t extra, const Format &infoBody)
@@ -771,7 +788,7 @@ void AVPlayerCallback::OnStateChangeCb(const int32_t extra, const Format &infoBo
             cb->callbackName = AVPlayerEvent::EVENT_STATE_CHANGE;
             cb->state = stateStr;
             cb->reason = reason;
-            NapiCallback::CompleteCallback(env_, cb);
+            NapiCallback::CompleteCallback(eventBatcher_, cb);
         }
     }
 }
@@ -795,7 +812,7 @@ void AVPlayerCallback::OnVolumeChangeCb(const int32_t extra, const Format &infoB
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_VOLUME_CHANGE);
     cb->callbackName = AVPlayerEvent::EVENT_VOLUME_CHANGE;
     cb->value = static_cast<double>(volumeLevel);
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnSeekDoneCb(const int32_t extra, const Format &infoBody)
@@ -814,7 +831,7 @@ void AVPlayerCallback::OnSeekDoneCb(const int32_t extra, const Format &infoBody)
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_SEEK_DONE);
     cb->callbackName = AVPlayerEvent::EVENT_SEEK_DONE;
     cb->value = currentPositon;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnSpeedDoneCb(const int32_t extra, const Format &infoBody)
@@ -834,7 +851,7 @@ void AVPlayerCallback::OnSpeedDoneCb(const int32_t extra, const Format &infoBody
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_SPEED_DONE);
     cb->callbackName = AVPlayerEvent::EVENT_SPEED_DONE;
     cb->value = speedMode;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnBitRateDoneCb(const int32_t extra, const Format &infoBody)
@@ -854,7 +871,7 @@ void AVPlayerCallback::OnBitRateDoneCb(const int32_t extra, const Format &infoBo
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_BITRATE_DONE);
     cb->callbackName = AVPlayerEvent::EVENT_BITRATE_DONE;
     cb->value = bitRate;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnPositionUpdateCb(const int32_t extra, const Format &infoBody)
@@ -878,7 +895,8 @@ void AVPlayerCallback::OnPositionUpdateCb(const int32_t extra, const Format &inf
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_TIME_UPDATE);
     cb->callbackName = AVPlayerEvent::EVENT_TIME_UPDATE;
     cb->value = position;
-    NapiCallback::CompleteCallback(env_, cb);
+    // only the latest position matters to js, superseded ones are dropped if still pending
+    NapiCallback::CompleteCallback(eventBatcher_, cb, AVPlayerEvent::EVENT_TIME_UPDATE);
 }
 
 void AVPlayerCallback::OnDurationUpdateCb(const int32_t extra, const Format &infoBody)
@@ -903,7 +921,7 @@ void AVPlayerCallback::OnDurationUpdateCb(const int32_t extra, const Format &inf
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_DURATION_UPDATE);
     cb->callbackName = AVPlayerEvent::EVENT_DURATION_UPDATE;
     cb->value = duration;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnSubtitleUpdateCb(const int32_t extra, const Format &infoBody)
@@ -920,7 +938,7 @@ void AVPlayerCallback::OnSubtitleUpdateCb(const int32_t extra, const Format &inf
     }
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_SUBTITLE_TEXT_UPDATE);
     cb->callbackName = AVPlayerEvent::EVENT_SUBTITLE_TEXT_UPDATE;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnBufferingUpdateCb(const int32_t extra, const Format &infoBody)
@@ -958,7 +976,12 @@ void AVPlayerCallback::OnBufferingUpdateCb(const int32_t extra, const Format &in
     cb->callbackName = AVPlayerEvent::EVENT_BUFFERING_UPDATE;
     cb->valueVec.push_back(bufferingType);
     cb->valueVec.push_back(val);
-    NapiCallback::CompleteCallback(env_, cb);
+    // start and end keep their order, progress values are superseded by newer ones of the same type
+    std::string coalesceKey;
+    if (bufferingType == BUFFERING_PERCENT || bufferingType == CACHED_DURATION) {
+        coalesceKey = std::string(AVPlayerEvent::EVENT_BUFFERING_UPDATE) + "_" + std::to_string(bufferingType);
+    }
+    NapiCallback::CompleteCallback(eventBatcher_, cb, coalesceKey);
 }
 
 void AVPlayerCallback::OnMessageCb(const int32_t extra, const Format &infoBody)
@@ -985,7 +1008,7 @@ void AVPlayerCallback::OnStartRenderFrameCb() const
 
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_START_RENDER_FRAME);
     cb->callbackName = AVPlayerEvent::EVENT_START_RENDER_FRAME;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnVideoSizeChangedCb(const int32_t extra, const Format &infoBody)
@@ -1013,7 +1036,7 @@ void AVPlayerCallback::OnVideoSizeChangedCb(const int32_t extra, const Format &i
     cb->callbackName = AVPlayerEvent::EVENT_VIDEO_SIZE_CHANGE;
     cb->valueVec.push_back(width);
     cb->valueVec.push_back(height);
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnAudioInterruptCb(const int32_t extra, const Format &infoBody)
@@ -1042,7 +1065,7 @@ void AVPlayerCallback::OnAudioInterruptCb(const int32_t extra, const Format &inf
     cb->valueMap["eventType"] = eventType;
     cb->valueMap["forceType"] = forceType;
     cb->valueMap["hintType"] = hintType;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnBitRateCollectedCb(const int32_t extra, const Format &infoBody)
@@ -1081,7 +1104,7 @@ void AVPlayerCallback::OnBitRateCollectedCb(const int32_t extra, const Format &i
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_AVAILABLE_BITRATES);
     cb->callbackName = AVPlayerEvent::EVENT_AVAILABLE_BITRATES;
     cb->valueVec = bitrateVec;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnDrmInfoUpdatedCb(const int32_t extra, const Format &infoBody)
@@ -1132,7 +1155,7 @@ void AVPlayerCallback::OnDrmInfoUpdatedCb(const int32_t extra, const Format &inf
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_DRM_INFO_UPDATE);
     cb->callbackName = AVPlayerEvent::EVENT_DRM_INFO_UPDATE;
     cb->infoMap = drmInfoMap;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnSetDecryptConfigDoneCb(const int32_t extra, const Format &infoBody)
@@ -1149,7 +1172,7 @@ void AVPlayerCallback::OnSetDecryptConfigDoneCb(const int32_t extra, const Forma
 
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_SET_DECRYPT_CONFIG_DONE);
     cb->callbackName = AVPlayerEvent::EVENT_SET_DECRYPT_CONFIG_DONE;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnSubtitleInfoCb(const int32_t extra, const Format &infoBody)
@@ -1175,7 +1198,7 @@ void AVPlayerCallback::OnSubtitleInfoCb(const int32_t extra, const Format &infoB
     cb->valueMap.pts = pts;
     cb->valueMap.duration = duration;
 
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnEosCb(const int32_t extra, const Format &infoBody)
@@ -1194,7 +1217,7 @@ void AVPlayerCallback::OnEosCb(const int32_t extra, const Format &infoBody)
 
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_END_OF_STREAM);
     cb->callbackName = AVPlayerEvent::EVENT_END_OF_STREAM;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnTrackChangedCb(const int32_t extra, const Format &infoBody)
@@ -1216,7 +1239,7 @@ void AVPlayerCallback::OnTrackChangedCb(const int32_t extra, const Format &infoB
     cb->callbackName = AVPlayerEvent::EVENT_TRACKCHANGE;
     cb->number = index;
     cb->isSelect = isSelect ? true : false;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::OnTrackInfoUpdate(const int32_t extra, const Format &infoBody)
@@ -1235,7 +1258,7 @@ void AVPlayerCallback::OnTrackInfoUpdate(const int32_t extra, const Format &info
     cb->callback = refMap_.at(AVPlayerEvent::EVENT_TRACK_INFO_UPDATE);
     cb->callbackName = AVPlayerEvent::EVENT_TRACK_INFO_UPDATE;
     cb->trackInfo = trackInfo;
-    NapiCallback::CompleteCallback(env_, cb);
+    NapiCallback::CompleteCallback(eventBatcher_, cb);
 }
 
 void AVPlayerCallback::SaveCallbackReference(const std::string &name, std::weak_ptr<AutoRef> ref)
@@ -21,6 +21,7 @@
 #include "player.h"
 #include "media_errors.h"
 #include "common_napi.h"
+#include "avplayer_event_batcher.h"
 #include "event_handler.h"
 
 namespace OHOS {
@@ -89,6 +90,7 @@ private:
     PlayerStates state_ = PLAYER_IDLE;
     std::shared_ptr<AppExecFwk::EventHandler> handler_ = nullptr;
     std::map<uint32_t, OnInfoFunc> onInfoFuncs_;
+    std::shared_ptr<AVPlayerEventBatcher> eventBatcher_ = nullptr;
 };
 } // namespace Media
 } // namespace OHOS
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "avplayer_event_batcher.h"
+#include "media_log.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_ONLY_PRERELEASE, LOG_DOMAIN_PLAYER, "AVPlayerEventBatcher" };
+}
+
+namespace OHOS {
+namespace Media {
+AVPlayerEventBatcher::AVPlayerEventBatcher(Scheduler scheduler) : scheduler_(std::move(scheduler))
+{
+}
+
+void AVPlayerEventBatcher::Post(Event event, const std::string &coalesceKey)
+{
+    CHECK_AND_RETURN_LOG(event != nullptr, "event is nullptr");
+    postCount_++;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!coalesceKey.empty()) {
+            auto iter = coalesceIndex_.find(coalesceKey);
+            if (iter != coalesceIndex_.end()) {
+                pendingEvents_.erase(iter->second);
+                coalescedCount_++;
+            }
+        }
+        pendingEvents_.push_back({coalesceKey, std::move(event)});
+        if (!coalesceKey.empty()) {
+            coalesceIndex_[coalesceKey] = std::prev(pendingEvents_.end());
+        }
+        if (isFlushScheduled_) {
+            return;
+        }
+        isFlushScheduled_ = true;
+    }
+
+    // the flush keeps the batcher alive, events posted before the player is released are still delivered
+    std::shared_ptr<AVPlayerEventBatcher> batcher = shared_from_this();
+    bool ret = scheduler_ != nullptr && scheduler_([batcher]() {
+        batcher->Flush();
+    });
+    if (!ret) {
+        MEDIA_LOGE("Failed to schedule event flush");
+        // the pending events stay queued and go out with the next successful flush
+        std::lock_guard<std::mutex> lock(mutex_);
+        isFlushScheduled_ = false;
+    }
+}
+
+void AVPlayerEventBatcher::Flush()
+{
+    std::list<PendingEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events.swap(pendingEvents_);
+        coalesceIndex_.clear();
+        isFlushScheduled_ = false;
+    }
+    flushCount_++;
+    MEDIA_LOGD("Flush %{public}zu events", events.size());
+    for (auto &pendingEvent : events) {
+        pendingEvent.event();
+    }
+}
+
+uint64_t AVPlayerEventBatcher::GetPostCount() const
+{
+    return postCount_.load();
+}
+
+uint64_t AVPlayerEventBatcher::GetCoalescedCount() const
+{
+    return coalescedCount_.load();
+}
+
+uint64_t AVPlayerEventBatcher::GetFlushCount() const
+{
+    return flushCount_.load();
+}
+} // namespace Media
+} // namespace OHOS
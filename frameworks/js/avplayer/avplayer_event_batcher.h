@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AV_PLAYER_EVENT_BATCHER_H
+#define AV_PLAYER_EVENT_BATCHER_H
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace OHOS {
+namespace Media {
+/**
+ * Collects the events of one player and delivers everything pending in a single hop to the JS thread.
+ * Events posted with a coalesce key are "latest value wins": a newer one drops the pending one with the same key.
+ * Events without a key (state changes, errors, ...) are delivered in the order they were posted.
+ */
+class AVPlayerEventBatcher : public std::enable_shared_from_this<AVPlayerEventBatcher> {
+public:
+    using Event = std::function<void()>;
+    // queues the flush on the JS thread, returns false if it could not be queued
+    using Scheduler = std::function<bool(const std::function<void()> &flush)>;
+
+    explicit AVPlayerEventBatcher(Scheduler scheduler);
+    ~AVPlayerEventBatcher() = default;
+
+    void Post(Event event, const std::string &coalesceKey = "");
+    uint64_t GetPostCount() const;
+    uint64_t GetCoalescedCount() const;
+    // number of JS thread hops
+    uint64_t GetFlushCount() const;
+
+private:
+    struct PendingEvent {
+        std::string coalesceKey;
+        Event event;
+    };
+    void Flush();
+
+    Scheduler scheduler_;
+    std::mutex mutex_;
+    std::list<PendingEvent> pendingEvents_;
+    std::unordered_map<std::string, std::list<PendingEvent>::iterator> coalesceIndex_;
+    bool isFlushScheduled_ = false;
+    std::atomic<uint64_t> postCount_ = 0;
+    std::atomic<uint64_t> coalescedCount_ = 0;
+    std::atomic<uint64_t> flushCount_ = 0;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // AV_PLAYER_EVENT_BATCHER_H
@@ -38,6 +38,7 @@ protected:
     void PlayFunTest(const std::string &protocol = PlayerTestParam::LOCAL_PLAY);
     void NoRunPlayFunTest(const std::string &protocol = PlayerTestParam::LOCAL_PLAY);
     void GetSetParaFunTest();
+    void AccurateSeekBenchmark(const std::string &url);
 };
 } // namespace Media
 } // namespace OHOS
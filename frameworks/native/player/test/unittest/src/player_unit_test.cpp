@@ -14,6 +14,8 @@
  */
 
 #include "player_unit_test.h"
+#include <algorithm>
+#include <chrono>
 #include <unistd.h>
 #include <securec.h>
 #include "media_errors.h"
@@ -25,6 +27,11 @@ using namespace std;
 using namespace testing::ext;
 using namespace OHOS::Media::PlayerTestParam;
 
+namespace {
+constexpr int32_t ACCURATE_SEEK_POINT_COUNT = 8;
+constexpr int32_t ACCURATE_SEEK_OFFSET_MS = 900; // land well after the key frame so the whole gop is decoded
+}
+
 namespace OHOS {
 namespace Media {
 void PlayerUnitTest::SetUpTestCase(void)
@@ -52,6 +59,41 @@ void PlayerUnitTest::TearDown(void)
     }
 }
 
+void PlayerUnitTest::AccurateSeekBenchmark(const std::string &url)
+{
+    ASSERT_EQ(MSERR_OK, player_->SetSource(url));
+    sptr<Surface> videoSurface = player_->GetVideoSurface();
+    ASSERT_NE(nullptr, videoSurface);
+    EXPECT_EQ(MSERR_OK, player_->SetVideoSurface(videoSurface));
+    ASSERT_EQ(MSERR_OK, player_->Prepare());
+    int32_t duration = 0;
+    EXPECT_EQ(MSERR_OK, player_->GetDuration(duration));
+    int64_t totalMs = 0;
+    int64_t maxMs = 0;
+    int32_t seekCount = 0;
+    for (int32_t i = 0; i < ACCURATE_SEEK_POINT_COUNT; i++) {
+        int32_t seekPos = duration * i / ACCURATE_SEEK_POINT_COUNT + ACCURATE_SEEK_OFFSET_MS;
+        if (seekPos >= duration) {
+            break;
+        }
+        auto begin = std::chrono::steady_clock::now();
+        EXPECT_EQ(MSERR_OK, player_->Seek(seekPos, SEEK_CLOSEST));
+        int64_t costMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+        totalMs += costMs;
+        maxMs = std::max(maxMs, costMs);
+        seekCount++;
+        // latency depends on the device load, it is reported below and only the landing position is checked
+        int32_t currentTime = 0;
+        EXPECT_EQ(MSERR_OK, player_->GetCurrentTime(currentTime));
+        EXPECT_NEAR(seekPos, currentTime, DELTA_TIME);
+    }
+    ASSERT_GT(seekCount, 0);
+    std::cout << "accurate seek " << url << ": " << seekCount << " seeks, avg " << totalMs / seekCount <<
+        " ms, max " << maxMs << " ms" << std::endl;
+    EXPECT_EQ(MSERR_OK, player_->Reset());
+}
+
 void PlayerUnitTest::PlayFunTest(const std::string &protocol)
 {
     int32_t duration = 0;
@@ -3580,5 +3622,18 @@ HWTEST_F(PlayerUnitTest, Player_SeekContinuous_006, TestSize.Level0)
     EXPECT_EQ(MSERR_OK, player_->Play());
     EXPECT_EQ(MSERR_OK, player_->Stop());
 }
+
+/**
+ * @tc.name  : Test Player accurate seek latency
+ * @tc.number: Player_Seek_Closest_Benchmark_001
+ * @tc.desc  : Measure SEEK_CLOSEST latency on sources with different gop lengths
+ */
+HWTEST_F(PlayerUnitTest, Player_Seek_Closest_Benchmark_001, TestSize.Level2)
+{
+    AccurateSeekBenchmark(VIDEO_FILE1);
+    AccurateSeekBenchmark(MEDIA_ROOT + "ChineseColor_H264_AAC_480p_15fps.mp4");
+    AccurateSeekBenchmark(MEDIA_ROOT + "h264_aac_640x480_30r.ts");
+    AccurateSeekBenchmark(MEDIA_ROOT + "H265_AAC.mp4");
+}
 } // namespace Media
 } // namespace OHOS
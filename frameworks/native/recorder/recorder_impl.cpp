@@ -18,6 +18,7 @@
 #include "i_media_service.h"
 #include "media_log.h"
 #include "media_errors.h"
+#include "audio_shared_ring.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_RECORDER, "RecorderImpl"};
@@ -386,5 +387,19 @@ int32_t RecorderImpl::SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer)
     CHECK_AND_RETURN_RET_LOG(recorderService_ != nullptr, MSERR_INVALID_OPERATION, "recorder service does not exist..");
     return recorderService_->SetWatermark(waterMarkBuffer);
 }
+
+int32_t RecorderImpl::SavePreCache(int32_t fd, int32_t duration)
+{
+    CHECK_AND_RETURN_RET_LOG(recorderService_ != nullptr, MSERR_INVALID_OPERATION, "recorder service does not exist..");
+    return recorderService_->SavePreCache(fd, duration);
+}
+
+int32_t RecorderImpl::SetAudioSharedRing(const std::shared_ptr<AudioSharedRing> &ring, int32_t &sourceId)
+{
+    CHECK_AND_RETURN_RET_LOG(ring != nullptr && ring->IsValid() && ring->GetMemory() != nullptr, MSERR_INVALID_VAL,
+        "audio shared ring is invalid");
+    CHECK_AND_RETURN_RET_LOG(recorderService_ != nullptr, MSERR_INVALID_OPERATION, "recorder service does not exist..");
+    return recorderService_->SetAudioSharedRing(ring->GetMemory(), ring->GetEventFd(), sourceId);
+}
 } // namespace Media
 } // namespace OHOS
@@ -74,6 +74,8 @@ public:
     int32_t GetMaxAmplitude() override;
     int32_t IsWatermarkSupported(bool &isWatermarkSupported) override;
     int32_t SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer) override;
+    int32_t SavePreCache(int32_t fd, int32_t duration) override;
+    int32_t SetAudioSharedRing(const std::shared_ptr<AudioSharedRing> &ring, int32_t &sourceId) override;
 private:
     std::shared_ptr<IRecorderService> recorderService_ = nullptr;
     sptr<Surface> surface_ = nullptr;
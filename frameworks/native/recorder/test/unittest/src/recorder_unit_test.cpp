@@ -14,6 +14,7 @@
  */
 
 #include "recorder_unit_test.h"
+#include <chrono>
 #include <fcntl.h>
 #include <nativetoken_kit.h>
 #include <token_setproc.h>
@@ -1601,5 +1602,51 @@ HWTEST_F(RecorderUnitTest, recorder_video_GetMetaSurface, TestSize.Level0)
     EXPECT_EQ(MSERR_OK, recorder_->Release());
     close(g_videoRecorderConfig.outputFd);
 }
+
+/**
+ * @tc.name: recorder_SoftStop_001
+ * @tc.desc: record clips back to back with soft stop on a software encoder, the warm Prepare takes less time
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(RecorderUnitTest, recorder_SoftStop_001, TestSize.Level2)
+{
+    constexpr int32_t softStopCycles = 3;
+    VideoRecorderConfig videoRecorderConfig;
+    videoRecorderConfig.vSource = VIDEO_SOURCE_SURFACE_YUV;
+    // mpeg4 is encoded in software, so the saving does not depend on the hardware codec of the device
+    videoRecorderConfig.videoFormat = MPEG4;
+    Format softStop;
+    softStop.PutIntValue(RecorderKeys::RECORDER_SOFT_STOP, 1);
+    int64_t prepareMs[softStopCycles] = { 0 };
+    for (int32_t cycle = 0; cycle < softStopCycles; cycle++) {
+        videoRecorderConfig.outputFd = open((RECORDER_ROOT + "recorder_video_SoftStop_001_" +
+            std::to_string(cycle) + ".mp4").c_str(), O_RDWR);
+        ASSERT_TRUE(videoRecorderConfig.outputFd >= 0);
+
+        EXPECT_EQ(MSERR_OK, recorder_->SetFormat(PURE_VIDEO, videoRecorderConfig));
+        EXPECT_EQ(MSERR_OK, recorder_->SetParameter(videoRecorderConfig.videoSourceId, softStop));
+        auto prepareStart = std::chrono::steady_clock::now();
+        EXPECT_EQ(MSERR_OK, recorder_->Prepare());
+        prepareMs[cycle] = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - prepareStart).count();
+        cout << "soft stop cycle " << cycle << " prepare " << prepareMs[cycle] << " ms" << endl;
+        EXPECT_EQ(MSERR_OK, recorder_->RequesetBuffer(PURE_VIDEO, videoRecorderConfig));
+        EXPECT_EQ(MSERR_OK, recorder_->Start());
+        sleep(1); // 1: seconds recorded per clip
+        EXPECT_EQ(MSERR_OK, recorder_->Stop(false));
+        recorder_->StopBuffer(PURE_VIDEO);
+        close(videoRecorderConfig.outputFd);
+    }
+    // the first Prepare builds the encoder, the later ones only link a new muxer to the kept one
+    int64_t warmPrepareMs = 0;
+    for (int32_t cycle = 1; cycle < softStopCycles; cycle++) {
+        warmPrepareMs += prepareMs[cycle];
+    }
+    warmPrepareMs /= softStopCycles - 1;
+    EXPECT_LT(warmPrepareMs, prepareMs[0]);
+    EXPECT_EQ(MSERR_OK, recorder_->Reset());
+    EXPECT_EQ(MSERR_OK, recorder_->Release());
+}
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
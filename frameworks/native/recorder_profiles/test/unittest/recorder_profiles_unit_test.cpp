@@ -215,5 +215,33 @@ HWTEST_F(RecorderProfilesUnitTest, recorder_profile_GetVideoRecorderProfile_0200
     ASSERT_TRUE(videoRecorderProfile != nullptr);
     EXPECT_NE(ContainerFormatType::CFT_MPEG_4, videoRecorderProfile->containerFormatType);
 }
+
+/**
+ * @tc.name: recorder_profile_HasVideoRecorderProfile_0300
+ * @tc.desc: recorde profile HasVideoRecorderProfile agrees with GetVideoRecorderProfile for every quality level
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(RecorderProfilesUnitTest, recorder_profile_HasVideoRecorderProfile_0300, TestSize.Level0)
+{
+    int32_t sourceId = 0;
+    std::vector<int32_t> qualityLevels = {RECORDER_QUALITY_LOW, RECORDER_QUALITY_HIGH, RECORDER_QUALITY_QCIF,
+        RECORDER_QUALITY_CIF, RECORDER_QUALITY_480P, RECORDER_QUALITY_720P, RECORDER_QUALITY_1080P,
+        RECORDER_QUALITY_QVGA, RECORDER_QUALITY_2160P, RECORDER_QUALITY_TIME_LAPSE_LOW,
+        RECORDER_QUALITY_HIGH_SPEED_LOW};
+    RecorderProfiles &recorderProfiles = RecorderProfilesFactory::CreateRecorderProfiles();
+    for (int32_t qualityLevel : qualityLevels) {
+        bool hasProfile = recorderProfiles.HasVideoRecorderProfile(sourceId, qualityLevel);
+        std::shared_ptr<VideoRecorderProfile> videoRecorderProfile =
+            recorderProfiles.GetVideoRecorderProfile(sourceId, qualityLevel);
+        ASSERT_TRUE(videoRecorderProfile != nullptr);
+        if (hasProfile) {
+            EXPECT_EQ(qualityLevel, videoRecorderProfile->qualityLevel);
+            EXPECT_FALSE(videoRecorderProfile->containerFormatType.empty());
+        } else {
+            EXPECT_TRUE(videoRecorderProfile->containerFormatType.empty());
+        }
+    }
+}
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
@@ -89,6 +89,15 @@ int32_t ScreenCaptureImpl::ExcludeContent(ScreenCaptureContentFilter &contentFil
     return screenCaptureService_->ExcludeContent(contentFilter);
 }
 
+int32_t ScreenCaptureImpl::AddOutputProfile(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile)
+{
+    MEDIA_LOGD("ScreenCaptureImpl:0x%{public}06" PRIXPTR " AddOutputProfile in", FAKE_POINTER(this));
+    CHECK_AND_RETURN_RET_LOG(screenCaptureService_ != nullptr, MSERR_NO_MEMORY,
+        "screen capture service does not exist..");
+    CHECK_AND_RETURN_RET_LOG(surface != nullptr, MSERR_INVALID_VAL, "surface is nullptr");
+    return screenCaptureService_->AddOutputProfile(surface, profile);
+}
+
 int32_t ScreenCaptureImpl::SetPrivacyAuthorityEnabled()
 {
     CHECK_AND_RETURN_RET_LOG(screenCaptureService_ != nullptr, MSERR_NO_MEMORY,
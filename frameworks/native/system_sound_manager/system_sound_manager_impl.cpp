@@ -25,6 +25,7 @@
 #include "media_errors.h"
 #include "ringtone_player_impl.h"
 #include "system_tone_player_impl.h"
+#include "tone_attrs_index.h"
 
 using namespace std;
 using namespace nlohmann;
@@ -96,10 +97,14 @@ SystemSoundManagerImpl::SystemSoundManagerImpl()
     InitDefaultUriMap();
     InitRingerMode();
     InitMap();
+    InitToneAttrsIndex();
 }
 
 SystemSoundManagerImpl::~SystemSoundManagerImpl()
 {
+    if (toneAttrsIndex_ != nullptr) {
+        toneAttrsIndex_->SetChangeCallback(nullptr);
+    }
     if (audioGroupManager_ != nullptr) {
         (void)audioGroupManager_->UnsetRingerModeCallback(getpid(), ringerModeCallback_);
         ringerModeCallback_ = nullptr;
@@ -120,6 +125,17 @@ void SystemSoundManagerImpl::InitMap(void)
     shotToneTypeMap_[SYSTEM_TONE_TYPE_SIM_CARD_1] = SHOT_TONE_TYPE_SIM_CARD_2;
 }
 
+void SystemSoundManagerImpl::InitToneAttrsIndex(void)
+{
+    toneAttrsIndex_ = std::make_shared<ToneAttrsIndex>();
+    toneAttrsIndex_->SetChangeCallback([this]() {
+        // The tones may be changed by other processes, let the system tone players check their uri again.
+        NotifySystemToneChanged(SYSTEM_TONE_TYPE_SIM_CARD_0);
+        NotifySystemToneChanged(SYSTEM_TONE_TYPE_SIM_CARD_1);
+        NotifySystemToneChanged(SYSTEM_TONE_TYPE_NOTIFICATION);
+    });
+}
+
 void SystemSoundManagerImpl::InitRingerMode(void)
 {
     audioGroupManager_ = AudioStandard::AudioSystemManager::GetInstance()->
@@ -418,6 +434,7 @@ int32_t SystemSoundManagerImpl::SetRingtoneUri(const shared_ptr<Context> &contex
     if (ringtoneAsset != nullptr) {
         int32_t changedRows = UpdateRingtoneUri(dataShareHelper, ringtoneAsset->GetId(),
             ringtoneType, ringtoneAsset->GetRingtoneType());
+        toneAttrsIndex_->Invalidate();
         resultSet == nullptr ? : resultSet->Close();
         return changedRows > 0 ? SUCCESS : ERROR;
     }
@@ -450,12 +467,20 @@ std::string SystemSoundManagerImpl::GetRingtoneUri(const shared_ptr<Context> &co
     CHECK_AND_RETURN_RET_LOG(isRingtoneTypeValid(ringtoneType), "", "Invalid ringtone type");
     std::string ringtoneUri = "";
     MEDIA_LOGI("GetRingtoneUri: ringtoneType %{public}d", ringtoneType);
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataShareHelper(STORAGE_MANAGER_MANAGER_ID);
-    CHECK_AND_RETURN_RET_LOG(dataShareHelper != nullptr, "",
-        "Create dataShare failed, datashare or ringtone library error.");
-    ringtoneUri = GetRingtoneUriByType(dataShareHelper, to_string(ringtoneTypeMap_[ringtoneType]));
-    if (ringtoneUri.empty()) {
-        ringtoneUri = GetRingtoneUriByType(dataShareHelper, to_string(RING_TONE_TYPE_SIM_CARD_BOTH));
+    bool isIndexed = toneAttrsIndex_->GetCustomizedRingtoneUri(ringtoneTypeMap_[ringtoneType], ringtoneUri);
+    if (isIndexed && ringtoneUri.empty()) {
+        isIndexed = toneAttrsIndex_->GetCustomizedRingtoneUri(RING_TONE_TYPE_SIM_CARD_BOTH, ringtoneUri);
+    }
+    if (!isIndexed) {
+        std::shared_ptr<DataShare::DataShareHelper> dataShareHelper =
+            CreateDataShareHelper(STORAGE_MANAGER_MANAGER_ID);
+        CHECK_AND_RETURN_RET_LOG(dataShareHelper != nullptr, "",
+            "Create dataShare failed, datashare or ringtone library error.");
+        ringtoneUri = GetRingtoneUriByType(dataShareHelper, to_string(ringtoneTypeMap_[ringtoneType]));
+        if (ringtoneUri.empty()) {
+            ringtoneUri = GetRingtoneUriByType(dataShareHelper, to_string(RING_TONE_TYPE_SIM_CARD_BOTH));
+        }
+        dataShareHelper->Release();
     }
     if (ringtoneUri.empty()) {
         std::shared_ptr<ToneAttrs> ringtoneAttrs = GetDefaultRingtoneAttrs(context, ringtoneType);
@@ -465,7 +490,6 @@ std::string SystemSoundManagerImpl::GetRingtoneUri(const shared_ptr<Context> &co
             MEDIA_LOGE("GetRingtoneUri: no ringtone in the ringtone library!");
         }
     }
-    dataShareHelper->Release();
     if (!ringtoneUri.empty()) {
         MEDIA_LOGI("GetRingtoneUri: ringtoneUri %{public}s", ringtoneUri.c_str());
     }
@@ -476,6 +500,10 @@ std::string SystemSoundManagerImpl::GetRingtoneTitle(const std::string &ringtone
 {
     std::lock_guard<std::mutex> lock(uriMutex_);
     std::string ringtoneTitle = "";
+    ToneIndexRecord record;
+    if (toneAttrsIndex_->GetRecordByUri(ringtoneUri, record)) {
+        return record.title;
+    }
     std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataShareHelper(STORAGE_MANAGER_MANAGER_ID);
     CHECK_AND_RETURN_RET_LOG(dataShareHelper != nullptr, ringtoneUri,
         "Create dataShare failed, datashare or ringtone library error.");
@@ -513,13 +541,30 @@ std::shared_ptr<SystemTonePlayer> SystemSoundManagerImpl::GetSystemTonePlayer(
     CHECK_AND_RETURN_RET_LOG(isSystemToneTypeValid(systemToneType), nullptr, "invalid system tone type");
     MEDIA_LOGI("GetSystemTonePlayer: for systemToneType %{public}d", systemToneType);
 
-    std::shared_ptr<SystemTonePlayer> systemTonePlayer =
+    std::shared_ptr<SystemTonePlayerImpl> systemTonePlayer =
         std::make_shared<SystemTonePlayerImpl>(context, *this, systemToneType);
     CHECK_AND_RETURN_RET_LOG(systemTonePlayer != nullptr, nullptr,
         "Failed to create system tone player object");
+
+    std::lock_guard<std::mutex> playersLock(systemTonePlayersMutex_);
+    for (auto iter = systemTonePlayers_.begin(); iter != systemTonePlayers_.end();) {
+        iter = iter->expired() ? systemTonePlayers_.erase(iter) : iter + 1;
+    }
+    systemTonePlayers_.push_back(systemTonePlayer);
     return systemTonePlayer;
 }
 
+void SystemSoundManagerImpl::NotifySystemToneChanged(SystemToneType systemToneType)
+{
+    std::lock_guard<std::mutex> lock(systemTonePlayersMutex_);
+    for (auto &weakPlayer : systemTonePlayers_) {
+        std::shared_ptr<SystemTonePlayerImpl> player = weakPlayer.lock();
+        if (player != nullptr) {
+            player->NotifySystemToneChanged(systemToneType);
+        }
+    }
+}
+
 int32_t SystemSoundManagerImpl::UpdateShotToneUri(std::shared_ptr<DataShare::DataShareHelper> dataShareHelper,
     const int32_t &toneId, SystemToneType systemToneType, const int32_t &num)
 {
@@ -623,6 +668,10 @@ int32_t SystemSoundManagerImpl::SetSystemToneUri(const shared_ptr<Context> &cont
                 systemToneType, ringtoneAsset->GetShottoneType());
         }
         resultSet == nullptr ? : resultSet->Close();
+        toneAttrsIndex_->Invalidate();
+        if (changedRows > 0) {
+            NotifySystemToneChanged(systemToneType);
+        }
         return changedRows > 0 ? SUCCESS : ERROR;
     }
     resultSet == nullptr ? : resultSet->Close();
@@ -757,6 +806,15 @@ std::vector<std::shared_ptr<ToneAttrs>> SystemSoundManagerImpl::GetRingtoneAttrL
 {
     std::lock_guard<std::mutex> lock(uriMutex_);
     ringtoneAttrsArray_.clear();
+    std::vector<ToneIndexRecord> records;
+    if (toneAttrsIndex_->GetRecordList(TONE_TYPE_RINGTONE, records)) {
+        for (const auto &record : records) {
+            ringtoneAttrs_ = std::make_shared<ToneAttrs>(record.title, record.displayName, record.path,
+                sourceTypeMap_[record.sourceType], TONE_CATEGORY_RINGTONE);
+            ringtoneAttrsArray_.push_back(ringtoneAttrs_);
+        }
+        return ringtoneAttrsArray_;
+    }
     std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataShareHelper(STORAGE_MANAGER_MANAGER_ID);
     CHECK_AND_RETURN_RET_LOG(dataShareHelper != nullptr, ringtoneAttrsArray_,
         "Create dataShare failed, datashare or ringtone library error.");
@@ -837,11 +895,20 @@ std::vector<std::shared_ptr<ToneAttrs>> SystemSoundManagerImpl::GetSystemToneAtt
 {
     std::lock_guard<std::mutex> lock(uriMutex_);
     systemtoneAttrsArray_.clear();
+    int32_t category = systemToneType == SYSTEM_TONE_TYPE_NOTIFICATION ?
+        TONE_CATEGORY_NOTIFICATION : TONE_CATEGORY_TEXT_MESSAGE;
+    std::vector<ToneIndexRecord> records;
+    if (toneAttrsIndex_->GetRecordList(TONE_TYPE_NOTIFICATION, records)) {
+        for (const auto &record : records) {
+            systemtoneAttrs_ = std::make_shared<ToneAttrs>(record.title, record.displayName, record.path,
+                sourceTypeMap_[record.sourceType], category);
+            systemtoneAttrsArray_.push_back(systemtoneAttrs_);
+        }
+        return systemtoneAttrsArray_;
+    }
     std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataShareHelper(STORAGE_MANAGER_MANAGER_ID);
     CHECK_AND_RETURN_RET_LOG(dataShareHelper != nullptr, systemtoneAttrsArray_,
         "Create dataShare failed, datashare or ringtone library error.");
-    int32_t category = systemToneType == SYSTEM_TONE_TYPE_NOTIFICATION ?
-        TONE_CATEGORY_NOTIFICATION : TONE_CATEGORY_TEXT_MESSAGE;
     DataShare::DatashareBusinessError businessError;
     DataShare::DataSharePredicates queryPredicates;
     queryPredicates.EqualTo(RINGTONE_COLUMN_TONE_TYPE, to_string(TONE_TYPE_NOTIFICATION));
@@ -906,6 +973,7 @@ int32_t SystemSoundManagerImpl::SetAlarmToneUri(const std::shared_ptr<AbilityRun
         updateValuesBucket.Put(RINGTONE_COLUMN_ALARM_TONE_TYPE, ALARM_TONE_TYPE);
         updateValuesBucket.Put(RINGTONE_COLUMN_ALARM_TONE_SOURCE_TYPE, SOURCE_TYPE_CUSTOMISED);
         int32_t changedRows = dataShareHelper->Update(RINGTONEURI, updatePredicates, updateValuesBucket);
+        toneAttrsIndex_->Invalidate();
         resultSet == nullptr ? : resultSet->Close();
         dataShareHelper->Release();
         return changedRows > 0 ? SUCCESS : ERROR;
@@ -977,6 +1045,15 @@ std::vector<std::shared_ptr<ToneAttrs>> SystemSoundManagerImpl::GetAlarmToneAttr
 {
     std::lock_guard<std::mutex> lock(uriMutex_);
     alarmtoneAttrsArray_.clear();
+    std::vector<ToneIndexRecord> records;
+    if (toneAttrsIndex_->GetRecordList(TONE_TYPE_ALARM, records)) {
+        for (const auto &record : records) {
+            alarmtoneAttrs_ = std::make_shared<ToneAttrs>(record.title, record.displayName, record.path,
+                sourceTypeMap_[record.sourceType], TONE_CATEGORY_ALARM);
+            alarmtoneAttrsArray_.push_back(alarmtoneAttrs_);
+        }
+        return alarmtoneAttrsArray_;
+    }
     std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataShareHelper(STORAGE_MANAGER_MANAGER_ID);
     CHECK_AND_RETURN_RET_LOG(dataShareHelper != nullptr, alarmtoneAttrsArray_,
         "Create dataShare failed, datashare or ringtone library error.");
@@ -1125,7 +1202,9 @@ int32_t SystemSoundManagerImpl::AddCustomizedTone(const std::shared_ptr<DataShar
             break;
     }
     valuesBucket.Put(RINGTONE_COLUMN_DATA, static_cast<string>(toneAttrs->GetUri()));
-    return dataShareHelper->Insert(RINGTONEURI, valuesBucket);
+    int32_t result = dataShareHelper->Insert(RINGTONEURI, valuesBucket);
+    toneAttrsIndex_->Invalidate();
+    return result;
 }
 
 std::string SystemSoundManagerImpl::AddCustomizedToneByFdAndOffset(
@@ -1208,6 +1287,7 @@ int32_t SystemSoundManagerImpl::RemoveCustomizedTone(
         deletePredicates.SetWhereClause(RINGTONE_COLUMN_TONE_ID + " = ? ");
         deletePredicates.SetWhereArgs({to_string(ringtoneAsset->GetId())});
         changedRows = dataShareHelper->Delete(RINGTONEURI, deletePredicates);
+        toneAttrsIndex_->Invalidate();
     } else {
         MEDIA_LOGE("RemoveCustomizedTone: the ringtone is not customized!");
     }
@@ -41,6 +41,8 @@
 namespace OHOS {
 namespace Media {
 class RingerModeCallbackImpl;
+class SystemTonePlayerImpl;
+class ToneAttrsIndex;
 
 class SystemSoundManagerImpl : public SystemSoundManager {
 public:
@@ -93,6 +95,7 @@ public:
     int32_t RemoveCustomizedTone(const std::shared_ptr<AbilityRuntime::Context> &context,
         const std::string &uri) override;
     std::string GetRingtoneTitle(const std::string &ringtoneUri);
+    void NotifySystemToneChanged(SystemToneType systemToneType);
 
 private:
     void InitDefaultUriMap();
@@ -107,6 +110,7 @@ private:
     std::string GetUriFromDatabase(const std::string &key);
     std::string GetKeyForDatabase(const std::string &systemSoundType, int32_t type);
     void InitRingerMode(void);
+    void InitToneAttrsIndex(void);
     void GetCustomizedTone(const std::shared_ptr<ToneAttrs> &toneAttrs);
     void InitMap();
     std::string GetRingtoneUriByType(std::shared_ptr<DataShare::DataShareHelper> dataShareHelper,
@@ -127,6 +131,8 @@ private:
     std::string systemSoundPath_ = "";
     std::mutex uriMutex_;
     std::mutex playerMutex_;
+    std::mutex systemTonePlayersMutex_;
+    std::vector<std::weak_ptr<SystemTonePlayerImpl>> systemTonePlayers_;
     std::string mimeType_ = "";
     std::string displayName_ = "";
     std::unordered_map<RingtoneType, std::string> defaultRingtoneUriMap_;
@@ -141,6 +147,7 @@ private:
     std::vector<std::shared_ptr<ToneAttrs>> ringtoneAttrsArray_;
     std::vector<std::shared_ptr<ToneAttrs>> systemtoneAttrsArray_;
     std::vector<std::shared_ptr<ToneAttrs>> alarmtoneAttrsArray_;
+    std::shared_ptr<ToneAttrsIndex> toneAttrsIndex_ = nullptr;
 };
 
 class RingerModeCallbackImpl : public AudioStandard::AudioRingerModeCallback {
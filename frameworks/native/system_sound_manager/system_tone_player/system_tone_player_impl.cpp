@@ -54,6 +54,7 @@ SystemTonePlayerImpl::SystemTonePlayerImpl(const shared_ptr<Context> &context,
 SystemTonePlayerImpl::~SystemTonePlayerImpl()
 {
     DeleteAllPlayer();
+    DeleteAllPreparedPlayer();
     audioHapticManager_->UnregisterSource(sourceId_);
 }
 
@@ -61,6 +62,8 @@ int32_t SystemTonePlayerImpl::InitPlayer(const std::string &audioUri)
 {
     MEDIA_LOGI("Enter InitPlayer() with audio uri %{public}s", audioUri.c_str());
 
+    // The prepared players belong to the previous source, they can not be reused for the new uri.
+    DeleteAllPreparedPlayer();
     if (sourceId_ != -1) {
         (void)audioHapticManager_->UnregisterSource(sourceId_);
         sourceId_ = -1;
@@ -86,6 +89,38 @@ int32_t SystemTonePlayerImpl::InitPlayer(const std::string &audioUri)
     return MSERR_OK;
 }
 
+int32_t SystemTonePlayerImpl::GetOptionsKey(const AudioHapticPlayerOptions &options)
+{
+    return (static_cast<int32_t>(options.muteAudio) << 1) | static_cast<int32_t>(options.muteHaptics);
+}
+
+int32_t SystemTonePlayerImpl::PreparePlayerWithOptions(const AudioHapticPlayerOptions &options)
+{
+    int32_t optionsKey = GetOptionsKey(options);
+    if (preparedPlayerMap_.count(optionsKey) > 0) {
+        return MSERR_OK;
+    }
+
+    std::shared_ptr<AudioHapticPlayer> player = audioHapticManager_->CreatePlayer(sourceId_, options);
+    CHECK_AND_RETURN_RET_LOG(player != nullptr, MSERR_OPEN_FILE_FAILED,
+        "Failed to create system tone player instance");
+
+    std::shared_ptr<SystemTonePlayerCallback> callback =
+        std::make_shared<SystemTonePlayerCallback>(-1, shared_from_this());
+    CHECK_AND_RETURN_RET_LOG(callback != nullptr, MSERR_OPEN_FILE_FAILED,
+        "Failed to create system tone player callback object");
+    (void)player->SetAudioHapticPlayerCallback(callback);
+
+    int32_t result = player->Prepare();
+    if (result != MSERR_OK) {
+        MEDIA_LOGE("Failed to prepare for system tone player: %{public}d", result);
+        (void)player->Release();
+        return result;
+    }
+    preparedPlayerMap_[optionsKey] = std::make_pair(player, callback);
+    return MSERR_OK;
+}
+
 int32_t SystemTonePlayerImpl::CreatePlayerWithOptions(const AudioHapticPlayerOptions &options)
 {
     streamId_++;
@@ -94,18 +129,19 @@ int32_t SystemTonePlayerImpl::CreatePlayerWithOptions(const AudioHapticPlayerOpt
         DeletePlayer(streamId_);
     }
 
-    playerMap_[streamId_] = audioHapticManager_->CreatePlayer(sourceId_, options);
-    CHECK_AND_RETURN_RET_LOG(playerMap_[streamId_] != nullptr, MSERR_OPEN_FILE_FAILED,
-        "Failed to create system tone player instance");
-
-    callbackMap_[streamId_] = std::make_shared<SystemTonePlayerCallback>(streamId_, shared_from_this());
-    CHECK_AND_RETURN_RET_LOG(callbackMap_[streamId_] != nullptr, MSERR_OPEN_FILE_FAILED,
-        "Failed to create system tone player callback object");
-    (void)playerMap_[streamId_]->SetAudioHapticPlayerCallback(callbackMap_[streamId_]);
-
-    int32_t result = playerMap_[streamId_]->Prepare();
+    int32_t result = PreparePlayerWithOptions(options);
     CHECK_AND_RETURN_RET_LOG(result == MSERR_OK, result,
-        "Failed to prepare for system tone player: %{public}d", result);
+        "Failed to get prepared system tone player: %{public}d", result);
+
+    int32_t optionsKey = GetOptionsKey(options);
+    auto iter = preparedPlayerMap_.find(optionsKey);
+    CHECK_AND_RETURN_RET_LOG(iter != preparedPlayerMap_.end(), MSERR_OPEN_FILE_FAILED,
+        "The prepared system tone player is not found");
+    playerMap_[streamId_] = iter->second.first;
+    callbackMap_[streamId_] = iter->second.second;
+    callbackMap_[streamId_]->SetStreamId(streamId_);
+    optionsKeyMap_[streamId_] = optionsKey;
+    preparedPlayerMap_.erase(iter);
     return MSERR_OK;
 }
 
@@ -204,7 +240,10 @@ int32_t SystemTonePlayerImpl::Prepare()
     std::string systemToneUri = systemSoundMgr_.GetSystemToneUri(context_, systemToneType_);
     if (!configuredUri_.empty() && configuredUri_ == systemToneUri) {
         MEDIA_LOGI("The right system tone uri has been registered. Return directly.");
+        isSystemToneChanged_ = false;
         systemToneState_ = SystemToneState::STATE_PREPARED;
+        // Keep a player with default options prepared, so that the first Start() only starts the renderer.
+        (void)PreparePlayerWithOptions({false, muteHaptics_});
         return MSERR_OK;
     }
 
@@ -212,7 +251,9 @@ int32_t SystemTonePlayerImpl::Prepare()
     int32_t result = InitPlayer(systemToneUri);
     CHECK_AND_RETURN_RET_LOG(result == MSERR_OK, result,
         "Failed to init player for system tone player: %{public}d", result);
+    isSystemToneChanged_ = false;
     systemToneState_ = SystemToneState::STATE_PREPARED;
+    (void)PreparePlayerWithOptions({false, muteHaptics_});
     return result;
 }
 
@@ -231,6 +272,8 @@ int32_t SystemTonePlayerImpl::Start(const SystemToneOptions &systemToneOptions)
     CHECK_AND_RETURN_RET_LOG(systemToneState_ != SystemToneState::STATE_RELEASED, MSERR_INVALID_STATE,
         "System tone player has been released!");
 
+    CheckSystemToneChanged();
+
     int32_t result = MSERR_OK;
     bool actualMuteHaptics = systemToneOptions.muteHaptics || muteHaptics_;
     AudioHapticPlayerOptions actualOptions = {systemToneOptions.muteAudio, actualMuteHaptics};
@@ -257,7 +300,11 @@ int32_t SystemTonePlayerImpl::Stop(const int32_t &streamId)
     }
 
     int32_t result = playerMap_[streamId]->Stop();
-    DeletePlayer(streamId);
+    if (result == MSERR_OK) {
+        RecyclePlayer(streamId);
+    } else {
+        DeletePlayer(streamId);
+    }
     CHECK_AND_RETURN_RET_LOG(result == MSERR_OK, MSERR_INVALID_OPERATION,
         "Failed to stop audio haptic player: %{public}d", result);
     return result;
@@ -272,6 +319,7 @@ int32_t SystemTonePlayerImpl::Release()
         return MSERR_OK;
     }
     DeleteAllPlayer();
+    DeleteAllPreparedPlayer();
     audioHapticManager_->UnregisterSource(sourceId_);
     systemToneState_ = SystemToneState::STATE_RELEASED;
     return MSERR_OK;
@@ -294,6 +342,7 @@ void SystemTonePlayerImpl::DeletePlayer(const int32_t &streamId)
     if (callbackMap_.count(streamId) > 0) {
         callbackMap_.erase(streamId);
     }
+    optionsKeyMap_.erase(streamId);
     MEDIA_LOGI("DeletePlayer. playerMap_.size() %{public}zu  callbackMap_.size() %{public}zu ",
         playerMap_.size(), callbackMap_.size());
 }
@@ -306,13 +355,73 @@ void SystemTonePlayerImpl::DeleteAllPlayer()
     }
     playerMap_.clear();
     callbackMap_.clear();
+    optionsKeyMap_.clear();
+}
+
+void SystemTonePlayerImpl::DeleteAllPreparedPlayer()
+{
+    MEDIA_LOGI("Delete all prepared audio haptic player!");
+    for (auto iter = preparedPlayerMap_.begin(); iter != preparedPlayerMap_.end(); iter++) {
+        iter->second.first->Release();
+    }
+    preparedPlayerMap_.clear();
+}
+
+void SystemTonePlayerImpl::RecyclePlayer(const int32_t &streamId)
+{
+    auto optionsIter = optionsKeyMap_.find(streamId);
+    if (systemToneState_ == SystemToneState::STATE_RELEASED || isSystemToneChanged_ ||
+        optionsIter == optionsKeyMap_.end() || preparedPlayerMap_.count(optionsIter->second) > 0 ||
+        playerMap_.count(streamId) == 0 || callbackMap_.count(streamId) == 0) {
+        DeletePlayer(streamId);
+        return;
+    }
+
+    MEDIA_LOGI("RecyclePlayer for streamId %{public}d", streamId);
+    // The finished player stays prepared. Detach it from the stream id and keep it for the next Start().
+    callbackMap_[streamId]->SetStreamId(-1);
+    preparedPlayerMap_[optionsIter->second] = std::make_pair(playerMap_[streamId], callbackMap_[streamId]);
+    playerMap_.erase(streamId);
+    callbackMap_.erase(streamId);
+    optionsKeyMap_.erase(optionsIter);
 }
 
-void SystemTonePlayerImpl::NotifyEndofStreamEvent(const int32_t &streamId)
+void SystemTonePlayerImpl::CheckSystemToneChanged()
+{
+    if (!isSystemToneChanged_.exchange(false)) {
+        return;
+    }
+    MEDIA_LOGI("The system tone has been changed. Reload the system tone uri.");
+    DeleteAllPreparedPlayer();
+    std::string systemToneUri = systemSoundMgr_.GetSystemToneUri(context_, systemToneType_);
+    if (configuredUri_ != systemToneUri) {
+        int32_t result = InitPlayer(systemToneUri);
+        CHECK_AND_RETURN_LOG(result == MSERR_OK, "Failed to reload system tone uri: %{public}d", result);
+    }
+}
+
+void SystemTonePlayerImpl::NotifySystemToneChanged(SystemToneType systemToneType)
+{
+    if (systemToneType != systemToneType_) {
+        return;
+    }
+    // Only mark here. The caller may hold the uri lock of system sound manager, so the prepared
+    // players are invalidated by the next Start() under the player lock.
+    MEDIA_LOGI("NotifySystemToneChanged for systemToneType %{public}d", systemToneType);
+    isSystemToneChanged_ = true;
+}
+
+void SystemTonePlayerImpl::NotifyEndofStreamEvent(const int32_t &streamId, uint32_t generation)
 {
     std::lock_guard<std::mutex> lock(systemTonePlayerMutex_);
-    // onPlayFinished for a stream.
-    DeletePlayer(streamId);
+    auto callbackIter = callbackMap_.find(streamId);
+    if (callbackIter == callbackMap_.end() || !callbackIter->second->IsBoundTo(streamId, generation)) {
+        // The player has been recycled and bound to another stream since the event was raised.
+        MEDIA_LOGW("Ignore the stale end of stream event of streamId %{public}d", streamId);
+        return;
+    }
+    // onPlayFinished for a stream. Keep the player prepared for the next Start().
+    RecyclePlayer(streamId);
 }
 
 void SystemTonePlayerImpl::NotifyInterruptEvent(const int32_t &streamId,
@@ -329,6 +438,26 @@ SystemTonePlayerCallback::SystemTonePlayerCallback(int32_t streamId,
     systemTonePlayerImpl_ = systemTonePlayerImpl;
 }
 
+void SystemTonePlayerCallback::SetStreamId(int32_t streamId)
+{
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    streamId_ = streamId;
+    generation_++;
+}
+
+int32_t SystemTonePlayerCallback::GetStreamId(uint32_t &generation)
+{
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    generation = generation_;
+    return streamId_;
+}
+
+bool SystemTonePlayerCallback::IsBoundTo(int32_t streamId, uint32_t generation)
+{
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    return streamId_ == streamId && generation_ == generation;
+}
+
 void SystemTonePlayerCallback::OnInterrupt(const AudioStandard::InterruptEvent &interruptEvent)
 {
     MEDIA_LOGI("OnInterrupt from audio haptic player: hintTye %{public}d", interruptEvent.hintType);
@@ -337,18 +466,25 @@ void SystemTonePlayerCallback::OnInterrupt(const AudioStandard::InterruptEvent &
         MEDIA_LOGE("The audio haptic player has been released.");
         return;
     }
-    player->NotifyInterruptEvent(streamId_, interruptEvent);
+    uint32_t generation = 0;
+    player->NotifyInterruptEvent(GetStreamId(generation), interruptEvent);
 }
 
 void SystemTonePlayerCallback::OnEndOfStream(void)
 {
-    MEDIA_LOGI("OnEndOfStream from audio haptic player. StreamId %{public}d", streamId_);
+    uint32_t generation = 0;
+    int32_t streamId = GetStreamId(generation);
+    MEDIA_LOGI("OnEndOfStream from audio haptic player. StreamId %{public}d", streamId);
+    if (streamId == -1) {
+        MEDIA_LOGW("The player is not bound to any stream.");
+        return;
+    }
     std::shared_ptr<SystemTonePlayerImpl> player = systemTonePlayerImpl_.lock();
     if (player == nullptr) {
         MEDIA_LOGE("The audio haptic player has been released.");
         return;
     }
-    player->NotifyEndofStreamEvent(streamId_);
+    player->NotifyEndofStreamEvent(streamId, generation);
 }
 
 void SystemTonePlayerCallback::OnError(int32_t errorCode)
@@ -37,14 +37,22 @@ public:
     int32_t Stop(const int32_t &streamID) override;
     int32_t Release() override;
 
-    void NotifyEndofStreamEvent(const int32_t &streamId);
+    void NotifyEndofStreamEvent(const int32_t &streamId, uint32_t generation);
     void NotifyInterruptEvent(const int32_t &streamId, const AudioStandard::InterruptEvent &interruptEvent);
+    void NotifySystemToneChanged(SystemToneType systemToneType);
 
 private:
+    using PreparedPlayer = std::pair<std::shared_ptr<AudioHapticPlayer>, std::shared_ptr<SystemTonePlayerCallback>>;
+
     int32_t InitPlayer(const std::string &audioUri);
     int32_t CreatePlayerWithOptions(const AudioHapticPlayerOptions &options);
+    int32_t PreparePlayerWithOptions(const AudioHapticPlayerOptions &options);
+    void RecyclePlayer(const int32_t &streamId);
     void DeletePlayer(const int32_t &streamId);
     void DeleteAllPlayer();
+    void DeleteAllPreparedPlayer();
+    void CheckSystemToneChanged();
+    static int32_t GetOptionsKey(const AudioHapticPlayerOptions &options);
     std::string GetHapticUriForAudioUri(const std::string &audioUri);
     bool IsFileExisting(const std::string &fileUri);
     bool GetMuteHapticsValue();
@@ -53,6 +61,11 @@ private:
     std::shared_ptr<AudioHapticManager> audioHapticManager_ = nullptr;
     std::unordered_map<int32_t, std::shared_ptr<AudioHapticPlayer>> playerMap_;
     std::unordered_map<int32_t, std::shared_ptr<SystemTonePlayerCallback>> callbackMap_;
+    // streamId -> options key of the player, used to recycle the player when the stream finishes.
+    std::unordered_map<int32_t, int32_t> optionsKeyMap_;
+    // options key -> prepared idle player of the configured uri, reused by the next Start().
+    std::unordered_map<int32_t, PreparedPlayer> preparedPlayerMap_;
+    std::atomic<bool> isSystemToneChanged_ = false;
     bool muteHaptics_ = false;
     int32_t sourceId_ = -1;
     int32_t streamId_ = 0;
@@ -74,9 +87,16 @@ public:
     void OnEndOfStream(void) override;
     void OnError(int32_t errorCode) override;
 
+    void SetStreamId(int32_t streamId);
+    int32_t GetStreamId(uint32_t &generation);
+    bool IsBoundTo(int32_t streamId, uint32_t generation);
+
 private:
     std::weak_ptr<SystemTonePlayerImpl> systemTonePlayerImpl_;
-    int32_t streamId_;
+    std::mutex streamMutex_;
+    int32_t streamId_ = -1;
+    // bumped on every SetStreamId, tells events of an earlier binding of the recycled player apart
+    uint32_t generation_ = 0;
 };
 } // namespace Media
 } // namespace OHOS
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tone_attrs_index.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+
+#include "iservice_registry.h"
+#include "ringtone_asset.h"
+#include "ringtone_db_const.h"
+#include "ringtone_fetch_result.h"
+#include "system_ability_definition.h"
+
+#include "media_log.h"
+
+using namespace std;
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_AUDIO_NAPI, "ToneAttrsIndex"};
+}
+
+namespace OHOS {
+namespace Media {
+const int STORAGE_MANAGER_MANAGER_ID = 5003;
+const int32_t INVALID_TONE_ID = -1;
+const vector<string> INDEX_COLUMNS = {{RINGTONE_COLUMN_TONE_ID}, {RINGTONE_COLUMN_DATA},
+    {RINGTONE_COLUMN_DISPLAY_NAME}, {RINGTONE_COLUMN_TITLE}, {RINGTONE_COLUMN_TONE_TYPE},
+    {RINGTONE_COLUMN_SOURCE_TYPE}, {RINGTONE_COLUMN_RING_TONE_TYPE}, {RINGTONE_COLUMN_RING_TONE_SOURCE_TYPE}};
+
+static shared_ptr<DataShare::DataShareHelper> CreateDataShareHelper(int32_t systemAbilityId)
+{
+    auto saManager = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    if (saManager == nullptr) {
+        MEDIA_LOGE("Get system ability manager failed.");
+        return nullptr;
+    }
+    auto remoteObj = saManager->GetSystemAbility(systemAbilityId);
+    if (remoteObj == nullptr) {
+        MEDIA_LOGE("Get system ability:[%{public}d] failed.", systemAbilityId);
+        return nullptr;
+    }
+    return DataShare::DataShareHelper::Creator(remoteObj, RINGTONE_URI);
+}
+
+static ToneIndexRecord MakeRecord(const unique_ptr<RingtoneAsset> &ringtoneAsset)
+{
+    ToneIndexRecord record;
+    record.toneId = ringtoneAsset->GetId();
+    record.toneType = ringtoneAsset->GetToneType();
+    record.sourceType = ringtoneAsset->GetSourceType();
+    record.ringtoneType = ringtoneAsset->GetRingtoneType();
+    record.ringtoneSourceType = ringtoneAsset->GetRingtoneSourceType();
+    record.title = ringtoneAsset->GetTitle();
+    record.displayName = ringtoneAsset->GetDisplayName();
+    record.path = ringtoneAsset->GetPath();
+    return record;
+}
+
+ToneAttrsIndex::~ToneAttrsIndex()
+{
+    if (dataShareHelper_ != nullptr) {
+        if (toneObserver_ != nullptr) {
+            Uri ringtoneUri(RINGTONE_PATH_URI);
+            dataShareHelper_->UnregisterObserverExt(ringtoneUri, toneObserver_);
+            toneObserver_ = nullptr;
+        }
+        dataShareHelper_->Release();
+        dataShareHelper_ = nullptr;
+    }
+}
+
+void ToneAttrsIndex::SetChangeCallback(const std::function<void()> &callback)
+{
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    changeCallback_ = callback;
+}
+
+void ToneAttrsIndex::Invalidate()
+{
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    needReload_ = true;
+}
+
+bool ToneAttrsIndex::GetRecordList(int32_t toneType, std::vector<ToneIndexRecord> &records)
+{
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    CHECK_AND_RETURN_RET_LOG(EnsureUpdatedLocked(), false, "The tone attrs index is unavailable");
+    records.clear();
+    auto typeIter = typeIndex_.find(toneType);
+    if (typeIter == typeIndex_.end()) {
+        return true;
+    }
+    records.reserve(typeIter->second.size());
+    for (const auto &[toneId, record] : typeIter->second) {
+        records.push_back(record);
+    }
+    return true;
+}
+
+bool ToneAttrsIndex::GetRecordByUri(const std::string &uri, ToneIndexRecord &record)
+{
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    CHECK_AND_RETURN_RET_LOG(EnsureUpdatedLocked(), false, "The tone attrs index is unavailable");
+    auto uriIter = uriIndex_.find(uri);
+    if (uriIter == uriIndex_.end()) {
+        return false;
+    }
+    record = typeIndex_[uriIter->second.first][uriIter->second.second];
+    return true;
+}
+
+bool ToneAttrsIndex::GetCustomizedRingtoneUri(int32_t ringtoneType, std::string &uri)
+{
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    CHECK_AND_RETURN_RET_LOG(EnsureUpdatedLocked(), false, "The tone attrs index is unavailable");
+    uri = "";
+    for (const auto &[toneType, records] : typeIndex_) {
+        for (const auto &[toneId, record] : records) {
+            if (record.ringtoneType == ringtoneType && record.ringtoneSourceType == SOURCE_TYPE_CUSTOMISED) {
+                uri = record.path;
+                return true;
+            }
+        }
+    }
+    return true;
+}
+
+void ToneAttrsIndex::OnToneChanged(const DataShare::DataShareObserver::ChangeInfo &changeInfo)
+{
+    {
+        std::lock_guard<std::mutex> lock(indexMutex_);
+        MEDIA_LOGI("OnToneChanged: changeType %{public}u, uri count %{public}zu",
+            static_cast<uint32_t>(changeInfo.changeType_), changeInfo.uris_.size());
+        for (const auto &uri : changeInfo.uris_) {
+            int32_t toneId = GetToneIdFromUri(uri.ToString());
+            if (toneId == INVALID_TONE_ID) {
+                needReload_ = true;
+                break;
+            }
+            dirtyToneIds_.insert(toneId);
+        }
+        if (changeInfo.uris_.empty()) {
+            needReload_ = true;
+        }
+    }
+    // the owner clears the callback before it is destroyed, that waits here until the callback returned
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    if (changeCallback_ != nullptr) {
+        changeCallback_();
+    }
+}
+
+int32_t ToneAttrsIndex::GetToneIdFromUri(const std::string &uriStr)
+{
+    size_t pos = uriStr.find_last_of('/');
+    std::string idStr = pos == std::string::npos ? uriStr : uriStr.substr(pos + 1);
+    if (idStr.empty() || idStr.find_first_not_of("0123456789") != std::string::npos) {
+        return INVALID_TONE_ID;
+    }
+    char *end = nullptr;
+    errno = 0;
+    long long toneId = strtoll(idStr.c_str(), &end, 10); /* 10 means decimal */
+    if (errno == ERANGE || end == idStr.c_str() || *end != '\0' || toneId > INT32_MAX) {
+        return INVALID_TONE_ID;
+    }
+    return static_cast<int32_t>(toneId);
+}
+
+bool ToneAttrsIndex::EnsureUpdatedLocked()
+{
+    if (dataShareHelper_ == nullptr) {
+        dataShareHelper_ = CreateDataShareHelper(STORAGE_MANAGER_MANAGER_ID);
+        CHECK_AND_RETURN_RET_LOG(dataShareHelper_ != nullptr, false,
+            "Create dataShare failed, datashare or ringtone library error.");
+        RegisterObserverLocked();
+    }
+    if (!isLoaded_ || needReload_) {
+        return ReloadAllLocked();
+    }
+    for (int32_t toneId : dirtyToneIds_) {
+        RefreshToneLocked(toneId);
+    }
+    dirtyToneIds_.clear();
+    return true;
+}
+
+void ToneAttrsIndex::RegisterObserverLocked()
+{
+    if (toneObserver_ != nullptr) {
+        return;
+    }
+    toneObserver_ = std::make_shared<ToneChangeObserver>(weak_from_this());
+    Uri ringtoneUri(RINGTONE_PATH_URI);
+    dataShareHelper_->RegisterObserverExt(ringtoneUri, toneObserver_, true);
+}
+
+bool ToneAttrsIndex::ReloadAllLocked()
+{
+    MEDIA_LOGI("Reload all tones of the ringtone library.");
+    DataShare::DatashareBusinessError businessError;
+    DataShare::DataSharePredicates queryPredicates;
+    queryPredicates.GreaterThan(RINGTONE_COLUMN_MEDIA_TYPE, to_string(RINGTONE_MEDIA_TYPE_INVALID));
+    Uri ringtonePathUri(RINGTONE_PATH_URI);
+    auto resultSet = dataShareHelper_->Query(ringtonePathUri, queryPredicates, INDEX_COLUMNS, &businessError);
+    CHECK_AND_RETURN_RET_LOG(resultSet != nullptr, false, "Failed to query the ringtone library.");
+    auto results = make_unique<RingtoneFetchResult<RingtoneAsset>>(move(resultSet));
+
+    typeIndex_.clear();
+    uriIndex_.clear();
+    unique_ptr<RingtoneAsset> ringtoneAsset = results->GetFirstObject();
+    while (ringtoneAsset != nullptr) {
+        InsertRecordLocked(MakeRecord(ringtoneAsset));
+        ringtoneAsset = results->GetNextObject();
+    }
+    resultSet == nullptr ? : resultSet->Close();
+
+    isLoaded_ = true;
+    needReload_ = false;
+    dirtyToneIds_.clear();
+    MEDIA_LOGI("The tone attrs index has %{public}zu tones.", uriIndex_.size());
+    return true;
+}
+
+void ToneAttrsIndex::RefreshToneLocked(int32_t toneId)
+{
+    EraseRecordLocked(toneId);
+
+    DataShare::DatashareBusinessError businessError;
+    DataShare::DataSharePredicates queryPredicates;
+    queryPredicates.EqualTo(RINGTONE_COLUMN_TONE_ID, to_string(toneId));
+    queryPredicates.GreaterThan(RINGTONE_COLUMN_MEDIA_TYPE, to_string(RINGTONE_MEDIA_TYPE_INVALID));
+    Uri ringtonePathUri(RINGTONE_PATH_URI);
+    auto resultSet = dataShareHelper_->Query(ringtonePathUri, queryPredicates, INDEX_COLUMNS, &businessError);
+    auto results = make_unique<RingtoneFetchResult<RingtoneAsset>>(move(resultSet));
+    unique_ptr<RingtoneAsset> ringtoneAsset = results->GetFirstObject();
+    if (ringtoneAsset != nullptr) {
+        InsertRecordLocked(MakeRecord(ringtoneAsset));
+    }
+    resultSet == nullptr ? : resultSet->Close();
+}
+
+void ToneAttrsIndex::InsertRecordLocked(const ToneIndexRecord &record)
+{
+    typeIndex_[record.toneType][record.toneId] = record;
+    uriIndex_[record.path] = std::make_pair(record.toneType, record.toneId);
+}
+
+void ToneAttrsIndex::EraseRecordLocked(int32_t toneId)
+{
+    for (auto &[toneType, records] : typeIndex_) {
+        auto recordIter = records.find(toneId);
+        if (recordIter == records.end()) {
+            continue;
+        }
+        auto uriIter = uriIndex_.find(recordIter->second.path);
+        if (uriIter != uriIndex_.end() && uriIter->second.second == toneId) {
+            uriIndex_.erase(uriIter);
+        }
+        records.erase(recordIter);
+        return;
+    }
+}
+
+ToneChangeObserver::ToneChangeObserver(std::weak_ptr<ToneAttrsIndex> toneAttrsIndex)
+    : toneAttrsIndex_(toneAttrsIndex)
+{
+}
+
+void ToneChangeObserver::OnChange(const ChangeInfo &changeInfo)
+{
+    std::shared_ptr<ToneAttrsIndex> toneAttrsIndex = toneAttrsIndex_.lock();
+    CHECK_AND_RETURN_LOG(toneAttrsIndex != nullptr, "The tone attrs index has been released.");
+    toneAttrsIndex->OnToneChanged(changeInfo);
+}
+} // namespace Media
+} // namespace OHOS
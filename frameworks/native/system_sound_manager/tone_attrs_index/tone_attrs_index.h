@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TONE_ATTRS_INDEX_H
+#define TONE_ATTRS_INDEX_H
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "datashare_helper.h"
+#include "datashare_observer.h"
+
+namespace OHOS {
+namespace Media {
+struct ToneIndexRecord {
+    int32_t toneId = -1;
+    int32_t toneType = -1;
+    int32_t sourceType = -1;
+    int32_t ringtoneType = -1;
+    int32_t ringtoneSourceType = -1;
+    std::string title = "";
+    std::string displayName = "";
+    std::string path = "";
+};
+
+/**
+ * In-process index of the valid tones in the ringtone library, keyed by tone type and by uri.
+ * It is loaded once, then kept up to date by the change notifications of the ringtone library:
+ * changed tone ids are re-queried one by one on the next read, unknown changes reload everything.
+ */
+class ToneAttrsIndex : public std::enable_shared_from_this<ToneAttrsIndex> {
+public:
+    ToneAttrsIndex() = default;
+    ~ToneAttrsIndex();
+
+    bool GetRecordList(int32_t toneType, std::vector<ToneIndexRecord> &records);
+    bool GetRecordByUri(const std::string &uri, ToneIndexRecord &record);
+    bool GetCustomizedRingtoneUri(int32_t ringtoneType, std::string &uri);
+    void SetChangeCallback(const std::function<void()> &callback);
+    void Invalidate();
+    void OnToneChanged(const DataShare::DataShareObserver::ChangeInfo &changeInfo);
+
+private:
+    bool EnsureUpdatedLocked();
+    bool ReloadAllLocked();
+    void RefreshToneLocked(int32_t toneId);
+    void InsertRecordLocked(const ToneIndexRecord &record);
+    void EraseRecordLocked(int32_t toneId);
+    void RegisterObserverLocked();
+    static int32_t GetToneIdFromUri(const std::string &uriStr);
+
+    std::mutex indexMutex_;
+    bool isLoaded_ = false;
+    bool needReload_ = true;
+    std::set<int32_t> dirtyToneIds_;
+    // tone type -> (tone id -> record), ordered by tone id as the ringtone library returns them.
+    std::unordered_map<int32_t, std::map<int32_t, ToneIndexRecord>> typeIndex_;
+    // tone uri -> (tone type, tone id)
+    std::unordered_map<std::string, std::pair<int32_t, int32_t>> uriIndex_;
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper_ = nullptr;
+    std::shared_ptr<DataShare::DataShareObserver> toneObserver_ = nullptr;
+    // held while the callback runs, so clearing it waits for a running callback to return
+    std::mutex callbackMutex_;
+    std::function<void()> changeCallback_ = nullptr;
+};
+
+class ToneChangeObserver : public DataShare::DataShareObserver {
+public:
+    explicit ToneChangeObserver(std::weak_ptr<ToneAttrsIndex> toneAttrsIndex);
+    virtual ~ToneChangeObserver() = default;
+    void OnChange(const ChangeInfo &changeInfo) override;
+
+private:
+    std::weak_ptr<ToneAttrsIndex> toneAttrsIndex_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // TONE_ATTRS_INDEX_H
@@ -14,6 +14,8 @@
  */
 #include "system_sound_manager_unit_test.h"
 
+#include "media_errors.h"
+
 using namespace OHOS::AbilityRuntime;
 using namespace testing::ext;
 
@@ -286,5 +288,52 @@ HWTEST(SystemSoundManagerUnitTest, Media_SoundManager_RemoveCustomizedTone_001,
     EXPECT_NE(res, 0);
 }
 
+/**
+ * @tc.name  : Test SystemTonePlayer Start API
+ * @tc.number: Media_SoundManager_SystemTonePlayer_Start_001
+ * @tc.desc  : Test SystemTonePlayer Start interface. The prepared player is reused after the stream is stopped.
+ */
+HWTEST(SystemSoundManagerUnitTest, Media_SoundManager_SystemTonePlayer_Start_001, TestSize.Level2)
+{
+    auto systemSoundManager_ = SystemSoundManagerFactory::CreateSystemSoundManager();
+    std::shared_ptr<AbilityRuntime::Context> context_ = std::make_shared<ContextImpl>();
+    auto systemTonePlayer_ = systemSoundManager_->GetSystemTonePlayer(context_,
+        SystemToneType::SYSTEM_TONE_TYPE_NOTIFICATION);
+    ASSERT_NE(systemTonePlayer_, nullptr);
+    EXPECT_EQ(systemTonePlayer_->Prepare(), MSERR_OK);
+
+    SystemToneOptions options = {false, true};
+    int32_t streamId = systemTonePlayer_->Start(options);
+    EXPECT_GT(streamId, 0);
+    EXPECT_EQ(systemTonePlayer_->Stop(streamId), MSERR_OK);
+
+    int32_t nextStreamId = systemTonePlayer_->Start(options);
+    EXPECT_GT(nextStreamId, streamId);
+    EXPECT_EQ(systemTonePlayer_->Stop(nextStreamId), MSERR_OK);
+    EXPECT_EQ(systemTonePlayer_->Release(), MSERR_OK);
+}
+
+/**
+ * @tc.name  : Test GetRingtoneAttrList API
+ * @tc.number: Media_SoundManager_GetRingtoneAttrList_002
+ * @tc.desc  : Test GetRingtoneAttrList interface. Repeated calls served by the tone index return the same tones.
+ */
+HWTEST(SystemSoundManagerUnitTest, Media_SoundManager_GetRingtoneAttrList_002, TestSize.Level2)
+{
+    auto systemSoundManager_ = SystemSoundManagerFactory::CreateSystemSoundManager();
+    std::shared_ptr<AbilityRuntime::Context> context_ = std::make_shared<ContextImpl>();
+    auto firstAttrsArray_ = systemSoundManager_->GetRingtoneAttrList(context_,
+        RingtoneType::RINGTONE_TYPE_SIM_CARD_0);
+    auto secondAttrsArray_ = systemSoundManager_->GetRingtoneAttrList(context_,
+        RingtoneType::RINGTONE_TYPE_SIM_CARD_0);
+    ASSERT_GT(firstAttrsArray_.size(), 0);
+    ASSERT_EQ(firstAttrsArray_.size(), secondAttrsArray_.size());
+    EXPECT_EQ(firstAttrsArray_[0]->GetUri(), secondAttrsArray_[0]->GetUri());
+
+    auto systemSoundManagerImpl_ = std::static_pointer_cast<SystemSoundManagerImpl>(systemSoundManager_);
+    EXPECT_EQ(systemSoundManagerImpl_->GetRingtoneTitle(firstAttrsArray_[0]->GetUri()),
+        firstAttrsArray_[0]->GetTitle());
+}
+
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
@@ -199,6 +199,8 @@ enum PlayerOnInfoType : int32_t {
     INFO_TYPE_AUDIO_DEVICE_CHANGE,
     /* return the subtitle info */
     INFO_TYPE_SUBTITLE_UPDATE_INFO,
+    /* return the time spent in each startup phase in ms, keyed by phase name. */
+    INFO_TYPE_STARTUP_BREAKDOWN,
 };
 
 enum PlayerStates : int32_t {
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <map>
 #include <set>
 #include <parcel.h>
@@ -33,6 +34,32 @@ namespace OHOS {
 namespace Media {
 using ConfigMap = std::map<std::string, int32_t>;
 constexpr size_t DEVICE_INFO_SIZE_LIMIT = 30; // 30 from audioCapture
+
+class AudioSharedRing;
+
+/**
+ * @brief Keys of the extended parameters set through {@link Recorder::SetParameter}.
+ */
+class RecorderKeys {
+public:
+    /**
+     * Int32 length in milliseconds of the encoded stream kept in memory while recording, see
+     * {@link Recorder::SavePreCache}. Must be set before {@link Prepare}, 0 turns the cache off. The cache is
+     * filled from the encoded stream, without an output file the recording only fills the cache.
+     */
+    static constexpr std::string_view RECORDER_PRE_CACHE_DURATION = "pre_cache_duration";
+    /**
+     * Int32 upper bound in bytes of the in-memory cache, whole groups of pictures are dropped to stay below it.
+     */
+    static constexpr std::string_view RECORDER_PRE_CACHE_MAX_SIZE = "pre_cache_max_size";
+    /**
+     * Int32, 1 makes {@link Recorder::Stop} finish the output file but keep the video encoder and the surface
+     * returned by {@link Recorder::GetSurface} alive. When the next recording is configured the same way,
+     * {@link Recorder::Prepare} only sets up a new muxer and the same surface is handed out again.
+     * The mode lasts until {@link Recorder::Reset}.
+     */
+    static constexpr std::string_view RECORDER_SOFT_STOP = "soft_stop";
+};
 /**
  * @brief Enumerates video source types.
  *
@@ -926,7 +953,8 @@ public:
      *
      * This function must be called after {@link Start}. After this function is called, the file is split based on the
      * manual split type. After the manual split is complete, the initial split type is used. This function can be
-     * called again only after {@link RECORDER_INFO_FILE_SPLIT_FINISHED} is reported.
+     * called again only after {@link RECORDER_INFO_FILE_SPLIT_FINISHED} is reported. An error is returned when the
+     * muxer in use can not move over to another output file.
      *
      * @param type Indicates the file split type. For details, see {@link FileSplitType}.
      * @param timestamp Indicates the file split timestamp. This parameter is not supported currently and can be set to
@@ -979,6 +1007,33 @@ public:
      * @version 1.0
     */
     virtual int32_t SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer) = 0;
+    /**
+     * @brief Writes the last seconds held in the pre-cache to a separate file.
+     *
+     * The cache is enabled with {@link RecorderKeys::RECORDER_PRE_CACHE_DURATION}. This function must be called
+     * after {@link Start} and before {@link Stop}, the saved file begins at a key frame and the recording itself
+     * goes on unchanged. The cache also fills when no regular output file is set.
+     *
+     * @param fd Indicates the file descriptor of the file to write.
+     * @param duration Indicates how many milliseconds to save, counted back from the newest encoded frame.
+     * @return Returns {@link MSERR_OK} if the file is written; returns an error code otherwise.
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual int32_t SavePreCache(int32_t fd, int32_t duration) = 0;
+    /**
+     * @brief Sets a shared memory ring as the audio data source for recording.
+     *
+     * The caller writes PCM into the ring from its own thread, the recorder service reads it from the shared
+     * block without a remote call per buffer. This function must be called before {@link SetOutputFormat}.
+     *
+     * @param ring Indicates the ring created with AudioSharedRing::Create.
+     * @param sourceId Indicates the audio source ID. The value <b>-1</b> indicates an invalid ID and the setting fails.
+     * @return Returns {@link MSERR_OK} if the setting is successful; returns an error code otherwise.
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual int32_t SetAudioSharedRing(const std::shared_ptr<AudioSharedRing> &ring, int32_t &sourceId) = 0;
 };
 
 class __attribute__((visibility("default"))) RecorderFactory {
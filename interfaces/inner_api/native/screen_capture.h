@@ -142,6 +142,13 @@ struct ScreenCaptureContentFilter {
     std::vector<uint64_t> windowIDsVec;
 };
 
+struct ScreenCaptureOutputProfile {
+    int32_t width = 0;
+    int32_t height = 0;
+    /* region of the captured frame to scale, an empty rect selects the whole frame */
+    OHOS::Rect cropRect = {0, 0, 0, 0};
+};
+
 struct AudioCaptureInfo {
     int32_t audioSampleRate = 0;
     int32_t audioChannels = 0;
@@ -259,6 +266,7 @@ public:
     virtual int32_t SetScreenCaptureCallback(const std::shared_ptr<ScreenCaptureCallBack> &callback) = 0;
     virtual int32_t ExcludeContent(ScreenCaptureContentFilter &contentFilter) = 0;
     virtual int32_t SetPrivacyAuthorityEnabled() = 0;
+    virtual int32_t AddOutputProfile(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile) = 0;
 };
 
 class __attribute__((visibility("default"))) ScreenCaptureFactory {
@@ -47,6 +47,17 @@ enum TransCoderOnInfoType : int32_t {
     INFO_TYPE_TRANSCODER_COMPLETED = 0,
     /* return the current progress of transcoder automatically. */
     INFO_TYPE_PROGRESS_UPDATE = 1,
+    /* the service wide job queue holds the transcoding back or lets it go on, extra is a TransCoderScheduleState. */
+    INFO_TYPE_SCHEDULE_STATE_CHANGE = 2,
+};
+
+enum TransCoderScheduleState : int32_t {
+    /* started, but waiting for codecs or memory used by other transcodings. */
+    SCHEDULE_STATE_QUEUED = 0,
+    /* paused by the service so a foreground transcoding can run, goes on by itself later. */
+    SCHEDULE_STATE_SUSPENDED = 1,
+    /* running again after one of the states above. */
+    SCHEDULE_STATE_RUNNING = 2,
 };
 
 /**
@@ -14,15 +14,29 @@
  */
 
 #include "dfx_log_dump.h"
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <unistd.h>
 #include <malloc.h>
-#include <sys/time.h>
-#include "securec.h"
 
 namespace {
 constexpr int32_t FILE_MAX = 100;
-constexpr int32_t FILE_LINE_MAX = 50000;
+constexpr uint32_t FILE_LINE_MAX = 50000;
+// rings are drained this often while enabled, the file is still written once a minute or when a file is full
+constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(100);
+constexpr auto WRITE_INTERVAL = std::chrono::seconds(60);
+constexpr auto CHECK_INTERVAL = std::chrono::seconds(60);
+
+struct ThreadRingHolder {
+    std::shared_ptr<OHOS::Media::DfxLogRing> ring;
+    ~ThreadRingHolder()
+    {
+        if (ring != nullptr) {
+            ring->Retire();
+        }
+    }
+};
 }
 namespace OHOS {
 namespace Media {
@@ -49,68 +63,30 @@ DfxLogDump::~DfxLogDump()
     }
 }
 
-static void AddNewLog(const char *level, const OHOS::HiviewDFX::HiLogLabel &label, std::string &logStr)
+DfxLogRing *DfxLogDump::GetThreadRing()
 {
-    struct timeval time = {};
-    (void)gettimeofday(&time, nullptr);
-    int64_t second = time.tv_sec % 60;
-    int64_t allMinute = time.tv_sec / 60;
-    int64_t minute = allMinute % 60;
-    int64_t hour = allMinute / 60 % 24;
-    int64_t mSecond = time.tv_usec / 1000;
-
-    logStr += std::to_string(hour);
-    logStr += ":";
-    logStr += std::to_string(minute);
-    logStr += ":";
-    logStr += std::to_string(second);
-    logStr += ":";
-    logStr += std::to_string(mSecond);
-    logStr += " ";
-    logStr += level;
-    logStr += " pid:";
-    logStr += std::to_string(getpid());
-    logStr += " tid:";
-    logStr += std::to_string(gettid());
-    logStr += " ";
-    logStr += label.tag;
-    logStr += ":";
+    thread_local ThreadRingHolder holder;
+    if (holder.ring == nullptr) {
+        holder.ring = std::make_shared<DfxLogRing>();
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        rings_.push_back(holder.ring);
+    }
+    return holder.ring.get();
 }
 
 void DfxLogDump::SaveLog(const char *level, const OHOS::HiviewDFX::HiLogLabel &label, const char *fmt, ...)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (!isEnable_) {
+    if (!isEnable_.load(std::memory_order_relaxed)) {
         return;
     }
-    std::string temp = "";
-    std::string fmtStr = fmt;
-    int32_t srcPos = 0;
-    auto dtsPos = fmtStr.find("{public}", srcPos);
-    const int32_t pubLen = 8;
-    while (dtsPos != std::string::npos) {
-        temp += fmtStr.substr(srcPos, dtsPos - srcPos);
-        srcPos = static_cast<int32_t>(dtsPos) + pubLen;
-        dtsPos = fmtStr.find("{public}", srcPos);
-    }
-    temp += fmtStr.substr(srcPos);
-
+    DfxLogRing *ring = GetThreadRing();
     va_list ap;
     va_start(ap, fmt);
-    constexpr uint32_t maxLogLen = 1024;
-    char logBuf[maxLogLen];
-    auto ret = vsnprintf_s(logBuf, maxLogLen, maxLogLen - 1, temp.c_str(), ap);
+    (void)ring->Write(level, label.tag, fmt, ap);
     va_end(ap);
-
-    AddNewLog(level, label, logString_);
-    if (ret < 0) {
-        logString_ += "dump log error";
-    } else {
-        logString_ += logBuf;
-    }
-    logString_ += "\n";
-    lineCount_++;
-    if (lineCount_ >= FILE_LINE_MAX) {
+    // one wake-up per drain, later lines of the burst only find the request pending
+    if (ring->GetUsedSize() > ring->GetCapacity() / 2 && !isDrainRequested_.exchange(true)) {
+        std::lock_guard<std::mutex> lock(mutex_);
         cond_.notify_all();
     }
 }
@@ -127,52 +103,97 @@ void DfxLogDump::UpdateCheckEnable()
     isEnable_ = true;
 }
 
+uint32_t DfxLogDump::DrainRings(std::string &logString)
+{
+    std::vector<std::shared_ptr<DfxLogRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        rings = rings_;
+    }
+    uint32_t lineCount = 0;
+    uint64_t droppedCount = 0;
+    for (auto &ring : rings) {
+        lineCount += ring->Drain(logString);
+        droppedCount += ring->TakeDroppedCount();
+    }
+    if (droppedCount > 0) {
+        logString += "DfxLogDump dropped " + std::to_string(droppedCount) + " lines\n";
+    }
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(), [](const std::shared_ptr<DfxLogRing> &ring) {
+        return ring->IsRetired() && ring->GetUsedSize() == 0;
+    }), rings_.end());
+    return lineCount;
+}
+
+void DfxLogDump::WriteLogFile(const std::string &logString, bool isFull)
+{
+    std::string file = "/data/media/log/";
+    file += std::to_string(getpid());
+    file += "_hilog_media.log";
+    file += std::to_string(fileCount_);
+    std::ofstream ofStream;
+    if (isNewFile_) {
+        ofStream.open(file, std::ios::out | std::ios::trunc);
+    } else {
+        ofStream.open(file, std::ios::out | std::ios::app);
+    }
+    if (!ofStream.is_open()) {
+        return;
+    }
+    isNewFile_ = false;
+    if (isFull) {
+        isNewFile_ = true;
+        fileCount_++;
+        fileCount_ = fileCount_ > FILE_MAX ? 0 : fileCount_;
+    }
+    ofStream.write(logString.c_str(), logString.size());
+    ofStream.close();
+}
+
 void DfxLogDump::TaskProcessor()
 {
     pthread_setname_np(pthread_self(), "DfxLogTask");
     (void)mallopt(M_SET_THREAD_CACHE, M_THREAD_CACHE_DISABLE);
     (void)mallopt(M_DELAYED_FREE, M_DELAYED_FREE_DISABLE);
+    std::string logString;
+    uint32_t lineCount = 0;
+    auto lastWriteTime = std::chrono::steady_clock::now();
+    auto lastCheckTime = lastWriteTime - CHECK_INTERVAL;
     while (true) {
-        std::string temp;
-        int32_t lineCount = 0;
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastCheckTime >= CHECK_INTERVAL) {
+            // probing the config file touches the file system, it is kept away from the logging threads
+            UpdateCheckEnable();
+            lastCheckTime = now;
+        }
+        bool isExit = false;
+        bool isDump = false;
         {
             std::unique_lock<std::mutex> lock(mutex_);
-            if (isExit_) {
-                return;
+            std::chrono::milliseconds timeout = DRAIN_INTERVAL;
+            if (!isEnable_.load()) {
+                timeout = CHECK_INTERVAL;
             }
-            static constexpr int32_t timeout = 60; // every 1 minute have a log
-            cond_.wait_for(lock, std::chrono::seconds(timeout),
-                [this] {
-                    UpdateCheckEnable();
-                    return isExit_ || isDump_ || lineCount_ >= FILE_LINE_MAX || !logString_.empty();
-            });
+            cond_.wait_for(lock, timeout, [this] { return isExit_ || isDump_ || isDrainRequested_.load(); });
+            isExit = isExit_;
+            isDump = isDump_;
             isDump_ = false;
-            lineCount = lineCount_;
-            lineCount_ = lineCount_ >= FILE_LINE_MAX ? 0 : lineCount_;
-            swap(logString_, temp);
+            isDrainRequested_ = false;
         }
 
-        std::string file = "/data/media/log/";
-        file += std::to_string(getpid());
-        file += "_hilog_media.log";
-        file += std::to_string(fileCount_);
-        std::ofstream ofStream;
-        if (isNewFile_) {
-            ofStream.open(file, std::ios::out | std::ios::trunc);
-        } else {
-            ofStream.open(file, std::ios::out | std::ios::app);
-        }
-        if (!ofStream.is_open()) {
-            continue;
+        lineCount += DrainRings(logString);
+        bool isFull = lineCount >= FILE_LINE_MAX;
+        now = std::chrono::steady_clock::now();
+        if (!logString.empty() && (isFull || isDump || isExit || now - lastWriteTime >= WRITE_INTERVAL)) {
+            WriteLogFile(logString, isFull);
+            logString.clear();
+            lastWriteTime = now;
+            lineCount = isFull ? 0 : lineCount;
         }
-        isNewFile_ = false;
-        if (lineCount >= FILE_LINE_MAX) {
-            isNewFile_ = true;
-            fileCount_++;
-            fileCount_ = fileCount_ > FILE_MAX ? 0 : fileCount_;
+        if (isExit) {
+            return;
         }
-        ofStream.write(temp.c_str(), temp.size());
-        ofStream.close();
     }
 }
 } // namespace Media
@@ -15,10 +15,15 @@
 #ifndef DFX_LOG_DUMP_H
 #define DFX_LOG_DUMP_H
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <string>
 #include <hilog/log.h>
 #include <thread>
 #include <mutex>
+#include <vector>
+#include "dfx_log_ring.h"
 
 namespace OHOS {
 namespace Media {
@@ -31,16 +36,21 @@ private:
     DfxLogDump();
     ~DfxLogDump();
     void UpdateCheckEnable();
+    DfxLogRing *GetThreadRing();
+    uint32_t DrainRings(std::string &logString);
+    void WriteLogFile(const std::string &logString, bool isFull);
     int32_t fileCount_ = 0;
-    int32_t lineCount_ = 0;
     std::unique_ptr<std::thread> thread_;
     void TaskProcessor();
     std::mutex mutex_;
     std::condition_variable cond_;
-    std::string logString_;
+    std::mutex ringMutex_;
+    std::vector<std::shared_ptr<DfxLogRing>> rings_;
     bool isDump_ = false;
     bool isExit_ = false;
-    bool isEnable_ = false;
+    // set by a logging thread whose ring is half full, the writer drains before the next interval
+    std::atomic<bool> isDrainRequested_ = false;
+    std::atomic<bool> isEnable_ = false;
     bool isNewFile_ = true;
 };
 } // namespace Media
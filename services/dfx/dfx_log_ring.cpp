@@ -0,0 +1,470 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dfx_log_ring.h"
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unistd.h>
+#include <sys/time.h>
+#include "securec.h"
+
+namespace {
+constexpr size_t RECORD_ALIGN = 8;
+constexpr size_t ARG_SLOT_SIZE = 8;
+constexpr size_t MAX_SEGMENT_LEN = 1024;
+constexpr int64_t US_PER_MS = 1000;
+constexpr int64_t US_PER_SECOND = 1000000;
+constexpr int64_t SECONDS_PER_MINUTE = 60;
+constexpr int64_t MINUTES_PER_HOUR = 60;
+constexpr int64_t HOURS_PER_DAY = 24;
+const char *PUBLIC_TAG = "{public}";
+const char *PRIVATE_TAG = "{private}";
+const char *PRIVATE_STRING = "<private>";
+const char *NULL_STRING = "(null)";
+
+size_t AlignRecord(size_t size)
+{
+    return (size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+}
+
+size_t RoundUpPowerOfTwo(size_t size)
+{
+    size_t capacity = RECORD_ALIGN;
+    while (capacity < size) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+void AppendFormatted(std::string &out, const char *fmt, ...)
+{
+    char buf[MAX_SEGMENT_LEN] = {0};
+    va_list ap;
+    va_start(ap, fmt);
+    // truncated output is still kept, as the old dump did with its single buffer
+    (void)vsnprintf_s(buf, MAX_SEGMENT_LEN, MAX_SEGMENT_LEN - 1, fmt, ap);
+    va_end(ap);
+    out += buf;
+}
+
+// private arguments are consumed to keep the following ones in place, but never stored
+template <typename T>
+void PutArg(uint8_t *record, size_t &pos, T value, bool isPrivate = false)
+{
+    if (isPrivate) {
+        return;
+    }
+    static_assert(sizeof(T) <= ARG_SLOT_SIZE, "argument does not fit a slot");
+    (void)memcpy_s(record + pos, ARG_SLOT_SIZE, &value, sizeof(T));
+    pos += ARG_SLOT_SIZE;
+}
+
+template <typename T>
+T GetArg(const uint8_t *&payload)
+{
+    T value;
+    (void)memcpy_s(&value, sizeof(T), payload, sizeof(T));
+    payload += ARG_SLOT_SIZE;
+    return value;
+}
+}
+
+namespace OHOS {
+namespace Media {
+const DfxLogFormat *DfxLogFormat::Get(const char *fmt)
+{
+    thread_local std::unordered_map<const char *, const DfxLogFormat *> localFormats;
+    auto iter = localFormats.find(fmt);
+    if (iter != localFormats.end()) {
+        return iter->second;
+    }
+    static std::mutex formatMutex;
+    // never freed, log sites may still run while the process exits
+    static auto *formats = new std::unordered_map<const char *, std::unique_ptr<DfxLogFormat>>();
+    std::lock_guard<std::mutex> lock(formatMutex);
+    auto &format = (*formats)[fmt];
+    if (format == nullptr) {
+        format = std::make_unique<DfxLogFormat>(fmt);
+    }
+    localFormats[fmt] = format.get();
+    return format.get();
+}
+
+DfxLogFormat::DfxLogFormat(const char *fmt)
+{
+    std::string format = fmt == nullptr ? "" : fmt;
+    stripped_ = format;
+    for (const char *tag : { PUBLIC_TAG, PRIVATE_TAG }) {
+        size_t tagLen = strlen(tag);
+        for (size_t pos = stripped_.find(tag); pos != std::string::npos; pos = stripped_.find(tag, pos)) {
+            stripped_.erase(pos, tagLen);
+        }
+    }
+    hasPrivate_ = format.find(PRIVATE_TAG) != std::string::npos;
+    isSupported_ = Parse(format);
+    if (!isSupported_) {
+        segments_.clear();
+    }
+}
+
+bool DfxLogFormat::Parse(const std::string &fmt)
+{
+    std::string literal;
+    size_t pos = 0;
+    size_t len = fmt.size();
+    while (pos < len) {
+        if (fmt[pos] != '%') {
+            literal += fmt[pos++];
+            continue;
+        }
+        if (pos + 1 < len && fmt[pos + 1] == '%') {
+            literal += '%';
+            pos += 2; // 2 is the length of "%%"
+            continue;
+        }
+        pos++;
+        bool isPrivate = false;
+        if (fmt.compare(pos, strlen(PUBLIC_TAG), PUBLIC_TAG) == 0) {
+            pos += strlen(PUBLIC_TAG);
+        } else if (fmt.compare(pos, strlen(PRIVATE_TAG), PRIVATE_TAG) == 0) {
+            pos += strlen(PRIVATE_TAG);
+            isPrivate = true;
+        }
+        size_t start = pos;
+        while (pos < len && strchr("-+ #0", fmt[pos]) != nullptr) {
+            pos++;
+        }
+        while (pos < len && isdigit(static_cast<unsigned char>(fmt[pos]))) {
+            pos++;
+        }
+        if (pos < len && fmt[pos] == '.') {
+            pos++;
+            while (pos < len && isdigit(static_cast<unsigned char>(fmt[pos]))) {
+                pos++;
+            }
+        }
+        std::string length;
+        while (pos < len && strchr("hljztL", fmt[pos]) != nullptr) {
+            length += fmt[pos++];
+        }
+        if (pos >= len) {
+            return false;
+        }
+        char conversion = fmt[pos++];
+        ArgType type = ArgType::LITERAL;
+        if (strchr("diuoxXc", conversion) != nullptr) {
+            if (length.empty() || length == "h" || length == "hh") {
+                type = ArgType::INT;
+            } else if (length == "l" && conversion != 'c') {
+                type = ArgType::LONG;
+            } else if (length == "ll" && conversion != 'c') {
+                type = ArgType::LONG_LONG;
+            } else if (length == "j" && conversion != 'c') {
+                type = ArgType::INTMAX;
+            } else if (length == "z" && conversion != 'c') {
+                type = ArgType::SIZE;
+            } else if (length == "t" && conversion != 'c') {
+                type = ArgType::PTRDIFF;
+            }
+        } else if (strchr("eEfFgGaA", conversion) != nullptr && (length.empty() || length == "l")) {
+            type = ArgType::DOUBLE;
+        } else if (conversion == 'p' && length.empty()) {
+            type = ArgType::POINTER;
+        } else if (conversion == 's' && length.empty()) {
+            type = ArgType::STRING;
+        }
+        // '*' width or precision, long double, wide strings, %n and unknown conversions end up here
+        if (type == ArgType::LITERAL) {
+            return false;
+        }
+        if (!literal.empty()) {
+            segments_.push_back({literal, ArgType::LITERAL});
+            literal.clear();
+        }
+        segments_.push_back({"%" + fmt.substr(start, pos - start), type, isPrivate});
+    }
+    if (!literal.empty()) {
+        segments_.push_back({literal, ArgType::LITERAL});
+    }
+    return true;
+}
+
+bool DfxLogFormat::IsSupported() const
+{
+    return isSupported_;
+}
+
+const std::string &DfxLogFormat::GetStripped() const
+{
+    return stripped_;
+}
+
+const std::vector<DfxLogFormat::Segment> &DfxLogFormat::GetSegments() const
+{
+    return segments_;
+}
+
+bool DfxLogFormat::HasPrivate() const
+{
+    return hasPrivate_;
+}
+
+DfxLogRing::DfxLogRing(size_t capacity)
+    : capacity_(RoundUpPowerOfTwo(capacity < MAX_RECORD_SIZE * 2 ? MAX_RECORD_SIZE * 2 : capacity))
+{
+    buffer_.resize(capacity_);
+}
+
+size_t DfxLogRing::Serialize(uint8_t *record, const char *level, const char *tag, const char *fmt, va_list args)
+{
+    struct timeval time = {};
+    (void)gettimeofday(&time, nullptr);
+    RecordHeader header = {};
+    header.tid = gettid();
+    header.timeUs = static_cast<int64_t>(time.tv_sec) * US_PER_SECOND + time.tv_usec;
+    header.level = level;
+    header.tag = tag;
+    header.format = DfxLogFormat::Get(fmt);
+
+    size_t pos = sizeof(RecordHeader);
+    if (!header.format->IsSupported()) {
+        const std::string &stripped = header.format->GetStripped();
+        char *text = reinterpret_cast<char *>(record + pos);
+        size_t textMax = MAX_RECORD_SIZE - pos;
+        if (header.format->HasPrivate()) {
+            // the arguments can not be told apart without parsing, so none of them is formatted
+            size_t textLen = std::min(stripped.size(), textMax - 1);
+            (void)memcpy_s(text, textMax, stripped.c_str(), textLen);
+            pos += textLen;
+        } else {
+            int32_t ret = vsnprintf_s(text, textMax, textMax - 1, stripped.c_str(), args);
+            pos += ret < 0 ? strlen(text) : static_cast<size_t>(ret);
+        }
+        header.format = nullptr;
+    } else {
+        for (const auto &segment : header.format->GetSegments()) {
+            switch (segment.type) {
+                case DfxLogFormat::ArgType::INT:
+                    PutArg(record, pos, va_arg(args, int), segment.isPrivate);
+                    break;
+                case DfxLogFormat::ArgType::LONG:
+                    PutArg(record, pos, va_arg(args, long), segment.isPrivate);
+                    break;
+                case DfxLogFormat::ArgType::LONG_LONG:
+                    PutArg(record, pos, va_arg(args, long long), segment.isPrivate);
+                    break;
+                case DfxLogFormat::ArgType::INTMAX:
+                    PutArg(record, pos, va_arg(args, intmax_t), segment.isPrivate);
+                    break;
+                case DfxLogFormat::ArgType::SIZE:
+                    PutArg(record, pos, va_arg(args, size_t), segment.isPrivate);
+                    break;
+                case DfxLogFormat::ArgType::PTRDIFF:
+                    PutArg(record, pos, va_arg(args, ptrdiff_t), segment.isPrivate);
+                    break;
+                case DfxLogFormat::ArgType::DOUBLE:
+                    PutArg(record, pos, va_arg(args, double), segment.isPrivate);
+                    break;
+                case DfxLogFormat::ArgType::POINTER:
+                    PutArg(record, pos, va_arg(args, void *), segment.isPrivate);
+                    break;
+                case DfxLogFormat::ArgType::STRING: {
+                    // strings are copied, the caller's buffer is gone by the time the record is formatted
+                    const char *str = va_arg(args, const char *);
+                    if (segment.isPrivate) {
+                        break;
+                    }
+                    str = str == nullptr ? NULL_STRING : str;
+                    size_t room = MAX_RECORD_SIZE - pos - ARG_SLOT_SIZE;
+                    size_t strLen = strnlen(str, std::min(room, MAX_STRING_LEN));
+                    PutArg(record, pos, static_cast<uint16_t>(strLen));
+                    (void)memcpy_s(record + pos, MAX_RECORD_SIZE - pos, str, strLen);
+                    pos += AlignRecord(strLen);
+                    break;
+                }
+                default:
+                    break;
+            }
+            if (pos + ARG_SLOT_SIZE > MAX_RECORD_SIZE) {
+                // no room left for more arguments, the remaining segments are cut
+                break;
+            }
+        }
+    }
+    header.payloadSize = static_cast<uint32_t>(pos - sizeof(RecordHeader));
+    header.size = static_cast<uint32_t>(AlignRecord(pos));
+    (void)memcpy_s(record, sizeof(RecordHeader), &header, sizeof(RecordHeader));
+    return header.size;
+}
+
+bool DfxLogRing::Write(const char *level, const char *tag, const char *fmt, va_list args)
+{
+    alignas(RECORD_ALIGN) thread_local uint8_t record[MAX_RECORD_SIZE];
+    size_t recordSize = Serialize(record, level, tag, fmt, args);
+
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    size_t offset = static_cast<size_t>(head & (capacity_ - 1));
+    size_t contiguous = capacity_ - offset;
+    size_t padding = contiguous < recordSize ? contiguous : 0;
+    if (capacity_ - static_cast<size_t>(head - tail) < padding + recordSize) {
+        droppedCount_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (padding >= sizeof(RecordHeader)) {
+        RecordHeader paddingHeader = {};
+        paddingHeader.size = static_cast<uint32_t>(padding);
+        (void)memcpy_s(buffer_.data() + offset, contiguous, &paddingHeader, sizeof(RecordHeader));
+    }
+    offset = static_cast<size_t>((head + padding) & (capacity_ - 1));
+    (void)memcpy_s(buffer_.data() + offset, capacity_ - offset, record, recordSize);
+    head_.store(head + padding + recordSize, std::memory_order_release);
+    return true;
+}
+
+uint32_t DfxLogRing::Drain(std::string &out)
+{
+    uint32_t lineCount = 0;
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    while (tail < head) {
+        size_t offset = static_cast<size_t>(tail & (capacity_ - 1));
+        size_t contiguous = capacity_ - offset;
+        if (contiguous < sizeof(RecordHeader)) {
+            // too short for a padding record, the writer wrapped without one
+            tail += contiguous;
+            continue;
+        }
+        RecordHeader header;
+        (void)memcpy_s(&header, sizeof(RecordHeader), buffer_.data() + offset, sizeof(RecordHeader));
+        if (header.level != nullptr) {
+            FormatRecord(header, buffer_.data() + offset + sizeof(RecordHeader), out);
+            lineCount++;
+        }
+        tail += header.size;
+    }
+    tail_.store(tail, std::memory_order_release);
+    return lineCount;
+}
+
+void DfxLogRing::FormatRecord(const RecordHeader &header, const uint8_t *payload, std::string &out) const
+{
+    int64_t seconds = header.timeUs / US_PER_SECOND;
+    int64_t allMinute = seconds / SECONDS_PER_MINUTE;
+    out += std::to_string(allMinute / MINUTES_PER_HOUR % HOURS_PER_DAY);
+    out += ":";
+    out += std::to_string(allMinute % MINUTES_PER_HOUR);
+    out += ":";
+    out += std::to_string(seconds % SECONDS_PER_MINUTE);
+    out += ":";
+    out += std::to_string(header.timeUs % US_PER_SECOND / US_PER_MS);
+    out += " ";
+    out += header.level;
+    out += " pid:";
+    out += std::to_string(getpid());
+    out += " tid:";
+    out += std::to_string(header.tid);
+    out += " ";
+    out += header.tag;
+    out += ":";
+    if (header.format == nullptr) {
+        out.append(reinterpret_cast<const char *>(payload), header.payloadSize);
+        out += "\n";
+        return;
+    }
+    const uint8_t *end = payload + header.payloadSize;
+    for (const auto &segment : header.format->GetSegments()) {
+        if (segment.type == DfxLogFormat::ArgType::LITERAL) {
+            out += segment.fmt;
+            continue;
+        }
+        if (segment.isPrivate) {
+            out += PRIVATE_STRING;
+            continue;
+        }
+        if (payload >= end) {
+            break;
+        }
+        const char *fmt = segment.fmt.c_str();
+        switch (segment.type) {
+            case DfxLogFormat::ArgType::INT:
+                AppendFormatted(out, fmt, GetArg<int>(payload));
+                break;
+            case DfxLogFormat::ArgType::LONG:
+                AppendFormatted(out, fmt, GetArg<long>(payload));
+                break;
+            case DfxLogFormat::ArgType::LONG_LONG:
+                AppendFormatted(out, fmt, GetArg<long long>(payload));
+                break;
+            case DfxLogFormat::ArgType::INTMAX:
+                AppendFormatted(out, fmt, GetArg<intmax_t>(payload));
+                break;
+            case DfxLogFormat::ArgType::SIZE:
+                AppendFormatted(out, fmt, GetArg<size_t>(payload));
+                break;
+            case DfxLogFormat::ArgType::PTRDIFF:
+                AppendFormatted(out, fmt, GetArg<ptrdiff_t>(payload));
+                break;
+            case DfxLogFormat::ArgType::DOUBLE:
+                AppendFormatted(out, fmt, GetArg<double>(payload));
+                break;
+            case DfxLogFormat::ArgType::POINTER:
+                AppendFormatted(out, fmt, GetArg<void *>(payload));
+                break;
+            case DfxLogFormat::ArgType::STRING: {
+                uint16_t strLen = GetArg<uint16_t>(payload);
+                std::string str(reinterpret_cast<const char *>(payload), strLen);
+                payload += AlignRecord(strLen);
+                AppendFormatted(out, fmt, str.c_str());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    out += "\n";
+}
+
+uint64_t DfxLogRing::TakeDroppedCount()
+{
+    return droppedCount_.exchange(0, std::memory_order_relaxed);
+}
+
+size_t DfxLogRing::GetUsedSize() const
+{
+    return static_cast<size_t>(head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire));
+}
+
+size_t DfxLogRing::GetCapacity() const
+{
+    return capacity_;
+}
+
+void DfxLogRing::Retire()
+{
+    isRetired_.store(true, std::memory_order_release);
+}
+
+bool DfxLogRing::IsRetired() const
+{
+    return isRetired_.load(std::memory_order_acquire);
+}
+} // namespace Media
+} // namespace OHOS
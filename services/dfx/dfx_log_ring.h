@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DFX_LOG_RING_H
+#define DFX_LOG_RING_H
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace Media {
+/**
+ * Format string of one log site, with {public}/{private} stripped and split into one segment per conversion so the
+ * arguments can be captured as raw values and formatted later. Private arguments are never captured, they are
+ * written as <private> like hilog does. Parsed once per site and never freed.
+ */
+class __attribute__((visibility("default"))) DfxLogFormat {
+public:
+    enum class ArgType : uint8_t {
+        LITERAL = 0,
+        INT,
+        LONG,
+        LONG_LONG,
+        INTMAX,
+        SIZE,
+        PTRDIFF,
+        DOUBLE,
+        POINTER,
+        STRING,
+    };
+    struct Segment {
+        std::string fmt;
+        ArgType type;
+        bool isPrivate = false;
+    };
+
+    // fmt must outlive the process, as the string literals of the log macros do
+    static const DfxLogFormat *Get(const char *fmt);
+    explicit DfxLogFormat(const char *fmt);
+    ~DfxLogFormat() = default;
+
+    // false when the format uses a conversion that can not be captured, such as '*' width or long double
+    bool IsSupported() const;
+    const std::string &GetStripped() const;
+    const std::vector<Segment> &GetSegments() const;
+    bool HasPrivate() const;
+
+private:
+    bool Parse(const std::string &fmt);
+
+    std::string stripped_;
+    std::vector<Segment> segments_;
+    bool isSupported_ = false;
+    bool hasPrivate_ = false;
+};
+
+/**
+ * Lock free single producer single consumer ring of log records. The owning thread writes the raw arguments,
+ * the writer thread drains and formats them.
+ */
+class __attribute__((visibility("default"))) DfxLogRing {
+public:
+    explicit DfxLogRing(size_t capacity = DEFAULT_CAPACITY);
+    ~DfxLogRing() = default;
+
+    // producer side, returns false and counts a drop if the ring is full
+    bool Write(const char *level, const char *tag, const char *fmt, va_list args);
+    // consumer side, appends the formatted lines to out and returns how many were appended
+    uint32_t Drain(std::string &out);
+    uint64_t TakeDroppedCount();
+    size_t GetUsedSize() const;
+    size_t GetCapacity() const;
+    // the owning thread exited, nothing is written any more
+    void Retire();
+    bool IsRetired() const;
+
+    // about a thousand typical lines, the writer is woken up once half of it is used
+    static constexpr size_t DEFAULT_CAPACITY = 128 * 1024;
+    static constexpr size_t MAX_RECORD_SIZE = 1280;
+    static constexpr size_t MAX_STRING_LEN = 512;
+
+private:
+    struct RecordHeader {
+        // whole record including the header, a record without level is padding up to the end of the buffer
+        uint32_t size;
+        uint32_t payloadSize;
+        int32_t tid;
+        int64_t timeUs;
+        const char *level;
+        const char *tag;
+        // nullptr when the payload is text formatted at write time
+        const DfxLogFormat *format;
+    };
+
+    size_t Serialize(uint8_t *record, const char *level, const char *tag, const char *fmt, va_list args);
+    void FormatRecord(const RecordHeader &header, const uint8_t *payload, std::string &out) const;
+
+    std::vector<uint8_t> buffer_;
+    size_t capacity_ = 0;
+    alignas(64) std::atomic<uint64_t> head_ = 0;
+    alignas(64) std::atomic<uint64_t> tail_ = 0;
+    std::atomic<uint64_t> droppedCount_ = 0;
+    std::atomic<bool> isRetired_ = false;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // DFX_LOG_RING_H
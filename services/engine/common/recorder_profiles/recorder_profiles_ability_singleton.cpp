@@ -14,8 +14,13 @@
  */
 
 #include "recorder_profiles_ability_singleton.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
 #include "media_log.h"
 #include "media_errors.h"
+#include "recorder_profiles_parcel.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_RECORDER,
@@ -24,6 +29,39 @@ namespace {
 
 namespace OHOS {
 namespace Media {
+namespace {
+constexpr uint32_t CACHE_FILE_MAGIC = 0x52505243; // "RPRC"
+constexpr uint32_t CACHE_FILE_VERSION = 2;
+constexpr size_t CACHE_FILE_MAX_SIZE = 200 * 1024; // MessageParcel default capacity
+constexpr uint32_t QUALITY_LEVEL_BITS = 32;
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+// FNV-1a, stable across builds unlike std::hash
+uint64_t HashContent(const std::vector<char> &content)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (char c : content) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+}
+
+int64_t RecorderProfilesSnapshot::GetVideoProfileKey(int32_t sourceId, int32_t qualityLevel)
+{
+    return (static_cast<int64_t>(sourceId) << QUALITY_LEVEL_BITS) | static_cast<uint32_t>(qualityLevel);
+}
+
+std::string RecorderProfilesSnapshot::GetAudioConfigKey(const RecorderProfilesData &profile)
+{
+    const VideoRecorderProfile &recorderProfile = profile.recorderProfile;
+    return recorderProfile.containerFormatType + "|" + recorderProfile.audioCodec + "|" +
+        std::to_string(recorderProfile.audioBitrate) + "|" + std::to_string(recorderProfile.audioSampleRate) + "|" +
+        std::to_string(recorderProfile.audioChannels);
+}
+
 RecorderProfilesAbilitySingleton& RecorderProfilesAbilitySingleton::GetInstance()
 {
     static RecorderProfilesAbilitySingleton instance;
@@ -35,6 +73,7 @@ RecorderProfilesAbilitySingleton& RecorderProfilesAbilitySingleton::GetInstance(
 }
 
 RecorderProfilesAbilitySingleton::RecorderProfilesAbilitySingleton()
+    : snapshot_(std::make_shared<RecorderProfilesSnapshot>())
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
 }
@@ -46,11 +85,20 @@ RecorderProfilesAbilitySingleton::~RecorderProfilesAbilitySingleton()
 
 bool RecorderProfilesAbilitySingleton::ParseRecorderProfilesXml()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    // parsing is serialized on its own lock, readers only wait for the snapshot swap
+    std::lock_guard<std::mutex> parseLock(parseMutex_);
     if (isParsered_) {
         return true;
     }
-    capabilityDataArray_.clear();
+
+    RecorderProfilesConfigStamp stamp;
+    bool hasFileStamp = GetConfigFileStamp(stamp);
+    std::vector<RecorderProfilesData> data;
+    if (hasFileStamp && LoadCacheFile(stamp, data)) {
+        PublishSnapshot(BuildSnapshot(std::move(data)));
+        isParsered_ = true;
+        return true;
+    }
 
     std::shared_ptr<RecorderProfilesXmlParser> xmlParser = std::make_shared<RecorderProfilesXmlParser>();
 
@@ -66,15 +114,124 @@ bool RecorderProfilesAbilitySingleton::ParseRecorderProfilesXml()
         MEDIA_LOGE("RecorderProfiles Parse failed.");
         return false;
     }
-    std::vector<RecorderProfilesData> data = xmlParser->GetRecorderProfileDataArray();
-    capabilityDataArray_.insert(capabilityDataArray_.end(), data.begin(), data.end());
+    data = xmlParser->GetRecorderProfileDataArray();
+    if (hasFileStamp) {
+        SaveCacheFile(stamp, data);
+    }
+    PublishSnapshot(BuildSnapshot(std::move(data)));
     isParsered_ = true;
     return true;
 }
 
-std::vector<RecorderProfilesData> RecorderProfilesAbilitySingleton::GetCapabilityDataArray() const
+void RecorderProfilesAbilitySingleton::PublishSnapshot(std::shared_ptr<const RecorderProfilesSnapshot> snapshot)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshot_ = std::move(snapshot);
+}
+
+std::shared_ptr<const RecorderProfilesSnapshot> RecorderProfilesAbilitySingleton::GetSnapshot()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return snapshot_;
+}
+
+std::shared_ptr<const RecorderProfilesSnapshot> RecorderProfilesAbilitySingleton::BuildSnapshot(
+    std::vector<RecorderProfilesData> &&data)
+{
+    std::shared_ptr<RecorderProfilesSnapshot> snapshot = std::make_shared<RecorderProfilesSnapshot>();
+    snapshot->capabilityDataArray = std::move(data);
+    for (size_t i = 0; i < snapshot->capabilityDataArray.size(); i++) {
+        const RecorderProfilesData &capabilityData = snapshot->capabilityDataArray[i];
+        switch (capabilityData.mediaProfileType) {
+            case RECORDER_TYPE_AUDIO_CAPS:
+                snapshot->audioCapsArray.push_back(capabilityData);
+                break;
+            case RECORDER_TYPE_VIDEO_CAPS:
+                snapshot->videoCapsArray.push_back(capabilityData);
+                break;
+            case RECORDER_TYPE_PROFILE:
+                // keep the first match, as the linear lookups used to do
+                snapshot->videoProfileIndex.emplace(RecorderProfilesSnapshot::GetVideoProfileKey(
+                    capabilityData.sourceId, capabilityData.recorderProfile.qualityLevel), i);
+                snapshot->audioConfigIndex.insert(RecorderProfilesSnapshot::GetAudioConfigKey(capabilityData));
+                break;
+            default:
+                break;
+        }
+    }
+    MEDIA_LOGI("recorder profiles indexed, total:%{public}zu, profiles:%{public}zu",
+        snapshot->capabilityDataArray.size(), snapshot->videoProfileIndex.size());
+    return snapshot;
+}
+
+bool RecorderProfilesAbilitySingleton::GetConfigFileStamp(RecorderProfilesConfigStamp &stamp)
+{
+    struct stat fileStat;
+    if (stat(MEDIA_PROFILE_CONFIG_FILE, &fileStat) != 0) {
+        MEDIA_LOGW("stat recorder profiles config failed");
+        return false;
+    }
+    // reading the XML costs a small part of parsing it with libxml2
+    std::ifstream configFile(MEDIA_PROFILE_CONFIG_FILE, std::ios::binary);
+    CHECK_AND_RETURN_RET_LOG(configFile.is_open(), false, "open recorder profiles config failed");
+    std::vector<char> content((std::istreambuf_iterator<char>(configFile)), std::istreambuf_iterator<char>());
+    stamp.modifyTime = static_cast<int64_t>(fileStat.st_mtime);
+    stamp.fileSize = static_cast<int64_t>(content.size());
+    stamp.contentHash = HashContent(content);
+    return true;
+}
+
+bool RecorderProfilesAbilitySingleton::LoadCacheFile(const RecorderProfilesConfigStamp &stamp,
+    std::vector<RecorderProfilesData> &data)
 {
-    return capabilityDataArray_;
+    std::ifstream cacheFile(MEDIA_PROFILE_CACHE_FILE, std::ios::binary);
+    CHECK_AND_RETURN_RET_LOG(cacheFile.is_open(), false, "no recorder profiles cache");
+    std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(cacheFile)), std::istreambuf_iterator<char>());
+    CHECK_AND_RETURN_RET_LOG(!buffer.empty() && buffer.size() <= CACHE_FILE_MAX_SIZE, false,
+        "invalid recorder profiles cache size:%{public}zu", buffer.size());
+
+    MessageParcel parcel;
+    CHECK_AND_RETURN_RET_LOG(parcel.WriteBuffer(buffer.data(), buffer.size()), false,
+        "read recorder profiles cache failed");
+    CHECK_AND_RETURN_RET_LOG(parcel.ReadUint32() == CACHE_FILE_MAGIC && parcel.ReadUint32() == CACHE_FILE_VERSION,
+        false, "recorder profiles cache version mismatch");
+    CHECK_AND_RETURN_RET_LOG(parcel.ReadInt64() == stamp.modifyTime && parcel.ReadInt64() == stamp.fileSize &&
+        parcel.ReadUint64() == stamp.contentHash, false, "recorder profiles cache is stale");
+    CHECK_AND_RETURN_RET_LOG(RecorderProfilesParcel::Unmarshalling(parcel, data), false,
+        "unmarshalling recorder profiles cache failed");
+    // the end marker guards against a truncated cache file
+    if (parcel.ReadUint32() != CACHE_FILE_MAGIC) {
+        MEDIA_LOGW("recorder profiles cache is truncated");
+        data.clear();
+        return false;
+    }
+    MEDIA_LOGI("recorder profiles loaded from cache, count:%{public}zu", data.size());
+    return true;
+}
+
+void RecorderProfilesAbilitySingleton::SaveCacheFile(const RecorderProfilesConfigStamp &stamp,
+    const std::vector<RecorderProfilesData> &data)
+{
+    MessageParcel parcel;
+    bool ret = parcel.WriteUint32(CACHE_FILE_MAGIC) && parcel.WriteUint32(CACHE_FILE_VERSION) &&
+        parcel.WriteInt64(stamp.modifyTime) && parcel.WriteInt64(stamp.fileSize) &&
+        parcel.WriteUint64(stamp.contentHash) &&
+        RecorderProfilesParcel::Marshalling(parcel, data) && parcel.WriteUint32(CACHE_FILE_MAGIC);
+    CHECK_AND_RETURN_LOG(ret, "marshalling recorder profiles cache failed");
+
+    // write to a temporary file first, so a reader never sees a partial cache
+    std::string tmpPath = std::string(MEDIA_PROFILE_CACHE_FILE) + ".tmp";
+    {
+        std::ofstream cacheFile(tmpPath, std::ios::binary | std::ios::trunc);
+        CHECK_AND_RETURN_LOG(cacheFile.is_open(), "open recorder profiles cache failed");
+        cacheFile.write(reinterpret_cast<const char *>(parcel.GetData()),
+            static_cast<std::streamsize>(parcel.GetDataSize()));
+        CHECK_AND_RETURN_LOG(cacheFile.good(), "write recorder profiles cache failed");
+    }
+    if (std::rename(tmpPath.c_str(), MEDIA_PROFILE_CACHE_FILE) != 0) {
+        MEDIA_LOGW("rename recorder profiles cache failed");
+        (void)std::remove(tmpPath.c_str());
+    }
 }
 }  // namespace Media
 }  // namespace OHOS
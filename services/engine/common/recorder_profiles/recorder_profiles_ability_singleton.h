@@ -17,24 +17,57 @@
 #define RECORDERPROFILESABILITY_SINGLETON_H
 
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include "meta/format.h"
 #include "recorder_profiles_xml_parser.h"
 
 namespace OHOS {
 namespace Media {
+/**
+ * Immutable view of the parsed recorder profiles, indexed for the queries of RecorderProfilesServer.
+ * It is never modified after it is published, so it can be read without locking.
+ */
+struct RecorderProfilesSnapshot {
+    std::vector<RecorderProfilesData> capabilityDataArray;
+    std::vector<RecorderProfilesData> audioCapsArray;
+    std::vector<RecorderProfilesData> videoCapsArray;
+    // (sourceId, qualityLevel) -> index of the first matching profile in capabilityDataArray
+    std::unordered_map<int64_t, size_t> videoProfileIndex;
+    // container/codec/bitrate/sampleRate/channels tuples of all profiles
+    std::unordered_set<std::string> audioConfigIndex;
+
+    static int64_t GetVideoProfileKey(int32_t sourceId, int32_t qualityLevel);
+    static std::string GetAudioConfigKey(const RecorderProfilesData &profile);
+};
+
+// identifies the XML a cache file was built from, an OTA may keep the size and the mtime in seconds
+struct RecorderProfilesConfigStamp {
+    int64_t modifyTime = 0;
+    int64_t fileSize = 0;
+    uint64_t contentHash = 0;
+};
+
 class RecorderProfilesAbilitySingleton {
 public:
     const char *MEDIA_PROFILE_CONFIG_FILE = "/etc/recorder/recorder_configs.xml";
+    const char *MEDIA_PROFILE_CACHE_FILE = "/data/media/recorder_configs.bin";
     ~RecorderProfilesAbilitySingleton();
     static RecorderProfilesAbilitySingleton& GetInstance();
-    std::vector<RecorderProfilesData> GetCapabilityDataArray() const;
+    std::shared_ptr<const RecorderProfilesSnapshot> GetSnapshot();
 
 private:
     bool isParsered_ = false;
     RecorderProfilesAbilitySingleton();
     bool ParseRecorderProfilesXml();
-    std::vector<RecorderProfilesData> capabilityDataArray_;
+    bool GetConfigFileStamp(RecorderProfilesConfigStamp &stamp);
+    bool LoadCacheFile(const RecorderProfilesConfigStamp &stamp, std::vector<RecorderProfilesData> &data);
+    void SaveCacheFile(const RecorderProfilesConfigStamp &stamp, const std::vector<RecorderProfilesData> &data);
+    static std::shared_ptr<const RecorderProfilesSnapshot> BuildSnapshot(std::vector<RecorderProfilesData> &&data);
+    void PublishSnapshot(std::shared_ptr<const RecorderProfilesSnapshot> snapshot);
+    std::shared_ptr<const RecorderProfilesSnapshot> snapshot_;
     std::mutex mutex_;
+    std::mutex parseMutex_;
 };
 }  // namespace Media
 }  // namespace OHOS
@@ -87,8 +87,8 @@ std::unordered_map<int32_t, std::string> AVMetaDataCollector::ExtractMetadata()
     if (collectedMeta_.size() != 0) {
         return collectedMeta_;
     }
-    const std::shared_ptr<Meta> globalInfo = mediaDemuxer_->GetGlobalMetaInfo();
-    const std::vector<std::shared_ptr<Meta>> trackInfos = mediaDemuxer_->GetStreamMetaInfo();
+    const std::shared_ptr<Meta> globalInfo = GetGlobalMetaInfo();
+    const std::vector<std::shared_ptr<Meta>> trackInfos = GetStreamMetaInfo();
     collectedMeta_ = GetMetadata(globalInfo, trackInfos);
     return collectedMeta_;
 }
@@ -99,7 +99,7 @@ Status AVMetaDataCollector::GetVideoTrackId(uint32_t &trackId)
         trackId = videoTrackId_;
         return Status::OK;
     }
-    const std::vector<std::shared_ptr<Meta>> trackInfos = mediaDemuxer_->GetStreamMetaInfo();
+    const std::vector<std::shared_ptr<Meta>> trackInfos = GetStreamMetaInfo();
     size_t trackCount = trackInfos.size();
     CHECK_AND_RETURN_RET_LOG(trackCount > 0, Status::ERROR_INVALID_DATA, "GetTargetTrackInfo trackCount is invalid");
     for (size_t index = 0; index < trackCount; index++) {
@@ -144,7 +144,7 @@ std::shared_ptr<Meta> AVMetaDataCollector::GetAVMetadata()
         }
     }
 
-    customInfo_ = mediaDemuxer_->GetUserMeta();
+    customInfo_ = GetUserMeta();
     if (customInfo_ == nullptr) {
         MEDIA_LOGW("No valid user data");
     } else {
@@ -215,7 +215,7 @@ std::shared_ptr<AVSharedMemory> AVMetaDataCollector::GetArtPicture()
     if (collectedArtPicture_ != nullptr) {
         return collectedArtPicture_;
     }
-    const std::vector<std::shared_ptr<Meta>> trackInfos = mediaDemuxer_->GetStreamMetaInfo();
+    const std::vector<std::shared_ptr<Meta>> trackInfos = GetStreamMetaInfo();
     size_t trackCount = trackInfos.size();
     for (size_t index = 0; index < trackCount; index++) {
         std::shared_ptr<Meta> meta = trackInfos[index];
@@ -254,6 +254,7 @@ int32_t AVMetaDataCollector::GetTimeByFrameIndex(uint32_t index, int64_t &timeUs
 {
     uint32_t trackId = 0;
     CHECK_AND_RETURN_RET_LOG(GetVideoTrackId(trackId) == Status::OK, MSERR_UNSUPPORT_FILE, "No video track!");
+    CHECK_AND_RETURN_RET_LOG(mediaDemuxer_ != nullptr, MSERR_INVALID_STATE, "demuxer is nullptr");
     CHECK_AND_RETURN_RET_LOG(mediaDemuxer_->GetPresentationTimeUsByFrameIndex(trackId, index, timeUs) == Status::OK,
         MSERR_UNSUPPORT_FILE, "Get time by frame failed");
     return MSERR_OK;
@@ -263,6 +264,7 @@ int32_t AVMetaDataCollector::GetFrameIndexByTime(int64_t timeUs, uint32_t &index
 {
     uint32_t trackId = 0;
     CHECK_AND_RETURN_RET_LOG(GetVideoTrackId(trackId) == Status::OK, MSERR_UNSUPPORT_FILE, "No video track!");
+    CHECK_AND_RETURN_RET_LOG(mediaDemuxer_ != nullptr, MSERR_INVALID_STATE, "demuxer is nullptr");
     CHECK_AND_RETURN_RET_LOG(mediaDemuxer_->GetFrameIndexByPresentationTimeUs(trackId, timeUs, index) == Status::OK,
         MSERR_UNSUPPORT_FILE, "Get frame by time failed");
     return MSERR_OK;
@@ -380,9 +382,45 @@ bool AVMetaDataCollector::SetStringByValueType(const std::shared_ptr<Meta> &inne
     return true;
 }
 
+std::shared_ptr<Meta> AVMetaDataCollector::GetGlobalMetaInfo()
+{
+    if (probeInfo_.globalMeta != nullptr || mediaDemuxer_ == nullptr) {
+        return probeInfo_.globalMeta;
+    }
+    return mediaDemuxer_->GetGlobalMetaInfo();
+}
+
+std::vector<std::shared_ptr<Meta>> AVMetaDataCollector::GetStreamMetaInfo()
+{
+    if (probeInfo_.globalMeta != nullptr || mediaDemuxer_ == nullptr) {
+        return probeInfo_.trackMetas;
+    }
+    return mediaDemuxer_->GetStreamMetaInfo();
+}
+
+std::shared_ptr<Meta> AVMetaDataCollector::GetUserMeta()
+{
+    if (probeInfo_.hasUserMeta || mediaDemuxer_ == nullptr) {
+        return probeInfo_.userMeta;
+    }
+    return mediaDemuxer_->GetUserMeta();
+}
+
+void AVMetaDataCollector::SetDemuxer(const std::shared_ptr<MediaDemuxer> &mediaDemuxer)
+{
+    mediaDemuxer_ = mediaDemuxer;
+}
+
+void AVMetaDataCollector::SetProbeInfo(const MediaProbeInfo &probeInfo)
+{
+    probeInfo_ = probeInfo;
+}
+
 void AVMetaDataCollector::Reset()
 {
-    mediaDemuxer_->Reset();
+    if (mediaDemuxer_ != nullptr) {
+        mediaDemuxer_->Reset();
+    }
     collectedMeta_.clear();
     videoTrackId_ = 0;
     hasVideo_ = false;
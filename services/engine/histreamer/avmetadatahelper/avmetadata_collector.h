@@ -23,6 +23,7 @@
 #include <unordered_map>
 
 #include "media_demuxer.h"
+#include "media_probe_cache.h"
 #include "meta/meta.h"
 #include "meta/meta_key.h"
 
@@ -74,11 +75,15 @@ public:
     std::shared_ptr<AVSharedMemory> GetArtPicture();
     int32_t GetTimeByFrameIndex(uint32_t index, int64_t &timeUs);
     int32_t GetFrameIndexByTime(int64_t timeUs, uint32_t &index);
+    void SetDemuxer(const std::shared_ptr<MediaDemuxer> &mediaDemuxer);
+    void SetProbeInfo(const MediaProbeInfo &probeInfo);
     void Reset();
     void Destroy();
 
 private:
     std::shared_ptr<MediaDemuxer> mediaDemuxer_;
+    // probe results the metadata is read from, so metadata queries do not need the demuxer
+    MediaProbeInfo probeInfo_;
     std::unordered_map<int32_t, std::string> collectedMeta_ = {};
     std::shared_ptr<AVSharedMemory> collectedArtPicture_;
     std::shared_ptr<Meta> customInfo_;
@@ -96,6 +101,9 @@ private:
     bool SetStringByValueType(const std::shared_ptr<Meta> &innerMeta,
         Metadata &avmeta, int32_t avKey, std::string innerKey) const;
     Status GetVideoTrackId(uint32_t &trackId);
+    std::shared_ptr<Meta> GetGlobalMetaInfo();
+    std::vector<std::shared_ptr<Meta>> GetStreamMetaInfo();
+    std::shared_ptr<Meta> GetUserMeta();
 };
 }  // namespace Media
 }  // namespace OHOS
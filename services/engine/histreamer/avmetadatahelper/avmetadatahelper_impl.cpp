@@ -58,11 +58,25 @@ int32_t AVMetadataHelperImpl::SetSource(const std::string &uri, int32_t /* usage
     MEDIA_LOGD("0x%{public}06" PRIXPTR " SetSource uri: %{private}s, type:%{public}d", FAKE_POINTER(this), uri.c_str(),
         uriHelper.UriType());
 
+    std::string identity = uriHelper.FileIdentity();
+    if (MediaProbeCache::GetInstance().Lookup(identity, probeInfo_)) {
+        MEDIA_LOGI("0x%{public}06" PRIXPTR " SetSource hit probe cache", FAKE_POINTER(this));
+        Reset();
+        mediaDemuxer_ = nullptr;
+        sourceUri_ = uri;
+        CHECK_AND_RETURN_RET_LOG(MetaUtils::CheckFileType(probeInfo_.globalMeta),
+            MSERR_UNSUPPORT, "0x%{public}06" PRIXPTR "SetSource unsupport", FAKE_POINTER(this));
+        return MSERR_OK;
+    }
+
     auto ret = SetSourceInternel(uri);
     CHECK_AND_RETURN_RET_LOG(ret == Status::OK, MSERR_INVALID_VAL,
         "0x%{public}06" PRIXPTR " Failed to call SetSourceInternel", FAKE_POINTER(this));
-    CHECK_AND_RETURN_RET_LOG(MetaUtils::CheckFileType(mediaDemuxer_->GetGlobalMetaInfo()),
+    sourceUri_ = uri;
+    CollectProbeInfo();
+    CHECK_AND_RETURN_RET_LOG(MetaUtils::CheckFileType(probeInfo_.globalMeta),
         MSERR_UNSUPPORT, "0x%{public}06" PRIXPTR "SetSource unsupport", FAKE_POINTER(this));
+    MediaProbeCache::GetInstance().Insert(identity, probeInfo_);
     return MSERR_OK;
 }
 
@@ -71,8 +85,10 @@ int32_t AVMetadataHelperImpl::SetSource(const std::shared_ptr<IMediaDataSource>
     MEDIA_LOGI("0x%{public}06" PRIXPTR "SetSource dataSrc", FAKE_POINTER(this));
     Status ret = SetSourceInternel(dataSrc);
     CHECK_AND_RETURN_RET_LOG(ret == Status::OK, MSERR_INVALID_VAL, "Failed to call SetSourceInternel");
+    sourceUri_.clear();
+    CollectProbeInfo();
 
-    CHECK_AND_RETURN_RET_LOG(MetaUtils::CheckFileType(mediaDemuxer_->GetGlobalMetaInfo()),
+    CHECK_AND_RETURN_RET_LOG(MetaUtils::CheckFileType(probeInfo_.globalMeta),
         MSERR_UNSUPPORT, "0x%{public}06" PRIXPTR "SetSource unsupport", FAKE_POINTER(this));
     MEDIA_LOGI("0x%{public}06" PRIXPTR "set source success", FAKE_POINTER(this));
     return MSERR_OK;
@@ -103,6 +119,30 @@ Status AVMetadataHelperImpl::SetSourceInternel(const std::shared_ptr<IMediaDataS
     return Status::OK;
 }
 
+void AVMetadataHelperImpl::CollectProbeInfo()
+{
+    probeInfo_.globalMeta = mediaDemuxer_->GetGlobalMetaInfo();
+    probeInfo_.trackMetas = mediaDemuxer_->GetStreamMetaInfo();
+    probeInfo_.userMeta = mediaDemuxer_->GetUserMeta();
+    probeInfo_.hasUserMeta = true;
+}
+
+Status AVMetadataHelperImpl::EnsureDemuxer()
+{
+    if (mediaDemuxer_ != nullptr) {
+        return Status::OK;
+    }
+    CHECK_AND_RETURN_RET_LOG(!sourceUri_.empty(), Status::ERROR_INVALID_STATE, "source is not set");
+    MEDIA_LOGI("0x%{public}06" PRIXPTR " create demuxer deferred by probe cache", FAKE_POINTER(this));
+    auto mediaDemuxer = std::make_shared<MediaDemuxer>();
+    mediaDemuxer->SetPlayerId(groupId_);
+    Status ret = mediaDemuxer->SetDataSource(std::make_shared<MediaSource>(sourceUri_));
+    CHECK_AND_RETURN_RET_LOG(ret == Status::OK, ret,
+        "0x%{public}06" PRIXPTR " EnsureDemuxer failed to call SetDataSource", FAKE_POINTER(this));
+    mediaDemuxer_ = mediaDemuxer;
+    return Status::OK;
+}
+
 std::string AVMetadataHelperImpl::ResolveMetadata(int32_t key)
 {
     MEDIA_LOGI("enter ResolveMetadata with key: %{public}d", key);
@@ -130,6 +170,12 @@ std::shared_ptr<AVSharedMemory> AVMetadataHelperImpl::FetchArtPicture()
 std::shared_ptr<Meta> AVMetadataHelperImpl::GetAVMetadata()
 {
     MEDIA_LOGE("enter GetAVMetadata");
+    if (!probeInfo_.hasUserMeta) {
+        // entries fed by the player and the transcoder come without the user meta
+        CHECK_AND_RETURN_RET(EnsureDemuxer() == Status::OK, nullptr);
+        probeInfo_.userMeta = mediaDemuxer_->GetUserMeta();
+        probeInfo_.hasUserMeta = true;
+    }
     auto res = InitMetadataCollector();
     CHECK_AND_RETURN_RET(res == Status::OK, nullptr);
     return metadataCollector_->GetAVMetadata();
@@ -139,6 +185,7 @@ std::shared_ptr<AVSharedMemory> AVMetadataHelperImpl::FetchFrameAtTime(
     int64_t timeUs, int32_t option, const OutputConfiguration &param)
 {
     MEDIA_LOGD("enter FetchFrameAtTime");
+    CHECK_AND_RETURN_RET(EnsureDemuxer() == Status::OK, nullptr);
     auto res = InitThumbnailGenerator();
     CHECK_AND_RETURN_RET(res == Status::OK, nullptr);
     return thumbnailGenerator_->FetchFrameAtTime(timeUs, option, param);
@@ -148,6 +195,7 @@ std::shared_ptr<AVBuffer> AVMetadataHelperImpl::FetchFrameYuv(
     int64_t timeUs, int32_t option, const OutputConfiguration &param)
 {
     MEDIA_LOGD("enter FetchFrameAtTime");
+    CHECK_AND_RETURN_RET(EnsureDemuxer() == Status::OK, nullptr);
     auto res = InitThumbnailGenerator();
     CHECK_AND_RETURN_RET(res == Status::OK, nullptr);
     return thumbnailGenerator_->FetchFrameYuv(timeUs, option, param);
@@ -155,6 +203,7 @@ std::shared_ptr<AVBuffer> AVMetadataHelperImpl::FetchFrameYuv(
 
 int32_t AVMetadataHelperImpl::GetTimeByFrameIndex(uint32_t index, int64_t &time)
 {
+    CHECK_AND_RETURN_RET_LOG(EnsureDemuxer() == Status::OK, MSERR_INVALID_STATE, "Create demuxer failed");
     auto res = InitMetadataCollector();
     CHECK_AND_RETURN_RET_LOG(res == Status::OK, MSERR_INVALID_STATE, "Create collector failed");
     return metadataCollector_->GetTimeByFrameIndex(index, time);
@@ -162,6 +211,7 @@ int32_t AVMetadataHelperImpl::GetTimeByFrameIndex(uint32_t index, int64_t &time)
 
 int32_t AVMetadataHelperImpl::GetFrameIndexByTime(int64_t time, uint32_t &index)
 {
+    CHECK_AND_RETURN_RET_LOG(EnsureDemuxer() == Status::OK, MSERR_INVALID_STATE, "Create demuxer failed");
     auto res = InitMetadataCollector();
     CHECK_AND_RETURN_RET_LOG(res == Status::OK, MSERR_INVALID_STATE, "Create collector failed");
     return metadataCollector_->GetFrameIndexByTime(time, index);
@@ -205,6 +255,9 @@ Status AVMetadataHelperImpl::InitMetadataCollector()
     }
     CHECK_AND_RETURN_RET_LOG(
         metadataCollector_ != nullptr, Status::ERROR_INVALID_STATE, "Init metadata collector failed.");
+    // the source may have changed since the collector was created
+    metadataCollector_->SetDemuxer(mediaDemuxer_);
+    metadataCollector_->SetProbeInfo(probeInfo_);
     return Status::OK;
 }
 
@@ -26,6 +26,7 @@
 #include "i_avmetadatahelper_engine.h"
 #include "i_avmetadatahelper_service.h"
 #include "media_demuxer.h"
+#include "media_probe_cache.h"
 #include "nocopyable.h"
 
 namespace OHOS {
@@ -59,11 +60,16 @@ private:
     std::shared_ptr<AVSharedMemory> collectedArtPicture_;
     std::shared_ptr<AVSharedMemoryBase> fetchedFrameAtTime_;
     std::atomic_bool stopProcessing_{ false };
+    // probe results of the current source, the demuxer is created on first frame access when served from cache
+    MediaProbeInfo probeInfo_;
+    std::string sourceUri_;
 
     Status SetSourceInternel(const std::string &uri);
     Status SetSourceInternel(const std::shared_ptr<IMediaDataSource> &dataSrc);
     Status InitMetadataCollector();
     Status InitThumbnailGenerator();
+    Status EnsureDemuxer();
+    void CollectProbeInfo();
 
     void Reset();
     void Destroy();
@@ -16,6 +16,8 @@
 #define HST_LOG_TAG "HiPlayer"
 
 #include "hiplayer_impl.h"
+#include <algorithm>
+#include <unistd.h>
 #include "audio_info.h"
 #include "common/log.h"
 #include "common/media_source.h"
@@ -28,10 +30,14 @@
 #include "osal/utils/dump_buffer.h"
 #include "param_wrapper.h"
 #include "plugin/plugin_time.h"
+#include "securec.h"
+#include "sync_fence.h"
 #include "media_dfx.h"
+#include "media_probe_cache.h"
 #include "media_utils.h"
 #include "meta_utils.h"
 #include "meta/media_types.h"
+#include "uri_helper.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_CORE, LOG_DOMAIN_HIPLAYER, "HiPlayer" };
@@ -41,7 +47,16 @@ const int32_t FRAME_RATE_UNIT_MULTIPLE = 100; // the unit of frame rate is frame
 const int32_t PLAYING_SEEK_WAIT_TIME = 200; // wait up to 200 ms for new frame after seek in playing.
 const int64_t PLAY_RANGE_DEFAULT_VALUE = -1; // play range default value.
 const double FRAME_RATE_DEFAULT = -1.0;
-const double FRAME_RATE_FOR_SEEK_PERFORMANCE = 2000.0;
+// the fixed rate every accurate seek asked for before the hint followed the gop, a short gop must not get less
+const double MIN_FRAME_RATE_FOR_SEEK_PERFORMANCE = 2000.0;
+const double MAX_FRAME_RATE_FOR_SEEK_PERFORMANCE = 8000.0;
+const double DEFAULT_VIDEO_FRAME_RATE = 30.0;
+const double ACCURATE_SEEK_DECODE_BUDGET_MS = 100.0; // decode the frames from key frame to target within 100 ms
+const double MS_PER_SECOND = 1000.0;
+const size_t PARALLEL_PREPARE_POOL_SIZE = 2; // worker threads shared by the parallel filter creation jobs
+const int32_t KEY_FRAME_FENCE_WAIT_MS = 100;
+const int32_t KEY_FRAME_STRIDE_ALIGNMENT = 0x8;
+const size_t TRANSFORM_MATRIX_SIZE = 16;
 }
 
 namespace OHOS {
@@ -109,6 +124,10 @@ HiPlayerImpl::~HiPlayerImpl()
 
 void HiPlayerImpl::ReleaseInner()
 {
+    if (keyFrameScrubber_ != nullptr) {
+        keyFrameScrubber_->Release();
+        keyFrameScrubber_ = nullptr;
+    }
     pipeline_->Stop();
     audioSink_.reset();
 #ifdef SUPPORT_VIDEO
@@ -129,6 +148,7 @@ Status HiPlayerImpl::Init()
 {
     MediaTrace trace("HiPlayerImpl::Init");
     MEDIA_LOG_I_SHORT("Init start");
+    ScopedStartupPhase startupPhase(startupTracer_, StartupPhase::INIT);
     std::shared_ptr<EventReceiver> playerEventReceiver = std::make_shared<PlayerEventReceiver>(this, playerId_);
     playerEventReceiver_ = playerEventReceiver;
     std::shared_ptr<FilterCallback> playerFilterCallback = std::make_shared<PlayerFilterCallback>(this);
@@ -376,6 +396,8 @@ int32_t HiPlayerImpl::PrepareAsync()
         CollectionErrorInfo(MSERR_INVALID_OPERATION, "PrepareAsync pipelineStates not initialized or stopped");
         return MSERR_INVALID_OPERATION;
     }
+    startupTracer_.Reset();
+    startupTracer_.BeginPhase(StartupPhase::PREPARE_TOTAL);
     auto ret = Init();
     if (ret != Status::OK || isInterruptNeeded_.load()) {
         auto errCode = TransStatus(Status::ERROR_UNSUPPORTED_FORMAT);
@@ -393,13 +415,18 @@ int32_t HiPlayerImpl::PrepareAsync()
     NotifyBufferingUpdate(PlayerKeys::PLAYER_BUFFERING_START, 0);
     MEDIA_LOG_I_SHORT("PrepareAsync pipeline state " PUBLIC_LOG_S, StringnessPlayerState(pipelineStates_).c_str());
     OnStateChanged(PlayerStateId::PREPARING);
+    startupTracer_.BeginPhase(StartupPhase::PIPELINE_PREPARE);
+    StartParallelPrepare();
     ret = pipeline_->Prepare();
+    WaitAllParallelPrepareJobs();
+    startupTracer_.EndPhase(StartupPhase::PIPELINE_PREPARE);
     if (ret != Status::OK) {
         MEDIA_LOG_E_SHORT("PrepareAsync failed with error " PUBLIC_LOG_D32, ret);
         auto errCode = TransStatus(ret);
         CollectionErrorInfo(errCode, "pipeline PrepareAsync failed");
         return errCode;
     }
+    ShareProbeInfo();
     ret = DoSetPlayRange();
     FALSE_RETURN_V_MSG_E(ret == Status::OK, TransStatus(ret), "DoSetPlayRange failed");
     if (demuxer_ != nullptr && demuxer_->IsRenderNextVideoFrameSupported()
@@ -412,10 +439,21 @@ int32_t HiPlayerImpl::PrepareAsync()
         }
     }
     UpdatePlayerStateAndNotify();
+    startupTracer_.EndPhase(StartupPhase::PREPARE_TOTAL);
     MEDIA_LOG_D_SHORT("PrepareAsync End");
     return TransStatus(ret);
 }
 
+void HiPlayerImpl::ShareProbeInfo()
+{
+    // the player keeps its own demuxer, the probe result saves metadata helpers opening the same file
+    FALSE_RETURN(dataSrc_ == nullptr && demuxer_ != nullptr);
+    std::string identity = UriHelper(url_).FileIdentity();
+    FALSE_RETURN(!identity.empty() && !MediaProbeCache::GetInstance().Contains(identity));
+    MediaProbeCache::GetInstance().Insert(identity,
+        {demuxer_->GetGlobalMetaInfo(), demuxer_->GetStreamMetaInfo(), nullptr, false});
+}
+
 void HiPlayerImpl::CollectionErrorInfo(int32_t errCode, const std::string& errMsg)
 {
     MEDIA_LOG_E_SHORT("Error: " PUBLIC_LOG_S, errMsg.c_str());
@@ -425,6 +463,7 @@ void HiPlayerImpl::CollectionErrorInfo(int32_t errCode, const std::string& errMs
 
 void HiPlayerImpl::DoSetMediaSource(Status& ret)
 {
+    ScopedStartupPhase startupPhase(startupTracer_, StartupPhase::SET_SOURCE);
     if (dataSrc_ != nullptr) {
         ret = DoSetSource(std::make_shared<MediaSource>(dataSrc_));
     } else {
@@ -529,9 +568,14 @@ void HiPlayerImpl::DoInitializeForHttp()
 
 int32_t HiPlayerImpl::Play()
 {
+    std::lock_guard<std::mutex> pipelineLock(pipelineControlMutex_);
     MediaTrace trace("HiPlayerImpl::Play");
     MEDIA_LOG_I_SHORT("Play entered.");
     startTime_ = GetCurrentMillisecond();
+    if (isInitialPlay_) {
+        startupTracer_.BeginPhase(StartupPhase::FIRST_AUDIO_FRAME);
+        startupTracer_.BeginPhase(StartupPhase::FIRST_VIDEO_FRAME);
+    }
     int32_t ret = MSERR_INVALID_VAL;
     if (!IsValidPlayRange(playRangeStartTime_, playRangeEndTime_)) {
         MEDIA_LOG_E_SHORT("SetPlayRange failed! start: " PUBLIC_LOG_D64 ", end: " PUBLIC_LOG_D64,
@@ -559,7 +603,9 @@ int32_t HiPlayerImpl::Play()
         }
         callbackLooper_.StartReportMediaProgress(100); // 100 ms
         syncManager_->Resume();
+        startupTracer_.BeginPhase(StartupPhase::PIPELINE_START);
         ret = TransStatus(pipeline_->Start());
+        startupTracer_.EndPhase(StartupPhase::PIPELINE_START);
         if (ret != MSERR_OK) {
             UpdateStateNoLock(PlayerStates::PLAYER_STATE_ERROR);
         }
@@ -578,6 +624,7 @@ int32_t HiPlayerImpl::Play()
 
 int32_t HiPlayerImpl::Pause()
 {
+    std::lock_guard<std::mutex> pipelineLock(pipelineControlMutex_);
     MediaTrace trace("HiPlayerImpl::Pause");
     MEDIA_LOG_I_SHORT("Pause in");
     FALSE_RETURN_V_MSG_E(pipelineStates_ != PlayerStates::PLAYER_PLAYBACK_COMPLETE,
@@ -631,6 +678,7 @@ int64_t HiPlayerImpl::GetCurrentMillisecond()
 
 int32_t HiPlayerImpl::Stop()
 {
+    std::lock_guard<std::mutex> pipelineLock(pipelineControlMutex_);
     MediaTrace trace("HiPlayerImpl::Stop");
     MEDIA_LOG_I_SHORT("Stop entered.");
     UpdatePlayStatistics();
@@ -712,9 +760,9 @@ void HiPlayerImpl::AppendPlayerMediaInfo()
     }
     startTime_ = -1;
     playStatisticalInfo_.playDuration = static_cast<int32_t>(playTotalDuration_);
-    playStatisticalInfo_.maxSeekLatency = static_cast<int32_t>(maxSeekLatency_);
-    playStatisticalInfo_.maxAccurateSeekLatency = static_cast<int32_t>(maxAccurateSeekLatency_);
-    playStatisticalInfo_.maxSurfaceSwapLatency = static_cast<int32_t>(maxSurfaceSwapLatency_);
+    playStatisticalInfo_.maxSeekLatency = static_cast<int32_t>(seekLatencyHistogram_.GetMax());
+    playStatisticalInfo_.maxAccurateSeekLatency = static_cast<int32_t>(accurateSeekLatencyHistogram_.GetMax());
+    playStatisticalInfo_.maxSurfaceSwapLatency = static_cast<int32_t>(surfaceSwapLatencyHistogram_.GetMax());
     std::shared_ptr<Meta> meta = std::make_shared<Meta>();
     playStatisticalInfo_.containerMime = playStatisticalInfo_.videoMime + " : " + playStatisticalInfo_.audioMime;
     meta->SetData(Tag::AV_PLAYER_ERR_CODE, playStatisticalInfo_.errCode);
@@ -744,6 +792,10 @@ void HiPlayerImpl::AppendPlayerMediaInfo()
     meta->SetData(Tag::AV_PLAYER_MAX_LAG_DURATION, playStatisticalInfo_.maxLagDuration);
     meta->SetData(Tag::AV_PLAYER_AVG_LAG_DURATION, playStatisticalInfo_.avgLagDuration);
     meta->SetData(Tag::AV_PLAYER_MAX_SURFACESWAP_LATENCY, playStatisticalInfo_.maxSurfaceSwapLatency);
+    startupTracer_.AppendToMeta(meta);
+    seekLatencyHistogram_.AppendToMeta(meta);
+    accurateSeekLatencyHistogram_.AppendToMeta(meta);
+    surfaceSwapLatencyHistogram_.AppendToMeta(meta);
     AppendMediaInfo(meta, instanceId_);
 }
 
@@ -816,17 +868,17 @@ Status HiPlayerImpl::Seek(int64_t mSeconds, PlayerSeekMode mode, bool notifySeek
         audioSink_->SetIsTransitent(false);
     }
     isSeek_ = false;
-    UpdateMaxSeekLatency(mode, seekStartTime);
+    UpdateSeekLatency(mode, seekStartTime);
     return rtv;
 }
 
-void HiPlayerImpl::UpdateMaxSeekLatency(PlayerSeekMode mode, int64_t seekStartTime)
+void HiPlayerImpl::UpdateSeekLatency(PlayerSeekMode mode, int64_t seekStartTime)
 {
     int64_t seekDiffTime = GetCurrentMillisecond() - seekStartTime;
     if (mode == PlayerSeekMode::SEEK_CLOSEST) {
-        maxAccurateSeekLatency_ = (maxAccurateSeekLatency_ > seekDiffTime) ? maxAccurateSeekLatency_ : seekDiffTime;
+        accurateSeekLatencyHistogram_.Record(seekDiffTime);
     } else {
-        maxSeekLatency_ = (maxSeekLatency_ > seekDiffTime) ? maxSeekLatency_ : seekDiffTime;
+        seekLatencyHistogram_.Record(seekDiffTime);
     }
 }
 
@@ -857,6 +909,7 @@ void HiPlayerImpl::NotifySeek(Status rtv, bool flag, int64_t seekPos)
 
 int32_t HiPlayerImpl::Seek(int32_t mSeconds, PlayerSeekMode mode)
 {
+    std::lock_guard<std::mutex> pipelineLock(pipelineControlMutex_);
     MediaTrace trace("HiPlayerImpl::Seek.");
     MEDIA_LOG_I_SHORT("Seek.");
     return TransStatus(Seek(mSeconds, mode, true));
@@ -924,8 +977,9 @@ Status HiPlayerImpl::doSeek(int64_t seekPos, PlayerSeekMode mode)
             videoDecoder_->SetSeekTime(seekTimeUs);
         }
         seekAgent_ = std::make_shared<SeekAgent>(demuxer_);
-        SetFrameRateForSeekPerformance(FRAME_RATE_FOR_SEEK_PERFORMANCE);
-        auto res = seekAgent_->Seek(seekPos);
+        auto res = seekAgent_->Seek(seekPos, [this, seekPos](int64_t keyFramePos) {
+            SetFrameRateForSeekPerformance(GetFrameRateForAccurateSeek(seekPos, keyFramePos));
+        });
         SetFrameRateForSeekPerformance(FRAME_RATE_DEFAULT);
         MEDIA_LOG_I_SHORT("seekAgent_ Seek end");
         if (res != Status::OK) {
@@ -995,11 +1049,12 @@ int32_t HiPlayerImpl::SetVideoSurface(sptr<Surface> surface)
     if (videoDecoder_ != nullptr &&
         pipelineStates_ != PlayerStates::PLAYER_STOPPED &&
         pipelineStates_ != PlayerStates::PLAYER_STATE_ERROR) {
-        return TransStatus(videoDecoder_->SetVideoSurface(surface));
+        Status ret = videoDecoder_->SetVideoSurface(surface);
+        surfaceSwapLatencyHistogram_.Record(GetCurrentMillisecond() - startSetSurfaceTime);
+        return TransStatus(ret);
     }
     int64_t endSetSurfaceTime = GetCurrentMillisecond();
-    int64_t diffTime = endSetSurfaceTime - startSetSurfaceTime;
-    maxSurfaceSwapLatency_ = maxSurfaceSwapLatency_ > diffTime ? maxSurfaceSwapLatency_ : diffTime;
+    surfaceSwapLatencyHistogram_.Record(endSetSurfaceTime - startSetSurfaceTime);
 #endif
     return TransStatus(Status::OK);
 }
@@ -1587,6 +1642,21 @@ int32_t HiPlayerImpl::SetVideoScaleType(OHOS::Media::VideoScaleType videoScaleTy
 #endif
 }
 
+double HiPlayerImpl::GetFrameRateForAccurateSeek(int64_t seekPos, int64_t keyFramePos)
+{
+    // the decoder has to run through every reference frame between the key frame and the target, so ask for a
+    // rate that covers the whole gop within the budget. The floor already covers 200 frames per budget, so only
+    // gops longer than that (about 6.7 s at 30 fps) get a higher hint.
+    double videoFrameRate = playStatisticalInfo_.videoFrameRate > 0 ?
+        static_cast<double>(playStatisticalInfo_.videoFrameRate) : DEFAULT_VIDEO_FRAME_RATE;
+    double framesToDecode = static_cast<double>(std::max<int64_t>(seekPos - keyFramePos, 0)) * videoFrameRate /
+        MS_PER_SECOND;
+    double frameRate = framesToDecode * MS_PER_SECOND / ACCURATE_SEEK_DECODE_BUDGET_MS;
+    MEDIA_LOG_I_SHORT("accurate seek from key frame " PUBLIC_LOG_D64 " to " PUBLIC_LOG_D64 ", frames: %{public}f",
+        keyFramePos, seekPos, framesToDecode);
+    return std::clamp(frameRate, MIN_FRAME_RATE_FOR_SEEK_PERFORMANCE, MAX_FRAME_RATE_FOR_SEEK_PERFORMANCE);
+}
+
 int32_t HiPlayerImpl::SetFrameRateForSeekPerformance(double frameRate)
 {
     MEDIA_LOG_I_SHORT("SetFrameRateForSeekPerformance, frameRate: %{public}f", frameRate);
@@ -1668,6 +1738,7 @@ void HiPlayerImpl::OnEvent(const Event &event)
             MEDIA_LOG_D_SHORT("video first frame reneder received");
             Format format;
             playStatisticalInfo_.startLatency = static_cast<int32_t>(AnyCast<uint64_t>(event.param));
+            startupTracer_.EndPhase(StartupPhase::FIRST_VIDEO_FRAME);
             callbackLooper_.OnInfo(INFO_TYPE_MESSAGE, PlayerMessageType::PLAYER_INFO_VIDEO_RENDERING_START, format);
             HandleInitialPlayingStateChange(event.type);
             break;
@@ -1754,6 +1825,14 @@ void HiPlayerImpl::HandleInitialPlayingStateChange(const EventType& eventType)
 
     isInitialPlay_ = false;
     OnStateChanged(PlayerStateId::PLAYING);
+    NotifyStartupBreakdown();
+}
+
+void HiPlayerImpl::NotifyStartupBreakdown()
+{
+    Format format;
+    startupTracer_.ToFormat(format);
+    callbackLooper_.OnInfo(INFO_TYPE_STARTUP_BREAKDOWN, 0, format);
 }
 
 Status HiPlayerImpl::DoSetSource(const std::shared_ptr<MediaSource> source)
@@ -2102,6 +2181,7 @@ void HiPlayerImpl::NotifyAudioFirstFrame(const Event& event)
     uint64_t latency = AnyCast<uint64_t>(event.param);
     MEDIA_LOG_I_SHORT("Audio first frame event in latency " PUBLIC_LOG_U64, latency);
     playStatisticalInfo_.startLatency = static_cast<int32_t>(latency);
+    startupTracer_.EndPhase(StartupPhase::FIRST_AUDIO_FRAME);
     Format format;
     (void)format.PutLongValue(PlayerKeys::AUDIO_FIRST_FRAME, latency);
     callbackLooper_.OnInfo(INFO_TYPE_AUDIO_FIRST_FRAME, 0, format);
@@ -2280,6 +2360,14 @@ Status HiPlayerImpl::OnCallback(std::shared_ptr<Filter> filter, const FilterCall
 void HiPlayerImpl::OnDumpInfo(int32_t fd)
 {
     MEDIA_LOG_D_SHORT("HiPlayerImpl::OnDumpInfo called.");
+    std::string dumpString = startupTracer_.ToString();
+    dumpString += "Latency histograms (ms):\n";
+    dumpString += "  " + seekLatencyHistogram_.ToString();
+    dumpString += "  " + accurateSeekLatencyHistogram_.ToString();
+    dumpString += "  " + surfaceSwapLatencyHistogram_.ToString();
+    if (fd >= 0) {
+        (void)write(fd, dumpString.c_str(), dumpString.size());
+    }
     if (audioDecoder_ != nullptr) {
         audioDecoder_->OnDumpInfo(fd);
     }
@@ -2298,13 +2386,11 @@ Status HiPlayerImpl::LinkAudioDecoderFilter(const std::shared_ptr<Filter>& preFi
     MediaTrace trace("HiPlayerImpl::LinkAudioDecoderFilter");
     MEDIA_LOG_I_SHORT("HiPlayerImpl::LinkAudioDecoderFilter");
     FALSE_RETURN_V(audioDecoder_ == nullptr, Status::OK);
-    audioDecoder_ = FilterFactory::Instance().CreateFilter<AudioDecoderFilter>("player.audiodecoder",
-        FilterType::FILTERTYPE_ADEC);
+    ScopedStartupPhase startupPhase(startupTracer_, StartupPhase::LINK_AUDIO_DECODER);
+    WaitParallelPrepareJob(FilterType::FILTERTYPE_ADEC);
+    audioDecoder_ = preparedAudioDecoder_ != nullptr ? preparedAudioDecoder_ : CreateAudioDecoderFilter();
+    preparedAudioDecoder_ = nullptr;
     FALSE_RETURN_V(audioDecoder_ != nullptr, Status::ERROR_NULL_POINTER);
-    audioDecoder_->Init(playerEventReceiver_, playerFilterCallback_);
-
-    audioDecoder_->SetCallerInfo(instanceId_, bundleName_);
-    audioDecoder_->SetDumpFlag(isDump_);
     // set decrypt config for drm audios
     if (isDrmProtected_) {
         MEDIA_LOG_D_SHORT("HiPlayerImpl::LinkAudioDecoderFilter will SetDecryptConfig");
@@ -2332,14 +2418,34 @@ Status HiPlayerImpl::LinkAudioSinkFilter(const std::shared_ptr<Filter>& preFilte
     MediaTrace trace("HiPlayerImpl::LinkAudioSinkFilter");
     MEDIA_LOG_I_SHORT("HiPlayerImpl::LinkAudioSinkFilter");
     FALSE_RETURN_V(audioSink_ == nullptr, Status::OK);
-    audioSink_ = FilterFactory::Instance().CreateFilter<AudioSinkFilter>("player.audiosink",
-        FilterType::FILTERTYPE_ASINK);
+    ScopedStartupPhase startupPhase(startupTracer_, StartupPhase::LINK_AUDIO_SINK);
+    WaitParallelPrepareJob(FilterType::FILTERTYPE_ASINK);
+    audioSink_ = preparedAudioSink_ != nullptr ? preparedAudioSink_ :
+        CreateAudioSinkFilter(demuxer_ != nullptr ? demuxer_->GetGlobalMetaInfo() : std::make_shared<Meta>());
+    preparedAudioSink_ = nullptr;
     FALSE_RETURN_V(audioSink_ != nullptr, Status::ERROR_NULL_POINTER);
-    audioSink_->Init(playerEventReceiver_, playerFilterCallback_);
-    std::shared_ptr<Meta> globalMeta = std::make_shared<Meta>();
-    if (demuxer_ != nullptr) {
-        globalMeta = demuxer_->GetGlobalMetaInfo();
-    }
+    completeState_.emplace_back(std::make_pair("AudioSink", false));
+    initialAVStates_.emplace_back(std::make_pair(EventType::EVENT_AUDIO_FIRST_FRAME, false));
+    return pipeline_->LinkFilters(preFilter, {audioSink_}, type);
+}
+
+std::shared_ptr<AudioDecoderFilter> HiPlayerImpl::CreateAudioDecoderFilter()
+{
+    auto audioDecoder = FilterFactory::Instance().CreateFilter<AudioDecoderFilter>("player.audiodecoder",
+        FilterType::FILTERTYPE_ADEC);
+    FALSE_RETURN_V(audioDecoder != nullptr, nullptr);
+    audioDecoder->Init(playerEventReceiver_, playerFilterCallback_);
+    audioDecoder->SetCallerInfo(instanceId_, bundleName_);
+    audioDecoder->SetDumpFlag(isDump_);
+    return audioDecoder;
+}
+
+std::shared_ptr<AudioSinkFilter> HiPlayerImpl::CreateAudioSinkFilter(const std::shared_ptr<Meta>& globalMeta)
+{
+    auto audioSink = FilterFactory::Instance().CreateFilter<AudioSinkFilter>("player.audiosink",
+        FilterType::FILTERTYPE_ASINK);
+    FALSE_RETURN_V(audioSink != nullptr, nullptr);
+    audioSink->Init(playerEventReceiver_, playerFilterCallback_);
     if (globalMeta != nullptr) {
         globalMeta->SetData(Tag::APP_PID, appPid_);
         globalMeta->SetData(Tag::APP_UID, appUid_);
@@ -2353,12 +2459,10 @@ Status HiPlayerImpl::LinkAudioSinkFilter(const std::shared_ptr<Filter>& preFilte
                 globalMeta->SetData(iter->first, iter->second);
             }
         }
-        audioSink_->SetParameter(globalMeta);
+        audioSink->SetParameter(globalMeta);
     }
-    audioSink_->SetSyncCenter(syncManager_);
-    completeState_.emplace_back(std::make_pair("AudioSink", false));
-    initialAVStates_.emplace_back(std::make_pair(EventType::EVENT_AUDIO_FIRST_FRAME, false));
-    return pipeline_->LinkFilters(preFilter, {audioSink_}, type);
+    audioSink->SetSyncCenter(syncManager_);
+    return audioSink;
 }
 
 #ifdef SUPPORT_VIDEO
@@ -2366,16 +2470,12 @@ Status HiPlayerImpl::LinkVideoDecoderFilter(const std::shared_ptr<Filter>& preFi
 {
     MediaTrace trace("HiPlayerImpl::LinkVideoDecoderFilter");
     MEDIA_LOG_I_SHORT("LinkVideoDecoderFilter");
+    ScopedStartupPhase startupPhase(startupTracer_, StartupPhase::LINK_VIDEO_DECODER);
     if (videoDecoder_ == nullptr) {
-        videoDecoder_ = FilterFactory::Instance().CreateFilter<DecoderSurfaceFilter>("player.videodecoder",
-            FilterType::FILTERTYPE_VDEC);
+        WaitParallelPrepareJob(FilterType::FILTERTYPE_VDEC);
+        videoDecoder_ = preparedVideoDecoder_ != nullptr ? preparedVideoDecoder_ : CreateVideoDecoderFilter();
+        preparedVideoDecoder_ = nullptr;
         FALSE_RETURN_V(videoDecoder_ != nullptr, Status::ERROR_NULL_POINTER);
-        videoDecoder_->Init(playerEventReceiver_, playerFilterCallback_);
-        videoDecoder_->SetSyncCenter(syncManager_);
-        videoDecoder_->SetCallingInfo(appUid_, appPid_, bundleName_, instanceId_);
-        if (surface_ != nullptr) {
-            videoDecoder_->SetVideoSurface(surface_);
-        }
 
         // set decrypt config for drm videos
         if (isDrmProtected_) {
@@ -2400,11 +2500,116 @@ Status HiPlayerImpl::LinkVideoDecoderFilter(const std::shared_ptr<Filter>& preFi
     initialAVStates_.emplace_back(std::make_pair(EventType::EVENT_VIDEO_RENDERING_START, false));
     return pipeline_->LinkFilters(preFilter, {videoDecoder_}, type);
 }
+
+std::shared_ptr<DecoderSurfaceFilter> HiPlayerImpl::CreateVideoDecoderFilter()
+{
+    auto videoDecoder = FilterFactory::Instance().CreateFilter<DecoderSurfaceFilter>("player.videodecoder",
+        FilterType::FILTERTYPE_VDEC);
+    FALSE_RETURN_V(videoDecoder != nullptr, nullptr);
+    videoDecoder->Init(playerEventReceiver_, playerFilterCallback_);
+    videoDecoder->SetSyncCenter(syncManager_);
+    videoDecoder->SetCallingInfo(appUid_, appPid_, bundleName_, instanceId_);
+    if (surface_ != nullptr) {
+        videoDecoder->SetVideoSurface(surface_);
+    }
+    return videoDecoder;
+}
+#endif
+
+void HiPlayerImpl::StartParallelPrepare()
+{
+    std::string enable;
+    (void)OHOS::system::GetStringParameter("sys.media.player.parallel_prepare.enable", enable, "true");
+    FALSE_RETURN_MSG(enable == "true", "parallel prepare is disabled");
+    FALSE_RETURN(demuxer_ != nullptr);
+    bool hasAudio = false;
+    bool hasVideo = false;
+    for (const auto& trackInfo : demuxer_->GetStreamMetaInfo()) {
+        std::string mime;
+        if (trackInfo == nullptr || !trackInfo->GetData(Tag::MIME_TYPE, mime)) {
+            continue;
+        }
+        hasAudio = hasAudio || IsAudioMime(mime);
+#ifdef SUPPORT_VIDEO
+        hasVideo = hasVideo || IsVideoMime(mime);
+#endif
+    }
+    MEDIA_LOG_I_SHORT("StartParallelPrepare audio " PUBLIC_LOG_D32 " video " PUBLIC_LOG_D32, hasAudio, hasVideo);
+    if (hasAudio && audioDecoder_ == nullptr) {
+        SubmitParallelPrepareJob(FilterType::FILTERTYPE_ADEC,
+            [this] { preparedAudioDecoder_ = CreateAudioDecoderFilter(); });
+    }
+    if (hasAudio && audioSink_ == nullptr) {
+        // the demuxer keeps updating its global meta while the pipeline prepares, so the job works on a copy
+        std::shared_ptr<Meta> demuxerMeta = demuxer_->GetGlobalMetaInfo();
+        auto globalMeta = demuxerMeta != nullptr ? std::make_shared<Meta>(*demuxerMeta) : std::make_shared<Meta>();
+        SubmitParallelPrepareJob(FilterType::FILTERTYPE_ASINK,
+            [this, globalMeta] { preparedAudioSink_ = CreateAudioSinkFilter(globalMeta); });
+    }
+#ifdef SUPPORT_VIDEO
+    if (hasVideo && videoDecoder_ == nullptr) {
+        SubmitParallelPrepareJob(FilterType::FILTERTYPE_VDEC,
+            [this] { preparedVideoDecoder_ = CreateVideoDecoderFilter(); });
+    }
+#endif
+}
+
+void HiPlayerImpl::SubmitParallelPrepareJob(FilterType type, const std::function<void()>& job)
+{
+    auto promise = std::make_shared<std::promise<void>>();
+    std::lock_guard<std::mutex> lock(parallelPrepareMutex_);
+    if (parallelPrepareTasks_.empty()) {
+        for (size_t i = 0; i < PARALLEL_PREPARE_POOL_SIZE; ++i) {
+            parallelPrepareTasks_.push_back(std::make_unique<Task>("ParallelPrepare" + std::to_string(i),
+                playerId_, TaskType::SINGLETON, TaskPriority::HIGH, false));
+        }
+    }
+    auto& task = parallelPrepareTasks_[parallelPrepareJobs_.size() % parallelPrepareTasks_.size()];
+    task->SubmitJobOnce([job, promise] {
+        job();
+        promise->set_value();
+    });
+    parallelPrepareJobs_[type] = promise->get_future();
+}
+
+void HiPlayerImpl::WaitParallelPrepareJob(FilterType type)
+{
+    std::future<void> done;
+    {
+        std::lock_guard<std::mutex> lock(parallelPrepareMutex_);
+        auto iter = parallelPrepareJobs_.find(type);
+        if (iter == parallelPrepareJobs_.end()) {
+            return;
+        }
+        done = std::move(iter->second);
+        parallelPrepareJobs_.erase(iter);
+    }
+    MediaTrace trace("HiPlayerImpl::WaitParallelPrepareJob");
+    done.wait();
+}
+
+void HiPlayerImpl::WaitAllParallelPrepareJobs()
+{
+    std::map<FilterType, std::future<void>> prepareJobs;
+    {
+        std::lock_guard<std::mutex> lock(parallelPrepareMutex_);
+        prepareJobs.swap(parallelPrepareJobs_);
+    }
+    for (auto& [type, done] : prepareJobs) {
+        done.wait();
+    }
+    // filters of branches the demuxer never asked for are not linked and are dropped here
+    preparedAudioDecoder_ = nullptr;
+    preparedAudioSink_ = nullptr;
+#ifdef SUPPORT_VIDEO
+    preparedVideoDecoder_ = nullptr;
 #endif
+}
 
 Status HiPlayerImpl::LinkSubtitleSinkFilter(const std::shared_ptr<Filter>& preFilter, StreamType type)
 {
     MediaTrace trace("HiPlayerImpl::LinkSubtitleSinkFilter");
+    ScopedStartupPhase startupPhase(startupTracer_, StartupPhase::LINK_SUBTITLE_SINK);
     if (subtitleSink_ == nullptr) {
         subtitleSink_ = FilterFactory::Instance().CreateFilter<SubtitleSinkFilter>("player.subtitlesink",
             FilterType::FILTERTYPE_SSINK);
@@ -2429,27 +2634,47 @@ int32_t HiPlayerImpl::SeekContinous(int32_t mSeconds, int64_t seekContinousBatch
     FALSE_RETURN_V(!isNetWorkPlay_, TransStatus(Status::OK));
     FALSE_RETURN_V(seekContinousBatchNo_.load() <= seekContinousBatchNo, TransStatus(Status::OK));
     if (seekContinousBatchNo_.load() == seekContinousBatchNo) {
-        FALSE_RETURN_V(draggingPlayerAgent_ != nullptr, TransStatus(Status::OK));
-        lastSeekContinousPos_ = mSeconds;
-        draggingPlayerAgent_->UpdateSeekPos(mSeconds);
+        FALSE_RETURN_V(draggingPlayerAgent_ != nullptr || keyFrameScrubber_ != nullptr, TransStatus(Status::OK));
+        UpdateSeekContinousPos(mSeconds);
         MEDIA_LOG_I_SHORT("HiPlayerImpl::SeekContinous in " PUBLIC_LOG_D32, mSeconds);
         return TransStatus(Status::OK);
     }
     seekContinousBatchNo_.store(seekContinousBatchNo);
     auto res = StartSeekContinous();
-    FALSE_RETURN_V_MSG_E(res == Status::OK && draggingPlayerAgent_ != nullptr, TransStatus(Status::ERROR_UNKNOWN),
-        "StartSeekContinous failed");
-    lastSeekContinousPos_ = mSeconds;
-    draggingPlayerAgent_->UpdateSeekPos(mSeconds);
+    FALSE_RETURN_V_MSG_E(res == Status::OK && (draggingPlayerAgent_ != nullptr || keyFrameScrubber_ != nullptr),
+        TransStatus(Status::ERROR_UNKNOWN), "StartSeekContinous failed");
+    UpdateSeekContinousPos(mSeconds);
     MEDIA_LOG_I_SHORT("HiPlayerImpl::SeekContinous start " PUBLIC_LOG_D32, mSeconds);
     return TransStatus(Status::OK);
 }
 
+void HiPlayerImpl::UpdateSeekContinousPos(int32_t mSeconds)
+{
+    lastSeekContinousPos_ = mSeconds;
+    if (draggingPlayerAgent_ != nullptr) {
+        draggingPlayerAgent_->UpdateSeekPos(mSeconds);
+    } else if (keyFrameScrubber_ != nullptr) {
+        keyFrameScrubber_->UpdateSeekPos(mSeconds);
+    }
+}
+
 Status HiPlayerImpl::StartSeekContinous()
 {
-    FALSE_RETURN_V(!draggingPlayerAgent_, Status::OK);
+    FALSE_RETURN_V(!draggingPlayerAgent_ && !keyFrameScrubber_, Status::OK);
     draggingPlayerAgent_ = DraggingPlayerAgent::Create();
-    FALSE_RETURN_V(draggingPlayerAgent_ != nullptr, Status::OK);
+    if (draggingPlayerAgent_ == nullptr) {
+        MEDIA_LOG_I_SHORT("dragging player unavailable, use key frame scrubbing");
+        // the decoder must not hold back frames before a previous accurate seek target
+        videoDecoder_->ResetSeekInfo();
+        keyFrameScrubber_ = std::make_shared<KeyFrameScrubber>(demuxer_,
+            [this](const std::shared_ptr<SeekAgent> &seekAgent, int64_t seekMs, int64_t &keyFramePos) {
+                return PreviewKeyFrame(seekAgent, seekMs, keyFramePos);
+            },
+            [this]() { return CaptureKeyFrame(); },
+            [this](const sptr<SurfaceBuffer> &frame, int64_t keyFramePos) { return PresentKeyFrame(frame); },
+            playerId_);
+        return Status::OK;
+    }
     Status res = draggingPlayerAgent_->Init(demuxer_, videoDecoder_);
     if (res != Status::OK) {
         draggingPlayerAgent_ = nullptr;
@@ -2457,6 +2682,111 @@ Status HiPlayerImpl::StartSeekContinous()
     return res;
 }
 
+Status HiPlayerImpl::PreviewKeyFrame(const std::shared_ptr<SeekAgent> &seekAgent, int64_t seekMs,
+    int64_t &keyFramePos)
+{
+    std::lock_guard<std::mutex> pipelineLock(pipelineControlMutex_);
+    MediaTrace trace("HiPlayerImpl::PreviewKeyFrame");
+    previewBaseSeqNum_ = GetLastFlushedSeqNum();
+    // same sequence as a player seek, the demuxer read task must be stopped while the agent seeks the demuxer
+    pipeline_->Pause();
+    pipeline_->Flush();
+    Status ret = seekAgent->SeekToKeyFrame(seekMs, keyFramePos);
+    int64_t keyFrameTimeUs = 0;
+    if (ret == Status::OK && Plugins::Us2HstTime(keyFramePos, keyFrameTimeUs)) {
+        syncManager_->Seek(keyFrameTimeUs);
+    }
+    // the agent leaves the demuxer paused for seek, a playing pipeline goes on from the previewed key frame
+    if (pipelineStates_ == PlayerStates::PLAYER_STARTED) {
+        pipeline_->Resume();
+    }
+    return ret;
+}
+
+#ifdef SUPPORT_VIDEO
+static BufferRequestConfig GetKeyFrameBufferConfig(const sptr<SurfaceBuffer> &frame)
+{
+    return {
+        .width = frame->GetWidth(),
+        .height = frame->GetHeight(),
+        .strideAlignment = KEY_FRAME_STRIDE_ALIGNMENT,
+        .format = frame->GetFormat(),
+        .usage = BUFFER_USAGE_CPU_READ | BUFFER_USAGE_CPU_WRITE | BUFFER_USAGE_MEM_DMA,
+        .timeout = 0,
+    };
+}
+#endif
+
+uint32_t HiPlayerImpl::GetLastFlushedSeqNum()
+{
+#ifdef SUPPORT_VIDEO
+    FALSE_RETURN_V(surface_ != nullptr, 0);
+    sptr<SurfaceBuffer> onScreen = nullptr;
+    sptr<SyncFence> fence = nullptr;
+    float matrix[TRANSFORM_MATRIX_SIZE] = {0};
+    FALSE_RETURN_V(surface_->GetLastFlushedBuffer(onScreen, fence, matrix) == GSERROR_OK && onScreen != nullptr, 0);
+    return onScreen->GetSeqNum();
+#else
+    return 0;
+#endif
+}
+
+sptr<SurfaceBuffer> HiPlayerImpl::CaptureKeyFrame()
+{
+#ifdef SUPPORT_VIDEO
+    std::lock_guard<std::mutex> pipelineLock(pipelineControlMutex_);
+    // a started player has already moved on from the previewed key frame
+    FALSE_RETURN_V(surface_ != nullptr && pipelineStates_ != PlayerStates::PLAYER_STARTED, nullptr);
+    sptr<SurfaceBuffer> onScreen = nullptr;
+    sptr<SyncFence> fence = nullptr;
+    float matrix[TRANSFORM_MATRIX_SIZE] = {0};
+    GSError ret = surface_->GetLastFlushedBuffer(onScreen, fence, matrix);
+    // secure buffers have no cpu mapping and are never kept
+    FALSE_RETURN_V(ret == GSERROR_OK && onScreen != nullptr && onScreen->GetVirAddr() != nullptr, nullptr);
+    FALSE_RETURN_V_MSG_W(onScreen->GetSeqNum() != previewBaseSeqNum_, nullptr, "key frame not on screen yet");
+    FALSE_RETURN_V(fence == nullptr || fence->Wait(KEY_FRAME_FENCE_WAIT_MS) == 0, nullptr);
+    sptr<SurfaceBuffer> frame = SurfaceBuffer::Create();
+    FALSE_RETURN_V(frame != nullptr && frame->Alloc(GetKeyFrameBufferConfig(onScreen)) == GSERROR_OK, nullptr);
+    // the picture is copied as is, a different layout would need a conversion the scrubber is not worth
+    FALSE_RETURN_V(frame->GetStride() == onScreen->GetStride() && frame->GetSize() >= onScreen->GetSize(), nullptr);
+    FALSE_RETURN_V(memcpy_s(frame->GetVirAddr(), frame->GetSize(), onScreen->GetVirAddr(),
+        onScreen->GetSize()) == EOK, nullptr);
+    return frame;
+#else
+    return nullptr;
+#endif
+}
+
+Status HiPlayerImpl::PresentKeyFrame(const sptr<SurfaceBuffer> &frame)
+{
+#ifdef SUPPORT_VIDEO
+    std::lock_guard<std::mutex> pipelineLock(pipelineControlMutex_);
+    MediaTrace trace("HiPlayerImpl::PresentKeyFrame");
+    FALSE_RETURN_V(surface_ != nullptr && frame != nullptr, Status::ERROR_NULL_POINTER);
+    sptr<SurfaceBuffer> buffer = nullptr;
+    int32_t releaseFence = -1;
+    GSError ret = surface_->RequestBuffer(buffer, releaseFence, GetKeyFrameBufferConfig(frame));
+    FALSE_RETURN_V_MSG_E(ret == GSERROR_OK && buffer != nullptr, Status::ERROR_UNKNOWN,
+        "request window buffer failed: " PUBLIC_LOG_D32, ret);
+    sptr<SyncFence> syncFence = new SyncFence(releaseFence);
+    if (syncFence->Wait(KEY_FRAME_FENCE_WAIT_MS) != 0 || buffer->GetStride() != frame->GetStride() ||
+        memcpy_s(buffer->GetVirAddr(), buffer->GetSize(), frame->GetVirAddr(), frame->GetSize()) != EOK) {
+        surface_->CancelBuffer(buffer);
+        return Status::ERROR_UNKNOWN;
+    }
+    BufferFlushConfig flushConfig = {
+        .damage = { .x = 0, .y = 0, .w = frame->GetWidth(), .h = frame->GetHeight() },
+        .timestamp = 0,
+    };
+    ret = surface_->FlushBuffer(buffer, -1, flushConfig);
+    FALSE_RETURN_V_MSG_E(ret == GSERROR_OK, Status::ERROR_UNKNOWN, "flush window buffer failed: " PUBLIC_LOG_D32, ret);
+    return Status::OK;
+#else
+    (void)frame;
+    return Status::ERROR_UNSUPPORTED_FORMAT;
+#endif
+}
+
 int32_t HiPlayerImpl::ExitSeekContinous(bool align, int64_t seekContinousBatchNo)
 {
     std::lock_guard<std::mutex> lock(seekContinousMutex_);
@@ -2467,8 +2797,17 @@ int32_t HiPlayerImpl::ExitSeekContinous(bool align, int64_t seekContinousBatchNo
         draggingPlayerAgent_->Release();
         draggingPlayerAgent_ = nullptr;
     }
+    bool isServedFromCache = false;
+    if (keyFrameScrubber_ != nullptr) {
+        keyFrameScrubber_->Release();
+        isServedFromCache = keyFrameScrubber_->IsServedFromCache();
+        keyFrameScrubber_ = nullptr;
+    }
     if (align) {
         Seek(lastSeekContinousPos_, PlayerSeekMode::SEEK_CLOSEST, false);
+    } else if (isServedFromCache) {
+        // the picture on screen came from memory, the demuxer still sits at the last previewed key frame
+        Seek(lastSeekContinousPos_, PlayerSeekMode::SEEK_PREVIOUS_SYNC, false);
     }
     return TransStatus(Status::OK);
 }
@@ -16,8 +16,12 @@
 #ifndef HI_PLAYER_IMPL_H
 #define HI_PLAYER_IMPL_H
 
+#include <functional>
+#include <future>
+#include <map>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include <queue>
 
 #include "audio_decoder_filter.h"
@@ -32,10 +36,13 @@
 #include "media_sync_manager.h"
 #include "pipeline/pipeline.h"
 #include "seek_agent.h"
+#include "startup_tracer.h"
 #include "subtitle_sink_filter.h"
 #include "meta/meta.h"
 #include <chrono>
 #include "dragging_player_agent.h"
+#include "keyframe_scrubber.h"
+#include "latency_histogram.h"
 #ifdef SUPPORT_VIDEO
 #include "decoder_surface_filter.h"
 #endif
@@ -165,6 +172,7 @@ private:
     void GetDumpFlag();
     void HandleCompleteEvent(const Event& event);
     void HandleInitialPlayingStateChange(const EventType& eventType);
+    void NotifyStartupBreakdown();
     void HandleDrmInfoUpdatedEvent(const Event& event);
     void HandleIsLiveStreamEvent(bool isLiveStream);
     void HandleErrorEvent(int32_t errorCode);
@@ -189,6 +197,12 @@ private:
     Status LinkAudioDecoderFilter(const std::shared_ptr<Filter>& preFilter, StreamType type);
     Status LinkAudioSinkFilter(const std::shared_ptr<Filter>& preFilter, StreamType type);
     Status LinkSubtitleSinkFilter(const std::shared_ptr<Filter>& preFilter, StreamType type);
+    std::shared_ptr<AudioDecoderFilter> CreateAudioDecoderFilter();
+    std::shared_ptr<AudioSinkFilter> CreateAudioSinkFilter(const std::shared_ptr<Meta>& globalMeta);
+    void StartParallelPrepare();
+    void SubmitParallelPrepareJob(FilterType type, const std::function<void()>& job);
+    void WaitParallelPrepareJob(FilterType type);
+    void WaitAllParallelPrepareJobs();
     void NotifySubtitleUpdate(const Event& event);
     void DoInitializeForHttp();
     bool EnableBufferingBySysParam() const;
@@ -200,10 +214,12 @@ private:
     int64_t GetCurrentMillisecond();
     void UpdatePlayStatistics();
     void DoSetMediaSource(Status& ret);
+    void ShareProbeInfo();
     void UpdatePlayerStateAndNotify();
-    void UpdateMaxSeekLatency(PlayerSeekMode mode, int64_t seekStartTime);
+    void UpdateSeekLatency(PlayerSeekMode mode, int64_t seekStartTime);
 #ifdef SUPPORT_VIDEO
     Status LinkVideoDecoderFilter(const std::shared_ptr<Filter>& preFilter, StreamType type);
+    std::shared_ptr<DecoderSurfaceFilter> CreateVideoDecoderFilter();
     bool IsVideoMime(const std::string& mime);
 #endif
     bool IsAudioMime(const std::string& mime);
@@ -221,6 +237,7 @@ private:
     int32_t InitDuration();
     int32_t InitVideoWidthAndHeight();
     int32_t SetFrameRateForSeekPerformance(double frameRate);
+    double GetFrameRateForAccurateSeek(int64_t seekPos, int64_t keyFramePos);
     void SetBundleName(std::string bundleName);
     Status InitAudioDefaultTrackIndex();
     Status InitVideoDefaultTrackIndex();
@@ -232,6 +249,11 @@ private:
     Status SelectSeekType(int64_t seekPos, PlayerSeekMode mode);
     Status DoSetPlayRange();
     Status StartSeekContinous();
+    void UpdateSeekContinousPos(int32_t mSeconds);
+    Status PreviewKeyFrame(const std::shared_ptr<SeekAgent> &seekAgent, int64_t seekMs, int64_t &keyFramePos);
+    sptr<SurfaceBuffer> CaptureKeyFrame();
+    Status PresentKeyFrame(const sptr<SurfaceBuffer> &frame);
+    uint32_t GetLastFlushedSeqNum();
     int32_t InnerSelectTrack(std::string mime, int32_t trackId, PlayerSwitchMode mode);
 
     bool isNetWorkPlay_ = false;
@@ -310,10 +332,10 @@ private:
     int32_t defaultSubtitleTrackId_ = -1;
     PlayStatisticalInfo playStatisticalInfo_;
     int64_t startTime_ = 0;
-    int64_t maxSeekLatency_ = 0;
-    int64_t maxAccurateSeekLatency_ = 0;
+    LatencyHistogram seekLatencyHistogram_ {"av_player_seek_latency"};
+    LatencyHistogram accurateSeekLatencyHistogram_ {"av_player_accurate_seek_latency"};
     uint64_t instanceId_ = 0;
-    int64_t maxSurfaceSwapLatency_ = 0;
+    LatencyHistogram surfaceSwapLatencyHistogram_ {"av_player_surface_swap_latency"};
     int64_t playTotalDuration_ = 0;
     bool inEosSeek_ = false;
     std::string mimeType_;
@@ -324,10 +346,27 @@ private:
     OHOS::Media::Mutex stateChangeMutex_{};
 
     std::mutex seekContinousMutex_;
+    // pipeline pause, flush and resume of the API calls and of the scrubber worker must not interleave
+    std::mutex pipelineControlMutex_;
+    // last buffer flushed to the window before the running preview, the previewed key frame comes after it
+    uint32_t previewBaseSeqNum_ {0};
     std::atomic<int64_t> seekContinousBatchNo_ {-1};
     std::shared_ptr<DraggingPlayerAgent> draggingPlayerAgent_ {nullptr};
+    std::shared_ptr<KeyFrameScrubber> keyFrameScrubber_ {nullptr};
     int64_t lastSeekContinousPos_ {-1};
     std::atomic<bool> needUpdateSubtitle_ {true};
+    StartupTracer startupTracer_;
+
+    // Filters of independent track branches are created on a small pool of worker tasks while the demuxer
+    // prepares, the Link*Filter callbacks pick them up. Disabled by sys.media.player.parallel_prepare.enable=false.
+    std::mutex parallelPrepareMutex_;
+    std::vector<std::unique_ptr<Task>> parallelPrepareTasks_;
+    std::map<FilterType, std::future<void>> parallelPrepareJobs_;
+    std::shared_ptr<AudioDecoderFilter> preparedAudioDecoder_;
+    std::shared_ptr<AudioSinkFilter> preparedAudioSink_;
+#ifdef SUPPORT_VIDEO
+    std::shared_ptr<DecoderSurfaceFilter> preparedVideoDecoder_;
+#endif
 };
 } // namespace Media
 } // namespace OHOS
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define HST_LOG_TAG "KeyFrameScrubber"
+
+#include "keyframe_scrubber.h"
+#include <algorithm>
+#include "common/log.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_CORE, LOG_DOMAIN_PLAYER, "KeyFrameScrubber" };
+// a preview running longer than this is cut by the next position, shorter ones finish so the drag never starves
+constexpr int64_t PREVIEW_INTERRUPT_THRESHOLD_MS = 50;
+}
+
+namespace OHOS {
+namespace Media {
+KeyFrameScrubber::KeyFrameScrubber(std::shared_ptr<Pipeline::DemuxerFilter> demuxer, PreviewFunc preview,
+    CaptureFunc capture, PresentFunc present, const std::string &groupId)
+    : demuxer_(demuxer), preview_(std::move(preview)), capture_(std::move(capture)), present_(std::move(present))
+{
+    MEDIA_LOG_I("KeyFrameScrubber ctor called.");
+    task_ = std::make_unique<Task>("KeyFrameScrubber", groupId, TaskType::SINGLETON, TaskPriority::HIGH, false);
+}
+
+KeyFrameScrubber::~KeyFrameScrubber()
+{
+    MEDIA_LOG_I("~KeyFrameScrubber dtor called.");
+}
+
+void KeyFrameScrubber::UpdateSeekPos(int64_t seekMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    FALSE_RETURN(!isReleased_ && task_ != nullptr);
+    pendingPos_ = seekMs;
+    if (seekAgent_ != nullptr && std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - previewStartTime_).count() > PREVIEW_INTERRUPT_THRESHOLD_MS) {
+        seekAgent_->Interrupt();
+    }
+    if (isScrubbing_) {
+        return;
+    }
+    isScrubbing_ = true;
+    std::weak_ptr<KeyFrameScrubber> weakScrubber = shared_from_this();
+    task_->SubmitJobOnce([weakScrubber] {
+        auto scrubber = weakScrubber.lock();
+        FALSE_RETURN(scrubber != nullptr);
+        scrubber->ScrubLoop();
+    });
+}
+
+void KeyFrameScrubber::ScrubLoop()
+{
+    while (true) {
+        int64_t seekMs = -1;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (isReleased_ || pendingPos_ < 0) {
+                isScrubbing_ = false;
+                idleCond_.notify_all();
+                return;
+            }
+            seekMs = pendingPos_;
+            pendingPos_ = -1;
+        }
+        if (IsDisplayed(seekMs)) {
+            MEDIA_LOG_D("key frame " PUBLIC_LOG_D64 " already displayed for " PUBLIC_LOG_D64,
+                displayedKeyFramePos_, seekMs);
+            continue;
+        }
+        // the screen is about to change, keep the picture of the gop it shows for a drag back
+        CaptureDisplayed();
+        if (PresentCached(seekMs)) {
+            continue;
+        }
+        auto seekAgent = std::make_shared<SeekAgent>(demuxer_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (isReleased_) {
+                continue;
+            }
+            seekAgent_ = seekAgent;
+            previewStartTime_ = std::chrono::steady_clock::now();
+        }
+        int64_t keyFramePos = -1;
+        Status ret = preview_ != nullptr ? preview_(seekAgent, seekMs, keyFramePos) : Status::ERROR_NULL_POINTER;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            seekAgent_ = nullptr;
+        }
+        // an interrupted preview may have been cut before the key frame was pushed to the decoder
+        if (ret != Status::OK || keyFramePos < 0 || seekAgent->IsInterrupted()) {
+            displayedKeyFramePos_ = -1;
+            displayedMaxPos_ = -1;
+            isDisplayedCaptured_ = false;
+            continue;
+        }
+        SetDisplayed(keyFramePos, keyFramePos == displayedKeyFramePos_ ? std::max(displayedMaxPos_, seekMs) :
+            std::max(keyFramePos, seekMs), false);
+        MEDIA_LOG_D("preview key frame " PUBLIC_LOG_D64 " for " PUBLIC_LOG_D64, keyFramePos, seekMs);
+    }
+}
+
+bool KeyFrameScrubber::IsDisplayed(int64_t seekMs) const
+{
+    return displayedKeyFramePos_ >= 0 && displayedKeyFramePos_ <= seekMs && seekMs <= displayedMaxPos_;
+}
+
+void KeyFrameScrubber::CaptureDisplayed()
+{
+    FALSE_RETURN(capture_ != nullptr && displayedKeyFramePos_ >= 0 && !isDisplayedCaptured_);
+    isDisplayedCaptured_ = true;
+    sptr<SurfaceBuffer> frame = capture_();
+    FALSE_RETURN(frame != nullptr);
+    frameLru_.push_front({displayedKeyFramePos_, displayedMaxPos_, frame});
+    cachedBytes_ += frame->GetSize();
+    EvictCachedFrames();
+}
+
+bool KeyFrameScrubber::PresentCached(int64_t seekMs)
+{
+    FALSE_RETURN_V(present_ != nullptr, false);
+    auto iter = std::find_if(frameLru_.begin(), frameLru_.end(), [seekMs](const CachedKeyFrame &cached) {
+        return cached.keyFramePos <= seekMs && seekMs <= cached.maxPos;
+    });
+    FALSE_RETURN_V(iter != frameLru_.end(), false);
+    if (present_(iter->frame, iter->keyFramePos) != Status::OK) {
+        MEDIA_LOG_W("present cached key frame " PUBLIC_LOG_D64 " failed", iter->keyFramePos);
+        cachedBytes_ -= iter->frame->GetSize();
+        frameLru_.erase(iter);
+        return false;
+    }
+    frameLru_.splice(frameLru_.begin(), frameLru_, iter);
+    SetDisplayed(iter->keyFramePos, iter->maxPos, true);
+    MEDIA_LOG_D("cached key frame " PUBLIC_LOG_D64 " for " PUBLIC_LOG_D64, iter->keyFramePos, seekMs);
+    return true;
+}
+
+void KeyFrameScrubber::SetDisplayed(int64_t keyFramePos, int64_t maxPos, bool fromCache)
+{
+    displayedKeyFramePos_ = keyFramePos;
+    displayedMaxPos_ = maxPos;
+    isDisplayedCaptured_ = fromCache;
+    // a preview landing on a cached gop only widens the range that entry answers for
+    auto iter = std::find_if(frameLru_.begin(), frameLru_.end(), [keyFramePos](const CachedKeyFrame &cached) {
+        return cached.keyFramePos == keyFramePos;
+    });
+    if (iter != frameLru_.end()) {
+        iter->maxPos = std::max(iter->maxPos, maxPos);
+        isDisplayedCaptured_ = true;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    isServedFromCache_ = fromCache;
+}
+
+void KeyFrameScrubber::EvictCachedFrames()
+{
+    while (!frameLru_.empty() && (frameLru_.size() > MAX_CACHED_FRAME_COUNT ||
+        cachedBytes_ > MAX_CACHED_FRAME_BYTES)) {
+        cachedBytes_ -= frameLru_.back().frame->GetSize();
+        frameLru_.pop_back();
+    }
+}
+
+bool KeyFrameScrubber::IsServedFromCache()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return isServedFromCache_;
+}
+
+void KeyFrameScrubber::Release()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (isReleased_) {
+        return;
+    }
+    isReleased_ = true;
+    pendingPos_ = -1;
+    if (seekAgent_ != nullptr) {
+        seekAgent_->Interrupt();
+    }
+    idleCond_.wait(lock, [this] { return !isScrubbing_; });
+    lock.unlock();
+    task_.reset();
+    MEDIA_LOG_I("KeyFrameScrubber released, cached key frames: %{public}zu", frameLru_.size());
+    frameLru_.clear();
+    cachedBytes_ = 0;
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KEYFRAME_SCRUBBER_H
+#define KEYFRAME_SCRUBBER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "demuxer_filter.h"
+#include "osal/task/task.h"
+#include "seek_agent.h"
+#include "surface_buffer.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Built-in continuous seek used when the dragging player library is not installed. Every drag position is
+ * previewed with the sync sample before it, only that sample is decoded. Positions are coalesced on a worker
+ * so only the latest one is served, and a new position interrupts a preview that is taking too long.
+ * Positions inside the gop that is on screen are served without any demux or decode work. The decoded key frames
+ * of the gops left behind are kept in a small LRU, dragging back to one of them only puts its picture on screen.
+ */
+class KeyFrameScrubber : public std::enable_shared_from_this<KeyFrameScrubber> {
+public:
+    // runs seekAgent->SeekToKeyFrame through the player, which pauses, flushes and resyncs the pipeline around it
+    using PreviewFunc = std::function<Status(const std::shared_ptr<SeekAgent> &seekAgent, int64_t seekMs,
+        int64_t &keyFramePos)>;
+    // copy of the picture on screen, nullptr when it cannot be read back or is no longer the previewed key frame
+    using CaptureFunc = std::function<sptr<SurfaceBuffer>()>;
+    // puts a cached picture on screen without demuxing, the demuxer stays where the last preview left it
+    using PresentFunc = std::function<Status(const sptr<SurfaceBuffer> &frame, int64_t keyFramePos)>;
+
+    KeyFrameScrubber(std::shared_ptr<Pipeline::DemuxerFilter> demuxer, PreviewFunc preview, CaptureFunc capture,
+        PresentFunc present, const std::string &groupId);
+    ~KeyFrameScrubber();
+
+    void UpdateSeekPos(int64_t seekMs);
+    // interrupts the preview in flight and waits for the worker to finish, must be called before the last release
+    void Release();
+    // true when the picture on screen came from the cache, the demuxer then is not at the position shown
+    bool IsServedFromCache();
+
+    static constexpr size_t MAX_CACHED_FRAME_COUNT = 8;
+    static constexpr uint64_t MAX_CACHED_FRAME_BYTES = 48 * 1024 * 1024;
+
+private:
+    struct CachedKeyFrame {
+        int64_t keyFramePos;
+        // furthest position known to resolve to keyFramePos, there is no sync sample in between
+        int64_t maxPos;
+        sptr<SurfaceBuffer> frame;
+    };
+
+    void ScrubLoop();
+    bool IsDisplayed(int64_t seekMs) const;
+    void CaptureDisplayed();
+    bool PresentCached(int64_t seekMs);
+    void SetDisplayed(int64_t keyFramePos, int64_t maxPos, bool fromCache);
+    void EvictCachedFrames();
+
+    std::shared_ptr<Pipeline::DemuxerFilter> demuxer_;
+    PreviewFunc preview_;
+    CaptureFunc capture_;
+    PresentFunc present_;
+    std::unique_ptr<Task> task_;
+    std::mutex mutex_;
+    std::condition_variable idleCond_;
+    int64_t pendingPos_ {-1};
+    bool isScrubbing_ {false};
+    bool isReleased_ {false};
+    std::shared_ptr<SeekAgent> seekAgent_ {nullptr};
+    std::chrono::steady_clock::time_point previewStartTime_;
+    int64_t displayedKeyFramePos_ {-1};
+    // furthest position known to resolve to displayedKeyFramePos_, there is no sync sample in between
+    int64_t displayedMaxPos_ {-1};
+    bool isDisplayedCaptured_ {false};
+    bool isServedFromCache_ {false};
+    // only touched by the worker, most recently shown first
+    std::list<CachedKeyFrame> frameLru_;
+    uint64_t cachedBytes_ {0};
+};
+} // namespace Media
+} // namespace OHOS
+#endif // KEYFRAME_SCRUBBER_H
@@ -71,15 +71,46 @@ SeekAgent::~SeekAgent()
     MEDIA_LOG_I("~SeekAgent dtor called.");
 }
 
-Status SeekAgent::Seek(int64_t seekPos)
+Status SeekAgent::Seek(int64_t seekPos, const std::function<void(int64_t)> &onKeyFrameLocated)
 {
-    MEDIA_LOG_I("Seek start, seekPos: %{public}" PRId64, seekPos);
+    return DoSeek(seekPos, Plugins::SeekMode::SEEK_CLOSEST_INNER, onKeyFrameLocated);
+}
+
+Status SeekAgent::SeekToKeyFrame(int64_t seekPos, int64_t &keyFramePos)
+{
+    return DoSeek(seekPos, Plugins::SeekMode::SEEK_PREVIOUS_SYNC,
+        [&keyFramePos](int64_t realSeekTime) { keyFramePos = realSeekTime; });
+}
+
+void SeekAgent::Interrupt()
+{
+    isInterrupted_ = true;
+    AutoLock lock(targetArrivedLock_);
+    targetArrivedCond_.NotifyAll();
+}
+
+bool SeekAgent::IsInterrupted() const
+{
+    return isInterrupted_.load();
+}
+
+Status SeekAgent::DoSeek(int64_t seekPos, Plugins::SeekMode mode,
+    const std::function<void(int64_t)> &onKeyFrameLocated)
+{
+    MEDIA_LOG_I("Seek start, seekPos: %{public}" PRId64 ", mode: %{public}d", seekPos, static_cast<int32_t>(mode));
     FALSE_RETURN_V_MSG_E(demuxer_ != nullptr, Status::ERROR_INVALID_PARAMETER, "Invalid demuxer filter instance.");
     seekTargetPos_ = seekPos;
     int64_t realSeekTime = seekPos;
-    auto st = demuxer_->SeekTo(seekPos, Plugins::SeekMode::SEEK_CLOSEST_INNER, realSeekTime);
+    auto st = demuxer_->SeekTo(seekPos, mode, realSeekTime);
     FALSE_RETURN_V_MSG_E(st == Status::OK, Status::ERROR_INVALID_OPERATION, "Seekto error.");
- 
+    if (mode != Plugins::SeekMode::SEEK_CLOSEST_INNER) {
+        // the sync sample itself is the target
+        seekTargetPos_ = realSeekTime;
+    }
+    if (onKeyFrameLocated != nullptr) {
+        onKeyFrameLocated(realSeekTime);
+    }
+
     isSeeking_ = true;
     st = SetBufferFilledListener();
     FALSE_RETURN_V_MSG_E(st == Status::OK, Status::ERROR_INVALID_OPERATION, "SetBufferFilledListener failed.");
@@ -90,12 +121,16 @@ Status SeekAgent::Seek(int64_t seekPos)
     {
         AutoLock lock(targetArrivedLock_);
         demuxer_->ResumeForSeek();
-        targetArrivedCond_.WaitFor(lock, WAIT_MAX_MS, [this] {return isAudioTargetArrived_ && isVideoTargetArrived_;});
+        targetArrivedCond_.WaitFor(lock, WAIT_MAX_MS, [this] {
+            return isInterrupted_ || (isAudioTargetArrived_ && isVideoTargetArrived_);
+        });
         MEDIA_LOG_I("Wait end");
     }
     MEDIA_LOG_I("PauseForSeek start");
     demuxer_->PauseForSeek();
     st = RemoveBufferFilledListener();
+    MEDIA_LOG_I("Seek end, video pushed: %{public}u, dropped: %{public}u", videoPushedCount_.load(),
+        videoDroppedCount_.load());
     return st;
 }
 
@@ -191,6 +226,10 @@ Status SeekAgent::OnAudioBufferFilled(std::shared_ptr<AVBuffer>& buffer,
     sptr<AVBufferQueueProducer> producer, int32_t trackId)
 {
     MEDIA_LOG_D("OnAudioBufferFilled, pts: %{public}" PRId64, buffer->pts_);
+    if (isInterrupted_) {
+        producer->ReturnBuffer(buffer, false);
+        return Status::OK;
+    }
     if (buffer->pts_ >= seekTargetPos_ * MS_TO_US || (buffer->flag_ & (uint32_t)(AVBufferFlag::EOS))) {
         {
             AutoLock lock(targetArrivedLock_);
@@ -211,7 +250,11 @@ Status SeekAgent::OnAudioBufferFilled(std::shared_ptr<AVBuffer>& buffer,
 Status SeekAgent::OnVideoBufferFilled(std::shared_ptr<AVBuffer>& buffer,
     sptr<AVBufferQueueProducer> producer, int32_t trackId)
 {
-    MEDIA_LOG_I("OnVideoBufferFilled, pts: %{public}" PRId64, buffer->pts_);
+    MEDIA_LOG_D("OnVideoBufferFilled, pts: %{public}" PRId64, buffer->pts_);
+    if (isInterrupted_) {
+        producer->ReturnBuffer(buffer, false);
+        return Status::OK;
+    }
     if (buffer->pts_ >= seekTargetPos_ * MS_TO_US || (buffer->flag_ & (uint32_t)(AVBufferFlag::EOS))) {
         {
             AutoLock lock(targetArrivedLock_);
@@ -220,12 +263,19 @@ Status SeekAgent::OnVideoBufferFilled(std::shared_ptr<AVBuffer>& buffer,
         MEDIA_LOG_I("video arrive target");
         demuxer_->PauseTaskByTrackId(trackId);
         targetArrivedCond_.NotifyAll();
+        videoPushedCount_++;
         producer->ReturnBuffer(buffer, true);
         return Status::OK;
     }
     bool canDrop = false;
     buffer->meta_->GetData(Media::Tag::VIDEO_BUFFER_CAN_DROP, canDrop);
     MEDIA_LOG_D("ReturnBuffer, pts: %{public}" PRId64 ", isPushBuffer: %{public}i", buffer->pts_, !canDrop);
+    // non-reference frames before the target never reach the decoder
+    if (canDrop) {
+        videoDroppedCount_++;
+    } else {
+        videoPushedCount_++;
+    }
     producer->ReturnBuffer(buffer, !canDrop);
     return Status::OK;
 }
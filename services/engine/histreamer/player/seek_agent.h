@@ -16,6 +16,7 @@
 #ifndef SEEK_AGENT_H
 #define SEEK_AGENT_H
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include "common/status.h"
@@ -34,13 +35,20 @@ public:
     explicit SeekAgent(std::shared_ptr<Pipeline::DemuxerFilter> demuxer);
     ~SeekAgent();
 
-    Status Seek(int64_t seekPos);
+    // onKeyFrameLocated is called with the key frame position (ms) before decoding towards seekPos starts
+    Status Seek(int64_t seekPos, const std::function<void(int64_t)> &onKeyFrameLocated = nullptr);
+    // decodes only the sync sample at or before seekPos, keyFramePos is its position (ms)
+    Status SeekToKeyFrame(int64_t seekPos, int64_t &keyFramePos);
+    // stops waiting for the target, buffers delivered afterwards are not pushed to the decoders
+    void Interrupt();
+    bool IsInterrupted() const;
     Status OnAudioBufferFilled(std::shared_ptr<AVBuffer>& buffer,
         sptr<AVBufferQueueProducer> producer, int32_t trackId);
     Status OnVideoBufferFilled(std::shared_ptr<AVBuffer>& buffer,
         sptr<AVBufferQueueProducer> producer, int32_t trackId);
 
 private:
+    Status DoSeek(int64_t seekPos, Plugins::SeekMode mode, const std::function<void(int64_t)> &onKeyFrameLocated);
     Status SetBufferFilledListener();
     Status RemoveBufferFilledListener();
     Status GetAllTrackInfo(uint32_t &videoTrackId, std::vector<uint32_t> &audioTrackIds);
@@ -53,6 +61,9 @@ private:
 
     int64_t seekTargetPos_{-1};
     std::atomic<bool> isSeeking_{false};
+    std::atomic<bool> isInterrupted_{false};
+    std::atomic<uint32_t> videoPushedCount_{0};
+    std::atomic<uint32_t> videoDroppedCount_{0};
     std::map<uint32_t, sptr<AVBufferQueueProducer>> producerMap_;
     std::map<uint32_t, sptr<IBrokerListener>> listenerMap_;
 
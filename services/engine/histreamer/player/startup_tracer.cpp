@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define HST_LOG_TAG "StartupTracer"
+
+#include "startup_tracer.h"
+#include <chrono>
+#include <cinttypes>
+#include "common/log.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_CORE, LOG_DOMAIN_PLAYER, "StartupTracer" };
+constexpr int64_t US_PER_MS = 1000;
+constexpr int64_t US_PER_TENTH_MS = 100;
+const char *STARTUP_META_PREFIX = "av_player_startup_";
+const char *PHASE_NAMES[] = {
+    "init",
+    "set_source",
+    "pipeline_prepare",
+    "link_audio_decoder",
+    "link_video_decoder",
+    "link_audio_sink",
+    "link_subtitle_sink",
+    "prepare_total",
+    "pipeline_start",
+    "first_audio_frame",
+    "first_video_frame",
+};
+static_assert(sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]) ==
+    static_cast<size_t>(OHOS::Media::StartupPhase::PHASE_BUTT), "phase names mismatch");
+}
+
+namespace OHOS {
+namespace Media {
+int64_t StartupTracer::GetNowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char *StartupTracer::GetPhaseName(size_t index)
+{
+    return index < static_cast<size_t>(StartupPhase::PHASE_BUTT) ? PHASE_NAMES[index] : "unknown";
+}
+
+void StartupTracer::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    phases_.fill(PhaseRecord {});
+}
+
+void StartupTracer::BeginPhase(StartupPhase phase)
+{
+    size_t index = static_cast<size_t>(phase);
+    FALSE_RETURN(index < phases_.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (phases_[index].beginUs < 0) {
+        phases_[index].beginUs = GetNowUs();
+    }
+}
+
+void StartupTracer::EndPhase(StartupPhase phase)
+{
+    size_t index = static_cast<size_t>(phase);
+    FALSE_RETURN(index < phases_.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    PhaseRecord &record = phases_[index];
+    if (record.beginUs < 0 || record.endUs >= 0) {
+        return;
+    }
+    record.endUs = GetNowUs();
+    MEDIA_LOG_D("phase %{public}s cost %{public}" PRId64 " us", PHASE_NAMES[index], record.endUs - record.beginUs);
+}
+
+void StartupTracer::ToFormat(Format &format)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < phases_.size(); ++i) {
+        if (phases_[i].endUs >= 0) {
+            format.PutLongValue(PHASE_NAMES[i], (phases_[i].endUs - phases_[i].beginUs) / US_PER_MS);
+        }
+    }
+}
+
+void StartupTracer::AppendToMeta(const std::shared_ptr<Meta> &meta)
+{
+    FALSE_RETURN(meta != nullptr);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < phases_.size(); ++i) {
+        if (phases_[i].endUs >= 0) {
+            meta->SetData(std::string(STARTUP_META_PREFIX) + PHASE_NAMES[i],
+                static_cast<int32_t>((phases_[i].endUs - phases_[i].beginUs) / US_PER_MS));
+        }
+    }
+}
+
+std::string StartupTracer::ToString()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string result = "Startup phases (ms):\n";
+    for (size_t i = 0; i < phases_.size(); ++i) {
+        result += "  " + std::string(GetPhaseName(i)) + ": ";
+        if (phases_[i].endUs >= 0) {
+            int64_t costUs = phases_[i].endUs - phases_[i].beginUs;
+            result += std::to_string(costUs / US_PER_MS) + "." +
+                std::to_string(costUs % US_PER_MS / US_PER_TENTH_MS) + "\n";
+        } else {
+            result += phases_[i].beginUs >= 0 ? "running\n" : "-\n";
+        }
+    }
+    return result;
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024-2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STARTUP_TRACER_H
+#define STARTUP_TRACER_H
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "meta/format.h"
+#include "meta/meta.h"
+
+namespace OHOS {
+namespace Media {
+enum class StartupPhase : int32_t {
+    INIT = 0,
+    SET_SOURCE,
+    PIPELINE_PREPARE,
+    LINK_AUDIO_DECODER,
+    LINK_VIDEO_DECODER,
+    LINK_AUDIO_SINK,
+    LINK_SUBTITLE_SINK,
+    PREPARE_TOTAL,
+    PIPELINE_START,
+    FIRST_AUDIO_FRAME,
+    FIRST_VIDEO_FRAME,
+    PHASE_BUTT,
+};
+
+/**
+ * Records the time spent in each phase of one player startup, from PrepareAsync to the first rendered frames.
+ * Only the first occurrence of a phase after Reset is kept, so track switches do not overwrite the startup values.
+ */
+class StartupTracer {
+public:
+    StartupTracer() = default;
+    ~StartupTracer() = default;
+
+    void Reset();
+    void BeginPhase(StartupPhase phase);
+    void EndPhase(StartupPhase phase);
+
+    void ToFormat(Format &format);
+    void AppendToMeta(const std::shared_ptr<Meta> &meta);
+    std::string ToString();
+
+private:
+    struct PhaseRecord {
+        int64_t beginUs = -1;
+        int64_t endUs = -1;
+    };
+
+    static int64_t GetNowUs();
+    static const char *GetPhaseName(size_t index);
+
+    std::mutex mutex_;
+    std::array<PhaseRecord, static_cast<size_t>(StartupPhase::PHASE_BUTT)> phases_ {};
+};
+
+class ScopedStartupPhase {
+public:
+    ScopedStartupPhase(StartupTracer &tracer, StartupPhase phase) : tracer_(tracer), phase_(phase)
+    {
+        tracer_.BeginPhase(phase_);
+    }
+    ~ScopedStartupPhase()
+    {
+        tracer_.EndPhase(phase_);
+    }
+
+private:
+    StartupTracer &tracer_;
+    StartupPhase phase_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // STARTUP_TRACER_H
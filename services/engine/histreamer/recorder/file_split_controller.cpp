@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "file_split_controller.h"
+#include <unistd.h>
+
+namespace OHOS {
+namespace Media {
+FileSplitController::~FileSplitController()
+{
+    Reset();
+}
+
+void FileSplitController::AddNextFd(int32_t fd)
+{
+    if (fd < 0) {
+        return;
+    }
+    nextFds_.push_back(fd);
+    isNoFdReported_ = false;
+}
+
+size_t FileSplitController::GetNextFdCount() const
+{
+    return nextFds_.size();
+}
+
+bool FileSplitController::Arm(int64_t nowMs, int64_t delayMs, int64_t periodMs)
+{
+    if (delayMs < 0 || periodMs < 0) {
+        return false;
+    }
+    int64_t baseMs = pausedAtMs_ >= 0 ? pausedAtMs_ : nowMs;
+    dueMs_ = baseMs + delayMs;
+    periodMs_ = periodMs;
+    isNoFdReported_ = false;
+    return true;
+}
+
+bool FileSplitController::IsArmed() const
+{
+    return dueMs_ >= 0;
+}
+
+int64_t FileSplitController::GetDelayMs(int64_t nowMs) const
+{
+    if (dueMs_ < 0 || pausedAtMs_ >= 0) {
+        return -1;
+    }
+    return dueMs_ > nowMs ? dueMs_ - nowMs : 0;
+}
+
+FileSplitAction FileSplitController::Poll(int64_t nowMs, int32_t &fd)
+{
+    fd = -1;
+    if (GetDelayMs(nowMs) != 0) {
+        return FileSplitAction::NONE;
+    }
+    if (nextFds_.empty()) {
+        // stay due, the split happens as soon as a file is added
+        if (isNoFdReported_) {
+            return FileSplitAction::NONE;
+        }
+        isNoFdReported_ = true;
+        return FileSplitAction::NO_NEXT_FD;
+    }
+    fd = nextFds_.front();
+    nextFds_.pop_front();
+    isNoFdReported_ = false;
+    if (periodMs_ > 0) {
+        // a boundary that was late because no file was ready does not shorten the following segment
+        dueMs_ = dueMs_ + periodMs_ > nowMs ? dueMs_ + periodMs_ : nowMs + periodMs_;
+    } else {
+        dueMs_ = -1;
+    }
+    return FileSplitAction::SWITCH;
+}
+
+void FileSplitController::Pause(int64_t nowMs)
+{
+    if (pausedAtMs_ < 0) {
+        pausedAtMs_ = nowMs;
+    }
+}
+
+void FileSplitController::Resume(int64_t nowMs)
+{
+    if (pausedAtMs_ < 0) {
+        return;
+    }
+    if (dueMs_ >= 0 && nowMs > pausedAtMs_) {
+        dueMs_ += nowMs - pausedAtMs_;
+    }
+    pausedAtMs_ = -1;
+}
+
+void FileSplitController::Reset()
+{
+    for (int32_t fd : nextFds_) {
+        (void)close(fd);
+    }
+    nextFds_.clear();
+    dueMs_ = -1;
+    periodMs_ = 0;
+    pausedAtMs_ = -1;
+    isNoFdReported_ = false;
+}
+} // namespace Media
+} // namespace OHOS
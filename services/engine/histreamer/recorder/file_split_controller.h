@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FILE_SPLIT_CONTROLLER_H
+#define FILE_SPLIT_CONTROLLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace OHOS {
+namespace Media {
+enum class FileSplitAction {
+    NONE,
+    // the split is due and an output file is ready, the muxer moves over to it
+    SWITCH,
+    // the split is due but no next output file was registered, reported once per boundary
+    NO_NEXT_FD,
+};
+
+/**
+ * Decides when a running recording rolls over to the next pre-registered output file. Time is recording time,
+ * the span the recorder spent paused is not counted towards a boundary. Not thread safe, the owner serializes
+ * the calls.
+ */
+class FileSplitController {
+public:
+    FileSplitController() = default;
+    ~FileSplitController();
+
+    // takes ownership of fd, files are used in the order they were added
+    void AddNextFd(int32_t fd);
+    size_t GetNextFdCount() const;
+    // first boundary after delayMs, then every periodMs if it is positive
+    bool Arm(int64_t nowMs, int64_t delayMs, int64_t periodMs);
+    bool IsArmed() const;
+    // ms until the next boundary, 0 if it is due, -1 if nothing is armed or the recorder is paused
+    int64_t GetDelayMs(int64_t nowMs) const;
+    // on SWITCH fd receives the next output file and the caller owns it
+    FileSplitAction Poll(int64_t nowMs, int32_t &fd);
+    void Pause(int64_t nowMs);
+    void Resume(int64_t nowMs);
+    // disarms and closes every output file not handed out yet
+    void Reset();
+
+private:
+    std::deque<int32_t> nextFds_;
+    int64_t dueMs_ = -1;
+    int64_t periodMs_ = 0;
+    int64_t pausedAtMs_ = -1;
+    bool isNoFdReported_ = false;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // FILE_SPLIT_CONTROLLER_H
@@ -16,11 +16,15 @@
 #include "meta/audio_types.h"
 #include "osal/task/pipeline_threadpool.h"
 #include "sync_fence.h"
+#include "mp4_fragment_scanner.h"
+#include "osal/utils/steady_clock.h"
 #include <sys/syscall.h>
 #include "media_dfx.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_CORE, LOG_DOMAIN_RECORDER, "HiRecorder" };
+constexpr int64_t MS_TO_US = 1000;
+constexpr int32_t DEFAULT_PRE_CACHE_MAX_BYTES = 64 * 1024 * 1024;
 }
 
 namespace OHOS {
@@ -90,7 +94,10 @@ HiRecorderImpl::HiRecorderImpl(int32_t appUid, int32_t appPid, uint32_t appToken
 
 HiRecorderImpl::~HiRecorderImpl()
 {
+    softStopEnabled_ = false;
     Stop(false);
+    ReleaseWarmEncoders();
+    CloseOutputFile(false);
     PipeLineThreadPool::GetInstance().DestroyThread(recorderId_);
 }
 
@@ -266,8 +273,13 @@ int32_t HiRecorderImpl::Configure(int32_t sourceId, const RecorderParam &recPara
         case RecorderPublicParamType::GEO_LOCATION:
         case RecorderPublicParamType::GENRE_INFO:
         case RecorderPublicParamType::CUSTOM_INFO:
+        case RecorderPublicParamType::PRE_CACHE:
             ConfigureMuxer(recParam);
             break;
+        case RecorderPublicParamType::SOFT_STOP:
+        case RecorderPublicParamType::WARM_RESTART:
+            ConfigureWarmRestart(recParam);
+            break;
         case RecorderPublicParamType::META_MIME_TYPE:
         case RecorderPublicParamType::META_TIMED_KEY:
         case RecorderPublicParamType::META_SOURCE_TRACK_MIME:
@@ -289,6 +301,10 @@ sptr<Surface> HiRecorderImpl::GetSurface(int32_t sourceId)
     MEDIA_LOG_I("GetSurface enter.");
     if (videoEncoderFilter_) {
         producerSurface_ = videoEncoderFilter_->GetInputSurface();
+        // the relay only exists once SetWatermark created it, recordings without a watermark feed the encoder
+        if (watermarkRelay_ != nullptr) {
+            producerSurface_ = watermarkRelay_->GetInputSurface();
+        }
     }
     if (videoCaptureFilter_) {
         producerSurface_ = videoCaptureFilter_->GetInputSurface();
@@ -326,8 +342,21 @@ int32_t HiRecorderImpl::Prepare()
 {
     MediaTrace trace("HiRecorderImpl::Prepare");
     MEDIA_LOG_I("Prepare enter.");
-    FALSE_RETURN_V_MSG_E(lseek(fd_, 0, SEEK_CUR) != -1,
+    // with the pre-cache on, a recording without an output file only fills the cache
+    bool isCacheOnly = fd_ < 0 && preCacheDurationMs_ > 0;
+    FALSE_RETURN_V_MSG_E(isCacheOnly || lseek(fd_, 0, SEEK_CUR) != -1,
         (int32_t)Status::ERROR_UNKNOWN, "The fd is invalid.");
+    int64_t prepareStartMs = SteadyClock::GetCurrentTimeMs();
+    bool isWarmRestart = reuseWarmEncoders_ && videoEncoderFilter_ != nullptr;
+    if (hasWarmEncoders_ && !isWarmRestart) {
+        ReleaseWarmEncoders();
+        // with a video source this recording's Configure already set the mime type of the new encoder
+        if (videoCount_ == 0) {
+            codecMimeType_ = "";
+        }
+    }
+    hasWarmEncoders_ = false;
+    reuseWarmEncoders_ = false;
 
     if (audioCaptureFilter_) {
         audioEncFormat_->Set<Tag::APP_TOKEN_ID>(appTokenId_);
@@ -348,7 +377,7 @@ int32_t HiRecorderImpl::Prepare()
         audioEncFormat_->Set<Tag::AUDIO_SAMPLE_FORMAT>(Plugins::AudioSampleFormat::SAMPLE_S16LE);
         audioDataSourceFilter_->Init(recorderEventReceiver_, recorderCallback_);
     }
-    if (videoEncoderFilter_) {
+    if (videoEncoderFilter_ && !isWarmRestart) {
         if (videoSourceIsRGBA_) {
             videoEncFormat_->Set<Tag::VIDEO_PIXEL_FORMAT>(Plugins::VideoPixelFormat::RGBA);
         }
@@ -373,6 +402,8 @@ int32_t HiRecorderImpl::Prepare()
     if (ret != Status::OK) {
         return (int32_t)ret;
     }
+    MEDIA_LOG_I("Prepare done in " PUBLIC_LOG_D64 " ms, warm restart " PUBLIC_LOG_D32,
+        SteadyClock::GetCurrentTimeMs() - prepareStartMs, static_cast<int32_t>(isWarmRestart));
     return (int32_t)ret;
 }
 
@@ -396,12 +427,15 @@ int32_t HiRecorderImpl::Pause()
 {
     MediaTrace trace("HiRecorderImpl::Pause");
     MEDIA_LOG_I("Pause enter.");
+    // a file split pauses and resumes the pipeline itself, the two must not interleave
+    std::lock_guard<std::mutex> lock(splitMutex_);
     Status ret = Status::OK;
     if (curState_ != StateId::READY) {
         ret = pipeline_->Pause();
     }
     if (ret == Status::OK) {
         OnStateChanged(StateId::PAUSE);
+        fileSplitController_.Pause(SteadyClock::GetCurrentTimeMs());
     }
     return (int32_t)ret;
 }
@@ -410,10 +444,14 @@ int32_t HiRecorderImpl::Resume()
 {
     MediaTrace trace("HiRecorderImpl::Resume");
     MEDIA_LOG_I("Resume enter.");
+    std::lock_guard<std::mutex> lock(splitMutex_);
     Status ret = Status::OK;
     ret = pipeline_->Resume();
     if (ret == Status::OK) {
         OnStateChanged(StateId::RECORDING);
+        int64_t nowMs = SteadyClock::GetCurrentTimeMs();
+        fileSplitController_.Resume(nowMs);
+        ScheduleFileSplitCheck(fileSplitController_.GetDelayMs(nowMs));
     }
     return (int32_t)ret;
 }
@@ -427,6 +465,8 @@ int32_t HiRecorderImpl::Stop(bool isDrainAll)
         return static_cast<int32_t>(Status::OK);
     }
     Status ret = Status::OK;
+    bool isInterrupted = curState_ == StateId::ERROR;
+    StopFileSplit();
     outputFormatType_ = OutputFormatType::FORMAT_BUTT;
     if (audioCaptureFilter_) {
         ret = audioCaptureFilter_->SendEos();
@@ -435,13 +475,34 @@ int32_t HiRecorderImpl::Stop(bool isDrainAll)
     if (ret == Status::OK) {
         OnStateChanged(StateId::INIT);
     }
+    CloseOutputFile(isInterrupted || ret != Status::OK);
+    // the stopped encoder keeps its configuration and input surface, only the link to this muxer goes
+    bool keepEncoders = softStopEnabled_ && !isInterrupted && ret == Status::OK && videoEncoderFilter_ != nullptr;
+    std::shared_ptr<Pipeline::Filter> muxerInput = preCacheFilter_;
+    if (muxerInput == nullptr) {
+        muxerInput = muxerFilter_;
+    }
+    if (keepEncoders && muxerInput != nullptr) {
+        videoEncoderFilter_->UnLinkNext(muxerInput, Pipeline::StreamType::STREAMTYPE_ENCODED_VIDEO);
+    }
+    hasWarmEncoders_ = keepEncoders;
+    MEDIA_LOG_I("Stop keeps warm encoders " PUBLIC_LOG_D32, static_cast<int32_t>(keepEncoders));
     audioCount_ = 0;
     videoCount_ = 0;
     audioSourceId_ = 0;
     videoSourceId_ = 0;
     muxerFilter_ = nullptr;
-    isWatermarkSupported_ = false;
-    codecMimeType_ = "";
+    muxerLinks_.clear();
+    if (preCacheFilter_ != nullptr) {
+        preCacheFilter_->ClearCache();
+        preCacheFilter_ = nullptr;
+    }
+    preCacheDurationMs_ = 0;
+    preCacheMaxBytes_ = 0;
+    if (!keepEncoders) {
+        codecMimeType_ = "";
+        ReleaseWarmEncoders();
+    }
     if (audioCaptureFilter_) {
         pipeline_->RemoveHeadFilter(audioCaptureFilter_);
     }
@@ -466,13 +527,24 @@ int32_t HiRecorderImpl::Reset()
 {
     MediaTrace trace("HiRecorderImpl::Reset");
     MEDIA_LOG_I("Reset enter.");
-    return Stop(false);
+    softStopEnabled_ = false;
+    int32_t ret = Stop(false);
+    ReleaseWarmEncoders();
+    return ret;
 }
 
 int32_t HiRecorderImpl::SetParameter(int32_t sourceId, const RecorderParam &recParam)
 {
     MEDIA_LOG_I("SetParameter enter.");
-    return Configure(sourceId, recParam);
+    // these are taken while recording and must not move the state back to RECORDING_SETTING like Configure does
+    switch (recParam.type) {
+        case RecorderPublicParamType::NEXT_OUT_FD:
+            return AddNextOutputFile(static_cast<const NextOutFd&>(recParam).fd);
+        case RecorderPublicParamType::FILE_SPLIT:
+            return ScheduleFileSplit(static_cast<const FileSplit&>(recParam));
+        default:
+            return Configure(sourceId, recParam);
+    }
 }
 
 void HiRecorderImpl::OnEvent(const Event &event)
@@ -523,32 +595,15 @@ Status HiRecorderImpl::OnCallback(std::shared_ptr<Pipeline::Filter> filter, cons
                 pipeline_->LinkFilters(filter, {audioEncoderFilter_}, outType);
                 break;
             case Pipeline::StreamType::STREAMTYPE_ENCODED_AUDIO:
-                if (muxerFilter_ == nullptr) {
-                    muxerFilter_ = Pipeline::FilterFactory::Instance().CreateFilter<Pipeline::MuxerFilter>
-                        ("muxerFilter", Pipeline::FilterType::FILTERTYPE_MUXER);
-                    muxerFilter_->SetCallingInfo(appUid_, appPid_, bundleName_, instanceId_);
-                    muxerFilter_->Init(recorderEventReceiver_, recorderCallback_);
-                    muxerFilter_->SetOutputParameter(appUid_, appPid_, fd_, outputFormatType_);
-                    muxerFilter_->SetParameter(muxerFormat_);
-                    muxerFilter_->SetUserMeta(userMeta_);
-                    close(fd_);
-                    fd_ = -1;
-                }
-                pipeline_->LinkFilters(filter, {muxerFilter_}, outType);
-                break;
             case Pipeline::StreamType::STREAMTYPE_ENCODED_VIDEO:
-                if (muxerFilter_ == nullptr) {
-                    muxerFilter_ = Pipeline::FilterFactory::Instance().CreateFilter<Pipeline::MuxerFilter>
-                        ("muxerFilter", Pipeline::FilterType::FILTERTYPE_MUXER);
-                    muxerFilter_->SetCallingInfo(appUid_, appPid_, bundleName_, instanceId_);
-                    muxerFilter_->Init(recorderEventReceiver_, recorderCallback_);
-                    muxerFilter_->SetOutputParameter(appUid_, appPid_, fd_, outputFormatType_);
-                    muxerFilter_->SetParameter(muxerFormat_);
-                    muxerFilter_->SetUserMeta(userMeta_);
+                if (muxerFilter_ == nullptr && fd_ >= 0) {
+                    muxerFilter_ = CreateMuxerFilter(fd_);
                     close(fd_);
                     fd_ = -1;
                 }
-                pipeline_->LinkFilters(filter, {muxerFilter_}, outType);
+                pipeline_->LinkFilters(filter, {GetMuxerInputFilter()}, outType);
+                // a file split relinks exactly these to the next muxer
+                muxerLinks_.emplace_back(filter, outType);
                 break;
             default:
                 break;
@@ -557,6 +612,19 @@ Status HiRecorderImpl::OnCallback(std::shared_ptr<Pipeline::Filter> filter, cons
     return Status::OK;
 }
 
+std::shared_ptr<Pipeline::MuxerFilter> HiRecorderImpl::CreateMuxerFilter(int32_t fd)
+{
+    auto muxerFilter = Pipeline::FilterFactory::Instance().CreateFilter<Pipeline::MuxerFilter>
+        ("muxerFilter", Pipeline::FilterType::FILTERTYPE_MUXER);
+    muxerFilter->SetCallingInfo(appUid_, appPid_, bundleName_, instanceId_);
+    muxerFilter->Init(recorderEventReceiver_, recorderCallback_);
+    // the muxer dups fd, the caller keeps its own
+    muxerFilter->SetOutputParameter(appUid_, appPid_, fd, outputFormatType_);
+    muxerFilter->SetParameter(muxerFormat_);
+    muxerFilter->SetUserMeta(userMeta_);
+    return muxerFilter;
+}
+
 void HiRecorderImpl::OnAudioCaptureChange(const AudioStandard::AudioCapturerChangeInfo &capturerChangeInfo)
 {
     MEDIA_LOG_I("OnAudioCaptureChange enter.");
@@ -797,6 +865,11 @@ void HiRecorderImpl::ConfigureMuxer(const RecorderParam &recParam)
         case RecorderPublicParamType::OUT_FD: {
             OutFd outFd = static_cast<const OutFd&>(recParam);
             fd_ = dup(outFd.fd);
+            if (outputFd_ >= 0) {
+                close(outputFd_);
+            }
+            // kept after the muxer took fd_, an interrupted fragmented file is cut back through it
+            outputFd_ = dup(outFd.fd);
             muxerFormat_->Set<Tag::MEDIA_CREATION_TIME>("now");
             MEDIA_LOG_I("ConfigureMuxer enter " PUBLIC_LOG_D32, fd_);
             break;
@@ -834,6 +907,14 @@ void HiRecorderImpl::ConfigureMuxer(const RecorderParam &recParam)
             muxerFormat_->SetData("genre", genreInfo.genre);
             break;
         }
+        case RecorderPublicParamType::PRE_CACHE: {
+            PreCache preCache = static_cast<const PreCache&>(recParam);
+            preCacheDurationMs_ = preCache.duration;
+            preCacheMaxBytes_ = preCache.maxBytes > 0 ? preCache.maxBytes : DEFAULT_PRE_CACHE_MAX_BYTES;
+            MEDIA_LOG_I("pre-cache " PUBLIC_LOG_D32 " ms, at most " PUBLIC_LOG_D32 " bytes",
+                preCacheDurationMs_, preCacheMaxBytes_);
+            break;
+        }
         default:
             break;
     }
@@ -966,6 +1047,11 @@ int32_t HiRecorderImpl::IsWatermarkSupported(bool &isWatermarkSupported)
     }
     codecCapabilityAdapter_->Init();
     Status ret = codecCapabilityAdapter_->IsWatermarkSupported(codecMimeType_, isWatermarkSupported);
+    if (ret == Status::OK && !isWatermarkSupported && videoEncoderFilter_ != nullptr) {
+        MEDIA_LOG_I("encoder can not overlay the watermark, blend it in software");
+        isSoftwareWatermark_ = true;
+        isWatermarkSupported = true;
+    }
     return static_cast<int32_t>(ret);
 }
 
@@ -973,7 +1059,255 @@ int32_t HiRecorderImpl::SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer)
 {
     FALSE_RETURN_V_MSG_E(videoEncoderFilter_ != nullptr, static_cast<int32_t>(Status::ERROR_NULL_POINTER),
         "videoEncoderFilter is nullptr, cannot set watermark");
-    return static_cast<int32_t>(videoEncoderFilter_->SetWatermark(waterMarkBuffer));
+    if (!isSoftwareWatermark_) {
+        return static_cast<int32_t>(videoEncoderFilter_->SetWatermark(waterMarkBuffer));
+    }
+    if (watermarkRelay_ == nullptr) {
+        // frames already go straight to the encoder surface, they can not be routed through the relay any more
+        FALSE_RETURN_V_MSG_E(producerSurface_ == nullptr, static_cast<int32_t>(Status::ERROR_INVALID_OPERATION),
+            "input surface is in use, set the watermark before getting the input surface");
+        Status ret = CreateWatermarkRelay();
+        FALSE_RETURN_V(ret == Status::OK, static_cast<int32_t>(ret));
+    }
+    return static_cast<int32_t>(watermarkRelay_->SetWatermark(waterMarkBuffer));
+}
+
+void HiRecorderImpl::ConfigureWarmRestart(const RecorderParam &recParam)
+{
+    if (recParam.type == RecorderPublicParamType::SOFT_STOP) {
+        softStopEnabled_ = static_cast<const SoftStop&>(recParam).enable;
+        MEDIA_LOG_I("soft stop " PUBLIC_LOG_D32, static_cast<int32_t>(softStopEnabled_));
+        return;
+    }
+    reuseWarmEncoders_ = hasWarmEncoders_ && static_cast<const WarmRestart&>(recParam).reuse;
+    MEDIA_LOG_I("reuse warm encoders " PUBLIC_LOG_D32, static_cast<int32_t>(reuseWarmEncoders_));
+}
+
+void HiRecorderImpl::ReleaseWarmEncoders()
+{
+    hasWarmEncoders_ = false;
+    reuseWarmEncoders_ = false;
+    // the watermark answers were cached for the released encoder, the next query asks the codec again
+    isWatermarkSupported_ = false;
+    isSoftwareWatermark_ = false;
+    if (watermarkRelay_ != nullptr) {
+        watermarkRelay_->Release();
+        watermarkRelay_ = nullptr;
+    }
+    producerSurface_ = nullptr;
+}
+
+std::shared_ptr<Pipeline::Filter> HiRecorderImpl::GetMuxerInputFilter()
+{
+    if (preCacheDurationMs_ <= 0) {
+        return muxerFilter_;
+    }
+    if (preCacheFilter_ == nullptr) {
+        preCacheFilter_ = std::make_shared<PreCacheFilter>("preCacheFilter", muxerFilter_,
+            static_cast<int64_t>(preCacheDurationMs_) * MS_TO_US, static_cast<uint64_t>(preCacheMaxBytes_));
+        preCacheFilter_->Init(recorderEventReceiver_, recorderCallback_);
+    }
+    return preCacheFilter_;
+}
+
+int32_t HiRecorderImpl::SavePreCache(int32_t fd, int32_t duration)
+{
+    MediaTrace trace("HiRecorderImpl::SavePreCache");
+    MEDIA_LOG_I("SavePreCache enter, duration " PUBLIC_LOG_D32 " ms", duration);
+    FALSE_RETURN_V_MSG_E(curState_ == StateId::RECORDING || curState_ == StateId::PAUSE,
+        (int32_t)Status::ERROR_WRONG_STATE, "not recording");
+    FALSE_RETURN_V_MSG_E(preCacheFilter_ != nullptr, (int32_t)Status::ERROR_INVALID_OPERATION,
+        "pre-cache is not enabled");
+    FALSE_RETURN_V_MSG_E(fd >= 0 && duration > 0, (int32_t)Status::ERROR_INVALID_PARAMETER, "invalid fd or duration");
+    Plugins::OutputFormat format = outputFormatType_ == OutputFormatType::FORMAT_M4A ?
+        Plugins::OutputFormat::M4A : Plugins::OutputFormat::MPEG_4;
+    return (int32_t)preCacheFilter_->SaveTo(fd, static_cast<int64_t>(duration) * MS_TO_US, format);
+}
+
+void HiRecorderImpl::CloseOutputFile(bool isInterrupted)
+{
+    if (outputFd_ < 0) {
+        return;
+    }
+    if (isInterrupted) {
+        // a fragmented file keeps every fragment written before the recording broke off, the one being written is
+        // incomplete and players stop at the last whole one, any other file is left as it is
+        int64_t trimmed = Mp4FragmentScanner::TrimToPlayable(outputFd_);
+        MEDIA_LOG_I("interrupted recording, trimmed " PUBLIC_LOG_D64 " bytes", trimmed);
+    }
+    close(outputFd_);
+    outputFd_ = -1;
+}
+
+int32_t HiRecorderImpl::AddNextOutputFile(int32_t fd)
+{
+    int32_t nextFd = dup(fd);
+    FALSE_RETURN_V_MSG_E(nextFd >= 0, (int32_t)Status::ERROR_INVALID_PARAMETER, "dup next output file failed");
+    std::lock_guard<std::mutex> lock(splitMutex_);
+    fileSplitController_.AddNextFd(nextFd);
+    MEDIA_LOG_I("next output file added, " PUBLIC_LOG_U32 " waiting",
+        static_cast<uint32_t>(fileSplitController_.GetNextFdCount()));
+    // a boundary that passed while no file was waiting is taken right away
+    ScheduleFileSplitCheck(fileSplitController_.GetDelayMs(SteadyClock::GetCurrentTimeMs()));
+    return (int32_t)Status::OK;
+}
+
+int32_t HiRecorderImpl::ScheduleFileSplit(const FileSplit &fileSplit)
+{
+    FALSE_RETURN_V_MSG_E(curState_ == StateId::RECORDING || curState_ == StateId::PAUSE,
+        (int32_t)Status::ERROR_INVALID_OPERATION, "file split needs a started recording");
+    FALSE_RETURN_V_MSG_E(muxerFilter_ != nullptr, (int32_t)Status::ERROR_INVALID_OPERATION, "muxer is nullptr");
+    // frames from before the call are already in the current file, a backward split can not move them
+    FALSE_RETURN_V_MSG_E(fileSplit.type == FileSplitType::FILE_SPLIT_POST ||
+        fileSplit.type == FileSplitType::FILE_SPLIT_NORMAL, (int32_t)Status::ERROR_INVALID_PARAMETER,
+        "unsupported file split type " PUBLIC_LOG_D32, static_cast<int32_t>(fileSplit.type));
+    MEDIA_LOG_I("file split type " PUBLIC_LOG_D32 ", timestamp " PUBLIC_LOG_D64 ", duration " PUBLIC_LOG_U32,
+        static_cast<int32_t>(fileSplit.type), fileSplit.timestamp, fileSplit.duration);
+
+    // POST rolls over once after duration, NORMAL keeps rolling over every duration until Stop
+    int64_t durationMs = static_cast<int64_t>(fileSplit.duration);
+    int64_t periodMs = fileSplit.type == FileSplitType::FILE_SPLIT_NORMAL ? durationMs : 0;
+    std::lock_guard<std::mutex> lock(splitMutex_);
+    int64_t nowMs = SteadyClock::GetCurrentTimeMs();
+    FALSE_RETURN_V(fileSplitController_.Arm(nowMs, durationMs, periodMs), (int32_t)Status::ERROR_INVALID_PARAMETER);
+    ScheduleFileSplitCheck(fileSplitController_.GetDelayMs(nowMs));
+    return (int32_t)Status::OK;
+}
+
+void HiRecorderImpl::ScheduleFileSplitCheck(int64_t delayMs)
+{
+    if (delayMs < 0) {
+        return;
+    }
+    int64_t checkAtMs = SteadyClock::GetCurrentTimeMs() + delayMs;
+    if (splitCheckAtMs_ >= 0 && splitCheckAtMs_ <= checkAtMs) {
+        return;
+    }
+    if (splitTask_ == nullptr) {
+        splitTask_ = std::make_unique<Task>("FileSplit", recorderId_, TaskType::GLOBAL, TaskPriority::NORMAL, false);
+        splitTask_->Start();
+    }
+    splitCheckAtMs_ = checkAtMs;
+    splitTask_->SubmitJob([this] { CheckFileSplit(); }, delayMs * MS_TO_US);
+}
+
+void HiRecorderImpl::CheckFileSplit()
+{
+    std::lock_guard<std::mutex> lock(splitMutex_);
+    int64_t nowMs = SteadyClock::GetCurrentTimeMs();
+    if (nowMs >= splitCheckAtMs_) {
+        splitCheckAtMs_ = -1;
+    }
+    int32_t fd = -1;
+    FileSplitAction action = fileSplitController_.Poll(nowMs, fd);
+    if (action == FileSplitAction::SWITCH) {
+        SwitchOutputFile(fd);
+    } else if (action == FileSplitAction::NO_NEXT_FD) {
+        MEDIA_LOG_W("file split is due but no next output file is set");
+        auto ptr = obs_.lock();
+        if (ptr != nullptr) {
+            ptr->OnInfo(IRecorderEngineObs::InfoType::NEXT_FILE_FD_NOT_SET, 0);
+        }
+    }
+    ScheduleFileSplitCheck(fileSplitController_.GetDelayMs(nowMs));
+}
+
+void HiRecorderImpl::SwitchOutputFile(int32_t fd)
+{
+    MediaTrace trace("HiRecorderImpl::SwitchOutputFile");
+    // splitMutex_ is held, so Pause and Resume wait until the rollover is done
+    if (curState_ != StateId::RECORDING || muxerFilter_ == nullptr) {
+        MEDIA_LOG_W("not recording, the output file is not switched");
+        close(fd);
+        return;
+    }
+    Status ret = RollOverMuxer(fd);
+    if (ret != Status::OK) {
+        // the encoders are left without a muxer or a paused pipeline, the recording can not go on
+        OnEvent({"hirecorder", EventType::EVENT_ERROR, ret});
+        return;
+    }
+    MEDIA_LOG_I("output switched to the next file, " PUBLIC_LOG_U32 " left",
+        static_cast<uint32_t>(fileSplitController_.GetNextFdCount()));
+
+    auto ptr = obs_.lock();
+    if (ptr != nullptr) {
+        ptr->OnInfo(IRecorderEngineObs::InfoType::NEXT_OUTPUT_FILE_STARTED, 0);
+        if (!fileSplitController_.IsArmed()) {
+            ptr->OnInfo(IRecorderEngineObs::InfoType::FILE_SPLIT_FINISHED, 0);
+        }
+    }
+}
+
+Status HiRecorderImpl::RollOverMuxer(int32_t fd)
+{
+    // nothing is encoded while the pipeline is paused, so the current file ends on a whole frame and the first
+    // frame encoded after the resume is the first frame of the next one
+    Status ret = pipeline_->Pause();
+    if (ret != Status::OK) {
+        close(fd);
+        MEDIA_LOG_E("pause for the file split failed");
+        return ret;
+    }
+    std::shared_ptr<Pipeline::Filter> muxerInput = GetMuxerInputFilter();
+    for (const auto &link : muxerLinks_) {
+        link.first->UnLinkNext(muxerInput, link.second);
+    }
+    // stopping writes the index, the finished file is complete once this returns
+    if (muxerFilter_->Stop() != Status::OK) {
+        MEDIA_LOG_W("stopping the muxer of the finished file failed");
+    }
+    CloseOutputFile(false);
+    // kept like the first output, an interrupted fragmented file is cut back through it
+    outputFd_ = fd;
+    muxerFilter_ = CreateMuxerFilter(fd);
+    if (preCacheFilter_ != nullptr) {
+        // the cache stays in front of the muxer and keeps what it holds across the boundary
+        preCacheFilter_->SetNextFilter(muxerFilter_);
+    }
+    muxerInput = GetMuxerInputFilter();
+    for (const auto &link : muxerLinks_) {
+        ret = pipeline_->LinkFilters(link.first, {muxerInput}, link.second);
+        FALSE_RETURN_V_MSG_E(ret == Status::OK, ret, "relink stream type " PUBLIC_LOG_D32 " failed",
+            static_cast<int32_t>(link.second));
+    }
+    ret = muxerFilter_->Prepare();
+    FALSE_RETURN_V_MSG_E(ret == Status::OK, ret, "prepare the next muxer failed");
+    ret = muxerFilter_->Start();
+    FALSE_RETURN_V_MSG_E(ret == Status::OK, ret, "start the next muxer failed");
+    // a file has to start with a key frame, an encoded source can not be asked for one and the muxer waits for it
+    if (videoEncoderFilter_ != nullptr) {
+        auto keyFrameRequest = std::make_shared<Meta>();
+        keyFrameRequest->Set<Tag::VIDEO_REQUEST_I_FRAME>(true);
+        videoEncoderFilter_->SetParameter(keyFrameRequest);
+    }
+    return pipeline_->Resume();
+}
+
+void HiRecorderImpl::StopFileSplit()
+{
+    std::unique_ptr<Task> splitTask;
+    {
+        std::lock_guard<std::mutex> lock(splitMutex_);
+        fileSplitController_.Reset();
+        splitCheckAtMs_ = -1;
+        splitTask = std::move(splitTask_);
+    }
+    // outside the lock, a check that is running right now needs it to finish
+    if (splitTask != nullptr) {
+        splitTask->Stop();
+    }
+}
+
+Status HiRecorderImpl::CreateWatermarkRelay()
+{
+    sptr<Surface> encoderSurface = videoEncoderFilter_->GetInputSurface();
+    FALSE_RETURN_V_MSG_E(encoderSurface != nullptr, Status::ERROR_NULL_POINTER, "encoder input surface is nullptr");
+    auto relay = std::make_shared<WatermarkSurfaceRelay>(encoderSurface);
+    Status ret = relay->Init();
+    FALSE_RETURN_V_MSG_E(ret == Status::OK, ret, "software watermark init failed");
+    watermarkRelay_ = relay;
+    return Status::OK;
 }
 } // namespace MEDIA
 } // namespace OHOS
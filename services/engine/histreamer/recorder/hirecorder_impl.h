@@ -34,6 +34,9 @@
 #include "surface_encoder_filter.h"
 #include "video_capture_filter.h"
 #include "codec_capability_adapter.h"
+#include "file_split_controller.h"
+#include "pre_cache_filter.h"
+#include "watermark_surface_relay.h"
 
 namespace OHOS {
 namespace Media {
@@ -82,6 +85,7 @@ public:
     void SetCallingInfo(const std::string &bundleName, uint64_t instanceId);
     int32_t IsWatermarkSupported(bool &isWatermarkSupported);
     int32_t SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer);
+    int32_t SavePreCache(int32_t fd, int32_t duration);
 
 private:
     void ConfigureAudioCapture();
@@ -89,6 +93,8 @@ private:
     void ConfigureVideo(const RecorderParam &recParam);
     void ConfigureMeta(int32_t sourceId, const RecorderParam &recParam);
     void ConfigureMuxer(const RecorderParam &recParam);
+    void ConfigureWarmRestart(const RecorderParam &recParam);
+    void ReleaseWarmEncoders();
     bool CheckParamType(int32_t sourceId, const RecorderParam &recParam);
     void OnStateChanged(StateId state);
     void ConfigureVideoEncoderFormat(const RecorderParam &recParam);
@@ -96,6 +102,17 @@ private:
     bool CheckAudioSourceType(AudioSourceType sourceType);
     void ConfigureRotation(const RecorderParam &recParam);
     int32_t PrepareMeta();
+    Status CreateWatermarkRelay();
+    void CloseOutputFile(bool isInterrupted);
+    int32_t AddNextOutputFile(int32_t fd);
+    int32_t ScheduleFileSplit(const FileSplit &fileSplit);
+    void ScheduleFileSplitCheck(int64_t delayMs);
+    void CheckFileSplit();
+    void SwitchOutputFile(int32_t fd);
+    Status RollOverMuxer(int32_t fd);
+    std::shared_ptr<Pipeline::MuxerFilter> CreateMuxerFilter(int32_t fd);
+    void StopFileSplit();
+    std::shared_ptr<Pipeline::Filter> GetMuxerInputFilter();
     EncoderCapabilityData ConvertAudioEncoderInfo(MediaAVCodec::CapabilityData *capabilityData);
     EncoderCapabilityData ConvertVideoEncoderInfo(MediaAVCodec::CapabilityData *capabilityData);
     std::vector<EncoderCapabilityData> ConvertEncoderInfo(std::vector<MediaAVCodec::CapabilityData*> &capData);
@@ -117,6 +134,8 @@ private:
     std::shared_ptr<Pipeline::SurfaceEncoderFilter> videoEncoderFilter_;
     std::shared_ptr<Pipeline::VideoCaptureFilter> videoCaptureFilter_;
     std::shared_ptr<Pipeline::MuxerFilter> muxerFilter_;
+    // every filter linked to the muxer input and the stream type of the link
+    std::vector<std::pair<std::shared_ptr<Pipeline::Filter>, Pipeline::StreamType>> muxerLinks_;
     std::shared_ptr<Pipeline::CodecCapabilityAdapter> codecCapabilityAdapter_;
 
     std::shared_ptr<Pipeline::EventReceiver> recorderEventReceiver_;
@@ -137,10 +156,28 @@ private:
     int32_t fd_ = -1;
     int64_t maxDuration_ = 0;
     int64_t maxSize_ = 0;
+    int32_t outputFd_ = -1;
 
     bool videoSourceIsYuv_ = false;
     bool videoSourceIsRGBA_ = false;
     bool isWatermarkSupported_ = false;
+    // the encoder can not overlay the watermark, frames are blended by watermarkRelay_ before encoding
+    bool isSoftwareWatermark_ = false;
+    std::shared_ptr<WatermarkSurfaceRelay> watermarkRelay_ = nullptr;
+
+    std::mutex splitMutex_;
+    FileSplitController fileSplitController_;
+    std::unique_ptr<Task> splitTask_;
+    int64_t splitCheckAtMs_ = -1;
+
+    int32_t preCacheDurationMs_ = 0;
+    int32_t preCacheMaxBytes_ = 0;
+    std::shared_ptr<PreCacheFilter> preCacheFilter_ = nullptr;
+
+    // a soft stop keeps the video encoder and its input surface for the next recording
+    bool softStopEnabled_ = false;
+    bool hasWarmEncoders_ = false;
+    bool reuseWarmEncoders_ = false;
 
     Mutex stateMutex_ {};
     ConditionVariable cond_ {};
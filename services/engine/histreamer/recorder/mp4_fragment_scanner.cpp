@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mp4_fragment_scanner.h"
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+constexpr uint32_t BOX_HEADER_SIZE = 8;
+constexpr uint32_t LARGE_BOX_HEADER_SIZE = 16;
+constexpr uint32_t BYTE_BITS = 8;
+
+constexpr uint32_t FourCc(const char (&name)[5]) // 5: four characters and the terminator
+{
+    return (static_cast<uint32_t>(static_cast<uint8_t>(name[0])) << 24) | // 24: first byte
+        (static_cast<uint32_t>(static_cast<uint8_t>(name[1])) << 16) | // 16: second byte
+        (static_cast<uint32_t>(static_cast<uint8_t>(name[2])) << 8) | // 2, 8: third byte
+        static_cast<uint32_t>(static_cast<uint8_t>(name[3])); // 3: last byte
+}
+
+constexpr uint32_t BOX_MOOV = FourCc("moov");
+constexpr uint32_t BOX_MVEX = FourCc("mvex");
+constexpr uint32_t BOX_MOOF = FourCc("moof");
+constexpr uint32_t BOX_MDAT = FourCc("mdat");
+
+uint64_t ReadBigEndian(const uint8_t *data, size_t size)
+{
+    uint64_t value = 0;
+    for (size_t index = 0; index < size; index++) {
+        value = (value << BYTE_BITS) | data[index];
+    }
+    return value;
+}
+}
+
+namespace OHOS {
+namespace Media {
+bool Mp4FragmentScanner::ReadBoxHeader(const ReadFunc &read, uint64_t offset, uint64_t end, BoxHeader &box)
+{
+    uint8_t header[LARGE_BOX_HEADER_SIZE] = { 0 };
+    if (end < offset || end - offset < BOX_HEADER_SIZE || !read(offset, header, BOX_HEADER_SIZE)) {
+        return false;
+    }
+    box.offset = offset;
+    box.size = ReadBigEndian(header, sizeof(uint32_t));
+    box.type = static_cast<uint32_t>(ReadBigEndian(header + sizeof(uint32_t), sizeof(uint32_t)));
+    box.headerSize = BOX_HEADER_SIZE;
+    box.isOpenEnded = false;
+    if (box.size == 1) {
+        if (end - offset < LARGE_BOX_HEADER_SIZE ||
+            !read(offset + BOX_HEADER_SIZE, header + BOX_HEADER_SIZE, sizeof(uint64_t))) {
+            return false;
+        }
+        box.size = ReadBigEndian(header + BOX_HEADER_SIZE, sizeof(uint64_t));
+        box.headerSize = LARGE_BOX_HEADER_SIZE;
+    } else if (box.size == 0) {
+        // the box runs to the end of the file, a muxer that was killed before patching the size leaves this
+        box.size = end - offset;
+        box.isOpenEnded = true;
+    }
+    return box.size >= box.headerSize;
+}
+
+bool Mp4FragmentScanner::HasChild(const ReadFunc &read, const BoxHeader &parent, uint32_t type)
+{
+    uint64_t end = parent.offset + parent.size;
+    uint64_t offset = parent.offset + parent.headerSize;
+    BoxHeader child;
+    while (ReadBoxHeader(read, offset, end, child) && child.size <= end - offset) {
+        if (child.type == type) {
+            return true;
+        }
+        offset += child.size;
+    }
+    return false;
+}
+
+bool Mp4FragmentScanner::Scan(const ReadFunc &read, uint64_t fileSize, Mp4FragmentLayout &layout)
+{
+    layout = Mp4FragmentLayout();
+    uint64_t offset = 0;
+    uint64_t pendingMoof = 0;
+    bool hasPendingMoof = false;
+    BoxHeader box;
+    while (ReadBoxHeader(read, offset, fileSize, box)) {
+        if (box.size > fileSize - offset || box.isOpenEnded) {
+            // truncated box, or one whose size was never patched, so how much of it was written is unknown,
+            // everything from here on is lost
+            break;
+        }
+        uint64_t boxEnd = offset + box.size;
+        if (box.type == BOX_MOOV) {
+            layout.isFragmented = HasChild(read, box, BOX_MVEX);
+            layout.initSegmentEnd = boxEnd;
+            layout.playableSize = boxEnd;
+        } else if (box.type == BOX_MOOF) {
+            pendingMoof = offset;
+            hasPendingMoof = true;
+        } else if (box.type == BOX_MDAT && hasPendingMoof && layout.initSegmentEnd != 0) {
+            layout.fragments.emplace_back(pendingMoof, boxEnd);
+            layout.playableSize = boxEnd;
+            hasPendingMoof = false;
+        }
+        offset = boxEnd;
+    }
+    return layout.isFragmented;
+}
+
+int64_t Mp4FragmentScanner::TrimToPlayable(int32_t fd)
+{
+    struct stat fileStat;
+    if (fd < 0 || fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+        return -1;
+    }
+    int32_t flags = fcntl(fd, F_GETFL);
+    if (flags == -1) {
+        return -1;
+    }
+    // recordings are usually handed over write only, the headers are read through a second open of the same file
+    int32_t readFd = fd;
+    if ((static_cast<uint32_t>(flags) & O_ACCMODE) == O_WRONLY) {
+        std::string path = "/proc/self/fd/" + std::to_string(fd);
+        readFd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (readFd < 0) {
+            return -1;
+        }
+    }
+    auto read = [readFd](uint64_t offset, uint8_t *data, size_t size) {
+        return pread(readFd, data, size, static_cast<off_t>(offset)) == static_cast<ssize_t>(size);
+    };
+    uint64_t fileSize = static_cast<uint64_t>(fileStat.st_size);
+    Mp4FragmentLayout layout;
+    bool isFragmented = Scan(read, fileSize, layout);
+    if (readFd != fd) {
+        close(readFd);
+    }
+    if (!isFragmented || layout.playableSize == 0) {
+        return -1;
+    }
+    if (layout.playableSize == fileSize) {
+        return 0;
+    }
+    if (ftruncate(fd, static_cast<off_t>(layout.playableSize)) != 0) {
+        return -1;
+    }
+    return static_cast<int64_t>(fileSize - layout.playableSize);
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MP4_FRAGMENT_SCANNER_H
+#define MP4_FRAGMENT_SCANNER_H
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+namespace Media {
+struct Mp4FragmentLayout {
+    // the moov carries an mvex, so samples live in moof/mdat fragments
+    bool isFragmented = false;
+    uint64_t initSegmentEnd = 0;
+    // [moof offset, end of its mdat) of every fragment that is fully on disk
+    std::vector<std::pair<uint64_t, uint64_t>> fragments;
+    // end of the last complete fragment, or of the init segment, a player can read everything before it
+    uint64_t playableSize = 0;
+};
+
+/**
+ * Walks the top level boxes of a fragmented mp4 reading only their headers, so it costs one small read per box
+ * whatever the length of the recording. Used to cut a recording that was interrupted in the middle of a fragment
+ * back to its last complete fragment.
+ */
+class Mp4FragmentScanner {
+public:
+    using ReadFunc = std::function<bool(uint64_t offset, uint8_t *data, size_t size)>;
+
+    static bool Scan(const ReadFunc &read, uint64_t fileSize, Mp4FragmentLayout &layout);
+    // returns the number of bytes cut from the end of the file, or -1 if it is not a fragmented mp4, fd may be
+    // opened write only
+    static int64_t TrimToPlayable(int32_t fd);
+
+private:
+    struct BoxHeader {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint32_t type = 0;
+        uint32_t headerSize = 0;
+        // size 0, the box runs to the end of the file
+        bool isOpenEnded = false;
+    };
+
+    static bool ReadBoxHeader(const ReadFunc &read, uint64_t offset, uint64_t end, BoxHeader &box);
+    static bool HasChild(const ReadFunc &read, const BoxHeader &parent, uint32_t type);
+};
+} // namespace Media
+} // namespace OHOS
+#endif // MP4_FRAGMENT_SCANNER_H
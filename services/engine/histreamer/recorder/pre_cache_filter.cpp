@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pre_cache_filter.h"
+#include <limits>
+#include "avcodec_errors.h"
+#include "avmuxer.h"
+#include "common/log.h"
+#include "media_dfx.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_CORE, LOG_DOMAIN_RECORDER, "PreCacheFilter" };
+}
+
+namespace OHOS {
+namespace Media {
+PreCacheFilter::PreCacheFilter(const std::string &name, const std::shared_ptr<Pipeline::Filter> &nextFilter,
+    int64_t maxDurationUs, uint64_t maxBytes)
+    : BufferObserverFilter(name, Pipeline::FilterType::FILTERTYPE_MUXER, nextFilter), ring_(maxDurationUs, maxBytes)
+{
+    MEDIA_LOG_I("PreCacheFilter ctor called, max duration " PUBLIC_LOG_D64 " us", maxDurationUs);
+}
+
+PreCacheFilter::~PreCacheFilter()
+{
+    MEDIA_LOG_I("~PreCacheFilter dtor called.");
+}
+
+void PreCacheFilter::OnStreamMeta(Pipeline::StreamType inType, const std::shared_ptr<Meta> &meta)
+{
+    int32_t trackId = static_cast<int32_t>(inType);
+    std::lock_guard<std::mutex> lock(mutex_);
+    trackMetas_[trackId] = meta;
+    if (inType == Pipeline::StreamType::STREAMTYPE_ENCODED_VIDEO) {
+        ring_.SetAnchorTrack(trackId);
+    }
+}
+
+void PreCacheFilter::OnBufferObserved(Pipeline::StreamType inType, const std::shared_ptr<AVBuffer> &buffer)
+{
+    FALSE_RETURN(buffer->memory_ != nullptr);
+    const uint8_t *data = buffer->memory_->GetAddr();
+    int32_t size = buffer->memory_->GetSize();
+    FALSE_RETURN(data != nullptr && size > 0);
+    // the copy runs on the encoder output thread without the lock, SaveTo and the other tracks only wait for the
+    // ring bookkeeping
+    bool isKeyFrame = (buffer->flag_ & static_cast<uint32_t>(AVBufferFlag::SYNC_FRAME)) != 0;
+    auto sample = PreCacheRing::CreateSample(static_cast<int32_t>(inType), buffer->pts_, isKeyFrame, data,
+        static_cast<size_t>(size), buffer->flag_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (buffer->flag_ & static_cast<uint32_t>(AVBufferFlag::CODEC_DATA)) {
+        ring_.SetCodecConfig(sample);
+        return;
+    }
+    ring_.Push(sample);
+}
+
+Status PreCacheFilter::SaveTo(int32_t fd, int64_t durationUs, Plugins::OutputFormat format)
+{
+    MediaTrace trace("PreCacheFilter::SaveTo");
+    std::vector<std::shared_ptr<const PreCacheSample>> samples;
+    std::map<int32_t, std::shared_ptr<Meta>> trackMetas;
+    {
+        // the ring hands out shared samples, muxing runs without holding up the encoders
+        std::lock_guard<std::mutex> lock(mutex_);
+        FALSE_RETURN_V_MSG_E(ring_.Collect(durationUs, samples), Status::ERROR_INVALID_OPERATION, "cache is empty");
+        trackMetas = trackMetas_;
+    }
+    auto muxer = MediaAVCodec::AVMuxerFactory::CreateAVMuxer(fd, format);
+    FALSE_RETURN_V_MSG_E(muxer != nullptr, Status::ERROR_UNKNOWN, "create muxer failed");
+    std::map<int32_t, int32_t> trackIndexes;
+    for (const auto &trackMeta : trackMetas) {
+        int32_t trackIndex = -1;
+        FALSE_RETURN_V_MSG_E(muxer->AddTrack(trackIndex, trackMeta.second) == MediaAVCodec::AVCS_ERR_OK,
+            Status::ERROR_UNKNOWN, "add track " PUBLIC_LOG_D32 " failed", trackMeta.first);
+        trackIndexes[trackMeta.first] = trackIndex;
+    }
+    FALSE_RETURN_V_MSG_E(muxer->Start() == MediaAVCodec::AVCS_ERR_OK, Status::ERROR_UNKNOWN, "start muxer failed");
+
+    // the saved file starts at zero whatever the recording time of its first sample was
+    int64_t basePtsUs = std::numeric_limits<int64_t>::max();
+    for (const auto &sample : samples) {
+        if ((sample->flags & static_cast<uint32_t>(AVBufferFlag::CODEC_DATA)) == 0 && sample->ptsUs < basePtsUs) {
+            basePtsUs = sample->ptsUs;
+        }
+    }
+    for (const auto &sample : samples) {
+        auto buffer = AVBuffer::CreateAVBuffer(const_cast<uint8_t *>(sample->data.data()),
+            static_cast<int32_t>(sample->data.size()), static_cast<int32_t>(sample->data.size()));
+        if (buffer == nullptr) {
+            continue;
+        }
+        auto trackIndex = trackIndexes.find(sample->trackId);
+        if (trackIndex == trackIndexes.end()) {
+            MEDIA_LOG_W("skip sample of unknown track " PUBLIC_LOG_D32, sample->trackId);
+            continue;
+        }
+        bool isCodecData = (sample->flags & static_cast<uint32_t>(AVBufferFlag::CODEC_DATA)) != 0;
+        buffer->pts_ = isCodecData ? 0 : sample->ptsUs - basePtsUs;
+        buffer->flag_ = sample->flags;
+        int32_t ret = muxer->WriteSample(static_cast<uint32_t>(trackIndex->second), buffer);
+        if (ret != MediaAVCodec::AVCS_ERR_OK) {
+            MEDIA_LOG_W("write sample failed, track " PUBLIC_LOG_D32, sample->trackId);
+        }
+    }
+    FALSE_RETURN_V_MSG_E(muxer->Stop() == MediaAVCodec::AVCS_ERR_OK, Status::ERROR_UNKNOWN, "stop muxer failed");
+    MEDIA_LOG_I("saved " PUBLIC_LOG_U32 " cached samples", static_cast<uint32_t>(samples.size()));
+    return Status::OK;
+}
+
+void PreCacheFilter::ClearCache()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_.Clear();
+}
+} // namespace Media
+} // namespace OHOS
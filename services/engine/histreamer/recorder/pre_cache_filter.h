@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PRE_CACHE_FILTER_H
+#define PRE_CACHE_FILTER_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include "buffer_observer_filter.h"
+#include "meta/media_types.h"
+#include "pre_cache_ring.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Observes the muxer input queues and copies every access unit the encoders write there into a PreCacheRing, the
+ * regular output is untouched. SaveTo muxes the last seconds of the ring into another file.
+ * Without a muxer behind it the filter takes the encoder output itself, so the ring also fills when no output file
+ * is recorded.
+ */
+class PreCacheFilter : public BufferObserverFilter {
+public:
+    PreCacheFilter(const std::string &name, const std::shared_ptr<Pipeline::Filter> &nextFilter,
+        int64_t maxDurationUs, uint64_t maxBytes);
+    ~PreCacheFilter() override;
+
+    Status SaveTo(int32_t fd, int64_t durationUs, Plugins::OutputFormat format);
+    void ClearCache();
+
+protected:
+    void OnStreamMeta(Pipeline::StreamType inType, const std::shared_ptr<Meta> &meta) override;
+    void OnBufferObserved(Pipeline::StreamType inType, const std::shared_ptr<AVBuffer> &buffer) override;
+
+private:
+    std::mutex mutex_;
+    PreCacheRing ring_;
+    // keyed by the sample track id, which is the stream type the track was linked with
+    std::map<int32_t, std::shared_ptr<Meta>> trackMetas_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // PRE_CACHE_FILTER_H
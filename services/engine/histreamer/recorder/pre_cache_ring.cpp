@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pre_cache_ring.h"
+
+namespace OHOS {
+namespace Media {
+PreCacheRing::PreCacheRing(int64_t maxDurationUs, uint64_t maxBytes)
+    : maxDurationUs_(maxDurationUs), maxBytes_(maxBytes)
+{
+}
+
+void PreCacheRing::SetAnchorTrack(int32_t trackId)
+{
+    anchorTrackId_ = trackId;
+}
+
+std::shared_ptr<const PreCacheSample> PreCacheRing::CreateSample(int32_t trackId, int64_t ptsUs, bool isKeyFrame,
+    const uint8_t *data, size_t size, uint32_t flags)
+{
+    if (data == nullptr || size == 0) {
+        return nullptr;
+    }
+    auto sample = std::make_shared<PreCacheSample>();
+    sample->trackId = trackId;
+    sample->ptsUs = ptsUs;
+    sample->flags = flags;
+    sample->isKeyFrame = isKeyFrame;
+    sample->data.assign(data, data + size);
+    return sample;
+}
+
+void PreCacheRing::SetCodecConfig(int32_t trackId, const uint8_t *data, size_t size, uint32_t flags)
+{
+    SetCodecConfig(CreateSample(trackId, 0, false, data, size, flags));
+}
+
+void PreCacheRing::SetCodecConfig(const std::shared_ptr<const PreCacheSample> &sample)
+{
+    if (sample == nullptr || sample->data.empty()) {
+        return;
+    }
+    codecConfigs_[sample->trackId] = sample;
+}
+
+bool PreCacheRing::IsAnchor(const PreCacheSample &sample) const
+{
+    return anchorTrackId_ < 0 || (sample.trackId == anchorTrackId_ && sample.isKeyFrame);
+}
+
+void PreCacheRing::Push(int32_t trackId, int64_t ptsUs, bool isKeyFrame, const uint8_t *data, size_t size,
+    uint32_t flags)
+{
+    if (data == nullptr || size == 0 || size > maxBytes_) {
+        return;
+    }
+    Push(CreateSample(trackId, ptsUs, isKeyFrame, data, size, flags));
+}
+
+void PreCacheRing::Push(const std::shared_ptr<const PreCacheSample> &sample)
+{
+    if (sample == nullptr || sample->data.empty() || sample->data.size() > maxBytes_) {
+        return;
+    }
+    bool isAnchor = IsAnchor(*sample);
+    if (samples_.empty() && !isAnchor) {
+        // nothing before the first key frame can be decoded
+        return;
+    }
+    if (isAnchor) {
+        anchors_.push_back(frontIndex_ + samples_.size());
+    }
+    bytes_ += sample->data.size();
+    newestPtsUs_ = samples_.empty() || sample->ptsUs > newestPtsUs_ ? sample->ptsUs : newestPtsUs_;
+    samples_.push_back(sample);
+    Trim();
+}
+
+void PreCacheRing::DropFirstGop()
+{
+    uint64_t end = anchors_.size() > 1 ? anchors_[1] : frontIndex_ + samples_.size();
+    while (frontIndex_ < end && !samples_.empty()) {
+        bytes_ -= samples_.front()->data.size();
+        samples_.pop_front();
+        frontIndex_++;
+    }
+    if (!anchors_.empty()) {
+        anchors_.pop_front();
+    }
+}
+
+void PreCacheRing::Trim()
+{
+    while (bytes_ > maxBytes_ && !samples_.empty()) {
+        DropFirstGop();
+    }
+    // the first group goes once the second one alone still covers the whole duration
+    while (anchors_.size() > 1) {
+        int64_t secondAnchorPtsUs = samples_[anchors_[1] - frontIndex_]->ptsUs;
+        if (newestPtsUs_ - secondAnchorPtsUs < maxDurationUs_) {
+            break;
+        }
+        DropFirstGop();
+    }
+}
+
+bool PreCacheRing::Collect(int64_t durationUs, std::vector<std::shared_ptr<const PreCacheSample>> &samples) const
+{
+    samples.clear();
+    if (samples_.empty() || anchors_.empty()) {
+        return false;
+    }
+    int64_t targetPtsUs = newestPtsUs_ - durationUs;
+    uint64_t start = anchors_.front();
+    for (auto it = anchors_.rbegin(); it != anchors_.rend(); ++it) {
+        if (samples_[*it - frontIndex_]->ptsUs <= targetPtsUs) {
+            start = *it;
+            break;
+        }
+    }
+    samples.reserve(codecConfigs_.size() + samples_.size() - (start - frontIndex_));
+    for (const auto &config : codecConfigs_) {
+        samples.push_back(config.second);
+    }
+    samples.insert(samples.end(), samples_.begin() + static_cast<std::ptrdiff_t>(start - frontIndex_),
+        samples_.end());
+    return true;
+}
+
+void PreCacheRing::Clear()
+{
+    samples_.clear();
+    anchors_.clear();
+    codecConfigs_.clear();
+    bytes_ = 0;
+    newestPtsUs_ = 0;
+    frontIndex_ = 0;
+}
+
+uint64_t PreCacheRing::GetBytes() const
+{
+    return bytes_;
+}
+
+int64_t PreCacheRing::GetDurationUs() const
+{
+    return samples_.empty() ? 0 : newestPtsUs_ - samples_.front()->ptsUs;
+}
+
+size_t PreCacheRing::GetSampleCount() const
+{
+    return samples_.size();
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PRE_CACHE_RING_H
+#define PRE_CACHE_RING_H
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace OHOS {
+namespace Media {
+struct PreCacheSample {
+    int32_t trackId = 0;
+    int64_t ptsUs = 0;
+    uint32_t flags = 0;
+    bool isKeyFrame = false;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * Bounded ring of encoded access units kept in memory. It always starts at a key frame of the anchor track (the
+ * video track, or any sample when there is none) and drops whole groups of pictures from the front, so whatever
+ * it holds can be muxed on its own. Not thread safe, the owner serializes the calls.
+ */
+class PreCacheRing {
+public:
+    PreCacheRing(int64_t maxDurationUs, uint64_t maxBytes);
+
+    void SetAnchorTrack(int32_t trackId);
+    // copies data into a sample that can be handed to the ring later, so the copy can run outside the owner's lock
+    static std::shared_ptr<const PreCacheSample> CreateSample(int32_t trackId, int64_t ptsUs, bool isKeyFrame,
+        const uint8_t *data, size_t size, uint32_t flags);
+
+    // codec specific data is kept apart from the ring and never evicted
+    void SetCodecConfig(int32_t trackId, const uint8_t *data, size_t size, uint32_t flags);
+    void SetCodecConfig(const std::shared_ptr<const PreCacheSample> &sample);
+    void Push(int32_t trackId, int64_t ptsUs, bool isKeyFrame, const uint8_t *data, size_t size, uint32_t flags);
+    void Push(const std::shared_ptr<const PreCacheSample> &sample);
+    // codec configs first, then every sample from the last anchor at or before (newest pts - durationUs)
+    bool Collect(int64_t durationUs, std::vector<std::shared_ptr<const PreCacheSample>> &samples) const;
+    void Clear();
+
+    uint64_t GetBytes() const;
+    int64_t GetDurationUs() const;
+    size_t GetSampleCount() const;
+
+private:
+    bool IsAnchor(const PreCacheSample &sample) const;
+    void DropFirstGop();
+    void Trim();
+
+    int64_t maxDurationUs_ = 0;
+    uint64_t maxBytes_ = 0;
+    int32_t anchorTrackId_ = -1;
+    uint64_t bytes_ = 0;
+    int64_t newestPtsUs_ = 0;
+    std::deque<std::shared_ptr<const PreCacheSample>> samples_;
+    // positions are counted from the first sample ever pushed, so dropping from the front does not move them
+    std::deque<uint64_t> anchors_;
+    uint64_t frontIndex_ = 0;
+    std::map<int32_t, std::shared_ptr<const PreCacheSample>> codecConfigs_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // PRE_CACHE_RING_H
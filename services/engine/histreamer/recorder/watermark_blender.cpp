@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "watermark_blender.h"
+#include <algorithm>
+#include <climits>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+constexpr int32_t RGBA_PIXEL_SIZE = 4;
+constexpr int32_t RGBA_ALPHA_INDEX = 3;
+constexpr int32_t CHROMA_BLOCK = 2;
+constexpr int32_t BLOCK_PIXEL_COUNT = CHROMA_BLOCK * CHROMA_BLOCK;
+constexpr int32_t SIMD_WIDTH = 16;
+constexpr uint32_t MAX_VALUE = 255;
+constexpr uint32_t ROUND_VALUE = 128;
+constexpr uint32_t DIV_SHIFT = 8;
+
+// BT.601 limited range, the matrix the encoders assume for RGBA input
+inline int32_t RgbToY(int32_t r, int32_t g, int32_t b)
+{
+    return ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16; // 66, 129, 25, 128, 8, 16: BT.601 coefficients
+}
+
+inline int32_t RgbToU(int32_t r, int32_t g, int32_t b)
+{
+    return ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128; // -38, -74, 112, 128, 8: BT.601 coefficients
+}
+
+inline int32_t RgbToV(int32_t r, int32_t g, int32_t b)
+{
+    return ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128; // 112, -94, -18, 128, 8: BT.601 coefficients
+}
+
+// exact rounded x / 255 for x in [0, 255 * 255]
+inline uint8_t DivideBy255(uint32_t value)
+{
+    value += ROUND_VALUE;
+    return static_cast<uint8_t>((value + (value >> DIV_SHIFT)) >> DIV_SHIFT);
+}
+}
+
+namespace OHOS {
+namespace Media {
+bool WatermarkBlender::SetWatermark(const uint8_t *pixels, int32_t stride, int32_t width, int32_t height,
+    const WatermarkRect &rect)
+{
+    Reset();
+    if (pixels == nullptr || rect.left < 0 || rect.top < 0 || rect.width <= 0 || rect.height <= 0 ||
+        rect.width > width || rect.height > height) {
+        return false;
+    }
+    // the rect comes from the client, byte offsets up to its far edge must still fit the int32 plane geometry
+    int64_t rightBytes = (static_cast<int64_t>(rect.left) + rect.width) * RGBA_PIXEL_SIZE;
+    int64_t bottom = static_cast<int64_t>(rect.top) + rect.height;
+    if (static_cast<int64_t>(stride) < static_cast<int64_t>(rect.width) * RGBA_PIXEL_SIZE ||
+        rightBytes > INT32_MAX || bottom > INT32_MAX) {
+        return false;
+    }
+    rect_ = rect;
+    PrepareRgba(pixels, stride);
+    PrepareNv12(pixels, stride);
+    isEnabled_ = true;
+    return true;
+}
+
+void WatermarkBlender::Reset()
+{
+    rect_ = WatermarkRect();
+    rgba_ = Plane();
+    luma_ = Plane();
+    chroma_ = Plane();
+    isEnabled_ = false;
+}
+
+bool WatermarkBlender::IsEnabled() const
+{
+    return isEnabled_;
+}
+
+void WatermarkBlender::PrepareRgba(const uint8_t *pixels, int32_t stride)
+{
+    rgba_.left = rect_.left * RGBA_PIXEL_SIZE;
+    rgba_.top = rect_.top;
+    rgba_.width = rect_.width * RGBA_PIXEL_SIZE;
+    rgba_.height = rect_.height;
+    rgba_.src.resize(static_cast<size_t>(rgba_.width) * rgba_.height);
+    rgba_.alpha.resize(rgba_.src.size());
+    for (int32_t y = 0; y < rect_.height; y++) {
+        const uint8_t *srcRow = pixels + static_cast<size_t>(y) * stride;
+        uint8_t *dstRow = rgba_.src.data() + static_cast<size_t>(y) * rgba_.width;
+        uint8_t *alphaRow = rgba_.alpha.data() + static_cast<size_t>(y) * rgba_.width;
+        for (int32_t x = 0; x < rgba_.width; x += RGBA_PIXEL_SIZE) {
+            uint8_t alpha = srcRow[x + RGBA_ALPHA_INDEX];
+            for (int32_t channel = 0; channel < RGBA_ALPHA_INDEX; channel++) {
+                dstRow[x + channel] = srcRow[x + channel];
+                alphaRow[x + channel] = alpha;
+            }
+            // the alpha of the frame itself is kept
+            dstRow[x + RGBA_ALPHA_INDEX] = 0;
+            alphaRow[x + RGBA_ALPHA_INDEX] = 0;
+        }
+    }
+}
+
+void WatermarkBlender::PrepareNv12(const uint8_t *pixels, int32_t stride)
+{
+    luma_.left = rect_.left;
+    luma_.top = rect_.top;
+    luma_.width = rect_.width;
+    luma_.height = rect_.height;
+    luma_.src.resize(static_cast<size_t>(luma_.width) * luma_.height);
+    luma_.alpha.resize(luma_.src.size());
+    for (int32_t y = 0; y < rect_.height; y++) {
+        const uint8_t *srcRow = pixels + static_cast<size_t>(y) * stride;
+        for (int32_t x = 0; x < rect_.width; x++) {
+            const uint8_t *pixel = srcRow + x * RGBA_PIXEL_SIZE;
+            size_t index = static_cast<size_t>(y) * luma_.width + x;
+            luma_.src[index] = static_cast<uint8_t>(RgbToY(pixel[0], pixel[1], pixel[2])); // 0, 1, 2: r, g, b
+            luma_.alpha[index] = pixel[RGBA_ALPHA_INDEX];
+        }
+    }
+
+    // one interleaved UV pair per 2x2 block, blocks the watermark only partly covers get a partial alpha
+    int32_t blockLeft = rect_.left / CHROMA_BLOCK;
+    int32_t blockTop = rect_.top / CHROMA_BLOCK;
+    int32_t blockCols = (rect_.left + rect_.width - 1) / CHROMA_BLOCK - blockLeft + 1;
+    int32_t blockRows = (rect_.top + rect_.height - 1) / CHROMA_BLOCK - blockTop + 1;
+    chroma_.left = blockLeft * CHROMA_BLOCK;
+    chroma_.top = blockTop;
+    chroma_.width = blockCols * CHROMA_BLOCK;
+    chroma_.height = blockRows;
+    chroma_.src.assign(static_cast<size_t>(chroma_.width) * chroma_.height, 0);
+    chroma_.alpha.assign(chroma_.src.size(), 0);
+    for (int32_t by = 0; by < blockRows; by++) {
+        for (int32_t bx = 0; bx < blockCols; bx++) {
+            uint32_t sumAlpha = 0;
+            uint32_t sumU = 0;
+            uint32_t sumV = 0;
+            for (int32_t dy = 0; dy < CHROMA_BLOCK; dy++) {
+                int32_t y = (blockTop + by) * CHROMA_BLOCK + dy - rect_.top;
+                for (int32_t dx = 0; dx < CHROMA_BLOCK; dx++) {
+                    int32_t x = (blockLeft + bx) * CHROMA_BLOCK + dx - rect_.left;
+                    if (x < 0 || x >= rect_.width || y < 0 || y >= rect_.height) {
+                        continue;
+                    }
+                    const uint8_t *pixel = pixels + static_cast<size_t>(y) * stride + x * RGBA_PIXEL_SIZE;
+                    uint32_t alpha = pixel[RGBA_ALPHA_INDEX];
+                    sumAlpha += alpha;
+                    sumU += alpha * static_cast<uint32_t>(RgbToU(pixel[0], pixel[1], pixel[2])); // 0, 1, 2: r, g, b
+                    sumV += alpha * static_cast<uint32_t>(RgbToV(pixel[0], pixel[1], pixel[2])); // 0, 1, 2: r, g, b
+                }
+            }
+            if (sumAlpha == 0) {
+                continue;
+            }
+            size_t index = static_cast<size_t>(by) * chroma_.width + bx * CHROMA_BLOCK;
+            chroma_.src[index] = static_cast<uint8_t>((sumU + sumAlpha / 2) / sumAlpha); // 2: round
+            chroma_.src[index + 1] = static_cast<uint8_t>((sumV + sumAlpha / 2) / sumAlpha); // 2: round
+            uint8_t alpha = static_cast<uint8_t>((sumAlpha + BLOCK_PIXEL_COUNT / 2) / BLOCK_PIXEL_COUNT); // 2: round
+            chroma_.alpha[index] = alpha;
+            chroma_.alpha[index + 1] = alpha;
+        }
+    }
+}
+
+void WatermarkBlender::BlendRgba(uint8_t *frame, int32_t stride, int32_t width, int32_t height) const
+{
+    if (!isEnabled_ || frame == nullptr) {
+        return;
+    }
+    BlendPlane(rgba_, frame, stride, width * RGBA_PIXEL_SIZE, height);
+}
+
+void WatermarkBlender::BlendNv12(uint8_t *yPlane, int32_t yStride, uint8_t *uvPlane, int32_t uvStride,
+    int32_t width, int32_t height) const
+{
+    if (!isEnabled_ || yPlane == nullptr || uvPlane == nullptr) {
+        return;
+    }
+    BlendPlane(luma_, yPlane, yStride, width, height);
+    BlendPlane(chroma_, uvPlane, uvStride, (width + 1) / CHROMA_BLOCK * CHROMA_BLOCK,
+        (height + 1) / CHROMA_BLOCK);
+}
+
+void WatermarkBlender::BlendPlane(const Plane &plane, uint8_t *addr, int32_t stride, int32_t widthBytes,
+    int32_t height)
+{
+    // the part of the watermark outside the frame is clipped
+    int32_t cols = std::min(plane.width, widthBytes - plane.left);
+    int32_t rows = std::min(plane.height, height - plane.top);
+    if (cols <= 0 || rows <= 0) {
+        return;
+    }
+    for (int32_t y = 0; y < rows; y++) {
+        size_t offset = static_cast<size_t>(y) * plane.width;
+        BlendRow(addr + static_cast<size_t>(plane.top + y) * stride + plane.left, plane.src.data() + offset,
+            plane.alpha.data() + offset, cols);
+    }
+}
+
+void WatermarkBlender::BlendRow(uint8_t *dst, const uint8_t *src, const uint8_t *alpha, int32_t count)
+{
+    int32_t index = 0;
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const uint16x8_t round = vdupq_n_u16(ROUND_VALUE);
+    for (; index + SIMD_WIDTH <= count; index += SIMD_WIDTH) {
+        uint8x16_t srcVec = vld1q_u8(src + index);
+        uint8x16_t alphaVec = vld1q_u8(alpha + index);
+        uint8x16_t dstVec = vld1q_u8(dst + index);
+        uint8x16_t invAlpha = vmvnq_u8(alphaVec);
+        uint16x8_t low = vmull_u8(vget_low_u8(srcVec), vget_low_u8(alphaVec));
+        low = vmlal_u8(low, vget_low_u8(dstVec), vget_low_u8(invAlpha));
+        uint16x8_t high = vmull_u8(vget_high_u8(srcVec), vget_high_u8(alphaVec));
+        high = vmlal_u8(high, vget_high_u8(dstVec), vget_high_u8(invAlpha));
+        low = vaddq_u16(low, round);
+        high = vaddq_u16(high, round);
+        low = vaddq_u16(low, vshrq_n_u16(low, DIV_SHIFT));
+        high = vaddq_u16(high, vshrq_n_u16(high, DIV_SHIFT));
+        vst1q_u8(dst + index, vcombine_u8(vshrn_n_u16(low, DIV_SHIFT), vshrn_n_u16(high, DIV_SHIFT)));
+    }
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i maxValue = _mm_set1_epi16(MAX_VALUE);
+    const __m128i round = _mm_set1_epi16(ROUND_VALUE);
+    auto blendHalf = [&](__m128i srcHalf, __m128i alphaHalf, __m128i dstHalf) {
+        __m128i sum = _mm_add_epi16(_mm_mullo_epi16(srcHalf, alphaHalf),
+            _mm_mullo_epi16(dstHalf, _mm_sub_epi16(maxValue, alphaHalf)));
+        sum = _mm_add_epi16(sum, round);
+        sum = _mm_add_epi16(sum, _mm_srli_epi16(sum, DIV_SHIFT));
+        return _mm_srli_epi16(sum, DIV_SHIFT);
+    };
+    for (; index + SIMD_WIDTH <= count; index += SIMD_WIDTH) {
+        __m128i srcVec = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + index));
+        __m128i alphaVec = _mm_loadu_si128(reinterpret_cast<const __m128i *>(alpha + index));
+        __m128i dstVec = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + index));
+        __m128i low = blendHalf(_mm_unpacklo_epi8(srcVec, zero), _mm_unpacklo_epi8(alphaVec, zero),
+            _mm_unpacklo_epi8(dstVec, zero));
+        __m128i high = blendHalf(_mm_unpackhi_epi8(srcVec, zero), _mm_unpackhi_epi8(alphaVec, zero),
+            _mm_unpackhi_epi8(dstVec, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + index), _mm_packus_epi16(low, high));
+    }
+#endif
+    for (; index < count; index++) {
+        uint32_t a = alpha[index];
+        dst[index] = DivideBy255(src[index] * a + dst[index] * (MAX_VALUE - a));
+    }
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WATERMARK_BLENDER_H
+#define WATERMARK_BLENDER_H
+
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace Media {
+struct WatermarkRect {
+    int32_t left = 0;
+    int32_t top = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+};
+
+/**
+ * Software watermark for encoders that can not overlay one themselves. The RGBA watermark is converted once to
+ * per byte source and alpha rows for RGBA frames and for the Y and UV planes of NV12 frames, so blending a frame
+ * is one kernel over the rows the watermark covers and its cost follows the watermark area, not the frame size.
+ */
+class WatermarkBlender {
+public:
+    WatermarkBlender() = default;
+    ~WatermarkBlender() = default;
+
+    // pixels are a width x height RGBA 8888 image with straight alpha, rect is where its top left part sits in the
+    // frame and must not be bigger than the image
+    bool SetWatermark(const uint8_t *pixels, int32_t stride, int32_t width, int32_t height,
+        const WatermarkRect &rect);
+    void Reset();
+    bool IsEnabled() const;
+
+    void BlendRgba(uint8_t *frame, int32_t stride, int32_t width, int32_t height) const;
+    void BlendNv12(uint8_t *yPlane, int32_t yStride, uint8_t *uvPlane, int32_t uvStride, int32_t width,
+        int32_t height) const;
+
+    // dst = (src * alpha + dst * (255 - alpha)) / 255 rounded, vectorized where the target has SIMD
+    static void BlendRow(uint8_t *dst, const uint8_t *src, const uint8_t *alpha, int32_t count);
+
+private:
+    struct Plane {
+        std::vector<uint8_t> src;
+        std::vector<uint8_t> alpha;
+        int32_t left = 0;
+        int32_t top = 0;
+        int32_t width = 0; // in bytes
+        int32_t height = 0;
+    };
+
+    void PrepareRgba(const uint8_t *pixels, int32_t stride);
+    void PrepareNv12(const uint8_t *pixels, int32_t stride);
+    static void BlendPlane(const Plane &plane, uint8_t *addr, int32_t stride, int32_t widthBytes, int32_t height);
+
+    WatermarkRect rect_;
+    Plane rgba_;
+    Plane luma_;
+    Plane chroma_;
+    bool isEnabled_ = false;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // WATERMARK_BLENDER_H
@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "watermark_surface_relay.h"
+#include "common/log.h"
+#include "media_dfx.h"
+#include "meta/meta_key.h"
+#include "native_buffer.h"
+#include "sync_fence.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_CORE, LOG_DOMAIN_RECORDER, "HiRecorder" };
+constexpr int32_t NV12_UV_PLANE_INDEX = 1;
+}
+
+namespace OHOS {
+namespace Media {
+class WatermarkRelayListener : public IBufferConsumerListener {
+public:
+    explicit WatermarkRelayListener(std::weak_ptr<WatermarkSurfaceRelay> relay) : relay_(relay)
+    {
+    }
+
+    void OnBufferAvailable() override
+    {
+        auto relay = relay_.lock();
+        if (relay != nullptr) {
+            relay->OnBufferAvailable();
+        }
+    }
+
+private:
+    std::weak_ptr<WatermarkSurfaceRelay> relay_;
+};
+
+WatermarkSurfaceRelay::WatermarkSurfaceRelay(sptr<Surface> encoderSurface) : encoderSurface_(encoderSurface)
+{
+}
+
+WatermarkSurfaceRelay::~WatermarkSurfaceRelay()
+{
+    Release();
+}
+
+Status WatermarkSurfaceRelay::Init()
+{
+    MEDIA_LOG_I("WatermarkSurfaceRelay Init enter.");
+    FALSE_RETURN_V_MSG_E(encoderSurface_ != nullptr, Status::ERROR_NULL_POINTER, "encoder surface is nullptr");
+    sptr<Surface> consumer = Surface::CreateSurfaceAsConsumer("WatermarkRelay");
+    FALSE_RETURN_V_MSG_E(consumer != nullptr, Status::ERROR_NO_MEMORY, "CreateSurfaceAsConsumer failed");
+    consumer->SetDefaultWidthAndHeight(encoderSurface_->GetDefaultWidth(), encoderSurface_->GetDefaultHeight());
+    // the frame is blended by the cpu before the encoder reads it
+    consumer->SetDefaultUsage(encoderSurface_->GetDefaultUsage() | BUFFER_USAGE_CPU_READ | BUFFER_USAGE_CPU_WRITE);
+    consumer->SetQueueSize(encoderSurface_->GetQueueSize());
+    sptr<IBufferConsumerListener> listener =
+        new (std::nothrow) WatermarkRelayListener(std::weak_ptr<WatermarkSurfaceRelay>(shared_from_this()));
+    FALSE_RETURN_V_MSG_E(listener != nullptr, Status::ERROR_NO_MEMORY, "create listener failed");
+    FALSE_RETURN_V_MSG_E(consumer->RegisterConsumerListener(listener) == GSERROR_OK, Status::ERROR_UNKNOWN,
+        "RegisterConsumerListener failed");
+    sptr<Surface> producer = Surface::CreateSurfaceAsProducer(consumer->GetProducer());
+    FALSE_RETURN_V_MSG_E(producer != nullptr, Status::ERROR_NO_MEMORY, "CreateSurfaceAsProducer failed");
+
+    std::weak_ptr<WatermarkSurfaceRelay> weakRelay = shared_from_this();
+    GSError ret = encoderSurface_->RegisterReleaseListener([weakRelay](sptr<SurfaceBuffer> &buffer) {
+        (void)buffer;
+        auto relay = weakRelay.lock();
+        if (relay != nullptr) {
+            relay->ReturnBuffersToInput();
+        }
+        return GSERROR_OK;
+    });
+    FALSE_RETURN_V_MSG_E(ret == GSERROR_OK, Status::ERROR_UNKNOWN, "RegisterReleaseListener failed");
+
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    inputConsumer_ = consumer;
+    inputSurface_ = producer;
+    return Status::OK;
+}
+
+sptr<Surface> WatermarkSurfaceRelay::GetInputSurface()
+{
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    return inputSurface_;
+}
+
+Status WatermarkSurfaceRelay::SetWatermark(const std::shared_ptr<AVBuffer> &waterMarkBuffer)
+{
+    FALSE_RETURN_V_MSG_E(waterMarkBuffer != nullptr && waterMarkBuffer->memory_ != nullptr &&
+        waterMarkBuffer->meta_ != nullptr, Status::ERROR_INVALID_PARAMETER, "invalid watermark buffer");
+    sptr<SurfaceBuffer> surfaceBuffer = waterMarkBuffer->memory_->GetSurfaceBuffer();
+    FALSE_RETURN_V_MSG_E(surfaceBuffer != nullptr && surfaceBuffer->GetVirAddr() != nullptr,
+        Status::ERROR_INVALID_PARAMETER, "watermark has no pixels");
+    FALSE_RETURN_V_MSG_E(surfaceBuffer->GetFormat() == GraphicPixelFormat::GRAPHIC_PIXEL_FMT_RGBA_8888,
+        Status::ERROR_INVALID_PARAMETER, "watermark format " PUBLIC_LOG_D32 " is not RGBA 8888",
+        surfaceBuffer->GetFormat());
+    // the blender reads stride x height bytes, a buffer reporting more than it holds must not pass
+    FALSE_RETURN_V_MSG_E(surfaceBuffer->GetStride() > 0 && surfaceBuffer->GetHeight() > 0 &&
+        static_cast<uint64_t>(surfaceBuffer->GetStride()) * static_cast<uint64_t>(surfaceBuffer->GetHeight()) <=
+        surfaceBuffer->GetSize(), Status::ERROR_INVALID_PARAMETER, "watermark geometry exceeds its buffer");
+    bool isEnabled = true;
+    waterMarkBuffer->meta_->Get<Tag::VIDEO_ENCODER_ENABLE_WATERMARK>(isEnabled);
+    WatermarkRect rect;
+    FALSE_RETURN_V_MSG_E(waterMarkBuffer->meta_->Get<Tag::VIDEO_COORDINATE_X>(rect.left) &&
+        waterMarkBuffer->meta_->Get<Tag::VIDEO_COORDINATE_Y>(rect.top) &&
+        waterMarkBuffer->meta_->Get<Tag::VIDEO_COORDINATE_W>(rect.width) &&
+        waterMarkBuffer->meta_->Get<Tag::VIDEO_COORDINATE_H>(rect.height),
+        Status::ERROR_INVALID_PARAMETER, "watermark position is missing");
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!isEnabled) {
+        blender_.Reset();
+        return Status::OK;
+    }
+    // the rect is client meta, the blender rejects one bigger than the watermark buffer
+    FALSE_RETURN_V_MSG_E(blender_.SetWatermark(static_cast<const uint8_t *>(surfaceBuffer->GetVirAddr()),
+        surfaceBuffer->GetStride(), surfaceBuffer->GetWidth(), surfaceBuffer->GetHeight(), rect),
+        Status::ERROR_INVALID_PARAMETER, "invalid watermark, "
+        "x:" PUBLIC_LOG_D32 " y:" PUBLIC_LOG_D32 " w:" PUBLIC_LOG_D32 " h:" PUBLIC_LOG_D32,
+        rect.left, rect.top, rect.width, rect.height);
+    MEDIA_LOG_I("software watermark set, x:" PUBLIC_LOG_D32 " y:" PUBLIC_LOG_D32 " w:" PUBLIC_LOG_D32
+        " h:" PUBLIC_LOG_D32, rect.left, rect.top, rect.width, rect.height);
+    return Status::OK;
+}
+
+void WatermarkSurfaceRelay::Release()
+{
+    sptr<Surface> consumer = nullptr;
+    sptr<Surface> encoderSurface = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        consumer = inputConsumer_;
+        encoderSurface = encoderSurface_;
+        inputConsumer_ = nullptr;
+        inputSurface_ = nullptr;
+        encoderSurface_ = nullptr;
+        pendingReturnCount_ = 0;
+    }
+    if (consumer != nullptr) {
+        consumer->UnregisterConsumerListener();
+    }
+    if (encoderSurface != nullptr) {
+        encoderSurface->UnRegisterReleaseListener();
+    }
+}
+
+void WatermarkSurfaceRelay::OnBufferAvailable()
+{
+    MediaTrace trace("WatermarkSurfaceRelay::OnBufferAvailable");
+    sptr<Surface> consumer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        consumer = inputConsumer_;
+    }
+    FALSE_RETURN(consumer != nullptr);
+    int32_t flushFence = -1;
+    int64_t timestamp = 0;
+    OHOS::Rect damage;
+    sptr<SurfaceBuffer> buffer = nullptr;
+    GSError ret = consumer->AcquireBuffer(buffer, flushFence, timestamp, damage);
+    FALSE_RETURN_MSG(ret == GSERROR_OK && buffer != nullptr, "AcquireBuffer failed");
+    sptr<SyncFence> syncFence = new SyncFence(flushFence);
+    if (syncFence->Wait(FENCE_WAIT_MS) != 0) {
+        // the producer is still writing the frame, blending it now would race that write
+        MEDIA_LOG_W("input fence wait timeout, frame dropped");
+        consumer->ReleaseBuffer(buffer, -1);
+        return;
+    }
+
+    BlendFrame(buffer);
+    if (ForwardToEncoder(buffer, timestamp, damage)) {
+        ReturnBuffersToInput();
+    }
+}
+
+void WatermarkSurfaceRelay::BlendFrame(const sptr<SurfaceBuffer> &buffer)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint8_t *addr = static_cast<uint8_t *>(buffer->GetVirAddr());
+    if (!blender_.IsEnabled() || addr == nullptr) {
+        return;
+    }
+    bool isCached = (buffer->GetUsage() & BUFFER_USAGE_MEM_MMZ_CACHE) != 0;
+    if (isCached) {
+        buffer->InvalidateCache();
+    }
+    int32_t format = buffer->GetFormat();
+    if (format == GraphicPixelFormat::GRAPHIC_PIXEL_FMT_RGBA_8888) {
+        blender_.BlendRgba(addr, buffer->GetStride(), buffer->GetWidth(), buffer->GetHeight());
+    } else if (format == GraphicPixelFormat::GRAPHIC_PIXEL_FMT_YCBCR_420_SP) {
+        int32_t yStride = buffer->GetStride();
+        uint64_t uvOffset = static_cast<uint64_t>(yStride) * buffer->GetHeight();
+        int32_t uvStride = yStride;
+        OH_NativeBuffer_Planes *planes = nullptr;
+        if (buffer->GetPlanesInfo(reinterpret_cast<void **>(&planes)) == GSERROR_OK && planes != nullptr &&
+            planes->planeCount > NV12_UV_PLANE_INDEX) {
+            uvOffset = planes->planes[NV12_UV_PLANE_INDEX].offset;
+            uvStride = static_cast<int32_t>(planes->planes[NV12_UV_PLANE_INDEX].rowStride);
+        }
+        blender_.BlendNv12(addr, yStride, addr + uvOffset, uvStride, buffer->GetWidth(), buffer->GetHeight());
+    } else {
+        MEDIA_LOG_D("unsupported format " PUBLIC_LOG_D32 ", watermark skipped", format);
+        return;
+    }
+    if (isCached) {
+        buffer->FlushCache();
+    }
+}
+
+bool WatermarkSurfaceRelay::ForwardToEncoder(sptr<SurfaceBuffer> &buffer, int64_t timestamp,
+    const OHOS::Rect &damage)
+{
+    sptr<Surface> consumer = nullptr;
+    sptr<Surface> encoderSurface = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        consumer = inputConsumer_;
+        encoderSurface = encoderSurface_;
+    }
+    FALSE_RETURN_V(consumer != nullptr && encoderSurface != nullptr, false);
+    if (consumer->DetachBufferFromQueue(buffer) != GSERROR_OK) {
+        MEDIA_LOG_W("detach from input failed, frame dropped");
+        consumer->ReleaseBuffer(buffer, -1);
+        return false;
+    }
+    if (encoderSurface->AttachBufferToQueue(buffer) != GSERROR_OK) {
+        MEDIA_LOG_W("attach to encoder failed, frame dropped");
+        if (consumer->AttachBufferToQueue(buffer) == GSERROR_OK) {
+            consumer->ReleaseBuffer(buffer, -1);
+        }
+        return false;
+    }
+    {
+        // the input queue is now one buffer short, a free one of the encoder queue goes back for it
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        returnConfig_ = {
+            .width = buffer->GetWidth(),
+            .height = buffer->GetHeight(),
+            .strideAlignment = 0x8,
+            .format = buffer->GetFormat(),
+            .usage = buffer->GetUsage(),
+            .timeout = 0,
+        };
+        pendingReturnCount_++;
+    }
+    BufferFlushConfig flushConfig = {
+        .damage = {
+            .x = damage.x,
+            .y = damage.y,
+            .w = damage.w,
+            .h = damage.h,
+        },
+        .timestamp = timestamp,
+    };
+    if (encoderSurface->FlushBuffer(buffer, -1, flushConfig) != GSERROR_OK) {
+        MEDIA_LOG_W("flush to encoder failed, frame dropped");
+        encoderSurface->CancelBuffer(buffer);
+    }
+    return true;
+}
+
+void WatermarkSurfaceRelay::ReturnBuffersToInput()
+{
+    while (true) {
+        sptr<Surface> consumer = nullptr;
+        sptr<Surface> encoderSurface = nullptr;
+        BufferRequestConfig config;
+        {
+            std::lock_guard<std::mutex> lock(bufferMutex_);
+            if (pendingReturnCount_ == 0 || inputConsumer_ == nullptr || encoderSurface_ == nullptr) {
+                return;
+            }
+            // claimed before the surfaces are touched, a release callback running meanwhile takes the next one
+            pendingReturnCount_--;
+            consumer = inputConsumer_;
+            encoderSurface = encoderSurface_;
+            config = returnConfig_;
+        }
+        sptr<SurfaceBuffer> buffer = nullptr;
+        int32_t releaseFence = -1;
+        GSError ret = encoderSurface->RequestBuffer(buffer, releaseFence, config);
+        if (ret == GSERROR_OK && buffer != nullptr) {
+            sptr<SyncFence> syncFence = new SyncFence(releaseFence);
+            // the encoder may still read the buffer, it only goes to the producer once the fence signaled
+            if (syncFence->Wait(FENCE_WAIT_MS) == 0 && encoderSurface->DetachBufferFromQueue(buffer) == GSERROR_OK) {
+                if (consumer->AttachBufferToQueue(buffer) == GSERROR_OK) {
+                    consumer->ReleaseBuffer(buffer, -1);
+                }
+                continue;
+            }
+            encoderSurface->CancelBuffer(buffer);
+        }
+        // the encoder still holds or reads every buffer, retried when it releases one
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        pendingReturnCount_++;
+        return;
+    }
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WATERMARK_SURFACE_RELAY_H
+#define WATERMARK_SURFACE_RELAY_H
+
+#include <memory>
+#include <mutex>
+#include "buffer/avbuffer.h"
+#include "common/status.h"
+#include "surface.h"
+#include "watermark_blender.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Pre-encoder stage used when the video encoder can not overlay a watermark. The application renders into the
+ * surface of the relay, every frame gets the watermark blended in place and the same buffer is then attached to
+ * the encoder input surface, so no frame is copied. A free buffer of the encoder surface is moved back for each
+ * forwarded one to keep the application side supplied.
+ */
+class WatermarkSurfaceRelay : public std::enable_shared_from_this<WatermarkSurfaceRelay> {
+public:
+    explicit WatermarkSurfaceRelay(sptr<Surface> encoderSurface);
+    ~WatermarkSurfaceRelay();
+
+    Status Init();
+    sptr<Surface> GetInputSurface();
+    Status SetWatermark(const std::shared_ptr<AVBuffer> &waterMarkBuffer);
+    void Release();
+    void OnBufferAvailable();
+
+private:
+    void BlendFrame(const sptr<SurfaceBuffer> &buffer);
+    bool ForwardToEncoder(sptr<SurfaceBuffer> &buffer, int64_t timestamp, const OHOS::Rect &damage);
+    void ReturnBuffersToInput();
+
+    std::mutex mutex_;
+    WatermarkBlender blender_;
+
+    std::mutex bufferMutex_;
+    sptr<Surface> encoderSurface_ = nullptr;
+    sptr<Surface> inputConsumer_ = nullptr;
+    sptr<Surface> inputSurface_ = nullptr;
+    BufferRequestConfig returnConfig_ {};
+    uint32_t pendingReturnCount_ = 0;
+
+    static constexpr int32_t FENCE_WAIT_MS = 100;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // WATERMARK_SURFACE_RELAY_H
@@ -18,6 +18,8 @@
 #include "directory_ex.h"
 #include "osal/task/jobutils.h"
 #include "media_utils.h"
+#include "media_probe_cache.h"
+#include "uri_helper.h"
 #include "meta/video_types.h"
 #include "meta/any.h"
 #include "common/log.h"
@@ -96,6 +98,7 @@ HiTransCoderImpl::HiTransCoderImpl(int32_t appUid, int32_t appPid, uint32_t appT
 {
     MEDIA_LOG_I("HiTransCoderImpl");
     pipeline_ = std::make_shared<Pipeline::Pipeline>();
+    stageMonitor_ = std::make_shared<TransCoderStageMonitor>();
     transCoderId_ = std::string("Trans_") + std::to_string(OHOS::Media::Pipeline::Pipeline::GetNextPipelineId());
 }
 
@@ -471,6 +474,7 @@ int32_t HiTransCoderImpl::Prepare()
         OnEvent({"TranscoderEngine", EventType::EVENT_ERROR, errCode});
         return static_cast<int32_t>(errCode);
     }
+    ShareProbeInfo();
     if ((videoEncoderFilter_ != nullptr) && (videoDecoderFilter_ != nullptr)) {
         if (isNeedVideoResizeFilter_ && (videoResizeFilter_ != nullptr)) {
             sptr<Surface> resizeFilterSurface = videoResizeFilter_->GetInputSurface();
@@ -491,6 +495,16 @@ int32_t HiTransCoderImpl::Prepare()
     return static_cast<int32_t>(ret);
 }
 
+void HiTransCoderImpl::ShareProbeInfo()
+{
+    // the source of a transcode is often one the gallery opens again for its thumbnail right after
+    FALSE_RETURN(demuxerFilter_ != nullptr);
+    std::string identity = UriHelper(inputFile_).FileIdentity();
+    FALSE_RETURN(!identity.empty() && !MediaProbeCache::GetInstance().Contains(identity));
+    MediaProbeCache::GetInstance().Insert(identity,
+        {demuxerFilter_->GetGlobalMetaInfo(), demuxerFilter_->GetStreamMetaInfo(), nullptr, false});
+}
+
 int32_t HiTransCoderImpl::Start()
 {
     MEDIA_LOG_I("HiTransCoderImpl::Start()");
@@ -588,7 +602,9 @@ Status HiTransCoderImpl::LinkAudioDecoderFilter(const std::shared_ptr<Pipeline::
     FALSE_RETURN_V_MSG_E(audioDecoderFilter_ != nullptr, Status::ERROR_NULL_POINTER,
         "audioDecoderFilter is nullptr");
     audioDecoderFilter_->Init(transCoderEventReceiver_, transCoderFilterCallback_);
-    FALSE_RETURN_V_MSG_E(pipeline_->LinkFilters(preFilter, {audioDecoderFilter_}, type) == Status::OK,
+    auto probeFilter = CreateProbeFilter("audioDecoderProbe", Pipeline::FilterType::FILTERTYPE_ADEC,
+        audioDecoderFilter_, {{type, TransCoderLink::DEMUXER_TO_AUDIO_DECODER}});
+    FALSE_RETURN_V_MSG_E(pipeline_->LinkFilters(preFilter, {probeFilter}, type) == Status::OK,
         Status::ERROR_UNKNOWN, "Add audioDecoderFilter to pipeline fail");
     return Status::OK;
 }
@@ -610,7 +626,9 @@ Status HiTransCoderImpl::LinkAudioEncoderFilter(const std::shared_ptr<Pipeline::
     audioEncoderFilter_->Init(transCoderEventReceiver_, transCoderFilterCallback_);
     FALSE_RETURN_V_MSG_E(audioEncoderFilter_->Configure(audioEncFormat_) == Status::OK,
         Status::ERROR_UNKNOWN, "audioEncoderFilter Configure fail");
-    FALSE_RETURN_V_MSG_E(pipeline_->LinkFilters(preFilter, {audioEncoderFilter_}, type) == Status::OK,
+    auto probeFilter = CreateProbeFilter("audioEncoderProbe", Pipeline::FilterType::FILTERTYPE_AENC,
+        audioEncoderFilter_, {{type, TransCoderLink::AUDIO_DECODER_TO_AUDIO_ENCODER}});
+    FALSE_RETURN_V_MSG_E(pipeline_->LinkFilters(preFilter, {probeFilter}, type) == Status::OK,
         Status::ERROR_UNKNOWN, "Add audioEncoderFilter to pipeline fail");
     return Status::OK;
 }
@@ -624,7 +642,9 @@ Status HiTransCoderImpl::LinkVideoDecoderFilter(const std::shared_ptr<Pipeline::
     FALSE_RETURN_V_MSG_E(videoDecoderFilter_ != nullptr, Status::ERROR_NULL_POINTER,
         "videoDecoderFilter is nullptr");
     videoDecoderFilter_->Init(transCoderEventReceiver_, transCoderFilterCallback_);
-    FALSE_RETURN_V_MSG_E(pipeline_->LinkFilters(preFilter, {videoDecoderFilter_}, type) == Status::OK,
+    auto probeFilter = CreateProbeFilter("videoDecoderProbe", Pipeline::FilterType::FILTERTYPE_VIDEODEC,
+        videoDecoderFilter_, {{type, TransCoderLink::DEMUXER_TO_VIDEO_DECODER}});
+    FALSE_RETURN_V_MSG_E(pipeline_->LinkFilters(preFilter, {probeFilter}, type) == Status::OK,
         Status::ERROR_UNKNOWN, "Add videoDecoderFilter_ to pipeline fail");
     return Status::OK;
 }
@@ -684,12 +704,25 @@ Status HiTransCoderImpl::LinkMuxerFilter(const std::shared_ptr<Pipeline::Filter>
         muxerFilter_->SetTransCoderMode();
         close(fd_);
         fd_ = -1;
+        // both encoders feed the muxer through the same probe, it tells the tracks apart by stream type
+        muxerProbeFilter_ = CreateProbeFilter("muxerProbe", Pipeline::FilterType::FILTERTYPE_MUXER, muxerFilter_, {
+            {Pipeline::StreamType::STREAMTYPE_ENCODED_VIDEO, TransCoderLink::VIDEO_ENCODER_TO_MUXER},
+            {Pipeline::StreamType::STREAMTYPE_ENCODED_AUDIO, TransCoderLink::AUDIO_ENCODER_TO_MUXER}});
     }
-    FALSE_RETURN_V_MSG_E(pipeline_->LinkFilters(preFilter, {muxerFilter_}, type) == Status::OK,
+    FALSE_RETURN_V_MSG_E(pipeline_->LinkFilters(preFilter, {muxerProbeFilter_}, type) == Status::OK,
         Status::ERROR_UNKNOWN, "Add muxerFilter to pipeline fail");
     return Status::OK;
 }
 
+std::shared_ptr<TransCoderProbeFilter> HiTransCoderImpl::CreateProbeFilter(const std::string &name,
+    Pipeline::FilterType type, const std::shared_ptr<Pipeline::Filter> &nextFilter,
+    const std::map<Pipeline::StreamType, TransCoderLink> &links)
+{
+    auto probeFilter = std::make_shared<TransCoderProbeFilter>(name, type, nextFilter, stageMonitor_, links);
+    probeFilter->Init(transCoderEventReceiver_, transCoderFilterCallback_);
+    return probeFilter;
+}
+
 void HiTransCoderImpl::OnCallback(std::shared_ptr<Pipeline::Filter> filter, const Pipeline::FilterCallBackCommand cmd,
     Pipeline::StreamType outType)
 {
@@ -737,5 +770,20 @@ int32_t HiTransCoderImpl::GetDuration(int32_t& durationMs)
     durationMs = durationMs_.load();
     return static_cast<int32_t>(Status::OK);
 }
+
+int32_t HiTransCoderImpl::GetStageStats(std::vector<TransCoderStageStats> &stats)
+{
+    stageMonitor_->GetStageStats(stats);
+    return static_cast<int32_t>(Status::OK);
+}
+
+void HiTransCoderImpl::OnDumpInfo(int32_t fd)
+{
+    std::string dumpString;
+    stageMonitor_->Dump(dumpString);
+    if (fd >= 0 && !dumpString.empty()) {
+        (void)write(fd, dumpString.c_str(), dumpString.size());
+    }
+}
 } // namespace MEDIA
 } // namespace OHOS
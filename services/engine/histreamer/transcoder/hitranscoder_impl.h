@@ -33,6 +33,8 @@
 #include "muxer_filter.h"
 #include "video_resize_filter.h"
 #include "hitranscoder_callback_looper.h"
+#include "transcoder_probe_filter.h"
+#include "transcoder_stage_monitor.h"
 
 namespace OHOS {
 namespace Media {
@@ -57,6 +59,8 @@ public:
         Pipeline::StreamType outType);
     int32_t GetCurrentTime(int32_t& currentPositionMs);
     int32_t GetDuration(int32_t& durationMs);
+    int32_t GetStageStats(std::vector<TransCoderStageStats> &stats);
+    void OnDumpInfo(int32_t fd);
 
 private:
     int32_t GetRealPath(const std::string &url, std::string &realUrlPath) const;
@@ -67,9 +71,13 @@ private:
     Status LinkVideoEncoderFilter(const std::shared_ptr<Pipeline::Filter>& preFilter, Pipeline::StreamType type);
     Status LinkVideoResizeFilter(const std::shared_ptr<Pipeline::Filter>& preFilter, Pipeline::StreamType type);
     Status LinkMuxerFilter(const std::shared_ptr<Pipeline::Filter>& preFilter, Pipeline::StreamType type);
+    std::shared_ptr<TransCoderProbeFilter> CreateProbeFilter(const std::string &name, Pipeline::FilterType type,
+        const std::shared_ptr<Pipeline::Filter> &nextFilter,
+        const std::map<Pipeline::StreamType, TransCoderLink> &links);
     void CancelTransCoder();
     void HandleErrorEvent(int32_t errorCode);
     Status ConfigureVideoAudioMetaData();
+    void ShareProbeInfo();
     Status ConfigureMetaData(const std::vector<std::shared_ptr<Meta>> &trackInfos);
     Status SetTrackMime(const std::vector<std::shared_ptr<Meta>> &trackInfos);
     Status ConfigureVideoWidthHeight(const TransCoderParam &transCoderParam);
@@ -91,6 +99,8 @@ private:
     std::shared_ptr<Pipeline::SurfaceEncoderFilter> videoEncoderFilter_;
     std::shared_ptr<Pipeline::VideoResizeFilter> videoResizeFilter_;
     std::shared_ptr<Pipeline::MuxerFilter> muxerFilter_;
+    std::shared_ptr<TransCoderProbeFilter> muxerProbeFilter_;
+    std::shared_ptr<TransCoderStageMonitor> stageMonitor_;
 
     std::shared_ptr<Pipeline::EventReceiver> transCoderEventReceiver_;
     std::shared_ptr<Pipeline::FilterCallback> transCoderFilterCallback_;
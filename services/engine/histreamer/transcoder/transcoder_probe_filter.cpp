@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "transcoder_probe_filter.h"
+#include "common/log.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_CORE, LOG_DOMAIN_SYSTEM_PLAYER, "TransCoderProbeFilter" };
+}
+
+namespace OHOS {
+namespace Media {
+TransCoderProbeFilter::TransCoderProbeFilter(const std::string &name, Pipeline::FilterType type,
+    const std::shared_ptr<Pipeline::Filter> &nextFilter, const std::shared_ptr<TransCoderStageMonitor> &monitor,
+    const std::map<Pipeline::StreamType, TransCoderLink> &links)
+    : BufferObserverFilter(name, type, nextFilter), monitor_(monitor), links_(links)
+{
+    MEDIA_LOG_I("TransCoderProbeFilter ctor called");
+}
+
+TransCoderProbeFilter::~TransCoderProbeFilter()
+{
+    MEDIA_LOG_I("~TransCoderProbeFilter dtor called.");
+}
+
+bool TransCoderProbeFilter::OnQueueLinked(Pipeline::StreamType inType)
+{
+    auto linkIt = links_.find(inType);
+    FALSE_RETURN_V_MSG_E(linkIt != links_.end() && monitor_ != nullptr, false,
+        "stream type " PUBLIC_LOG_D32 " is not probed", static_cast<int32_t>(inType));
+    monitor_->EnableLink(linkIt->second);
+    MEDIA_LOG_I("probing link " PUBLIC_LOG_D32, static_cast<int32_t>(linkIt->second));
+    return true;
+}
+
+void TransCoderProbeFilter::OnBufferReturned(Pipeline::StreamType inType, int64_t arrivalUs, int64_t returnUs)
+{
+    // links_ never changes after construction and OnQueueLinked only lets probed streams through
+    auto linkIt = links_.find(inType);
+    if (linkIt != links_.end()) {
+        monitor_->OnBuffer(linkIt->second, arrivalUs, returnUs);
+    }
+}
+} // namespace Media
+} // namespace OHOS
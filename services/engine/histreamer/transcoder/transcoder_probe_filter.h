@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRANSCODER_PROBE_FILTER_H
+#define TRANSCODER_PROBE_FILTER_H
+
+#include <map>
+#include <memory>
+#include "buffer_observer_filter.h"
+#include "transcoder_stage_monitor.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Observes the input queue of the next filter and reports every buffer with the time the downstream took to
+ * accept it to the TransCoderStageMonitor.
+ */
+class TransCoderProbeFilter : public BufferObserverFilter {
+public:
+    TransCoderProbeFilter(const std::string &name, Pipeline::FilterType type,
+        const std::shared_ptr<Pipeline::Filter> &nextFilter, const std::shared_ptr<TransCoderStageMonitor> &monitor,
+        const std::map<Pipeline::StreamType, TransCoderLink> &links);
+    ~TransCoderProbeFilter() override;
+
+protected:
+    bool OnQueueLinked(Pipeline::StreamType inType) override;
+    void OnBufferReturned(Pipeline::StreamType inType, int64_t arrivalUs, int64_t returnUs) override;
+
+private:
+    std::shared_ptr<TransCoderStageMonitor> monitor_;
+    const std::map<Pipeline::StreamType, TransCoderLink> links_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // TRANSCODER_PROBE_FILTER_H
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "transcoder_stage_monitor.h"
+#include <algorithm>
+
+namespace {
+using OHOS::Media::TransCoderLink;
+using OHOS::Media::TransCoderStage;
+constexpr int64_t US_TO_MS = 1000;
+constexpr int64_t US_PER_SECOND = 1000000;
+
+constexpr uint32_t LinkBit(TransCoderLink link)
+{
+    return 1u << static_cast<uint32_t>(link);
+}
+
+struct StageLinks {
+    TransCoderStage stage;
+    const char *name;
+    uint32_t inputLinks;
+    uint32_t outputLinks;
+};
+
+// the pipeline built by HiTransCoderImpl in data flow order, indexed by TransCoderStage
+constexpr StageLinks STAGE_LINKS[] = {
+    { TransCoderStage::DEMUXER, "demuxer", 0,
+        LinkBit(TransCoderLink::DEMUXER_TO_VIDEO_DECODER) | LinkBit(TransCoderLink::DEMUXER_TO_AUDIO_DECODER) },
+    { TransCoderStage::VIDEO_CODEC, "video codec", LinkBit(TransCoderLink::DEMUXER_TO_VIDEO_DECODER),
+        LinkBit(TransCoderLink::VIDEO_ENCODER_TO_MUXER) },
+    { TransCoderStage::AUDIO_DECODER, "audio decoder", LinkBit(TransCoderLink::DEMUXER_TO_AUDIO_DECODER),
+        LinkBit(TransCoderLink::AUDIO_DECODER_TO_AUDIO_ENCODER) },
+    { TransCoderStage::AUDIO_ENCODER, "audio encoder", LinkBit(TransCoderLink::AUDIO_DECODER_TO_AUDIO_ENCODER),
+        LinkBit(TransCoderLink::AUDIO_ENCODER_TO_MUXER) },
+    { TransCoderStage::MUXER, "muxer",
+        LinkBit(TransCoderLink::VIDEO_ENCODER_TO_MUXER) | LinkBit(TransCoderLink::AUDIO_ENCODER_TO_MUXER), 0 },
+};
+}
+
+namespace OHOS {
+namespace Media {
+TransCoderStageMonitor::TransCoderStageMonitor(int64_t stallThresholdUs)
+    : stallThresholdUs_(stallThresholdUs)
+{
+}
+
+void TransCoderStageMonitor::EnableLink(TransCoderLink link)
+{
+    if (link < TransCoderLink::LINK_BUTT) {
+        links_[static_cast<size_t>(link)].isEnabled = true;
+    }
+}
+
+void TransCoderStageMonitor::OnBuffer(TransCoderLink link, int64_t arrivalUs, int64_t handOffUs)
+{
+    if (link >= TransCoderLink::LINK_BUTT) {
+        return;
+    }
+    LinkCounters &counters = links_[static_cast<size_t>(link)];
+    int64_t lastArrivalUs = counters.lastArrivalUs.load(std::memory_order_relaxed);
+    if (lastArrivalUs < 0) {
+        counters.firstArrivalUs.store(arrivalUs, std::memory_order_relaxed);
+    } else if (arrivalUs - lastArrivalUs > stallThresholdUs_) {
+        counters.stallUs.fetch_add(arrivalUs - lastArrivalUs, std::memory_order_relaxed);
+    }
+    counters.lastArrivalUs.store(arrivalUs, std::memory_order_relaxed);
+    counters.handOffUs.fetch_add(handOffUs, std::memory_order_relaxed);
+    counters.frames.fetch_add(1, std::memory_order_relaxed);
+    UpdateDepth(link);
+}
+
+void TransCoderStageMonitor::UpdateDepth(TransCoderLink link)
+{
+    // a buffer entering a stage is the moment its depth can grow
+    for (const auto &stageLinks : STAGE_LINKS) {
+        if ((stageLinks.inputLinks & LinkBit(link)) == 0 || stageLinks.outputLinks == 0) {
+            continue;
+        }
+        uint64_t framesIn = GetFrames(stageLinks.inputLinks);
+        uint64_t framesOut = GetFrames(stageLinks.outputLinks);
+        int32_t depth = framesIn > framesOut ? static_cast<int32_t>(framesIn - framesOut) : 0;
+        auto &maxDepth = depths_[static_cast<size_t>(stageLinks.stage)].maxDepth;
+        int32_t current = maxDepth.load(std::memory_order_relaxed);
+        while (depth > current && !maxDepth.compare_exchange_weak(current, depth, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+uint64_t TransCoderStageMonitor::GetFrames(uint32_t linkMask) const
+{
+    uint64_t frames = 0;
+    for (size_t i = 0; i < links_.size(); i++) {
+        if (linkMask & (1u << i)) {
+            frames += links_[i].frames.load(std::memory_order_relaxed);
+        }
+    }
+    return frames;
+}
+
+int64_t TransCoderStageMonitor::GetStallUs(uint32_t linkMask) const
+{
+    int64_t stallUs = 0;
+    for (size_t i = 0; i < links_.size(); i++) {
+        if (linkMask & (1u << i)) {
+            stallUs += links_[i].stallUs.load(std::memory_order_relaxed);
+        }
+    }
+    return stallUs;
+}
+
+int64_t TransCoderStageMonitor::GetHandOffUs(uint32_t linkMask) const
+{
+    int64_t handOffUs = 0;
+    for (size_t i = 0; i < links_.size(); i++) {
+        if (linkMask & (1u << i)) {
+            handOffUs += links_[i].handOffUs.load(std::memory_order_relaxed);
+        }
+    }
+    return handOffUs;
+}
+
+bool TransCoderStageMonitor::IsAnyEnabled(uint32_t linkMask) const
+{
+    for (size_t i = 0; i < links_.size(); i++) {
+        if ((linkMask & (1u << i)) && links_[i].isEnabled.load(std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TransCoderStageMonitor::GetStageStats(std::vector<TransCoderStageStats> &stats) const
+{
+    stats.clear();
+    for (const auto &stageLinks : STAGE_LINKS) {
+        if (!IsAnyEnabled(stageLinks.inputLinks | stageLinks.outputLinks)) {
+            continue;
+        }
+        TransCoderStageStats stageStats;
+        stageStats.stage = stageLinks.stage;
+        // the demuxer has no observed input and the muxer no observed output, both count what they handled
+        stageStats.framesOut = GetFrames(stageLinks.outputLinks);
+        stageStats.framesIn = stageLinks.inputLinks != 0 ? GetFrames(stageLinks.inputLinks) : stageStats.framesOut;
+        if (stageLinks.outputLinks == 0) {
+            stageStats.framesOut = stageStats.framesIn;
+        }
+        stageStats.inputWaitUs = GetStallUs(stageLinks.inputLinks);
+        stageStats.handOffUs = GetHandOffUs(stageLinks.outputLinks);
+        if (stageLinks.inputLinks != 0 && stageLinks.outputLinks != 0) {
+            stageStats.queueDepth = stageStats.framesIn > stageStats.framesOut ?
+                static_cast<int32_t>(stageStats.framesIn - stageStats.framesOut) : 0;
+            stageStats.maxQueueDepth = std::max(stageStats.queueDepth,
+                depths_[static_cast<size_t>(stageLinks.stage)].maxDepth.load(std::memory_order_relaxed));
+        }
+        stats.push_back(stageStats);
+    }
+}
+
+void TransCoderStageMonitor::Dump(std::string &dumpString) const
+{
+    std::vector<TransCoderStageStats> stats;
+    GetStageStats(stats);
+    for (const auto &stageStats : stats) {
+        const auto &stageLinks = STAGE_LINKS[static_cast<size_t>(stageStats.stage)];
+        uint32_t links = stageLinks.outputLinks != 0 ? stageLinks.outputLinks : stageLinks.inputLinks;
+        int64_t firstUs = -1;
+        int64_t lastUs = -1;
+        for (size_t i = 0; i < links_.size(); i++) {
+            int64_t linkFirstUs = links_[i].firstArrivalUs.load(std::memory_order_relaxed);
+            if ((links & (1u << i)) == 0 || linkFirstUs < 0) {
+                continue;
+            }
+            firstUs = firstUs < 0 ? linkFirstUs : std::min(firstUs, linkFirstUs);
+            lastUs = std::max(lastUs, links_[i].lastArrivalUs.load(std::memory_order_relaxed));
+        }
+        uint64_t fps = lastUs > firstUs ?
+            stageStats.framesOut * US_PER_SECOND / static_cast<uint64_t>(lastUs - firstUs) : 0;
+        dumpString += std::string("TransCoder stage ") + stageLinks.name +
+            ": in " + std::to_string(stageStats.framesIn) + ", out " + std::to_string(stageStats.framesOut) +
+            ", fps " + std::to_string(fps) +
+            ", input wait " + std::to_string(stageStats.inputWaitUs / US_TO_MS) + " ms" +
+            ", hand-off " + std::to_string(stageStats.handOffUs / US_TO_MS) + " ms" +
+            ", depth " + std::to_string(stageStats.queueDepth) +
+            " (max " + std::to_string(stageStats.maxQueueDepth) + ")\n";
+    }
+}
+} // namespace Media
+} // namespace OHOS
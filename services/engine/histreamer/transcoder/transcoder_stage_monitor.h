@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRANSCODER_STAGE_MONITOR_H
+#define TRANSCODER_STAGE_MONITOR_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "transcoder_stage_stats.h"
+
+namespace OHOS {
+namespace Media {
+// the buffer queue links of the pipeline, the surface links inside the video chain can not be observed
+enum class TransCoderLink : int32_t {
+    DEMUXER_TO_VIDEO_DECODER = 0,
+    DEMUXER_TO_AUDIO_DECODER,
+    AUDIO_DECODER_TO_AUDIO_ENCODER,
+    VIDEO_ENCODER_TO_MUXER,
+    AUDIO_ENCODER_TO_MUXER,
+    LINK_BUTT,
+};
+
+/**
+ * Counts the buffers crossing each link of the transcoder pipeline and turns them into per stage figures. A stage
+ * waits on input for the gaps between buffers arriving on its input links that are longer than the stall
+ * threshold. The hand-off time is how long the next queue took to take its buffers, the wait of a stage for a free
+ * output buffer happens inside its filter and is not seen. Every link is written by one thread only, the figures
+ * of a stage are read without stopping the pipeline and are approximate.
+ */
+class TransCoderStageMonitor {
+public:
+    explicit TransCoderStageMonitor(int64_t stallThresholdUs = DEFAULT_STALL_THRESHOLD_US);
+    ~TransCoderStageMonitor() = default;
+
+    void EnableLink(TransCoderLink link);
+    // arrivalUs is when the upstream handed the buffer over, handOffUs how long the downstream took to accept it
+    void OnBuffer(TransCoderLink link, int64_t arrivalUs, int64_t handOffUs);
+    void GetStageStats(std::vector<TransCoderStageStats> &stats) const;
+    void Dump(std::string &dumpString) const;
+
+    static constexpr int64_t DEFAULT_STALL_THRESHOLD_US = 20000;
+
+private:
+    struct LinkCounters {
+        std::atomic<bool> isEnabled = false;
+        std::atomic<uint64_t> frames = 0;
+        std::atomic<int64_t> firstArrivalUs = -1;
+        std::atomic<int64_t> lastArrivalUs = -1;
+        std::atomic<int64_t> stallUs = 0;
+        std::atomic<int64_t> handOffUs = 0;
+    };
+    struct StageDepth {
+        std::atomic<int32_t> maxDepth = 0;
+    };
+
+    uint64_t GetFrames(uint32_t linkMask) const;
+    int64_t GetStallUs(uint32_t linkMask) const;
+    int64_t GetHandOffUs(uint32_t linkMask) const;
+    bool IsAnyEnabled(uint32_t linkMask) const;
+    void UpdateDepth(TransCoderLink link);
+
+    int64_t stallThresholdUs_;
+    std::array<LinkCounters, static_cast<size_t>(TransCoderLink::LINK_BUTT)> links_;
+    std::array<StageDepth, static_cast<size_t>(TransCoderStage::STAGE_BUTT)> depths_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // TRANSCODER_STAGE_MONITOR_H
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "buffer_observer_filter.h"
+#include <chrono>
+#include "common/log.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_CORE, LOG_DOMAIN_SYSTEM_PLAYER, "BufferObserverFilter" };
+constexpr uint32_t SINK_QUEUE_SIZE = 8;
+
+int64_t GetNowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+namespace OHOS {
+namespace Media {
+BufferObserverFilter::BufferObserverFilter(const std::string &name, Pipeline::FilterType type,
+    const std::shared_ptr<Pipeline::Filter> &nextFilter)
+    : Filter(name, type), nextFilter_(nextFilter)
+{
+}
+
+BufferObserverFilter::~BufferObserverFilter()
+{
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    for (auto &queue : queues_) {
+        if (queue.second.producer != nullptr && queue.second.listener != nullptr) {
+            queue.second.producer->RemoveBufferFilledListener(queue.second.listener);
+        }
+    }
+}
+
+void BufferObserverFilter::RemoveQueue(Pipeline::StreamType inType)
+{
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    auto it = queues_.find(inType);
+    if (it == queues_.end()) {
+        return;
+    }
+    if (it->second.producer != nullptr && it->second.listener != nullptr) {
+        it->second.producer->RemoveBufferFilledListener(it->second.listener);
+    }
+    queues_.erase(it);
+}
+
+Status BufferObserverFilter::OnLinked(Pipeline::StreamType inType, const std::shared_ptr<Meta> &meta,
+    const std::shared_ptr<Pipeline::FilterLinkCallback> &callback)
+{
+    MEDIA_LOG_I("OnLinked, stream type " PUBLIC_LOG_D32, static_cast<int32_t>(inType));
+    OnStreamMeta(inType, meta);
+    if (nextFilter_ == nullptr) {
+        return LinkAsSink(inType, meta, callback);
+    }
+    // a filter in front of the muxer is linked once per track, the muxer itself must only be driven once
+    if (nextFiltersMap_.empty()) {
+        nextFiltersMap_[inType].push_back(nextFilter_);
+    }
+    auto linkCallback = std::make_shared<BufferObserverLinkCallback>(shared_from_this(), inType, callback);
+    return nextFilter_->OnLinked(inType, meta, linkCallback);
+}
+
+Status BufferObserverFilter::LinkAsSink(Pipeline::StreamType inType, const std::shared_ptr<Meta> &meta,
+    const std::shared_ptr<Pipeline::FilterLinkCallback> &callback)
+{
+    FALSE_RETURN_V_MSG_E(callback != nullptr, Status::ERROR_NULL_POINTER, "link callback is nullptr");
+    std::shared_ptr<AVBufferQueue> queue = AVBufferQueue::Create(SINK_QUEUE_SIZE, MemoryType::UNKNOWN_MEMORY,
+        "BufferObserverSink");
+    FALSE_RETURN_V_MSG_E(queue != nullptr, Status::ERROR_NO_MEMORY, "create sink queue failed");
+    sptr<AVBufferQueueConsumer> consumer = queue->GetConsumer();
+    sptr<AVBufferQueueProducer> producer = queue->GetProducer();
+    FALSE_RETURN_V_MSG_E(consumer != nullptr && producer != nullptr, Status::ERROR_NULL_POINTER,
+        "sink queue has no consumer or producer");
+    sptr<IConsumerListener> listener = new BufferObserverConsumerListener(shared_from_this(), inType);
+    consumer->SetBufferAvailableListener(listener);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        ObservedQueue &observed = queues_[inType];
+        observed.sinkQueue = queue;
+        observed.consumer = consumer;
+    }
+    MEDIA_LOG_I("taking stream type " PUBLIC_LOG_D32 " without a next filter", static_cast<int32_t>(inType));
+    std::shared_ptr<Meta> linkMeta = meta;
+    callback->OnLinkedResult(producer, linkMeta);
+    return Status::OK;
+}
+
+Status BufferObserverFilter::OnUpdated(Pipeline::StreamType inType, const std::shared_ptr<Meta> &meta,
+    const std::shared_ptr<Pipeline::FilterLinkCallback> &callback)
+{
+    OnStreamMeta(inType, meta);
+    if (nextFilter_ == nullptr) {
+        std::shared_ptr<Meta> updatedMeta = meta;
+        if (callback != nullptr) {
+            callback->OnUpdatedResult(updatedMeta);
+        }
+        return Status::OK;
+    }
+    auto linkCallback = std::make_shared<BufferObserverLinkCallback>(shared_from_this(), inType, callback);
+    return nextFilter_->OnUpdated(inType, meta, linkCallback);
+}
+
+Status BufferObserverFilter::OnUnLinked(Pipeline::StreamType inType,
+    const std::shared_ptr<Pipeline::FilterLinkCallback> &callback)
+{
+    RemoveQueue(inType);
+    if (nextFilter_ == nullptr) {
+        auto meta = std::make_shared<Meta>();
+        if (callback != nullptr) {
+            callback->OnUnlinkedResult(meta);
+        }
+        return Status::OK;
+    }
+    auto linkCallback = std::make_shared<BufferObserverLinkCallback>(shared_from_this(), inType, callback);
+    return nextFilter_->OnUnLinked(inType, linkCallback);
+}
+
+void BufferObserverFilter::SetNextFilter(const std::shared_ptr<Pipeline::Filter> &nextFilter)
+{
+    nextFilter_ = nextFilter;
+    nextFiltersMap_.clear();
+}
+
+void BufferObserverFilter::OnLinkedResult(Pipeline::StreamType inType, const sptr<AVBufferQueueProducer> &queue)
+{
+    // a surface link hands no queue over, there is nothing to listen on
+    FALSE_RETURN_MSG(queue != nullptr, "stream type " PUBLIC_LOG_D32 " has no input queue",
+        static_cast<int32_t>(inType));
+    FALSE_RETURN(OnQueueLinked(inType));
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    ObservedQueue &observed = queues_[inType];
+    observed.producer = queue;
+    observed.listener = new BufferObserverListener(shared_from_this(), queue, inType);
+    queue->SetBufferFilledListener(observed.listener);
+    MEDIA_LOG_I("observing stream type " PUBLIC_LOG_D32, static_cast<int32_t>(inType));
+}
+
+void BufferObserverFilter::OnBufferFilled(Pipeline::StreamType inType, const sptr<AVBufferQueueProducer> &producer,
+    std::shared_ptr<AVBuffer> &buffer)
+{
+    bool isFrame = buffer != nullptr && (buffer->flag_ & static_cast<uint32_t>(AVBufferFlag::EOS)) == 0;
+    if (isFrame) {
+        OnBufferObserved(inType, buffer);
+    }
+    int64_t arrivalUs = GetNowUs();
+    producer->ReturnBuffer(buffer, true);
+    if (isFrame) {
+        OnBufferReturned(inType, arrivalUs, GetNowUs() - arrivalUs);
+    }
+}
+
+void BufferObserverFilter::OnBufferAvailable(Pipeline::StreamType inType)
+{
+    sptr<AVBufferQueueConsumer> consumer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        auto it = queues_.find(inType);
+        FALSE_RETURN(it != queues_.end() && it->second.consumer != nullptr);
+        consumer = it->second.consumer;
+    }
+    std::shared_ptr<AVBuffer> buffer = nullptr;
+    FALSE_RETURN(consumer->AcquireBuffer(buffer) == Status::OK && buffer != nullptr);
+    bool isFrame = (buffer->flag_ & static_cast<uint32_t>(AVBufferFlag::EOS)) == 0;
+    if (isFrame) {
+        OnBufferObserved(inType, buffer);
+    }
+    int64_t arrivalUs = GetNowUs();
+    consumer->ReleaseBuffer(buffer);
+    if (isFrame) {
+        OnBufferReturned(inType, arrivalUs, GetNowUs() - arrivalUs);
+    }
+}
+
+void BufferObserverFilter::OnStreamMeta(Pipeline::StreamType inType, const std::shared_ptr<Meta> &meta)
+{
+    (void)inType;
+    (void)meta;
+}
+
+bool BufferObserverFilter::OnQueueLinked(Pipeline::StreamType inType)
+{
+    (void)inType;
+    return true;
+}
+
+void BufferObserverFilter::OnBufferObserved(Pipeline::StreamType inType, const std::shared_ptr<AVBuffer> &buffer)
+{
+    (void)inType;
+    (void)buffer;
+}
+
+void BufferObserverFilter::OnBufferReturned(Pipeline::StreamType inType, int64_t arrivalUs, int64_t returnUs)
+{
+    (void)inType;
+    (void)arrivalUs;
+    (void)returnUs;
+}
+
+BufferObserverLinkCallback::BufferObserverLinkCallback(const std::shared_ptr<BufferObserverFilter> &filter,
+    Pipeline::StreamType inType, const std::shared_ptr<Pipeline::FilterLinkCallback> &upstream)
+    : filter_(filter), inType_(inType), upstream_(upstream)
+{
+}
+
+void BufferObserverLinkCallback::OnLinkedResult(const sptr<AVBufferQueueProducer> &queue,
+    std::shared_ptr<Meta> &meta)
+{
+    if (auto filter = filter_.lock()) {
+        filter->OnLinkedResult(inType_, queue);
+    }
+    // the upstream filter gets the downstream queue itself, buffers are only observed on their way through
+    if (upstream_ != nullptr) {
+        upstream_->OnLinkedResult(queue, meta);
+    }
+}
+
+void BufferObserverLinkCallback::OnUnlinkedResult(std::shared_ptr<Meta> &meta)
+{
+    if (upstream_ != nullptr) {
+        upstream_->OnUnlinkedResult(meta);
+    }
+}
+
+void BufferObserverLinkCallback::OnUpdatedResult(std::shared_ptr<Meta> &meta)
+{
+    if (upstream_ != nullptr) {
+        upstream_->OnUpdatedResult(meta);
+    }
+}
+
+BufferObserverConsumerListener::BufferObserverConsumerListener(const std::shared_ptr<BufferObserverFilter> &filter,
+    Pipeline::StreamType inType)
+    : filter_(filter), inType_(inType)
+{
+}
+
+void BufferObserverConsumerListener::OnBufferAvailable()
+{
+    if (auto filter = filter_.lock()) {
+        filter->OnBufferAvailable(inType_);
+    }
+}
+
+BufferObserverListener::BufferObserverListener(const std::shared_ptr<BufferObserverFilter> &filter,
+    sptr<AVBufferQueueProducer> producer, Pipeline::StreamType inType)
+    : filter_(filter), producer_(producer), inType_(inType)
+{
+}
+
+void BufferObserverListener::OnBufferFilled(std::shared_ptr<AVBuffer> &buffer)
+{
+    if (auto filter = filter_.lock()) {
+        filter->OnBufferFilled(inType_, producer_, buffer);
+        return;
+    }
+    producer_->ReturnBuffer(buffer, true);
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BUFFER_OBSERVER_FILTER_H
+#define BUFFER_OBSERVER_FILTER_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include "avbuffer_queue.h"
+#include "avbuffer_queue_define.h"
+#include "common/status.h"
+#include "filter/filter.h"
+#include "iremote_stub.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Sits in front of a filter that takes its input through a buffer queue and forwards linking to it unchanged. The
+ * upstream filter gets that queue and keeps writing into it, this filter only listens on it and lets every buffer
+ * go on, so the pipeline output is untouched. Without a next filter it ends the stream instead, the upstream filter
+ * gets a queue of this filter and every buffer is released once the hooks saw it. Subclasses see the buffers through
+ * the On* hooks, which run on the upstream filter's output thread or, without a next filter, on the queue's.
+ */
+class BufferObserverFilter : public Pipeline::Filter, public std::enable_shared_from_this<BufferObserverFilter> {
+public:
+    BufferObserverFilter(const std::string &name, Pipeline::FilterType type,
+        const std::shared_ptr<Pipeline::Filter> &nextFilter);
+    ~BufferObserverFilter() override;
+
+    Status OnLinked(Pipeline::StreamType inType, const std::shared_ptr<Meta> &meta,
+        const std::shared_ptr<Pipeline::FilterLinkCallback> &callback) override;
+    Status OnUpdated(Pipeline::StreamType inType, const std::shared_ptr<Meta> &meta,
+        const std::shared_ptr<Pipeline::FilterLinkCallback> &callback) override;
+    Status OnUnLinked(Pipeline::StreamType inType,
+        const std::shared_ptr<Pipeline::FilterLinkCallback> &callback) override;
+
+    // streams linked afterwards go to nextFilter, the ones linked to the old filter have to be unlinked first
+    void SetNextFilter(const std::shared_ptr<Pipeline::Filter> &nextFilter);
+    void OnLinkedResult(Pipeline::StreamType inType, const sptr<AVBufferQueueProducer> &queue);
+    void OnBufferFilled(Pipeline::StreamType inType, const sptr<AVBufferQueueProducer> &producer,
+        std::shared_ptr<AVBuffer> &buffer);
+    void OnBufferAvailable(Pipeline::StreamType inType);
+
+protected:
+    // the meta a stream was linked or updated with
+    virtual void OnStreamMeta(Pipeline::StreamType inType, const std::shared_ptr<Meta> &meta);
+    // false leaves the stream unobserved
+    virtual bool OnQueueLinked(Pipeline::StreamType inType);
+    // a buffer other than EOS before it goes on, it must not be kept after the call
+    virtual void OnBufferObserved(Pipeline::StreamType inType, const std::shared_ptr<AVBuffer> &buffer);
+    // the same buffer once the next filter has it, returnUs is how long handing it over took
+    virtual void OnBufferReturned(Pipeline::StreamType inType, int64_t arrivalUs, int64_t returnUs);
+
+private:
+    struct ObservedQueue {
+        sptr<AVBufferQueueProducer> producer;
+        sptr<IBrokerListener> listener;
+        // only set without a next filter, the queue is this filter's own
+        std::shared_ptr<AVBufferQueue> sinkQueue;
+        sptr<AVBufferQueueConsumer> consumer;
+    };
+
+    Status LinkAsSink(Pipeline::StreamType inType, const std::shared_ptr<Meta> &meta,
+        const std::shared_ptr<Pipeline::FilterLinkCallback> &callback);
+    void RemoveQueue(Pipeline::StreamType inType);
+
+    std::shared_ptr<Pipeline::Filter> nextFilter_;
+    std::mutex queueMutex_;
+    std::map<Pipeline::StreamType, ObservedQueue> queues_;
+};
+
+class BufferObserverLinkCallback : public Pipeline::FilterLinkCallback {
+public:
+    BufferObserverLinkCallback(const std::shared_ptr<BufferObserverFilter> &filter, Pipeline::StreamType inType,
+        const std::shared_ptr<Pipeline::FilterLinkCallback> &upstream);
+    ~BufferObserverLinkCallback() = default;
+
+    void OnLinkedResult(const sptr<AVBufferQueueProducer> &queue, std::shared_ptr<Meta> &meta) override;
+    void OnUnlinkedResult(std::shared_ptr<Meta> &meta) override;
+    void OnUpdatedResult(std::shared_ptr<Meta> &meta) override;
+
+private:
+    std::weak_ptr<BufferObserverFilter> filter_;
+    Pipeline::StreamType inType_;
+    std::shared_ptr<Pipeline::FilterLinkCallback> upstream_;
+};
+
+class BufferObserverConsumerListener : public IConsumerListener {
+public:
+    BufferObserverConsumerListener(const std::shared_ptr<BufferObserverFilter> &filter, Pipeline::StreamType inType);
+    ~BufferObserverConsumerListener() = default;
+
+    void OnBufferAvailable() override;
+
+private:
+    std::weak_ptr<BufferObserverFilter> filter_;
+    Pipeline::StreamType inType_;
+};
+
+class BufferObserverListener : public IRemoteStub<IBrokerListener> {
+public:
+    BufferObserverListener(const std::shared_ptr<BufferObserverFilter> &filter,
+        sptr<AVBufferQueueProducer> producer, Pipeline::StreamType inType);
+    ~BufferObserverListener() = default;
+
+    void OnBufferFilled(std::shared_ptr<AVBuffer> &buffer);
+
+private:
+    std::weak_ptr<BufferObserverFilter> filter_;
+    sptr<AVBufferQueueProducer> producer_;
+    Pipeline::StreamType inType_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // BUFFER_OBSERVER_FILTER_H
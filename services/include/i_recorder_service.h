@@ -21,6 +21,7 @@
 #include "refbase.h"
 #include "surface.h"
 #include "media_data_source.h"
+#include "buffer/avsharedmemory.h"
 
 namespace OHOS {
 namespace Media {
@@ -603,6 +604,28 @@ public:
     virtual int32_t IsWatermarkSupported(bool &isWatermarkSupported) = 0;
 
     virtual int32_t SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer) = 0;
+
+    /**
+     * @brief Writes the last duration milliseconds of the in-memory pre-cache to fd.
+     *
+     * @param fd file to write
+     * @param duration length to save in milliseconds
+     * @return Returns {@link SUCCESS} if the file is written; returns an error code defined
+     * in {@link media_errors.h} otherwise.
+    */
+    virtual int32_t SavePreCache(int32_t fd, int32_t duration) = 0;
+
+    /**
+     * @brief Sets the shared memory block and eventfd of an audio ring as the audio data source.
+     *
+     * @param memory shared block holding the ring
+     * @param eventFd eventfd the producer signals the reader with
+     * @param sourceId Indicates the audio source ID.
+     * @return Returns {@link SUCCESS} if the setting is successful; returns an error code defined
+     * in {@link media_errors.h} otherwise.
+    */
+    virtual int32_t SetAudioSharedRing(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd,
+        int32_t &sourceId) = 0;
 };
 } // namespace Media
 } // namespace OHOS
@@ -221,6 +221,10 @@ public:
      * Set watermark config
     */
     virtual int32_t SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer) = 0;
+    /**
+     * Mux the last duration ms of the in-memory cache into fd.
+     */
+    virtual int32_t SavePreCache(int32_t fd, int32_t duration) = 0;
 };
 } // namespace Media
 } // namespace OHOS
@@ -19,10 +19,13 @@
 #include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
 #include <refbase.h>
 #include "nocopyable.h"
+#include "media_errors.h"
 #include "transcoder.h"
 #include "transcoder_param.h"
+#include "transcoder_stage_stats.h"
 
 namespace OHOS {
 class Surface;
@@ -126,6 +129,24 @@ public:
      * Return MSERR_OK indicates success, or others indicate failed.
      */
     virtual int32_t GetDuration(int32_t &duration) = 0;
+
+    /**
+     * Get the frame counters, wait times and queue depth of every pipeline stage in use.
+     * Return MSERR_OK indicates success, or others indicate failed.
+     */
+    virtual int32_t GetStageStats(std::vector<TransCoderStageStats> &stats)
+    {
+        (void)stats;
+        return MSERR_UNSUPPORT;
+    }
+
+    /**
+     * Write the engine's per stage statistics to the dump fd.
+     */
+    virtual void OnDumpInfo(int32_t fd)
+    {
+        (void)fd;
+    }
 };
 } // namespace Media
 } // namespace OHOS
@@ -67,6 +67,10 @@ enum RecorderPublicParamType : uint32_t {
     GEO_LOCATION,
     CUSTOM_INFO,
     GENRE_INFO,
+    FILE_SPLIT,
+    PRE_CACHE,
+    SOFT_STOP,
+    WARM_RESTART,
 
     PUBLIC_PARAM_TYPE_END,
 };
@@ -204,6 +208,32 @@ struct GenreInfo : public RecorderParam {
     std::string genre;
 };
 
+struct FileSplit : public RecorderParam {
+    FileSplit(FileSplitType splitType, int64_t splitTimestamp, uint32_t splitDuration)
+        : RecorderParam(RecorderPublicParamType::FILE_SPLIT), type(splitType), timestamp(splitTimestamp),
+          duration(splitDuration) {}
+    FileSplitType type;
+    int64_t timestamp;
+    uint32_t duration;
+};
+
+struct PreCache : public RecorderParam {
+    PreCache(int32_t durationMs, int32_t maxSize)
+        : RecorderParam(RecorderPublicParamType::PRE_CACHE), duration(durationMs), maxBytes(maxSize) {}
+    int32_t duration;
+    int32_t maxBytes;
+};
+
+struct SoftStop : public RecorderParam {
+    explicit SoftStop(bool isEnabled) : RecorderParam(RecorderPublicParamType::SOFT_STOP), enable(isEnabled) {}
+    bool enable;
+};
+
+struct WarmRestart : public RecorderParam {
+    explicit WarmRestart(bool isReused) : RecorderParam(RecorderPublicParamType::WARM_RESTART), reuse(isReused) {}
+    bool reuse;
+};
+
 struct MetaMimeType : public RecorderParam {
     explicit MetaMimeType(const std::string_view &type) : RecorderParam(RecorderPublicParamType::META_MIME_TYPE),
         mimeType(type) {}
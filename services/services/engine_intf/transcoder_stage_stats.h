@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRANSCODER_STAGE_STATS_H
+#define TRANSCODER_STAGE_STATS_H
+
+#include <cstdint>
+
+namespace OHOS {
+namespace Media {
+enum class TransCoderStage : int32_t {
+    DEMUXER = 0,
+    // video decoder, resize and video encoder, they hand frames over through surfaces
+    VIDEO_CODEC,
+    AUDIO_DECODER,
+    AUDIO_ENCODER,
+    MUXER,
+    STAGE_BUTT,
+};
+
+struct TransCoderStageStats {
+    TransCoderStage stage = TransCoderStage::STAGE_BUTT;
+    uint64_t framesIn = 0;
+    uint64_t framesOut = 0;
+    // time the stage sat without input, only gaps longer than the stall threshold count
+    int64_t inputWaitUs = 0;
+    // time ReturnBuffer took to hand the output to the next queue, not the wait for a free output buffer
+    int64_t handOffUs = 0;
+    // frames taken in and not passed on yet
+    int32_t queueDepth = 0;
+    int32_t maxQueueDepth = 0;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // TRANSCODER_STAGE_STATS_H
@@ -14,6 +14,7 @@
  */
 
 #include "player_service_stub.h"
+#include <chrono>
 #include <unistd.h>
 #include "player_listener_proxy.h"
 #include "media_data_source_proxy.h"
@@ -211,6 +212,7 @@ int PlayerServiceStub::OnRemoteRequest(uint32_t code, MessageParcel &data, Messa
             MEDIA_LOGI("0x%{public}06" PRIXPTR " %{public}s", FAKE_POINTER(this), funcName.c_str());
         }
         if (memberFunc != nullptr) {
+            auto startTime = std::chrono::steady_clock::now();
             auto task = std::make_shared<TaskHandler<int>>([&, this] {
                 (void)IpcRecovery(false);
                 int32_t ret = -1;
@@ -219,6 +221,11 @@ int PlayerServiceStub::OnRemoteRequest(uint32_t code, MessageParcel &data, Messa
             });
             (void)taskQue_.EnqueueTask(task);
             auto result = task->GetResult();
+            if (playerServer_ != nullptr) {
+                std::static_pointer_cast<PlayerServer>(playerServer_)->RecordIpcLatency(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - startTime).count());
+            }
             CHECK_AND_RETURN_RET_LOG(result.HasResult(), MSERR_INVALID_OPERATION,
                 "failed to OnRemoteRequest code: %{public}u", code);
             return result.Value();
@@ -16,6 +16,9 @@
 #include "app_state_listener.h"
 #include "player_mem_manage.h"
 #include "media_log.h"
+#ifdef SUPPORT_TRANSCODER
+#include "transcoder_job_scheduler.h"
+#endif
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_PLAYER, "AppStateListener"};
@@ -68,6 +71,13 @@ void AppStateListener::OnAppStateChanged(int32_t pid, int32_t uid, int32_t state
 {
     MEDIA_LOGI("enter pid:%{public}d, uid:%{public}d, state:%{public}d", pid, uid, state);
     PlayerMemManage::GetInstance().RecordAppState(uid, pid, state);
+#ifdef SUPPORT_TRANSCODER
+    if (state == static_cast<int32_t>(AppState::APP_STATE_FRONT_GROUND) ||
+        state == static_cast<int32_t>(AppState::APP_STATE_BACK_GROUND)) {
+        TransCoderJobScheduler::GetInstance().OnAppStateChanged(pid,
+            state == static_cast<int32_t>(AppState::APP_STATE_FRONT_GROUND));
+    }
+#endif
 }
 }
 }
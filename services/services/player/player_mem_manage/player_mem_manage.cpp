@@ -14,12 +14,13 @@
  */
 
 #include "player_mem_manage.h"
-#include <unistd.h>
+#include <algorithm>
 #include <functional>
 #include "media_log.h"
 #include "media_errors.h"
 #include "mem_mgr_client.h"
 #include "hisysevent.h"
+#include "param_wrapper.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_PLAYER, "PlayerMemManage"};
@@ -27,8 +28,8 @@ namespace {
 
 namespace OHOS {
 namespace Media {
-constexpr double APP_BACK_GROUND_DESTROY_MEMERY_TIME = 60.0;
-constexpr double APP_FRONT_GROUND_DESTROY_MEMERY_TIME = 120.0;
+constexpr std::chrono::seconds APP_BACK_GROUND_DESTROY_MEMERY_TIME(60);
+constexpr std::chrono::seconds APP_FRONT_GROUND_DESTROY_MEMERY_TIME(120);
 
 // HiSysEvent
 const std::string PURGEABLE_EVENT_NAME = "MEMORY_PURGEABLE_INFO";
@@ -43,6 +44,7 @@ PlayerMemManage& PlayerMemManage::GetInstance()
 }
 
 PlayerMemManage::PlayerMemManage()
+    : isIdleReclaimEnabled_(OHOS::system::GetBoolParameter("sys.media.player.idleReclaimEnable", false))
 {
     MEDIA_LOGI("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
 }
@@ -50,60 +52,105 @@ PlayerMemManage::PlayerMemManage()
 PlayerMemManage::~PlayerMemManage()
 {
     Memory::MemMgrClient::GetInstance().UnsubscribeAppState(*appStateListener_);
-    if (isProbeTaskCreated_) {
-        isProbeTaskCreated_ = false;
-        probeTaskQueue_->Stop();
-        probeTaskQueue_ = nullptr;
+    {
+        std::lock_guard<std::recursive_mutex> lock(recTaskMutex_);
+        StopProbeTask();
     }
     playerManage_.clear();
     MEDIA_LOGI("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
 }
 
-void PlayerMemManage::FindBackGroundPlayerFromVec(AppPlayerInfo &appPlayerInfo)
+void PlayerMemManage::ProbePlayer(const PlayerProbeTarget &target)
 {
-    if (appPlayerInfo.appState == static_cast<int32_t>(AppState::APP_STATE_BACK_GROUND)) {
-        std::chrono::duration<double> durationCost = std::chrono::duration_cast<
-        std::chrono::duration<double>>(std::chrono::steady_clock::now() - appPlayerInfo.appEnterBackTime);
-        if (durationCost.count() > APP_BACK_GROUND_DESTROY_MEMERY_TIME) {
-            for (auto iter = appPlayerInfo.memRecallStructVec.begin();
-                iter != appPlayerInfo.memRecallStructVec.end(); iter++) {
-                ((*iter).resetBackGroundRecall)();
-            }
+    auto uidIter = playerManage_.find(target.uid);
+    CHECK_AND_RETURN(uidIter != playerManage_.end());
+    auto pidIter = uidIter->second.find(target.pid);
+    CHECK_AND_RETURN(pidIter != uidIter->second.end());
+    auto &appPlayerInfo = pidIter->second;
+    bool isFrontGround = appPlayerInfo.appState == static_cast<int32_t>(AppState::APP_STATE_FRONT_GROUND);
+    bool isBackGround = appPlayerInfo.appState == static_cast<int32_t>(AppState::APP_STATE_BACK_GROUND);
+    CHECK_AND_RETURN(isFrontGround || isBackGround);
+    for (auto &memRecallStruct : appPlayerInfo.memRecallStructVec) {
+        if (memRecallStruct.signAddr != target.signAddr) {
+            continue;
+        }
+        // the player answers through SchedulePlayerProbe with the time it may be reclaimed at, until then the next
+        // probe is one idle period away, so a recall that never reaches the player is still retried
+        ScheduleProbe(target, std::chrono::steady_clock::now() +
+            (isBackGround ? APP_BACK_GROUND_DESTROY_MEMERY_TIME : APP_FRONT_GROUND_DESTROY_MEMERY_TIME));
+        if (isFrontGround) {
+            (memRecallStruct.resetFrontGroundRecall)();
+        } else {
+            (memRecallStruct.resetBackGroundRecall)();
         }
+        return;
     }
 }
 
-void PlayerMemManage::FindFrontGroundPlayerFromVec(AppPlayerInfo &appPlayerInfo)
+void PlayerMemManage::ProbeTask()
 {
-    if (appPlayerInfo.appState == static_cast<int32_t>(AppState::APP_STATE_FRONT_GROUND)) {
-        std::chrono::duration<double> durationCost = std::chrono::duration_cast<
-            std::chrono::duration<double>>(std::chrono::steady_clock::now() - appPlayerInfo.appEnterFrontTime);
-        if (durationCost.count() > APP_FRONT_GROUND_DESTROY_MEMERY_TIME) {
-            for (auto iter = appPlayerInfo.memRecallStructVec.begin();
-                iter != appPlayerInfo.memRecallStructVec.end(); iter++) {
-                ((*iter).resetFrontGroundRecall)();
-            }
-        }
+    PlayerProbeTarget target;
+    while (probeScheduler_.WaitForDue(target)) {
+        std::lock_guard<std::recursive_mutex> lock(recMutex_);
+        ProbePlayer(target);
     }
 }
 
-void PlayerMemManage::FindProbeTaskPlayer()
+void PlayerMemManage::ScheduleProbe(const PlayerProbeTarget &target,
+    std::chrono::steady_clock::time_point deadline)
 {
-    std::lock_guard<std::recursive_mutex> lock(recMutex_);
-    for (auto &[uid, pidPlayersInfo] : playerManage_) {
-        for (auto &[pid, appPlayerInfo] : pidPlayersInfo) {
-            FindFrontGroundPlayerFromVec(appPlayerInfo);
-            FindBackGroundPlayerFromVec(appPlayerInfo);
+    if (isIdleReclaimEnabled_) {
+        probeScheduler_.Schedule(target, deadline);
+    }
+}
+
+void PlayerMemManage::ScheduleAppProbes(int32_t uid, int32_t pid, const AppPlayerInfo &appPlayerInfo)
+{
+    bool isFrontGround = appPlayerInfo.appState == static_cast<int32_t>(AppState::APP_STATE_FRONT_GROUND);
+    bool isBackGround = appPlayerInfo.appState == static_cast<int32_t>(AppState::APP_STATE_BACK_GROUND);
+    auto deadline = std::chrono::steady_clock::now() +
+        (isBackGround ? APP_BACK_GROUND_DESTROY_MEMERY_TIME : APP_FRONT_GROUND_DESTROY_MEMERY_TIME);
+    for (const auto &memRecallStruct : appPlayerInfo.memRecallStructVec) {
+        if (isFrontGround || isBackGround) {
+            ScheduleProbe(PlayerProbeTarget {uid, pid, memRecallStruct.signAddr}, deadline);
+        } else {
+            probeScheduler_.Cancel(memRecallStruct.signAddr);
         }
     }
 }
 
-void PlayerMemManage::ProbeTask()
+void PlayerMemManage::StartProbeTask()
 {
-    while (isProbeTaskCreated_) {
-        FindProbeTaskPlayer();
-        sleep(1);  // 1 : one second interval check
+    if (!isIdleReclaimEnabled_ || isProbeTaskCreated_) {
+        return;
+    }
+    MEDIA_LOGI("Start probe task");
+    probeTaskQueue_ = std::make_unique<TaskQueue>("probeTaskQueue");
+    CHECK_AND_RETURN_LOG(probeTaskQueue_->Start() == MSERR_OK, "init task failed");
+    probeScheduler_.Start();
+    auto task = std::make_shared<TaskHandler<void>>([this] {
+        ProbeTask();
+    });
+    if (probeTaskQueue_->EnqueueTask(task) != MSERR_OK) {
+        MEDIA_LOGE("enqueue probe task failed");
+        probeScheduler_.Stop();
+        probeTaskQueue_->Stop();
+        probeTaskQueue_ = nullptr;
+        return;
     }
+    isProbeTaskCreated_ = true;
+}
+
+void PlayerMemManage::StopProbeTask()
+{
+    if (!isProbeTaskCreated_) {
+        return;
+    }
+    MEDIA_LOGI("Stop probe task");
+    isProbeTaskCreated_ = false;
+    probeScheduler_.Stop();
+    probeTaskQueue_->Stop();
+    probeTaskQueue_ = nullptr;
 }
 
 bool PlayerMemManage::Init()
@@ -152,19 +199,15 @@ int32_t PlayerMemManage::RegisterPlayerServer(int32_t uid, int32_t pid, const Me
 
         auto &appPlayerInfo = pidIter->second;
         appPlayerInfo.memRecallStructVec.push_back(memRecallStruct);
+        auto idleTime = appPlayerInfo.appState == static_cast<int32_t>(AppState::APP_STATE_BACK_GROUND) ?
+            APP_BACK_GROUND_DESTROY_MEMERY_TIME : APP_FRONT_GROUND_DESTROY_MEMERY_TIME;
+        ScheduleProbe(PlayerProbeTarget {uid, pid, memRecallStruct.signAddr},
+            std::chrono::steady_clock::now() + idleTime);
     }
 
     {
         std::lock_guard<std::recursive_mutex> lock(recTaskMutex_);
-        if (!isProbeTaskCreated_) {
-            MEDIA_LOGI("Start probe task");
-            isProbeTaskCreated_ = true;
-            probeTaskQueue_ = std::make_unique<TaskQueue>("probeTaskQueue");
-            CHECK_AND_RETURN_RET_LOG(probeTaskQueue_->Start() == MSERR_OK, false, "init task failed");
-            auto task = std::make_shared<TaskHandler<void>>([this] {
-                ProbeTask();
-            });
-        }
+        StartProbeTask();
     }
 
     return MSERR_OK;
@@ -192,6 +235,7 @@ int32_t PlayerMemManage::DeregisterPlayerServer(const MemManageRecall &memRecall
     {
         std::lock_guard<std::recursive_mutex> lock(recMutex_);
         MEDIA_LOGD("Deregister PlayerServerTask");
+        probeScheduler_.Cancel(memRecallStruct.signAddr);
         for (auto &[uid, pidPlayersInfo] : playerManage_) {
             for (auto &[pid, appPlayerInfo] : pidPlayersInfo) {
                 FindDeregisterPlayerFromVec(isFind, appPlayerInfo, memRecallStruct);
@@ -214,11 +258,8 @@ int32_t PlayerMemManage::DeregisterPlayerServer(const MemManageRecall &memRecall
 
     {
         std::lock_guard<std::recursive_mutex> lock(recTaskMutex_);
-        if (isProbeTaskCreated_ && playerManage_.size() == 0) {
-            MEDIA_LOGI("Stop probe task");
-            isProbeTaskCreated_ = false;
-            probeTaskQueue_->Stop();
-            probeTaskQueue_ = nullptr;
+        if (playerManage_.size() == 0) {
+            StopProbeTask();
         }
     }
 
@@ -230,6 +271,25 @@ int32_t PlayerMemManage::DeregisterPlayerServer(const MemManageRecall &memRecall
     return MSERR_OK;
 }
 
+int32_t PlayerMemManage::SchedulePlayerProbe(const MemManageRecall &memRecallStruct, int64_t delayMs)
+{
+    std::lock_guard<std::recursive_mutex> lock(recMutex_);
+    for (auto &[uid, pidPlayersInfo] : playerManage_) {
+        for (auto &[pid, appPlayerInfo] : pidPlayersInfo) {
+            for (const auto &registered : appPlayerInfo.memRecallStructVec) {
+                if (registered.signAddr != memRecallStruct.signAddr) {
+                    continue;
+                }
+                ScheduleProbe(PlayerProbeTarget {uid, pid, memRecallStruct.signAddr},
+                    std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max<int64_t>(delayMs, 0)));
+                return MSERR_OK;
+            }
+        }
+    }
+    MEDIA_LOGD("0x%{public}06" PRIXPTR " player already deregister, no probe", FAKE_POINTER(this));
+    return MSERR_INVALID_OPERATION;
+}
+
 /* mem_mgr_client : currently dose not support the trigger this interface */
 int32_t PlayerMemManage::HandleForceReclaim(int32_t uid, int32_t pid)
 {
@@ -341,7 +401,11 @@ int32_t PlayerMemManage::RecordAppState(int32_t uid, int32_t pid, int32_t state)
         }
         for (auto &[findPid, appPlayerInfo] : pidPlayersInfo) {
             if (findPid == pid) {
+                int32_t lastState = appPlayerInfo.appState;
                 SetAppPlayerInfo(appPlayerInfo, state);
+                if (lastState != state) {
+                    ScheduleAppProbes(findUid, findPid, appPlayerInfo);
+                }
                 return MSERR_OK;
             }
         }
@@ -392,6 +456,7 @@ void PlayerMemManage::HandleOnRemoteDied(const wptr<IRemoteObject> &object)
             MEDIA_LOGI("Set all App front ground, uid:%{public}d, pid:%{public}d", findUid, findPid);
             appPlayerInfo.appState = static_cast<int32_t>(AppState::APP_STATE_FRONT_GROUND);
             appPlayerInfo.appEnterFrontTime = std::chrono::steady_clock::now();
+            ScheduleAppProbes(findUid, findPid, appPlayerInfo);
         }
     }
 }
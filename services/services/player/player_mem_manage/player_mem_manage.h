@@ -21,6 +21,7 @@
 #include <chrono>
 #include "task_queue.h"
 #include "app_state_listener.h"
+#include "player_probe_scheduler.h"
 
 namespace OHOS {
 namespace Media {
@@ -40,6 +41,7 @@ public:
     static PlayerMemManage& GetInstance();
     int32_t RegisterPlayerServer(int32_t uid, int32_t pid, const MemManageRecall &memRecallStruct);
     int32_t DeregisterPlayerServer(const MemManageRecall &memRecallStruct);
+    int32_t SchedulePlayerProbe(const MemManageRecall &memRecallStruct, int64_t delayMs);
     int32_t HandleForceReclaim(int32_t uid, int32_t pid);
     int32_t HandleOnTrim(Memory::SystemMemoryLevel level);
     int32_t RecordAppState(int32_t uid, int32_t pid, int32_t state);
@@ -57,10 +59,12 @@ private:
     PlayerMemManage();
     bool Init();
     void ProbeTask();
+    void ProbePlayer(const PlayerProbeTarget &target);
+    void ScheduleProbe(const PlayerProbeTarget &target, std::chrono::steady_clock::time_point deadline);
+    void ScheduleAppProbes(int32_t uid, int32_t pid, const AppPlayerInfo &appPlayerInfo);
+    void StartProbeTask();
+    void StopProbeTask();
     void HandleOnTrimLevelLow();
-    void FindBackGroundPlayerFromVec(AppPlayerInfo &appPlayerInfo);
-    void FindFrontGroundPlayerFromVec(AppPlayerInfo &appPlayerInfo);
-    void FindProbeTaskPlayer();
     void FindDeregisterPlayerFromVec(bool &isFind, AppPlayerInfo &appPlayerInfo,
         const MemManageRecall &memRecallStruct);
     void AwakeFrontGroundAppMedia(AppPlayerInfo &appPlayerInfo);
@@ -78,6 +82,9 @@ private:
     std::unordered_map<int32_t, PidPlayersInfo> playerManage_;
     std::unique_ptr<TaskQueue> probeTaskQueue_;
     bool isProbeTaskCreated_ = false;
+    // idle players are only reclaimed with sys.media.player.idleReclaimEnable set
+    bool isIdleReclaimEnabled_ = false;
+    PlayerProbeScheduler probeScheduler_;
 };
 }
 }
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2024. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "player_probe_scheduler.h"
+
+namespace OHOS {
+namespace Media {
+void PlayerProbeScheduler::Start()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isRunning_ = true;
+}
+
+void PlayerProbeScheduler::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isRunning_ = false;
+    cond_.notify_all();
+}
+
+void PlayerProbeScheduler::Schedule(const PlayerProbeTarget &target, std::chrono::steady_clock::time_point deadline)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CancelLocked(target.signAddr);
+    auto iter = deadlines_.emplace(deadline, target);
+    if (iter == deadlines_.begin()) {
+        cond_.notify_all();
+    }
+}
+
+void PlayerProbeScheduler::Cancel(void *signAddr)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CancelLocked(signAddr);
+}
+
+void PlayerProbeScheduler::CancelLocked(void *signAddr)
+{
+    for (auto iter = deadlines_.begin(); iter != deadlines_.end(); iter++) {
+        if (iter->second.signAddr == signAddr) {
+            deadlines_.erase(iter);
+            return;
+        }
+    }
+}
+
+bool PlayerProbeScheduler::GetDeadline(void *signAddr, std::chrono::steady_clock::time_point &deadline)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &[time, target] : deadlines_) {
+        if (target.signAddr == signAddr) {
+            deadline = time;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PlayerProbeScheduler::WaitForDue(PlayerProbeTarget &target)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (isRunning_) {
+        if (deadlines_.empty()) {
+            cond_.wait(lock);
+            continue;
+        }
+        auto deadline = deadlines_.begin()->first;
+        if (std::chrono::steady_clock::now() < deadline) {
+            cond_.wait_until(lock, deadline);
+            continue;
+        }
+        target = deadlines_.begin()->second;
+        deadlines_.erase(deadlines_.begin());
+        return true;
+    }
+    return false;
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2024. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PLAYER_PROBE_SCHEDULER_H
+#define PLAYER_PROBE_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+namespace OHOS {
+namespace Media {
+struct PlayerProbeTarget {
+    int32_t uid = 0;
+    int32_t pid = 0;
+    void *signAddr = nullptr;
+};
+
+/**
+ * One probe deadline per player, ordered by time. WaitForDue sleeps until the earliest deadline, an earlier one
+ * being scheduled or Stop, and hands the due player out with its deadline removed.
+ */
+class PlayerProbeScheduler {
+public:
+    PlayerProbeScheduler() = default;
+    ~PlayerProbeScheduler() = default;
+
+    void Start();
+    void Stop();
+    // replaces the deadline the player had
+    void Schedule(const PlayerProbeTarget &target, std::chrono::steady_clock::time_point deadline);
+    void Cancel(void *signAddr);
+    bool GetDeadline(void *signAddr, std::chrono::steady_clock::time_point &deadline);
+    // returns false once stopped
+    bool WaitForDue(PlayerProbeTarget &target);
+
+private:
+    void CancelLocked(void *signAddr);
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool isRunning_ = false;
+    std::multimap<std::chrono::steady_clock::time_point, PlayerProbeTarget> deadlines_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // PLAYER_PROBE_SCHEDULER_H
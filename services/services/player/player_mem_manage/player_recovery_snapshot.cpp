@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2024. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "player_recovery_snapshot.h"
+#include <algorithm>
+
+namespace {
+    // a paused player shows the frame it recovers to, only this close to the start is a sync frame close enough
+    constexpr int32_t MAX_PAUSED_REWIND_MS = 500;
+}
+
+namespace OHOS {
+namespace Media {
+bool PlayerRecoverySnapshot::NeedSeek() const
+{
+    return positionMs > 0;
+}
+
+PlayerRecoverySeek PlayerRecoverySnapshot::GetRecoverSeek(bool keyFrameSeekEnabled) const
+{
+    PlayerRecoverySeek seek;
+    seek.positionMs = durationMs > 0 ? std::clamp(positionMs, 0, durationMs) : std::max(positionMs, 0);
+    // every audio frame is a sync frame, only video has frames to skip decoding. A playing player moves on from
+    // wherever it lands, a paused one must show the frame it was paused on unless the rewind is known to be small
+    bool isRewindAcceptable = isPlaying || seek.positionMs <= MAX_PAUSED_REWIND_MS;
+    seek.toKeyFrame = keyFrameSeekEnabled && videoIndex >= 0 && isRewindAcceptable;
+    return seek;
+}
+
+void PlayerRecoverySnapshot::Dump(std::string &dumpString) const
+{
+    dumpString += "Recovery snapshot: position " + std::to_string(positionMs) + " ms" +
+        ", duration " + std::to_string(durationMs) + " ms" +
+        ", size " + std::to_string(videoWidth) + "x" + std::to_string(videoHeight) +
+        ", tracks audio " + std::to_string(audioIndex) + " video " + std::to_string(videoIndex) +
+        " text " + std::to_string(textIndex) +
+        ", playing " + (isPlaying ? "Yes" : "No") + "\n";
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2024. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PLAYER_RECOVERY_SNAPSHOT_H
+#define PLAYER_RECOVERY_SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+
+namespace OHOS {
+namespace Media {
+struct PlayerRecoverySeek {
+    int32_t positionMs = 0;
+    // land on the sync frame at or before positionMs instead of decoding forward to it, only while playing or
+    // close to the start
+    bool toKeyFrame = false;
+};
+
+/**
+ * Where playback of a local player stood and which tracks it played, taken right before PlayerServerMem releases
+ * the player. The getters answer from it while the player is released, the recover path seeks back with it.
+ */
+struct PlayerRecoverySnapshot {
+    int32_t positionMs = 0;
+    int32_t durationMs = 0;
+    int32_t videoWidth = 0;
+    int32_t videoHeight = 0;
+    int32_t audioIndex = -1;
+    int32_t videoIndex = -1;
+    int32_t textIndex = -1;
+    bool isPlaying = false;
+
+    bool NeedSeek() const;
+    PlayerRecoverySeek GetRecoverSeek(bool keyFrameSeekEnabled) const;
+    void Dump(std::string &dumpString) const;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // PLAYER_RECOVERY_SNAPSHOT_H
@@ -31,10 +31,9 @@ namespace {
 
 namespace OHOS {
 namespace Media {
-constexpr int32_t CONTINUE_RESET_MAX_NUM = 5;
 constexpr int32_t WAIT_RECOVER_TIME_SEC = 1;
-constexpr double APP_BACK_GROUND_DESTROY_MEMERY_LAST_SET_TIME = 60.0;
-constexpr double APP_FRONT_GROUND_DESTROY_MEMERY_LAST_SET_TIME = 120.0;
+constexpr int64_t APP_BACK_GROUND_DESTROY_MEMERY_LAST_SET_TIME_MS = 60000;
+constexpr int64_t APP_FRONT_GROUND_DESTROY_MEMERY_LAST_SET_TIME_MS = 120000;
 std::shared_ptr<IPlayerService> PlayerServerMem::Create()
 {
     MEDIA_LOGD("Create new PlayerServerMem");
@@ -177,19 +176,19 @@ int32_t PlayerServerMem::SetBehaviorInternal()
 {
     int ret = MSERR_OK;
     MEDIA_LOGI("speedMode:%{public}d currentTime:%{public}d audioIndex:%{public}d",
-        recoverConfig_.speedMode, recoverConfig_.currentTime, recoverConfig_.audioIndex);
+        recoverConfig_.speedMode, recoverConfig_.snapshot.positionMs, recoverConfig_.snapshot.audioIndex);
     if (recoverConfig_.speedMode != SPEED_FORWARD_1_00_X) {
         ret = PlayerServer::SetPlaybackSpeed(recoverConfig_.speedMode);
         CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "failed to SetPlaybackSpeed");
     }
 
-    if (recoverConfig_.currentTime != 0) {
-        ret = PlayerServer::Seek(recoverConfig_.currentTime, SEEK_CLOSEST);
+    if (recoverConfig_.snapshot.NeedSeek()) {
+        ret = SeekToSnapshotPosition();
         CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "failed to Seek");
     }
 
     if (NeedSelectAudioTrack()) {
-        ret = PlayerServer::SelectTrack(recoverConfig_.audioIndex, PlayerSwitchMode::SWITCH_SMOOTH);
+        ret = PlayerServer::SelectTrack(recoverConfig_.snapshot.audioIndex, PlayerSwitchMode::SWITCH_SMOOTH);
         CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "failed to SelectTrack");
     }
 
@@ -198,7 +197,8 @@ int32_t PlayerServerMem::SetBehaviorInternal()
 
 int32_t PlayerServerMem::SetPlaybackSpeedInternal()
 {
-    MEDIA_LOGI("speedMode:%{public}d audioIndex:%{public}d", recoverConfig_.speedMode, recoverConfig_.audioIndex);
+    MEDIA_LOGI("speedMode:%{public}d audioIndex:%{public}d",
+        recoverConfig_.speedMode, recoverConfig_.snapshot.audioIndex);
     int ret;
     if (recoverConfig_.speedMode != SPEED_FORWARD_1_00_X) {
         ret = PlayerServer::SetPlaybackSpeed(recoverConfig_.speedMode);
@@ -206,12 +206,25 @@ int32_t PlayerServerMem::SetPlaybackSpeedInternal()
     }
 
     if (NeedSelectAudioTrack()) {
-        ret = PlayerServer::SelectTrack(recoverConfig_.audioIndex, PlayerSwitchMode::SWITCH_SMOOTH);
+        ret = PlayerServer::SelectTrack(recoverConfig_.snapshot.audioIndex, PlayerSwitchMode::SWITCH_SMOOTH);
         CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "failed to SelectTrack");
     }
     return MSERR_OK;
 }
 
+int32_t PlayerServerMem::SeekToSnapshotPosition()
+{
+    std::string enable;
+    (void)OHOS::system::GetStringParameter("sys.media.player.recover.keyframe.enable", enable, "true");
+    PlayerRecoverySeek seek = recoverConfig_.snapshot.GetRecoverSeek(enable == "true");
+    // the demuxer finds the sync frame in its index, nothing is decoded and dropped on the way to the position,
+    // playback resumes up to one GOP before the position the player was released at. A paused player gets the
+    // exact frame back instead, see GetRecoverSeek
+    PlayerSeekMode mode = seek.toKeyFrame ? SEEK_PREVIOUS_SYNC : SEEK_CLOSEST;
+    MEDIA_LOGI("recover seek to %{public}d, mode %{public}d", seek.positionMs, mode);
+    return PlayerServer::Seek(seek.positionMs, mode);
+}
+
 void PlayerServerMem::SetResourceTypeBySysParam()
 {
     std::string cmd;
@@ -399,8 +412,8 @@ int32_t PlayerServerMem::GetCurrentTime(int32_t &currentTime)
 {
     std::unique_lock<std::mutex> lock(mutex_);
     if (isLocalResource_ && isReleaseMemByManage_) {
-        MEDIA_LOGI("User call GetCurrentTime:%{public}d", recoverConfig_.currentTime);
-        currentTime = recoverConfig_.currentTime;
+        MEDIA_LOGI("User call GetCurrentTime:%{public}d", recoverConfig_.snapshot.positionMs);
+        currentTime = recoverConfig_.snapshot.positionMs;
         return MSERR_OK;
     }
     return PlayerServer::GetCurrentTime(currentTime);
@@ -432,8 +445,8 @@ int32_t PlayerServerMem::GetVideoWidth()
 {
     std::unique_lock<std::mutex> lock(mutex_);
     if (isLocalResource_ && isReleaseMemByManage_) {
-        MEDIA_LOGI("User call GetVideoWidth:%{public}d", recoverConfig_.videoWidth);
-        return recoverConfig_.videoWidth;
+        MEDIA_LOGI("User call GetVideoWidth:%{public}d", recoverConfig_.snapshot.videoWidth);
+        return recoverConfig_.snapshot.videoWidth;
     }
     return PlayerServer::GetVideoWidth();
 }
@@ -442,8 +455,8 @@ int32_t PlayerServerMem::GetVideoHeight()
 {
     std::unique_lock<std::mutex> lock(mutex_);
     if (isLocalResource_ && isReleaseMemByManage_) {
-        MEDIA_LOGI("User call GetVideoHeight:%{public}d", recoverConfig_.videoHeight);
-        return recoverConfig_.videoHeight;
+        MEDIA_LOGI("User call GetVideoHeight:%{public}d", recoverConfig_.snapshot.videoHeight);
+        return recoverConfig_.snapshot.videoHeight;
     }
     return PlayerServer::GetVideoHeight();
 }
@@ -452,8 +465,8 @@ int32_t PlayerServerMem::GetDuration(int32_t &duration)
 {
     std::unique_lock<std::mutex> lock(mutex_);
     if (isLocalResource_ && isReleaseMemByManage_) {
-        MEDIA_LOGI("User call GetDuration:%{public}d", recoverConfig_.duration);
-        duration = recoverConfig_.duration;
+        MEDIA_LOGI("User call GetDuration:%{public}d", recoverConfig_.snapshot.durationMs);
+        duration = recoverConfig_.snapshot.durationMs;
         return MSERR_OK;
     }
     return PlayerServer::GetDuration(duration);
@@ -497,8 +510,8 @@ bool PlayerServerMem::IsPlaying()
 {
     std::unique_lock<std::mutex> lock(mutex_);
     if (isLocalResource_ && isReleaseMemByManage_) {
-        MEDIA_LOGI("User call IsPlaying:%{public}d", recoverConfig_.isPlaying);
-        return recoverConfig_.isPlaying;
+        MEDIA_LOGI("User call IsPlaying:%{public}d", recoverConfig_.snapshot.isPlaying);
+        return recoverConfig_.snapshot.isPlaying;
     }
     return PlayerServer::IsPlaying();
 }
@@ -612,11 +625,11 @@ int32_t PlayerServerMem::GetCurrentTrack(int32_t trackType, int32_t &index)
     std::unique_lock<std::mutex> lock(mutex_);
     if (isLocalResource_ && isReleaseMemByManage_) {
         if (trackType == MediaType::MEDIA_TYPE_AUD) {
-            index = recoverConfig_.audioIndex;
+            index = recoverConfig_.snapshot.audioIndex;
         } else if (trackType == MediaType::MEDIA_TYPE_VID) {
-            index = recoverConfig_.videoIndex;
+            index = recoverConfig_.snapshot.videoIndex;
         } else if (trackType == MediaType::MEDIA_TYPE_SUBTITLE) {
-            index = recoverConfig_.textIndex;
+            index = recoverConfig_.snapshot.textIndex;
         }  else {
             MEDIA_LOGE("User call GetCurrentTrack, Invalid trackType %{public}d", trackType);
             return MSERR_INVALID_OPERATION;
@@ -638,6 +651,9 @@ int32_t PlayerServerMem::DumpInfo(int32_t fd)
     } else {
         dumpString += "No\n";
     }
+    if (isLocalResource_ && isReleaseMemByManage_) {
+        recoverConfig_.snapshot.Dump(dumpString);
+    }
     write(fd, dumpString.c_str(), dumpString.size());
 
     return MSERR_OK;
@@ -718,25 +734,25 @@ void PlayerServerMem::OnInfo(PlayerOnInfoType type, int32_t extra, const Format
 
 int32_t PlayerServerMem::GetInformationBeforeMemReset()
 {
-    auto ret = PlayerServer::GetCurrentTime(recoverConfig_.currentTime);
+    auto ret = PlayerServer::GetCurrentTime(recoverConfig_.snapshot.positionMs);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "failed to GetCurrentTime");
     ret = PlayerServer::GetVideoTrackInfo(recoverConfig_.videoTrack);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "failed to GetVideoTrack");
     ret = PlayerServer::GetAudioTrackInfo(recoverConfig_.audioTrack);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "failed to GetAudioTrack");
 
-    ret = PlayerServer::GetCurrentTrack(MediaType::MEDIA_TYPE_AUD, recoverConfig_.audioIndex);
+    ret = PlayerServer::GetCurrentTrack(MediaType::MEDIA_TYPE_AUD, recoverConfig_.snapshot.audioIndex);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "failed to GetCurrentTrack");
-    ret = PlayerServer::GetCurrentTrack(MediaType::MEDIA_TYPE_VID, recoverConfig_.videoIndex);
+    ret = PlayerServer::GetCurrentTrack(MediaType::MEDIA_TYPE_VID, recoverConfig_.snapshot.videoIndex);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "failed to GetCurrentTrack");
-    ret = PlayerServer::GetCurrentTrack(MediaType::MEDIA_TYPE_SUBTITLE, recoverConfig_.textIndex);
+    ret = PlayerServer::GetCurrentTrack(MediaType::MEDIA_TYPE_SUBTITLE, recoverConfig_.snapshot.textIndex);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "failed to GetCurrentTrack");
 
-    recoverConfig_.videoWidth = PlayerServer::GetVideoWidth();
-    recoverConfig_.videoHeight = PlayerServer::GetVideoHeight();
-    ret = PlayerServer::GetDuration(recoverConfig_.duration);
+    recoverConfig_.snapshot.videoWidth = PlayerServer::GetVideoWidth();
+    recoverConfig_.snapshot.videoHeight = PlayerServer::GetVideoHeight();
+    ret = PlayerServer::GetDuration(recoverConfig_.snapshot.durationMs);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "failed to GetDuration");
-    recoverConfig_.isPlaying = PlayerServer::IsPlaying();
+    recoverConfig_.snapshot.isPlaying = PlayerServer::IsPlaying();
     recoverConfig_.effectMode = config_.effectMode;
     GetPlayerServerConfig();
 
@@ -861,7 +877,7 @@ void PlayerServerMem::RecoverToPrepared(PlayerOnInfoType type, int32_t extra)
 {
     if (NeedSelectAudioTrack() && type == INFO_TYPE_TRACKCHANGE) {
         (void)RecoverPlayerCb();
-    } else if (recoverConfig_.currentTime != 0 && type == INFO_TYPE_SEEKDONE) {
+    } else if (recoverConfig_.snapshot.NeedSeek() && type == INFO_TYPE_SEEKDONE) {
         (void)RecoverPlayerCb();
     } else if (recoverConfig_.speedMode != SPEED_FORWARD_1_00_X && type == INFO_TYPE_SPEEDDONE) {
         (void)RecoverPlayerCb();
@@ -891,44 +907,34 @@ void PlayerServerMem::CheckHasRecover(PlayerOnInfoType type, int32_t extra)
     }
 }
 
-void PlayerServerMem::ResetFrontGroundForMemManage()
+int64_t PlayerServerMem::ReleaseMemIfIdle(int64_t idleTimeMs)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (!PlayerServer::IsPrepared() || isAudioPlayer_) {
-        continueReset = 0;
-        return;
+    int64_t lastSetToNowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - lastestUserSetTime_).count();
+    if (lastSetToNowMs < idleTimeMs) {
+        return idleTimeMs - lastSetToNowMs;
     }
-    if (continueReset < CONTINUE_RESET_MAX_NUM) {
-        continueReset++;
-        return;
-    }
-    continueReset = 0;
+    ReleaseMemByManage();
+    return idleTimeMs;
+}
 
-    std::chrono::duration<double> lastSetToNow = std::chrono::duration_cast<
-        std::chrono::duration<double>>(std::chrono::steady_clock::now() - lastestUserSetTime_);
-    if (lastSetToNow.count() > APP_FRONT_GROUND_DESTROY_MEMERY_LAST_SET_TIME) {
-        ReleaseMemByManage();
+// returns the milliseconds after which PlayerMemManage should probe this player again
+int64_t PlayerServerMem::ResetFrontGroundForMemManage()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!PlayerServer::IsPrepared() || isAudioPlayer_) {
+        return APP_FRONT_GROUND_DESTROY_MEMERY_LAST_SET_TIME_MS;
     }
+    return ReleaseMemIfIdle(APP_FRONT_GROUND_DESTROY_MEMERY_LAST_SET_TIME_MS);
 }
 
-void PlayerServerMem::ResetBackGroundForMemManage()
+int64_t PlayerServerMem::ResetBackGroundForMemManage()
 {
     std::unique_lock<std::mutex> lock(mutex_);
     if (isAudioPlayer_ || PlayerServer::IsPlaying()) {
-        continueReset = 0;
-        return;
-    }
-    if (continueReset < CONTINUE_RESET_MAX_NUM) {
-        continueReset++;
-        return;
-    }
-    continueReset = 0;
-
-    std::chrono::duration<double> lastSetToNow = std::chrono::duration_cast<std::chrono::duration<double>>(
-        std::chrono::steady_clock::now() - lastestUserSetTime_);
-    if (lastSetToNow.count() > APP_BACK_GROUND_DESTROY_MEMERY_LAST_SET_TIME) {
-        ReleaseMemByManage();
+        return APP_BACK_GROUND_DESTROY_MEMERY_LAST_SET_TIME_MS;
     }
+    return ReleaseMemIfIdle(APP_BACK_GROUND_DESTROY_MEMERY_LAST_SET_TIME_MS);
 }
 
 void PlayerServerMem::ResetMemmgrForMemManage()
@@ -947,8 +953,8 @@ void PlayerServerMem::RecoverByMemManage()
 
 bool PlayerServerMem::NeedSelectAudioTrack()
 {
-    return (recoverConfig_.audioIndex >= 0 && defaultAudioIndex_ >= 0 &&
-        recoverConfig_.audioIndex != defaultAudioIndex_);
+    return (recoverConfig_.snapshot.audioIndex >= 0 && defaultAudioIndex_ >= 0 &&
+        recoverConfig_.snapshot.audioIndex != defaultAudioIndex_);
 }
 
 void PlayerServerMem::GetDefaultTrack(PlayerOnInfoType type, int32_t extra, const Format &infoBody)
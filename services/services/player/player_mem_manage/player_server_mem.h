@@ -20,6 +20,7 @@
 #include <chrono>
 #include "player_server.h"
 #include "player_server_state.h"
+#include "player_recovery_snapshot.h"
 
 namespace OHOS {
 namespace Media {
@@ -72,8 +73,8 @@ public:
     int32_t GetCurrentTrack(int32_t trackType, int32_t &index) override;
     int32_t DumpInfo(int32_t fd) override;
     void OnInfo(PlayerOnInfoType type, int32_t extra, const Format &infoBody = {}) override;
-    void ResetFrontGroundForMemManage();
-    void ResetBackGroundForMemManage();
+    int64_t ResetFrontGroundForMemManage();
+    int64_t ResetBackGroundForMemManage();
     void ResetMemmgrForMemManage();
     void RecoverByMemManage();
 
@@ -116,7 +117,6 @@ private:
         PlaybackRateMode speedMode = SPEED_FORWARD_1_00_X;
         sptr<Surface> surface = nullptr;
         bool loop = false;
-        bool isPlaying = false;
         int32_t videoScaleType = -1;
         int32_t contentType = -1;
         int32_t streamUsage = -1;
@@ -125,15 +125,9 @@ private:
         int32_t effectMode = OHOS::AudioStandard::AudioEffectMode::EFFECT_DEFAULT;
         std::shared_ptr<PlayerCallback> callback = nullptr;
         uint32_t bitRate = 0;
-        int32_t currentTime = 0;
         std::vector<Format> videoTrack;
         std::vector<Format> audioTrack;
-        int32_t videoWidth = 0;
-        int32_t videoHeight = 0;
-        int32_t duration = 0;
-        int32_t audioIndex = 0;
-        int32_t videoIndex = 0;
-        int32_t textIndex = 0;
+        PlayerRecoverySnapshot snapshot;
     } recoverConfig_;
     struct PlayerServerConfig {
         bool errorCbOnce = false;
@@ -146,7 +140,6 @@ private:
     bool isReleaseMemByManage_ = false;
     bool isRecoverMemByUser_ = false;
     bool isAudioPlayer_ = true;
-    int32_t continueReset = 0;
     std::map<void *, std::shared_ptr<MemBaseState>> stateMap_;
     std::chrono::steady_clock::time_point lastestUserSetTime_;
     std::condition_variable recoverCond_;
@@ -166,6 +159,7 @@ private:
     int32_t SetConfigInternal();
     int32_t SetBehaviorInternal();
     int32_t SetPlaybackSpeedInternal();
+    int32_t SeekToSnapshotPosition();
     int32_t GetInformationBeforeMemReset();
     void RecoverToInitialized(PlayerOnInfoType type, int32_t extra);
     void RecoverToPrepared(PlayerOnInfoType type, int32_t extra);
@@ -173,6 +167,7 @@ private:
     int32_t RecoverPlayerCb();
     void CheckHasRecover(PlayerOnInfoType type, int32_t extra);
     int32_t ReleaseMemByManage();
+    int64_t ReleaseMemIfIdle(int64_t idleTimeMs);
     int32_t RecoverMemByUser();
     bool NeedSelectAudioTrack();
     void GetDefaultTrack(PlayerOnInfoType type, int32_t extra, const Format &infoBody);
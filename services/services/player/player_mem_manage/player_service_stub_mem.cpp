@@ -112,7 +112,9 @@ void PlayerServiceStubMem::ResetFrontGroundForMemManageRecall()
 {
     auto task = std::make_shared<TaskHandler<void>>([&, this] {
         if (playerServer_ != nullptr) {
-            std::static_pointer_cast<PlayerServerMem>(playerServer_)->ResetFrontGroundForMemManage();
+            int64_t nextProbeMs =
+                std::static_pointer_cast<PlayerServerMem>(playerServer_)->ResetFrontGroundForMemManage();
+            PlayerMemManage::GetInstance().SchedulePlayerProbe(memRecallStruct_, nextProbeMs);
         }
         return;
     });
@@ -123,7 +125,9 @@ void PlayerServiceStubMem::ResetBackGroundForMemManageRecall()
 {
     auto task = std::make_shared<TaskHandler<void>>([&, this] {
         if (playerServer_ != nullptr) {
-            std::static_pointer_cast<PlayerServerMem>(playerServer_)->ResetBackGroundForMemManage();
+            int64_t nextProbeMs =
+                std::static_pointer_cast<PlayerServerMem>(playerServer_)->ResetBackGroundForMemManage();
+            PlayerMemManage::GetInstance().SchedulePlayerProbe(memRecallStruct_, nextProbeMs);
         }
         return;
     });
@@ -603,6 +603,11 @@ int32_t PlayerServer::OnStop(bool sync)
 int32_t PlayerServer::HandleStop()
 {
     ExitSeekContinous(false);
+    if (ipcLatencyHistogram_.GetCount() > 0) {
+        std::shared_ptr<Meta> meta = std::make_shared<Meta>();
+        ipcLatencyHistogram_.AppendToMeta(meta);
+        (void)AppendMediaInfo(meta, instanceId_);
+    }
     int32_t ret = playerEngine_->Stop();
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "Engine Stop Failed!");
 
@@ -640,6 +645,8 @@ int32_t PlayerServer::OnReset()
     lastOpStatus_ = PLAYER_IDLE;
     isLiveStream_ = false;
     subtitleTrackNum_ = 0;
+    // the stop above reported this session, the next source starts a fresh histogram
+    ipcLatencyHistogram_.Reset();
 
     return MSERR_OK;
 }
@@ -1374,11 +1381,17 @@ int32_t PlayerServer::DumpInfo(int32_t fd)
     int32_t currentTime = -1;
     (void)GetCurrentTime(currentTime);
     dumpString += "PlayerServer current time is: " + std::to_string(currentTime) + "\n";
+    dumpString += "PlayerServer " + ipcLatencyHistogram_.ToString();
     write(fd, dumpString.c_str(), dumpString.size());
 
     return MSERR_OK;
 }
 
+void PlayerServer::RecordIpcLatency(int64_t latencyUs)
+{
+    ipcLatencyHistogram_.Record(latencyUs);
+}
+
 void PlayerServer::OnError(PlayerErrorType errorType, int32_t errorCode)
 {
     (void)errorType;
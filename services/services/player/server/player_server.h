@@ -25,6 +25,7 @@
 #include "account_subscriber.h"
 #include "os_account_manager.h"
 #include "hitrace/tracechain.h"
+#include "latency_histogram.h"
 
 namespace OHOS {
 namespace Media {
@@ -113,6 +114,7 @@ public:
     int32_t SetParameter(const Format &param) override;
     int32_t SetPlayerCallback(const std::shared_ptr<PlayerCallback> &callback) override;
     virtual int32_t DumpInfo(int32_t fd);
+    void RecordIpcLatency(int64_t latencyUs);
     int32_t SelectBitRate(uint32_t bitRate) override;
     int32_t BackGroundChangeState(PlayerStates state, bool isBackGroundCb);
     int32_t SelectTrack(int32_t index, PlayerSwitchMode mode) override;
@@ -229,6 +231,7 @@ private:
     std::atomic<int32_t> userId_ = -1;
     std::atomic<bool> isBootCompleted_ = false;
     uint64_t instanceId_ = 0;
+    LatencyHistogram ipcLatencyHistogram_ {"av_player_ipc_latency_us"};
     std::shared_ptr<AVMediaSource> mediaSource_ = nullptr;
     AVPlayStrategy strategy_;
     std::atomic<bool> isInterruptNeeded_{false};
@@ -452,9 +452,10 @@ int32_t RecorderClient::SetFileSplitDuration(FileSplitType type, int64_t timesta
 
 int32_t RecorderClient::SetParameter(int32_t sourceId, const Format &format)
 {
-    (void)sourceId;
-    (void)format;
-    return MSERR_INVALID_OPERATION;
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(recorderProxy_ != nullptr, MSERR_NO_MEMORY, "recorder service does not exist.");
+
+    return recorderProxy_->SetParameter(sourceId, format);
 }
 
 int32_t RecorderClient::GetAVRecorderConfig(ConfigMap &configMap)
@@ -519,5 +520,24 @@ int32_t RecorderClient::SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer)
     MEDIA_LOGD("SetWatermark");
     return recorderProxy_->SetWatermark(waterMarkBuffer);
 }
+
+int32_t RecorderClient::SavePreCache(int32_t fd, int32_t duration)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(recorderProxy_ != nullptr, MSERR_NO_MEMORY, "recorder service does not exist.");
+
+    MEDIA_LOGD("SavePreCache fd(%{public}d), duration(%{public}d)", fd, duration);
+    return recorderProxy_->SavePreCache(fd, duration);
+}
+
+int32_t RecorderClient::SetAudioSharedRing(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd,
+    int32_t &sourceId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(recorderProxy_ != nullptr, MSERR_NO_MEMORY, "recorder service does not exist.");
+
+    MEDIA_LOGD("SetAudioSharedRing eventFd(%{public}d)", eventFd);
+    return recorderProxy_->SetAudioSharedRing(memory, eventFd, sourceId);
+}
 } // namespace Media
 } // namespace OHOS
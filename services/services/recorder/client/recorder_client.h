@@ -77,6 +77,9 @@ public:
     int32_t GetMaxAmplitude() override;
     int32_t IsWatermarkSupported(bool &isWatermarkSupported) override;
     int32_t SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer) override;
+    int32_t SavePreCache(int32_t fd, int32_t duration) override;
+    int32_t SetAudioSharedRing(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd,
+        int32_t &sourceId) override;
     // RecorderClient
     void MediaServerDied();
 
@@ -21,6 +21,7 @@
 #include "iremote_proxy.h"
 #include "iremote_stub.h"
 #include "recorder.h"
+#include "buffer/avsharedmemory.h"
 
 namespace OHOS {
 namespace Media {
@@ -93,6 +94,26 @@ public:
     virtual int32_t GetMaxAmplitude() = 0;
     virtual int32_t IsWatermarkSupported(bool &isWatermarkSupported) = 0;
     virtual int32_t SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer) = 0;
+    virtual int32_t SetParameter(int32_t sourceId, const Format &format)
+    {
+        (void)sourceId;
+        (void)format;
+        return MSERR_UNSUPPORT;
+    };
+    virtual int32_t SavePreCache(int32_t fd, int32_t duration)
+    {
+        (void)fd;
+        (void)duration;
+        return MSERR_UNSUPPORT;
+    };
+    virtual int32_t SetAudioSharedRing(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd,
+        int32_t &sourceId)
+    {
+        (void)memory;
+        (void)eventFd;
+        (void)sourceId;
+        return MSERR_UNSUPPORT;
+    };
     /**
      * IPC code ID
      */
@@ -144,6 +165,9 @@ public:
         SET_META_TIMED_KEY,
         SET_META_TRACK_SRC_MIME_TYPE,
         GET_META_SURFACE,
+        SET_PARAMETER,
+        SAVE_PRE_CACHE,
+        SET_AUDIO_SHARED_RING,
     };
 
     DECLARE_INTERFACE_DESCRIPTOR(u"IStandardRecorderService");
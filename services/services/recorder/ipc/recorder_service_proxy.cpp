@@ -17,6 +17,8 @@
 #include "recorder_listener_stub.h"
 #include "media_log.h"
 #include "media_errors.h"
+#include "media_parcel.h"
+#include "avsharedmemory_ipc.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_RECORDER, "RecorderServiceProxy"};
@@ -879,5 +881,64 @@ int32_t RecorderServiceProxy::SetWatermark(std::shared_ptr<AVBuffer> &waterMarkB
 
     return reply.ReadInt32();
 }
+
+int32_t RecorderServiceProxy::SetParameter(int32_t sourceId, const Format &format)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    bool token = data.WriteInterfaceToken(RecorderServiceProxy::GetDescriptor());
+    CHECK_AND_RETURN_RET_LOG(token, MSERR_INVALID_OPERATION, "Failed to write descriptor!");
+
+    data.WriteInt32(sourceId);
+    CHECK_AND_RETURN_RET_LOG(MediaParcel::Marshalling(data, format), MSERR_INVALID_OPERATION,
+        "Failed to write format!");
+
+    int error = Remote()->SendRequest(SET_PARAMETER, data, reply, option);
+    CHECK_AND_RETURN_RET_LOG(error == MSERR_OK, MSERR_INVALID_OPERATION,
+        "SetParameter failed, error: %{public}d", error);
+
+    return reply.ReadInt32();
+}
+
+int32_t RecorderServiceProxy::SavePreCache(int32_t fd, int32_t duration)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    bool token = data.WriteInterfaceToken(RecorderServiceProxy::GetDescriptor());
+    CHECK_AND_RETURN_RET_LOG(token, MSERR_INVALID_OPERATION, "Failed to write descriptor!");
+
+    (void)data.WriteFileDescriptor(fd);
+    data.WriteInt32(duration);
+    int error = Remote()->SendRequest(SAVE_PRE_CACHE, data, reply, option);
+    CHECK_AND_RETURN_RET_LOG(error == MSERR_OK, MSERR_INVALID_OPERATION,
+        "SavePreCache failed, error: %{public}d", error);
+
+    return reply.ReadInt32();
+}
+
+int32_t RecorderServiceProxy::SetAudioSharedRing(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd,
+    int32_t &sourceId)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    bool token = data.WriteInterfaceToken(RecorderServiceProxy::GetDescriptor());
+    CHECK_AND_RETURN_RET_LOG(token, MSERR_INVALID_OPERATION, "Failed to write descriptor!");
+
+    int32_t ret = WriteAVSharedMemoryToParcel(memory, data);
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "write ring memory failed");
+    (void)data.WriteFileDescriptor(eventFd);
+    int error = Remote()->SendRequest(SET_AUDIO_SHARED_RING, data, reply, option);
+    CHECK_AND_RETURN_RET_LOG(error == MSERR_OK, MSERR_INVALID_OPERATION,
+        "SetAudioSharedRing failed, error: %{public}d", error);
+
+    sourceId = reply.ReadInt32();
+    return reply.ReadInt32();
+}
 } // namespace Media
 } // namespace OHOS
@@ -23,6 +23,7 @@
 #include "media_permission.h"
 #include "accesstoken_kit.h"
 #include "media_dfx.h"
+#include "avsharedmemory_ipc.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_RECORDER, "RecorderServiceStub"};
@@ -98,6 +99,8 @@ void RecorderServiceStub::FillRecFuncPart1()
         [this](MessageParcel &data, MessageParcel &reply) { return SetOutputFormat(data, reply); };
     recFuncs_[SET_OUTPUT_FILE] =
         [this](MessageParcel &data, MessageParcel &reply) { return SetOutputFile(data, reply); };
+    recFuncs_[SET_NEXT_OUTPUT_FILE] =
+        [this](MessageParcel &data, MessageParcel &reply) { return SetNextOutputFile(data, reply); };
     recFuncs_[SET_LOCATION] =
         [this](MessageParcel &data, MessageParcel &reply) { return SetLocation(data, reply); };
     recFuncs_[SET_ORIENTATION_HINT] =
@@ -106,6 +109,8 @@ void RecorderServiceStub::FillRecFuncPart1()
         [this](MessageParcel &data, MessageParcel &reply) { return SetUserCustomInfo(data, reply); };
     recFuncs_[SET_GENRE] =
         [this](MessageParcel &data, MessageParcel &reply) { return SetGenre(data, reply); };
+    recFuncs_[SET_FILE_SPLIT_DURATION] =
+        [this](MessageParcel &data, MessageParcel &reply) { return SetFileSplitDuration(data, reply); };
     recFuncs_[PREPARE] =
         [this](MessageParcel &data, MessageParcel &reply) { return Prepare(data, reply); };
 }
@@ -156,6 +161,12 @@ void RecorderServiceStub::FillRecFuncPart2()
         [this](MessageParcel &data, MessageParcel &reply) { return SetMetaSourceTrackMime(data, reply); };
     recFuncs_[GET_META_SURFACE] =
         [this](MessageParcel &data, MessageParcel &reply) { return GetMetaSurface(data, reply); };
+    recFuncs_[SET_PARAMETER] =
+        [this](MessageParcel &data, MessageParcel &reply) { return SetParameter(data, reply); };
+    recFuncs_[SAVE_PRE_CACHE] =
+        [this](MessageParcel &data, MessageParcel &reply) { return SavePreCache(data, reply); };
+    recFuncs_[SET_AUDIO_SHARED_RING] =
+        [this](MessageParcel &data, MessageParcel &reply) { return SetAudioSharedRing(data, reply); };
 }
 
 int32_t RecorderServiceStub::DestroyStub()
@@ -388,6 +399,18 @@ int32_t RecorderServiceStub::SetOutputFile(int32_t fd)
     return recorderServer_->SetOutputFile(fd);
 }
 
+int32_t RecorderServiceStub::SetNextOutputFile(int32_t fd)
+{
+    CHECK_AND_RETURN_RET_LOG(recorderServer_ != nullptr, MSERR_NO_MEMORY, "recorder server is nullptr");
+    return recorderServer_->SetNextOutputFile(fd);
+}
+
+int32_t RecorderServiceStub::SetFileSplitDuration(FileSplitType type, int64_t timestamp, uint32_t duration)
+{
+    CHECK_AND_RETURN_RET_LOG(recorderServer_ != nullptr, MSERR_NO_MEMORY, "recorder server is nullptr");
+    return recorderServer_->SetFileSplitDuration(type, timestamp, duration);
+}
+
 int32_t RecorderServiceStub::SetLocation(float latitude, float longitude)
 {
     CHECK_AND_RETURN_RET_LOG(recorderServer_ != nullptr, MSERR_NO_MEMORY, "recorder server is nullptr");
@@ -492,6 +515,25 @@ int32_t RecorderServiceStub::SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBu
     return recorderServer_->SetWatermark(waterMarkBuffer);
 }
 
+int32_t RecorderServiceStub::SetParameter(int32_t sourceId, const Format &format)
+{
+    CHECK_AND_RETURN_RET_LOG(recorderServer_ != nullptr, MSERR_NO_MEMORY, "recorder server is nullptr");
+    return recorderServer_->SetParameter(sourceId, format);
+}
+
+int32_t RecorderServiceStub::SavePreCache(int32_t fd, int32_t duration)
+{
+    CHECK_AND_RETURN_RET_LOG(recorderServer_ != nullptr, MSERR_NO_MEMORY, "recorder server is nullptr");
+    return recorderServer_->SavePreCache(fd, duration);
+}
+
+int32_t RecorderServiceStub::SetAudioSharedRing(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd,
+    int32_t &sourceId)
+{
+    CHECK_AND_RETURN_RET_LOG(recorderServer_ != nullptr, MSERR_NO_MEMORY, "recorder server is nullptr");
+    return recorderServer_->SetAudioSharedRing(memory, eventFd, sourceId);
+}
+
 int32_t RecorderServiceStub::DoIpcAbnormality()
 {
     MEDIA_LOGI("Enter DoIpcAbnormality.");
@@ -715,6 +757,25 @@ int32_t RecorderServiceStub::SetOutputFile(MessageParcel &data, MessageParcel &r
     return MSERR_OK;
 }
 
+int32_t RecorderServiceStub::SetNextOutputFile(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t fd = data.ReadFileDescriptor();
+    reply.WriteInt32(SetNextOutputFile(fd));
+    (void)::close(fd);
+    return MSERR_OK;
+}
+
+int32_t RecorderServiceStub::SetFileSplitDuration(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t type = data.ReadInt32();
+    int64_t timestamp = data.ReadInt64();
+    uint32_t duration = data.ReadUint32();
+    CHECK_AND_RETURN_RET_LOG(type >= FileSplitType::FILE_SPLIT_POST && type < FileSplitType::FILE_SPLIT_BUTT,
+        MSERR_INVALID_VAL, "invalid file split type %{public}d", type);
+    reply.WriteInt32(SetFileSplitDuration(static_cast<FileSplitType>(type), timestamp, duration));
+    return MSERR_OK;
+}
+
 int32_t RecorderServiceStub::SetLocation(MessageParcel &data, MessageParcel &reply)
 {
     (void)reply;
@@ -917,5 +978,37 @@ int32_t RecorderServiceStub::SetWatermark(MessageParcel &data, MessageParcel &re
     CHECK_AND_RETURN_RET_LOG(reply.WriteInt32(SetWatermark(buffer)), MSERR_INVALID_OPERATION, "reply write failed");
     return MSERR_OK;
 }
+
+int32_t RecorderServiceStub::SetParameter(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t sourceId = data.ReadInt32();
+    Format format;
+    CHECK_AND_RETURN_RET_LOG(MediaParcel::Unmarshalling(data, format), MSERR_INVALID_OPERATION,
+        "read format failed");
+    CHECK_AND_RETURN_RET_LOG(reply.WriteInt32(SetParameter(sourceId, format)), MSERR_INVALID_OPERATION,
+        "reply write failed");
+    return MSERR_OK;
+}
+
+int32_t RecorderServiceStub::SavePreCache(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t fd = data.ReadFileDescriptor();
+    int32_t duration = data.ReadInt32();
+    reply.WriteInt32(SavePreCache(fd, duration));
+    (void)::close(fd);
+    return MSERR_OK;
+}
+
+int32_t RecorderServiceStub::SetAudioSharedRing(MessageParcel &data, MessageParcel &reply)
+{
+    std::shared_ptr<AVSharedMemory> memory = ReadAVSharedMemoryFromParcel(data);
+    int32_t eventFd = data.ReadFileDescriptor();
+    int32_t sourceId = 0;
+    int32_t ret = memory == nullptr ? MSERR_INVALID_VAL : SetAudioSharedRing(memory, eventFd, sourceId);
+    reply.WriteInt32(sourceId);
+    reply.WriteInt32(ret);
+    (void)::close(eventFd);
+    return MSERR_OK;
+}
 } // namespace Media
 } // namespace OHOS
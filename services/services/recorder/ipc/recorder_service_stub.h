@@ -61,6 +61,7 @@ public:
     int32_t SetMaxDuration(int32_t duration) override;
     int32_t SetOutputFormat(OutputFormatType format) override;
     int32_t SetOutputFile(int32_t fd) override;
+    int32_t SetNextOutputFile(int32_t fd) override;
     int32_t SetLocation(float latitude, float longitude) override;
     int32_t SetOrientationHint(int32_t rotation) override;
     int32_t Prepare() override;
@@ -79,6 +80,11 @@ public:
     int32_t GetMaxAmplitude() override;
     int32_t IsWatermarkSupported(bool &isWatermarkSupported) override;
     int32_t SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer) override;
+    int32_t SetParameter(int32_t sourceId, const Format &format) override;
+    int32_t SavePreCache(int32_t fd, int32_t duration) override;
+    int32_t SetAudioSharedRing(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd,
+        int32_t &sourceId) override;
+    int32_t SetFileSplitDuration(FileSplitType type, int64_t timestamp, uint32_t duration) override;
     // MonitorServerObject override
     int32_t DoIpcAbnormality() override;
     int32_t DoIpcRecovery(bool fromMonitor) override;
@@ -129,6 +135,11 @@ private:
     int32_t GetMaxAmplitude(MessageParcel &data, MessageParcel &reply);
     int32_t IsWatermarkSupported(MessageParcel &data, MessageParcel &reply);
     int32_t SetWatermark(MessageParcel &data, MessageParcel &reply);
+    int32_t SetParameter(MessageParcel &data, MessageParcel &reply);
+    int32_t SetNextOutputFile(MessageParcel &data, MessageParcel &reply);
+    int32_t SetFileSplitDuration(MessageParcel &data, MessageParcel &reply);
+    int32_t SavePreCache(MessageParcel &data, MessageParcel &reply);
+    int32_t SetAudioSharedRing(MessageParcel &data, MessageParcel &reply);
     int32_t CheckPermission();
     void FillRecFuncPart1();
     void FillRecFuncPart2();
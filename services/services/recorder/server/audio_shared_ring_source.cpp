@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "audio_shared_ring_source.h"
+#include <algorithm>
+#include "media_errors.h"
+#include "media_log.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_RECORDER, "AudioSharedRingSource"};
+    // several periods even at 10 ms, a client that stalls longer than this is treated as a gap
+    constexpr int32_t READ_TIMEOUT_MS = 200;
+}
+
+namespace OHOS {
+namespace Media {
+AudioSharedRingSource::AudioSharedRingSource(const std::shared_ptr<AudioSharedRing> &ring) : ring_(ring)
+{
+    MEDIA_LOGI("AudioSharedRingSource created, capacity %{public}u, period %{public}u",
+        ring_ == nullptr ? 0 : ring_->GetCapacity(), ring_ == nullptr ? 0 : ring_->GetPeriodSize());
+}
+
+int32_t AudioSharedRingSource::ReadAt(std::shared_ptr<AVBuffer> buffer, uint32_t length)
+{
+    CHECK_AND_RETURN_RET_LOG(ring_ != nullptr, MSERR_UNKNOWN, "ring is nullptr");
+    CHECK_AND_RETURN_RET_LOG(buffer != nullptr && buffer->memory_ != nullptr, MSERR_INVALID_VAL,
+        "buffer->memory_ is nullptr");
+    uint32_t capacity = static_cast<uint32_t>(std::max(buffer->memory_->GetCapacity(), 0));
+    uint32_t readSize = std::min({length, capacity, ring_->GetCapacity()});
+    CHECK_AND_RETURN_RET_LOG(readSize > 0, MSERR_INVALID_VAL, "nothing to read");
+    if (!ring_->WaitReadable(readSize, READ_TIMEOUT_MS)) {
+        MEDIA_LOGW("ring has %{public}u of %{public}u bytes, closed %{public}d", ring_->GetReadableSize(),
+            readSize, ring_->IsClosed());
+        return MSERR_INVALID_VAL;
+    }
+    uint64_t overrunCount = ring_->GetOverrunCount();
+    if (overrunCount != reportedOverrunCount_) {
+        MEDIA_LOGW("client dropped %{public}" PRIu64 " chunks, %{public}" PRIu64 " bytes in total",
+            overrunCount - reportedOverrunCount_, ring_->GetOverrunBytes());
+        reportedOverrunCount_ = overrunCount;
+    }
+    // the encoder buffer is filled straight from the shared block, there is no staging copy
+    uint32_t size = ring_->Read(buffer->memory_->GetAddr(), readSize);
+    buffer->memory_->SetSize(static_cast<int32_t>(size));
+    return MSERR_OK;
+}
+
+int32_t AudioSharedRingSource::GetSize(int64_t &size)
+{
+    CHECK_AND_RETURN_RET_LOG(ring_ != nullptr, MSERR_UNKNOWN, "ring is nullptr");
+    size = static_cast<int64_t>(ring_->GetPeriodSize());
+    return MSERR_OK;
+}
+} // namespace Media
+} // namespace OHOS
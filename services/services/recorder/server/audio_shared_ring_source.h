@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_SHARED_RING_SOURCE_H
+#define AUDIO_SHARED_RING_SOURCE_H
+
+#include <memory>
+#include "audio_shared_ring.h"
+#include "media_data_source.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Audio data source of the recorder fed by a client through an AudioSharedRing. ReadAt copies straight from the
+ * shared block into the encoder input buffer and sleeps on the ring's eventfd while the client is behind.
+ */
+class AudioSharedRingSource : public IAudioDataSource {
+public:
+    explicit AudioSharedRingSource(const std::shared_ptr<AudioSharedRing> &ring);
+    ~AudioSharedRingSource() = default;
+
+    int32_t ReadAt(std::shared_ptr<AVBuffer> buffer, uint32_t length) override;
+    int32_t GetSize(int64_t &size) override;
+
+private:
+    std::shared_ptr<AudioSharedRing> ring_;
+    uint64_t reportedOverrunCount_ = 0;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // AUDIO_SHARED_RING_SOURCE_H
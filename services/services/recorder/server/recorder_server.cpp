@@ -14,6 +14,7 @@
  */
 
 #include "recorder_server.h"
+#include <unistd.h>
 #include "map"
 #include "media_log.h"
 #include "media_errors.h"
@@ -24,6 +25,7 @@
 #include "media_dfx.h"
 #include "hitrace/tracechain.h"
 #include "media_utils.h"
+#include "audio_shared_ring_source.h"
 #ifdef SUPPORT_POWER_MANAGER
 #include "shutdown/shutdown_priority.h"
 #endif
@@ -466,6 +468,29 @@ int32_t RecorderServer::SetAudioDataSource(const std::shared_ptr<IAudioDataSourc
     return result.Value();
 }
 
+int32_t RecorderServer::SetAudioSharedRing(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd,
+    int32_t &sourceId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    MEDIA_LOGI("RecorderServer:0x%{public}06" PRIXPTR " SetAudioSharedRing in", FAKE_POINTER(this));
+    CHECK_STATUS_FAILED_AND_LOGE_RET(status_ != REC_INITIALIZED, MSERR_INVALID_OPERATION);
+    CHECK_AND_RETURN_RET_LOG(recorderEngine_ != nullptr, MSERR_NO_MEMORY, "engine is nullptr");
+    CHECK_AND_RETURN_RET_LOG(eventFd >= 0, MSERR_INVALID_VAL, "invalid eventfd");
+    // the ring keeps its own copy of the eventfd, the caller closes the one it passed in
+    std::shared_ptr<AudioSharedRing> ring = AudioSharedRing::Attach(memory, dup(eventFd));
+    CHECK_AND_RETURN_RET_LOG(ring != nullptr, MSERR_INVALID_VAL, "attach audio shared ring failed");
+    std::shared_ptr<IAudioDataSource> audioSource = std::make_shared<AudioSharedRingSource>(ring);
+
+    auto task = std::make_shared<TaskHandler<int32_t>>([&, this] {
+        return recorderEngine_->SetAudioDataSource(audioSource, sourceId);
+    });
+    int32_t ret = taskQue_.EnqueueTask(task);
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "EnqueueTask failed");
+
+    auto result = task->GetResult();
+    return result.Value();
+}
+
 int32_t RecorderServer::SetAudioEncoder(int32_t sourceId, AudioCodecFormat encoder)
 {
     MEDIA_LOGI("RecorderServer:0x%{public}06" PRIXPTR " SetAudioEncoder in, sourceId(%{public}d), encoder(%{public}d)",
@@ -674,11 +699,13 @@ int32_t RecorderServer::SetNextOutputFile(int32_t fd)
 {
     MEDIA_LOGI("RecorderServer:0x%{public}06" PRIXPTR " SetNextOutputFile in", FAKE_POINTER(this));
     std::lock_guard<std::mutex> lock(mutex_);
-    CHECK_STATUS_FAILED_AND_LOGE_RET(status_ != REC_CONFIGURED, MSERR_INVALID_OPERATION);
+    // files are queued ahead of time, each file split moves the muxer to the oldest one
+    CHECK_STATUS_FAILED_AND_LOGE_RET(status_ != REC_CONFIGURED && status_ != REC_PREPARED &&
+        status_ != REC_RECORDING && status_ != REC_PAUSED, MSERR_INVALID_OPERATION);
     CHECK_AND_RETURN_RET_LOG(recorderEngine_ != nullptr, MSERR_NO_MEMORY, "engine is nullptr");
     NextOutFd nextFileFd(fd);
     auto task = std::make_shared<TaskHandler<int32_t>>([&, this] {
-        return recorderEngine_->Configure(DUMMY_SOURCE_ID, nextFileFd);
+        return recorderEngine_->SetParameter(DUMMY_SOURCE_ID, nextFileFd);
     });
     int32_t ret = taskQue_.EnqueueTask(task);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "EnqueueTask failed");
@@ -780,6 +807,19 @@ int32_t RecorderServer::Prepare()
     }
     CHECK_STATUS_FAILED_AND_LOGE_RET(status_ != REC_CONFIGURED, MSERR_INVALID_OPERATION);
     CHECK_AND_RETURN_RET_LOG(recorderEngine_ != nullptr, MSERR_NO_MEMORY, "engine is nullptr");
+    if (hasWarmConfig_) {
+        // the encoders kept by the last soft stop are only reused when nothing they were built from changed
+        hasWarmConfig_ = false;
+        WarmRestart warmRestart(IsSameEncoderConfig(warmConfig_, config_));
+        MEDIA_LOGI("RecorderServer:0x%{public}06" PRIXPTR " Prepare reuse warm encoders(%{public}d)",
+            FAKE_POINTER(this), warmRestart.reuse);
+        auto warmTask = std::make_shared<TaskHandler<int32_t>>([&, this] {
+            return recorderEngine_->Configure(DUMMY_SOURCE_ID, warmRestart);
+        });
+        int32_t warmRet = taskQue_.EnqueueTask(warmTask);
+        CHECK_AND_RETURN_RET_LOG(warmRet == MSERR_OK, warmRet, "EnqueueTask failed");
+        (void)warmTask->GetResult();
+    }
     auto task = std::make_shared<TaskHandler<int32_t>>([&, this] {
         return recorderEngine_->Prepare();
     });
@@ -893,6 +933,10 @@ int32_t RecorderServer::Stop(bool block)
     auto result = task->GetResult();
     ret = result.Value();
     status_ = (ret == MSERR_OK ? REC_INITIALIZED : REC_ERROR);
+    if (status_ == REC_INITIALIZED && softStop_) {
+        warmConfig_ = config_;
+        hasWarmConfig_ = true;
+    }
     if (status_ == REC_INITIALIZED) {
         int64_t endTime = GetCurrentMillisecond();
         statisticalEventInfo_.recordDuration = static_cast<int32_t>(endTime - startTime_ -
@@ -917,6 +961,8 @@ int32_t RecorderServer::Reset()
     auto result = task->GetResult();
     ret = result.Value();
     status_ = (ret == MSERR_OK ? REC_INITIALIZED : REC_ERROR);
+    softStop_ = false;
+    hasWarmConfig_ = false;
     BehaviorEventWrite(GetStatusDescription(status_), "Recorder");
     return ret;
 }
@@ -949,20 +995,73 @@ int32_t RecorderServer::SetFileSplitDuration(FileSplitType type, int64_t timesta
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_STATUS_FAILED_AND_LOGE_RET(status_ != REC_RECORDING && status_ != REC_PAUSED, MSERR_INVALID_OPERATION);
+    CHECK_AND_RETURN_RET_LOG(recorderEngine_ != nullptr, MSERR_NO_MEMORY, "engine is nullptr");
+    MEDIA_LOGI("RecorderServer:0x%{public}06" PRIXPTR " SetFileSplitDuration in, type(%{public}d), "
+        "duration(%{public}u)", FAKE_POINTER(this), type, duration);
+    FileSplit fileSplit(type, timestamp, duration);
+    auto task = std::make_shared<TaskHandler<int32_t>>([&, this] {
+        return recorderEngine_->SetParameter(DUMMY_SOURCE_ID, fileSplit);
+    });
+    int32_t ret = taskQue_.EnqueueTask(task);
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "EnqueueTask failed");
 
-    (void)type;
-    (void)timestamp;
-    (void)duration;
-    return MSERR_OK;
+    auto result = task->GetResult();
+    return result.Value();
 }
 
 int32_t RecorderServer::SetParameter(int32_t sourceId, const Format &format)
 {
     (void)sourceId;
-    (void)format;
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_STATUS_FAILED_AND_LOGE_RET(status_ != REC_CONFIGURED && status_ != REC_PREPARED, MSERR_INVALID_OPERATION);
+    CHECK_AND_RETURN_RET_LOG(recorderEngine_ != nullptr, MSERR_NO_MEMORY, "engine is nullptr");
+
+    int32_t preCacheDuration = 0;
+    if (format.GetIntValue(RecorderKeys::RECORDER_PRE_CACHE_DURATION, preCacheDuration)) {
+        CHECK_STATUS_FAILED_AND_LOGE_RET(status_ != REC_CONFIGURED, MSERR_INVALID_OPERATION);
+        int32_t preCacheMaxSize = 0;
+        (void)format.GetIntValue(RecorderKeys::RECORDER_PRE_CACHE_MAX_SIZE, preCacheMaxSize);
+        MEDIA_LOGI("RecorderServer:0x%{public}06" PRIXPTR " SetParameter pre-cache duration(%{public}d), "
+            "max size(%{public}d)", FAKE_POINTER(this), preCacheDuration, preCacheMaxSize);
+        CHECK_AND_RETURN_RET_LOG(preCacheDuration >= 0 && preCacheMaxSize >= 0, MSERR_INVALID_VAL,
+            "invalid pre-cache config");
+        PreCache preCache(preCacheDuration, preCacheMaxSize);
+        auto task = std::make_shared<TaskHandler<int32_t>>([&, this] {
+            return recorderEngine_->Configure(DUMMY_SOURCE_ID, preCache);
+        });
+        int32_t ret = taskQue_.EnqueueTask(task);
+        CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "EnqueueTask failed");
+
+        auto result = task->GetResult();
+        CHECK_AND_RETURN_RET_LOG(result.Value() == MSERR_OK, result.Value(), "set pre-cache failed");
+    }
+
+    int32_t softStop = 0;
+    if (format.GetIntValue(RecorderKeys::RECORDER_SOFT_STOP, softStop)) {
+        MEDIA_LOGI("RecorderServer:0x%{public}06" PRIXPTR " SetParameter soft stop(%{public}d)",
+            FAKE_POINTER(this), softStop);
+        SoftStop softStopParam(softStop != 0);
+        auto task = std::make_shared<TaskHandler<int32_t>>([&, this] {
+            return recorderEngine_->Configure(DUMMY_SOURCE_ID, softStopParam);
+        });
+        int32_t ret = taskQue_.EnqueueTask(task);
+        CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "EnqueueTask failed");
+
+        auto result = task->GetResult();
+        CHECK_AND_RETURN_RET_LOG(result.Value() == MSERR_OK, result.Value(), "set soft stop failed");
+        softStop_ = softStop != 0;
+    }
     return MSERR_OK;
 }
 
+bool RecorderServer::IsSameEncoderConfig(const ConfigInfo &lhs, const ConfigInfo &rhs)
+{
+    return lhs.videoSource == rhs.videoSource && lhs.videoCodec == rhs.videoCodec && lhs.width == rhs.width &&
+        lhs.height == rhs.height && lhs.frameRate == rhs.frameRate && lhs.bitRate == rhs.bitRate &&
+        lhs.isHdr == rhs.isHdr && lhs.enableTemporalScale == rhs.enableTemporalScale &&
+        lhs.captureRate == rhs.captureRate && lhs.withVideo == rhs.withVideo;
+}
+
 int32_t RecorderServer::DumpInfo(int32_t fd)
 {
     std::string dumpString;
@@ -1098,6 +1197,25 @@ int32_t RecorderServer::SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer)
     return result.Value();
 }
 
+int32_t RecorderServer::SavePreCache(int32_t fd, int32_t duration)
+{
+    MEDIA_LOGI("RecorderServer:0x%{public}06" PRIXPTR " SavePreCache in, duration(%{public}d)",
+        FAKE_POINTER(this), duration);
+    std::lock_guard<std::mutex> lock(mutex_);
+    MediaTrace trace("RecorderServer::SavePreCache");
+    CHECK_STATUS_FAILED_AND_LOGE_RET(status_ != REC_RECORDING && status_ != REC_PAUSED, MSERR_INVALID_OPERATION);
+    CHECK_AND_RETURN_RET_LOG(recorderEngine_ != nullptr, MSERR_NO_MEMORY, "engine is nullptr");
+    CHECK_AND_RETURN_RET_LOG(fd >= 0 && duration > 0, MSERR_INVALID_VAL, "invalid fd or duration");
+    auto task = std::make_shared<TaskHandler<int32_t>>([&, this] {
+        return recorderEngine_->SavePreCache(fd, duration);
+    });
+    int32_t ret = taskQue_.EnqueueTask(task);
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "EnqueueTask failed");
+
+    auto result = task->GetResult();
+    return result.Value();
+}
+
 void RecorderServer::SetMetaDataReport()
 {
     std::shared_ptr<Media::Meta> meta = std::make_shared<Media::Meta>();
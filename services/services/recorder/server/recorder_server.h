@@ -117,6 +117,9 @@ public:
     int32_t GetMaxAmplitude() override;
     int32_t IsWatermarkSupported(bool &isWatermarkSupported) override;
     int32_t SetWatermark(std::shared_ptr<AVBuffer> &waterMarkBuffer) override;
+    int32_t SavePreCache(int32_t fd, int32_t duration) override;
+    int32_t SetAudioSharedRing(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd,
+        int32_t &sourceId) override;
 
     // IRecorderEngineObs override
     void OnError(ErrorType errorType, int32_t errorCode) override;
@@ -174,6 +177,11 @@ private:
         bool withAudio = false;
         bool withLocation = false;
     } config_;
+    // encoder side of config_ when a soft stop kept the encoders alive
+    ConfigInfo warmConfig_;
+    bool hasWarmConfig_ = false;
+    bool softStop_ = false;
+    static bool IsSameEncoderConfig(const ConfigInfo &lhs, const ConfigInfo &rhs);
     std::string lastErrMsg_;
 
     std::atomic<bool> watchdogPause_ = false;
@@ -43,99 +43,47 @@ RecorderProfilesServer::~RecorderProfilesServer()
 
 bool RecorderProfilesServer::IsAudioRecorderConfigSupported(const RecorderProfilesData &profile)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    bool ret = false;
-    std::vector<RecorderProfilesData> capabilityDataArray = GetCapabilityInfos();
-    for (auto iter = capabilityDataArray.begin(); iter != capabilityDataArray.end(); ++iter) {
-        RecorderProfilesData compareProfileData = (*iter);
-        if (compareProfileData.mediaProfileType == RECORDER_TYPE_PROFILE) {
-            if (CompareProfile(compareProfileData, profile)) {
-                ret = true;
-                break;
-            }
-        }
-    }
-    return ret;
+    std::shared_ptr<const RecorderProfilesSnapshot> snapshot = GetSnapshot();
+    CHECK_AND_RETURN_RET_LOG(snapshot != nullptr, false, "recorder profiles are unavailable");
+    return snapshot->audioConfigIndex.count(RecorderProfilesSnapshot::GetAudioConfigKey(profile)) > 0;
 }
 
 bool RecorderProfilesServer::HasVideoRecorderProfile(int32_t sourceId, int32_t qualityLevel)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    bool ret = false;
-    std::vector<RecorderProfilesData> capabilityDataArray = GetCapabilityInfos();
-    for (auto iter = capabilityDataArray.begin(); iter != capabilityDataArray.end(); ++iter) {
-        if (iter->mediaProfileType == RECORDER_TYPE_PROFILE) {
-            if ((sourceId == iter->sourceId) && (qualityLevel == iter->recorderProfile.qualityLevel)) {
-                ret = true;
-                break;
-            }
-        }
-    }
-    return ret;
+    std::shared_ptr<const RecorderProfilesSnapshot> snapshot = GetSnapshot();
+    CHECK_AND_RETURN_RET_LOG(snapshot != nullptr, false, "recorder profiles are unavailable");
+    return snapshot->videoProfileIndex.count(RecorderProfilesSnapshot::GetVideoProfileKey(sourceId, qualityLevel)) > 0;
 }
 
 RecorderProfilesData RecorderProfilesServer::GetVideoRecorderProfileInfo(int32_t sourceId, int32_t qualityLevel)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    RecorderProfilesData capabilityData;
-    std::vector<RecorderProfilesData> capabilityDataArray = GetCapabilityInfos();
-    for (auto iter = capabilityDataArray.begin(); iter != capabilityDataArray.end(); ++iter) {
-        if (iter->mediaProfileType == RECORDER_TYPE_PROFILE) {
-            if ((sourceId == iter->sourceId) && (qualityLevel == iter->recorderProfile.qualityLevel)) {
-                capabilityData = (*iter);
-                break;
-            }
-        }
+    std::shared_ptr<const RecorderProfilesSnapshot> snapshot = GetSnapshot();
+    CHECK_AND_RETURN_RET_LOG(snapshot != nullptr, RecorderProfilesData(), "recorder profiles are unavailable");
+    auto iter = snapshot->videoProfileIndex.find(RecorderProfilesSnapshot::GetVideoProfileKey(sourceId, qualityLevel));
+    if (iter == snapshot->videoProfileIndex.end()) {
+        return RecorderProfilesData();
     }
-    return capabilityData;
+    return snapshot->capabilityDataArray[iter->second];
 }
 
 std::vector<RecorderProfilesData> RecorderProfilesServer::GetAudioRecorderCapsInfo()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::vector<RecorderProfilesData> capabilityDataArray = GetCapabilityInfos();
-    for (auto iter = capabilityDataArray.begin(); iter != capabilityDataArray.end();) {
-        if (iter->mediaProfileType == RECORDER_TYPE_AUDIO_CAPS) {
-            ++iter;
-        } else {
-            iter = capabilityDataArray.erase(iter);
-        }
-    }
-    return capabilityDataArray;
+    std::shared_ptr<const RecorderProfilesSnapshot> snapshot = GetSnapshot();
+    CHECK_AND_RETURN_RET_LOG(snapshot != nullptr, {}, "recorder profiles are unavailable");
+    return snapshot->audioCapsArray;
 }
 
 std::vector<RecorderProfilesData> RecorderProfilesServer::GetVideoRecorderCapsInfo()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::vector<RecorderProfilesData> capabilityDataArray = GetCapabilityInfos();
-    for (auto iter = capabilityDataArray.begin(); iter != capabilityDataArray.end();) {
-        if (iter->mediaProfileType == RECORDER_TYPE_VIDEO_CAPS) {
-            ++iter;
-        } else {
-            iter = capabilityDataArray.erase(iter);
-        }
-    }
-    return capabilityDataArray;
+    std::shared_ptr<const RecorderProfilesSnapshot> snapshot = GetSnapshot();
+    CHECK_AND_RETURN_RET_LOG(snapshot != nullptr, {}, "recorder profiles are unavailable");
+    return snapshot->videoCapsArray;
 }
 
-std::vector<RecorderProfilesData> RecorderProfilesServer::GetCapabilityInfos()
+std::shared_ptr<const RecorderProfilesSnapshot> RecorderProfilesServer::GetSnapshot()
 {
     RecorderProfilesAbilitySingleton& mediaProfileAbilityInstance = RecorderProfilesAbilitySingleton::GetInstance();
-    return mediaProfileAbilityInstance.GetCapabilityDataArray();
-}
-
-bool RecorderProfilesServer::CompareProfile(
-    const RecorderProfilesData &compareProfile, const RecorderProfilesData &profile)
-{
-    bool ret = false;
-    if ((profile.recorderProfile.containerFormatType == compareProfile.recorderProfile.containerFormatType) &&
-        (profile.recorderProfile.audioCodec == compareProfile.recorderProfile.audioCodec) &&
-        (profile.recorderProfile.audioBitrate == compareProfile.recorderProfile.audioBitrate) &&
-        (profile.recorderProfile.audioSampleRate == compareProfile.recorderProfile.audioSampleRate) &&
-        (profile.recorderProfile.audioChannels == compareProfile.recorderProfile.audioChannels)) {
-        ret = true;
-    }
-    return ret;
+    return mediaProfileAbilityInstance.GetSnapshot();
 }
 }  // namespace Media
 }  // namespace OHOS
@@ -16,12 +16,13 @@
 #ifndef RECORDERPROFILES_SERVER_H
 #define RECORDERPROFILES_SERVER_H
 
-#include <mutex>
 #include "i_recorder_profiles_service.h"
 #include "nocopyable.h"
 
 namespace OHOS {
 namespace Media {
+struct RecorderProfilesSnapshot;
+
 class RecorderProfilesServer : public IRecorderProfilesService, public NoCopyable {
 public:
     static std::shared_ptr<IRecorderProfilesService> Create();
@@ -35,9 +36,7 @@ public:
     RecorderProfilesData GetVideoRecorderProfileInfo(int32_t sourceId, int32_t qualityLevel) override;
 
 private:
-    bool CompareProfile(const RecorderProfilesData &compareProfile, const RecorderProfilesData &profile);
-    std::vector<RecorderProfilesData> GetCapabilityInfos();
-    std::mutex mutex_;
+    std::shared_ptr<const RecorderProfilesSnapshot> GetSnapshot();
 };
 }  // namespace Media
 }  // namespace OHOS
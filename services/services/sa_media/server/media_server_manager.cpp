@@ -42,6 +42,7 @@
 #include "media_dfx.h"
 #include "service_dump_manager.h"
 #include "player_xcollie.h"
+#include "media_probe_cache.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_PLAYER, "MediaServerManager"};
@@ -130,6 +131,10 @@ int32_t MediaServerManager::Dump(int32_t fd, const std::vector<std::u16string> &
     CHECK_AND_RETURN_RET_LOG(ret == NO_ERROR,
         OHOS::INVALID_OPERATION, "Failed to write xcollie dump information");
 
+    ret = MediaProbeCache::GetInstance().Dump(fd);
+    CHECK_AND_RETURN_RET_LOG(ret == NO_ERROR,
+        OHOS::INVALID_OPERATION, "Failed to write probe cache dump information");
+
     ret = MonitorServiceStub::GetInstance()->DumpInfo(fd,
         argSets.find(u"monitor") != argSets.end());
     CHECK_AND_RETURN_RET_LOG(ret == NO_ERROR,
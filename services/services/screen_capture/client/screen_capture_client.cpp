@@ -158,6 +158,13 @@ int32_t ScreenCaptureClient::ExcludeContent(ScreenCaptureContentFilter &contentF
     return screenCaptureProxy_->ExcludeContent(contentFilter);
 }
 
+int32_t ScreenCaptureClient::AddOutputProfile(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(screenCaptureProxy_ != nullptr, MSERR_NO_MEMORY, "screenCapture service does not exist.");
+    return screenCaptureProxy_->AddOutputProfile(surface, profile);
+}
+
 int32_t ScreenCaptureClient::SetMicrophoneEnabled(bool isMicrophone)
 {
     std::lock_guard<std::mutex> lock(mutex_);
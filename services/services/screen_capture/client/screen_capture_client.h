@@ -52,6 +52,7 @@ public:
     int32_t SetScreenCaptureCallback(const std::shared_ptr<ScreenCaptureCallBack> &callback) override;
     void Release() override;
     int32_t ExcludeContent(ScreenCaptureContentFilter &contentFilter) override;
+    int32_t AddOutputProfile(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile) override;
 
 private:
     sptr<IStandardScreenCaptureService> screenCaptureProxy_ = nullptr;
@@ -52,6 +52,7 @@ public:
     virtual int32_t ReleaseAudioBuffer(AudioCaptureSourceType type) = 0;
     virtual int32_t ReleaseVideoBuffer() = 0;
     virtual int32_t ExcludeContent(ScreenCaptureContentFilter &contentFilter) = 0;
+    virtual int32_t AddOutputProfile(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile) = 0;
 
     /**
      * IPC code ID
@@ -78,6 +79,7 @@ public:
         STOP_SCREEN_CAPTURE = 18,
         SET_SCREEN_ROTATION = 19,
         EXCLUDE_CONTENT = 20,
+        ADD_OUTPUT_PROFILE = 21,
     };
 
     DECLARE_INTERFACE_DESCRIPTOR(u"IStandardScreenCaptureService");
@@ -442,6 +442,32 @@ int32_t ScreenCaptureServiceProxy::ExcludeContent(ScreenCaptureContentFilter &co
     return reply.ReadInt32();
 }
 
+int32_t ScreenCaptureServiceProxy::AddOutputProfile(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    bool token = data.WriteInterfaceToken(ScreenCaptureServiceProxy::GetDescriptor());
+    CHECK_AND_RETURN_RET_LOG(token, MSERR_INVALID_OPERATION, "Failed to write descriptor!");
+
+    CHECK_AND_RETURN_RET_LOG(surface != nullptr, MSERR_NO_MEMORY, "surface is nullptr");
+    sptr<IBufferProducer> producer = surface->GetProducer();
+    CHECK_AND_RETURN_RET_LOG(producer != nullptr, MSERR_NO_MEMORY, "producer is nullptr");
+    token = data.WriteRemoteObject(producer->AsObject());
+    CHECK_AND_RETURN_RET_LOG(token, MSERR_INVALID_OPERATION, "Failed to write producer!");
+
+    token = data.WriteInt32(profile.width) && data.WriteInt32(profile.height) &&
+        data.WriteInt32(profile.cropRect.x) && data.WriteInt32(profile.cropRect.y) &&
+        data.WriteInt32(profile.cropRect.w) && data.WriteInt32(profile.cropRect.h);
+    CHECK_AND_RETURN_RET_LOG(token, MSERR_INVALID_OPERATION, "Failed to write output profile!");
+
+    int error = Remote()->SendRequest(ADD_OUTPUT_PROFILE, data, reply, option);
+    CHECK_AND_RETURN_RET_LOG(error == MSERR_OK, MSERR_INVALID_OPERATION,
+        "AddOutputProfile failed, error: %{public}d", error);
+    return reply.ReadInt32();
+}
+
 int32_t ScreenCaptureServiceProxy::SetMicrophoneEnabled(bool isMicrophone)
 {
     MessageParcel data;
@@ -47,6 +47,7 @@ public:
     int32_t SetCanvasRotation(bool canvasRotation) override;
     int32_t SetListenerObject(const sptr<IRemoteObject> &object) override;
     int32_t ExcludeContent(ScreenCaptureContentFilter &contentFilter) override;
+    int32_t AddOutputProfile(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile) override;
 
 private:
     static inline BrokerDelegator<ScreenCaptureServiceProxy> delegator_;
@@ -75,6 +75,7 @@ int32_t ScreenCaptureServiceStub::Init()
     screenCaptureStubFuncs_[RELEASE_VIDEO_BUF] = &ScreenCaptureServiceStub::ReleaseVideoBuffer;
     screenCaptureStubFuncs_[DESTROY] = &ScreenCaptureServiceStub::DestroyStub;
     screenCaptureStubFuncs_[EXCLUDE_CONTENT] = &ScreenCaptureServiceStub::ExcludeContent;
+    screenCaptureStubFuncs_[ADD_OUTPUT_PROFILE] = &ScreenCaptureServiceStub::AddOutputProfile;
 
     return MSERR_OK;
 }
@@ -213,6 +214,13 @@ int32_t ScreenCaptureServiceStub::ExcludeContent(ScreenCaptureContentFilter &con
     return screenCaptureServer_->ExcludeContent(contentFilter);
 }
 
+int32_t ScreenCaptureServiceStub::AddOutputProfile(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile)
+{
+    CHECK_AND_RETURN_RET_LOG(screenCaptureServer_ != nullptr, MSERR_NO_MEMORY,
+        "screen capture server is nullptr");
+    return screenCaptureServer_->AddOutputProfile(surface, profile);
+}
+
 int32_t ScreenCaptureServiceStub::SetMicrophoneEnabled(bool isMicrophone)
 {
     CHECK_AND_RETURN_RET_LOG(screenCaptureServer_ != nullptr, false,
@@ -284,6 +292,30 @@ int32_t ScreenCaptureServiceStub::ExcludeContent(MessageParcel &data, MessagePar
     return MSERR_OK;
 }
 
+int32_t ScreenCaptureServiceStub::AddOutputProfile(MessageParcel &data, MessageParcel &reply)
+{
+    CHECK_AND_RETURN_RET_LOG(screenCaptureServer_ != nullptr, MSERR_INVALID_STATE,
+        "screen capture server is nullptr");
+
+    sptr<IRemoteObject> object = data.ReadRemoteObject();
+    CHECK_AND_RETURN_RET_LOG(object != nullptr, MSERR_NO_MEMORY, "AddOutputProfile object is nullptr");
+    sptr<IBufferProducer> producer = iface_cast<IBufferProducer>(object);
+    CHECK_AND_RETURN_RET_LOG(producer != nullptr, MSERR_NO_MEMORY, "failed to convert object to producer");
+    sptr<Surface> surface = Surface::CreateSurfaceAsProducer(producer);
+    CHECK_AND_RETURN_RET_LOG(surface != nullptr, MSERR_NO_MEMORY, "failed to create surface");
+
+    ScreenCaptureOutputProfile profile;
+    profile.width = data.ReadInt32();
+    profile.height = data.ReadInt32();
+    profile.cropRect.x = data.ReadInt32();
+    profile.cropRect.y = data.ReadInt32();
+    profile.cropRect.w = data.ReadInt32();
+    profile.cropRect.h = data.ReadInt32();
+    int32_t ret = AddOutputProfile(surface, profile);
+    reply.WriteInt32(ret);
+    return MSERR_OK;
+}
+
 int32_t ScreenCaptureServiceStub::SetMicrophoneEnabled(MessageParcel &data, MessageParcel &reply)
 {
     CHECK_AND_RETURN_RET_LOG(screenCaptureServer_ != nullptr, MSERR_INVALID_STATE,
@@ -50,6 +50,7 @@ public:
     int32_t SetListenerObject(const sptr<IRemoteObject> &object) override;
     int OnRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override;
     int32_t ExcludeContent(ScreenCaptureContentFilter &contentFilter) override;
+    int32_t AddOutputProfile(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile) override;
 
 private:
     ScreenCaptureServiceStub();
@@ -73,6 +74,7 @@ private:
     int32_t SetMicrophoneEnabled(MessageParcel &data, MessageParcel &reply);
     int32_t SetCanvasRotation(MessageParcel &data, MessageParcel &reply);
     int32_t ExcludeContent(MessageParcel &data, MessageParcel &reply);
+    int32_t AddOutputProfile(MessageParcel &data, MessageParcel &reply);
 
     int32_t Release(MessageParcel &data, MessageParcel &reply);
     int32_t DestroyStub(MessageParcel &data, MessageParcel &reply);
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "screen_capture_scaler.h"
+#include <algorithm>
+#include "media_errors.h"
+#include "media_log.h"
+#include "media_dfx.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_SCREENCAPTURE, "ScreenCaptureScaler"};
+}
+
+namespace OHOS {
+namespace Media {
+ScreenCaptureScaler::ScreenCaptureScaler(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile)
+    : taskQue_("ScreenCapScaler"), surface_(surface), profile_(profile)
+{
+    MEDIA_LOGI("0x%{public}06" PRIXPTR " Instances create, size:%{public}dx%{public}d, crop:[%{public}d,%{public}d,"
+        "%{public}d,%{public}d]", FAKE_POINTER(this), profile_.width, profile_.height, profile_.cropRect.x,
+        profile_.cropRect.y, profile_.cropRect.w, profile_.cropRect.h);
+    (void)taskQue_.Start();
+}
+
+ScreenCaptureScaler::~ScreenCaptureScaler()
+{
+    (void)taskQue_.Stop();
+    MEDIA_LOGI("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
+}
+
+std::shared_ptr<TaskHandler<void>> ScreenCaptureScaler::ScheduleFrame(const sptr<SurfaceBuffer> &srcBuffer,
+    const sptr<SyncFence> &acquireFence, int64_t timestamp)
+{
+    auto task = std::make_shared<TaskHandler<void>>([this, srcBuffer, acquireFence, timestamp]() {
+        (void)ProduceFrame(srcBuffer, acquireFence, timestamp);
+    });
+    if (taskQue_.EnqueueTask(task) != MSERR_OK) {
+        MEDIA_LOGW("scaler worker is not running, scale in place");
+        (void)ProduceFrame(srcBuffer, acquireFence, timestamp);
+        return nullptr;
+    }
+    return task;
+}
+
+int32_t ScreenCaptureScaler::ProduceFrame(const sptr<SurfaceBuffer> &srcBuffer, const sptr<SyncFence> &acquireFence,
+    int64_t timestamp)
+{
+    MediaTrace trace("ScreenCaptureScaler::ProduceFrame");
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(surface_ != nullptr && srcBuffer != nullptr, MSERR_INVALID_OPERATION,
+        "surface or source buffer is nullptr");
+    CHECK_AND_RETURN_RET_LOG(srcBuffer->GetFormat() == GraphicPixelFormat::GRAPHIC_PIXEL_FMT_RGBA_8888,
+        MSERR_UNSUPPORT, "unsupported source format:%{public}d", srcBuffer->GetFormat());
+    if (acquireFence != nullptr && acquireFence->IsValid() && acquireFence->Wait(ACQUIRE_FENCE_WAIT_MS) != 0) {
+        // the virtual screen may still be rendering into the source, scaling it now would read a partial frame
+        MEDIA_LOGD("wait acquire fence timeout, drop frame");
+        droppedCount_++;
+        return MSERR_OK;
+    }
+
+    BufferRequestConfig requestConfig = {
+        .width = profile_.width,
+        .height = profile_.height,
+        .strideAlignment = 0x8,
+        .format = GraphicPixelFormat::GRAPHIC_PIXEL_FMT_RGBA_8888,
+        .usage = BUFFER_USAGE_CPU_READ | BUFFER_USAGE_CPU_WRITE | BUFFER_USAGE_MEM_DMA,
+        .timeout = REQUEST_BUFFER_TIMEOUT_MS,
+    };
+    sptr<SurfaceBuffer> dstBuffer = nullptr;
+    int32_t releaseFence = -1;
+    GSError ret = surface_->RequestBuffer(dstBuffer, releaseFence, requestConfig);
+    if (ret != GSERROR_OK || dstBuffer == nullptr) {
+        MEDIA_LOGD("request buffer failed:%{public}d, consumer is slow, drop frame", ret);
+        droppedCount_++;
+        return MSERR_OK;
+    }
+    sptr<SyncFence> syncFence = new SyncFence(releaseFence);
+    if (syncFence->Wait(RELEASE_FENCE_WAIT_MS) != 0) {
+        // the consumer still reads the buffer, writing into it would tear the frame it shows
+        MEDIA_LOGD("wait release fence timeout, drop frame");
+        surface_->CancelBuffer(dstBuffer);
+        droppedCount_++;
+        return MSERR_OK;
+    }
+
+    ScalerImage src = { static_cast<uint8_t *>(srcBuffer->GetVirAddr()), srcBuffer->GetWidth(),
+        srcBuffer->GetHeight(), srcBuffer->GetStride() };
+    ScalerImage dst = { static_cast<uint8_t *>(dstBuffer->GetVirAddr()), dstBuffer->GetWidth(),
+        dstBuffer->GetHeight(), dstBuffer->GetStride() };
+    int32_t scaleRet = ScaleRgba(src, profile_.cropRect, dst);
+    if (scaleRet != MSERR_OK) {
+        surface_->CancelBuffer(dstBuffer);
+        droppedCount_++;
+        return scaleRet;
+    }
+
+    BufferFlushConfig flushConfig = {
+        .damage = {
+            .x = 0,
+            .y = 0,
+            .w = dst.width,
+            .h = dst.height,
+        },
+        .timestamp = timestamp,
+    };
+    ret = surface_->FlushBuffer(dstBuffer, -1, flushConfig);
+    CHECK_AND_RETURN_RET_LOG(ret == GSERROR_OK, MSERR_UNKNOWN, "flush buffer failed:%{public}d", ret);
+    producedCount_++;
+    return MSERR_OK;
+}
+
+uint64_t ScreenCaptureScaler::GetProducedCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return producedCount_;
+}
+
+uint64_t ScreenCaptureScaler::GetDroppedCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return droppedCount_;
+}
+
+const OHOS::Rect &ScreenCaptureScaler::GetCropRect() const
+{
+    return profile_.cropRect;
+}
+
+int32_t ScreenCaptureScaler::ScaleRgba(const ScalerImage &src, const OHOS::Rect &cropRect, const ScalerImage &dst)
+{
+    CHECK_AND_RETURN_RET_LOG(src.addr != nullptr && dst.addr != nullptr, MSERR_INVALID_VAL, "invalid image address");
+    CHECK_AND_RETURN_RET_LOG(src.width > 0 && src.height > 0 && dst.width > 0 && dst.height > 0,
+        MSERR_INVALID_VAL, "invalid image size");
+    OHOS::Rect crop = cropRect;
+    if (crop.w <= 0 || crop.h <= 0) {
+        crop = { 0, 0, src.width, src.height };
+    }
+    CHECK_AND_RETURN_RET_LOG(crop.x >= 0 && crop.y >= 0 && crop.x < src.width && crop.y < src.height &&
+        crop.w <= src.width - crop.x && crop.h <= src.height - crop.y, MSERR_INVALID_VAL,
+        "crop rect is out of the source frame");
+    CHECK_AND_RETURN_RET_LOG(src.stride >= static_cast<int64_t>(src.width) * RGBA_PIXEL_SIZE &&
+        dst.stride >= static_cast<int64_t>(dst.width) * RGBA_PIXEL_SIZE, MSERR_INVALID_VAL, "invalid image stride");
+
+    for (int32_t dstY = 0; dstY < dst.height; dstY++) {
+        ScaleRow(src, crop, dst, dstY);
+    }
+    return MSERR_OK;
+}
+
+void ScreenCaptureScaler::ScaleRow(const ScalerImage &src, const OHOS::Rect &cropRect, const ScalerImage &dst,
+    int32_t dstY)
+{
+    // Each destination pixel averages the source pixels it covers; when upscaling it covers less than
+    // one source pixel, so the range collapses to the nearest one.
+    int32_t srcY0 = cropRect.y + static_cast<int32_t>(static_cast<int64_t>(dstY) * cropRect.h / dst.height);
+    int32_t srcY1 = cropRect.y + static_cast<int32_t>(static_cast<int64_t>(dstY + 1) * cropRect.h / dst.height);
+    srcY1 = std::max(srcY1, srcY0 + 1);
+    uint8_t *dstRow = dst.addr + static_cast<int64_t>(dstY) * dst.stride;
+    for (int32_t dstX = 0; dstX < dst.width; dstX++) {
+        int32_t srcX0 = cropRect.x + static_cast<int32_t>(static_cast<int64_t>(dstX) * cropRect.w / dst.width);
+        int32_t srcX1 = cropRect.x + static_cast<int32_t>(static_cast<int64_t>(dstX + 1) * cropRect.w / dst.width);
+        srcX1 = std::max(srcX1, srcX0 + 1);
+        uint32_t sum[RGBA_PIXEL_SIZE] = { 0 };
+        for (int32_t y = srcY0; y < srcY1; y++) {
+            const uint8_t *srcPixel = src.addr + static_cast<int64_t>(y) * src.stride + srcX0 * RGBA_PIXEL_SIZE;
+            for (int32_t x = srcX0; x < srcX1; x++, srcPixel += RGBA_PIXEL_SIZE) {
+                for (int32_t c = 0; c < RGBA_PIXEL_SIZE; c++) {
+                    sum[c] += srcPixel[c];
+                }
+            }
+        }
+        uint32_t count = static_cast<uint32_t>((srcY1 - srcY0) * (srcX1 - srcX0));
+        uint8_t *dstPixel = dstRow + dstX * RGBA_PIXEL_SIZE;
+        for (int32_t c = 0; c < RGBA_PIXEL_SIZE; c++) {
+            dstPixel[c] = static_cast<uint8_t>((sum[c] + count / 2) / count);
+        }
+    }
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SCREEN_CAPTURE_SCALER_H
+#define SCREEN_CAPTURE_SCALER_H
+
+#include <cstdint>
+#include <mutex>
+#include "screen_capture.h"
+#include "surface.h"
+#include "sync_fence.h"
+#include "task_queue.h"
+
+namespace OHOS {
+namespace Media {
+struct ScalerImage {
+    uint8_t *addr = nullptr;
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t stride = 0;
+};
+
+/**
+ * Scaler stage of one output profile. It is fed with the RGBA frames of the virtual screen consumer,
+ * crops and scales them to the profile size on its own worker and queues the result into the surface of the profile.
+ */
+class ScreenCaptureScaler {
+public:
+    ScreenCaptureScaler(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile);
+    ~ScreenCaptureScaler();
+
+    // The returned task reads srcBuffer, it must be finished before srcBuffer goes back to the virtual screen.
+    // Returns nullptr when the frame could not be handed to the worker and was scaled in place.
+    // srcBuffer is only read once acquireFence has signaled, the frame is dropped if it does not in time.
+    std::shared_ptr<TaskHandler<void>> ScheduleFrame(const sptr<SurfaceBuffer> &srcBuffer,
+        const sptr<SyncFence> &acquireFence, int64_t timestamp);
+    int32_t ProduceFrame(const sptr<SurfaceBuffer> &srcBuffer, const sptr<SyncFence> &acquireFence,
+        int64_t timestamp);
+    uint64_t GetProducedCount();
+    uint64_t GetDroppedCount();
+    const OHOS::Rect &GetCropRect() const;
+
+    // Box filter for downscaling, nearest sampling for upscaling. RGBA 8888 only.
+    static int32_t ScaleRgba(const ScalerImage &src, const OHOS::Rect &cropRect, const ScalerImage &dst);
+
+private:
+    static void ScaleRow(const ScalerImage &src, const OHOS::Rect &cropRect, const ScalerImage &dst, int32_t dstY);
+
+    std::mutex mutex_;
+    TaskQueue taskQue_;
+    sptr<Surface> surface_ = nullptr;
+    ScreenCaptureOutputProfile profile_;
+    uint64_t producedCount_ = 0;
+    uint64_t droppedCount_ = 0;
+
+    static constexpr int32_t REQUEST_BUFFER_TIMEOUT_MS = 0; // never block the capture path on a slow consumer
+    static constexpr int32_t RELEASE_FENCE_WAIT_MS = 100;
+    static constexpr int32_t ACQUIRE_FENCE_WAIT_MS = 100;
+    static constexpr int32_t RGBA_PIXEL_SIZE = 4;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // SCREEN_CAPTURE_SCALER_H
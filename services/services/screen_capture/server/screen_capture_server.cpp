@@ -1486,6 +1486,37 @@ void ScreenCaptureServer::GetDumpFlag()
     MEDIA_LOGI("get dump flag, dumpRes: %{public}d, isDump_: %{public}d", dumpRes, isDump_);
 }
 
+void ScreenCaptureServer::GetFramePacingParam()
+{
+    const std::string skipStaticTag = "sys.media.screenCapture.skipStaticFrame.enable";
+    std::string skipStaticEnable;
+    (void)OHOS::system::GetStringParameter(skipStaticTag, skipStaticEnable, "false");
+    framePacingInfo_.skipStaticFrame = (skipStaticEnable == "true");
+
+    const std::string maxFrameRateTag = "sys.media.screenCapture.maxFrameRate";
+    int32_t maxFrameRate = OHOS::system::GetIntParameter(maxFrameRateTag, 0);
+    framePacingInfo_.maxFrameRate = (maxFrameRate >= VIDEO_FRAME_RATE_MIN && maxFrameRate <= VIDEO_FRAME_RATE_MAX) ?
+        maxFrameRate : 0;
+    MEDIA_LOGI("get frame pacing param, skipStaticFrame: %{public}d, maxFrameRate: %{public}d",
+        framePacingInfo_.skipStaticFrame, framePacingInfo_.maxFrameRate);
+}
+
+void ScreenCaptureServer::ReportFrameSkipStatistics()
+{
+    CHECK_AND_RETURN(surfaceCb_ != nullptr);
+    FrameSkipStatistics statistics =
+        (static_cast<ScreenCapBufferConsumerListener *>(surfaceCb_.GetRefPtr()))->GetFrameSkipStatistics();
+    MEDIA_LOGI("ScreenCaptureServer: 0x%{public}06" PRIXPTR " frame statistics, delivered:%{public}" PRIu64
+        ", static skipped:%{public}" PRIu64 ", pacing skipped:%{public}" PRIu64 ", slow consumer dropped:%{public}"
+        PRIu64, FAKE_POINTER(this), statistics.deliveredCount, statistics.staticSkipCount,
+        statistics.pacingSkipCount, statistics.slowConsumerDropCount);
+    for (size_t i = 0; i < outputScalers_.size(); i++) {
+        MEDIA_LOGI("ScreenCaptureServer: 0x%{public}06" PRIXPTR " output profile %{public}zu, produced:%{public}"
+            PRIu64 ", dropped:%{public}" PRIu64, FAKE_POINTER(this), i, outputScalers_[i]->GetProducedCount(),
+            outputScalers_[i]->GetDroppedCount());
+    }
+}
+
 int32_t ScreenCaptureServer::StartScreenCapture(bool isPrivacyAuthorityEnabled)
 {
     MediaTrace trace("ScreenCaptureServer::StartScreenCapture");
@@ -1493,6 +1524,7 @@ int32_t ScreenCaptureServer::StartScreenCapture(bool isPrivacyAuthorityEnabled)
     startTime_ = GetCurrentMillisecond();
     statisticalEventInfo_.enableMic = isMicrophoneOn_;
     GetDumpFlag();
+    GetFramePacingParam();
     MEDIA_LOGI("ScreenCaptureServer: 0x%{public}06" PRIXPTR "StartScreenCapture start, "
         "isPrivacyAuthorityEnabled:%{public}s, captureState:%{public}d.",
         FAKE_POINTER(this), isPrivacyAuthorityEnabled ? "true" : "false", captureState_);
@@ -1554,9 +1586,17 @@ int32_t ScreenCaptureServer::StartHomeVideoCapture()
     if (isSurfaceMode_) {
         int32_t ret = CreateVirtualScreen(virtualScreenName, surface_);
         CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "create virtual screen with input surface failed");
+        if (!outputScalers_.empty()) {
+            MEDIA_LOGW("output profiles are ignored in surface mode");
+        }
         return MSERR_OK;
     }
 
+    for (const auto &scaler : outputScalers_) {
+        CHECK_AND_RETURN_RET_LOG(IsCropInCaptureSize(scaler->GetCropRect()), MSERR_INVALID_VAL,
+            "crop rect of an output profile is out of the capture size");
+    }
+
     ON_SCOPE_EXIT(0) {
         DestroyVirtualScreen();
         if (consumer_ != nullptr && surfaceCb_ != nullptr) {
@@ -1576,6 +1616,8 @@ int32_t ScreenCaptureServer::StartHomeVideoCapture()
     CHECK_AND_RETURN_RET_LOG(producerSurface != nullptr, MSERR_UNKNOWN, "CreateSurfaceAsProducer failed");
     surfaceCb_ = OHOS::sptr<ScreenCapBufferConsumerListener>::MakeSptr(consumer_, screenCaptureCb_);
     CHECK_AND_RETURN_RET_LOG(surfaceCb_ != nullptr, MSERR_UNKNOWN, "MakeSptr surfaceCb_ failed");
+    (static_cast<ScreenCapBufferConsumerListener *>(surfaceCb_.GetRefPtr()))->SetFramePacing(framePacingInfo_);
+    (static_cast<ScreenCapBufferConsumerListener *>(surfaceCb_.GetRefPtr()))->SetOutputScalers(outputScalers_);
     consumer_->RegisterConsumerListener(surfaceCb_);
     int32_t ret = CreateVirtualScreen(virtualScreenName, producerSurface);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "create virtual screen without input surface failed");
@@ -1959,6 +2001,39 @@ int32_t ScreenCaptureServer::ExcludeContent(ScreenCaptureContentFilter &contentF
     return ret;
 }
 
+int32_t ScreenCaptureServer::AddOutputProfile(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile)
+{
+    MediaTrace trace("ScreenCaptureServer::AddOutputProfile");
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(captureState_ == AVScreenCaptureState::CREATED ||
+        captureState_ == AVScreenCaptureState::STOPPED, MSERR_INVALID_OPERATION,
+        "AddOutputProfile failed, capture is starting or started, state:%{public}d", captureState_);
+    CHECK_AND_RETURN_RET_LOG(surface != nullptr, MSERR_INVALID_VAL, "AddOutputProfile failed, surface is nullptr");
+    CHECK_AND_RETURN_RET_LOG(profile.width > 0 && profile.width <= VIDEO_FRAME_WIDTH_MAX &&
+        profile.height > 0 && profile.height <= VIDEO_FRAME_HEIGHT_MAX, MSERR_INVALID_VAL,
+        "AddOutputProfile failed, invalid size %{public}dx%{public}d", profile.width, profile.height);
+    CHECK_AND_RETURN_RET_LOG(IsCropInCaptureSize(profile.cropRect), MSERR_INVALID_VAL,
+        "AddOutputProfile failed, invalid crop rect [%{public}d,%{public}d,%{public}d,%{public}d]",
+        profile.cropRect.x, profile.cropRect.y, profile.cropRect.w, profile.cropRect.h);
+    CHECK_AND_RETURN_RET_LOG(outputScalers_.size() < OUTPUT_PROFILE_COUNT_MAX, MSERR_INVALID_OPERATION,
+        "AddOutputProfile failed, at most %{public}zu output profiles", OUTPUT_PROFILE_COUNT_MAX);
+    outputScalers_.push_back(std::make_shared<ScreenCaptureScaler>(surface, profile));
+    MEDIA_LOGI("ScreenCaptureServer: 0x%{public}06" PRIXPTR " AddOutputProfile %{public}dx%{public}d, "
+        "count:%{public}zu", FAKE_POINTER(this), profile.width, profile.height, outputScalers_.size());
+    return MSERR_OK;
+}
+
+bool ScreenCaptureServer::IsCropInCaptureSize(const OHOS::Rect &cropRect)
+{
+    // the capture size may be set after the profile, until then only the largest capture size is known
+    const VideoCaptureInfo &videoCapInfo = captureConfig_.videoInfo.videoCapInfo;
+    int64_t captureWidth = videoCapInfo.videoFrameWidth > 0 ? videoCapInfo.videoFrameWidth : VIDEO_FRAME_WIDTH_MAX;
+    int64_t captureHeight = videoCapInfo.videoFrameHeight > 0 ? videoCapInfo.videoFrameHeight : VIDEO_FRAME_HEIGHT_MAX;
+    return cropRect.x >= 0 && cropRect.y >= 0 && cropRect.w >= 0 && cropRect.h >= 0 &&
+        static_cast<int64_t>(cropRect.x) + cropRect.w <= captureWidth &&
+        static_cast<int64_t>(cropRect.y) + cropRect.h <= captureHeight;
+}
+
 int32_t ScreenCaptureServer::SetMicrophoneEnabled(bool isMicrophone)
 {
     MediaTrace trace("ScreenCaptureServer::SetMicrophoneEnabled");
@@ -2149,6 +2224,7 @@ int32_t ScreenCaptureServer::StopVideoCapture()
     }
 
     if (surfaceCb_ != nullptr) {
+        ReportFrameSkipStatistics();
         (static_cast<ScreenCapBufferConsumerListener *>(surfaceCb_.GetRefPtr()))->Release();
         surfaceCb_ = nullptr;
     }
@@ -2293,6 +2369,7 @@ void ScreenCaptureServer::ReleaseInner()
         StopScreenCaptureInner(AVScreenCaptureStateCode::SCREEN_CAPTURE_STATE_INVLID);
         sessionId = sessionId_;
         sessionId_ = SESSION_ID_INVALID;
+        outputScalers_.clear();
         MEDIA_LOGI("0x%{public}06" PRIXPTR " Instances ReleaseInner Stop done, sessionId:%{public}d",
             FAKE_POINTER(this), sessionId);
     }
@@ -2347,14 +2424,49 @@ void ScreenCapBufferConsumerListener::OnBufferAvailable()
     }
     MEDIA_LOGD("SurfaceBuffer size:%{public}u", buffer->GetSize());
 
+    int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    std::vector<std::shared_ptr<ScreenCaptureScaler>> scalers;
+    {
+        std::unique_lock<std::mutex> lock(bufferMutex_);
+        if (ShouldSkipFrame(damage, nowNs)) {
+            consumer_->ReleaseBuffer(buffer, flushFence);
+            return;
+        }
+        scalers = scalers_;
+    }
+    // Every scaled output runs on its own worker, the frame reaches the main consumer without waiting for them.
+    // The buffer goes back to the virtual screen only once the scalers are done with it.
+    auto entry = std::make_unique<SurfaceBufferEntry>(buffer, flushFence, timestamp, damage);
+    // the entry keeps flushFence for the release, the workers wait on a copy of it before reading the pixels
+    sptr<SyncFence> acquireFence = SyncFence::INVALID_FENCE;
+    if (!scalers.empty() && flushFence >= 0) {
+        acquireFence = new SyncFence(::dup(flushFence));
+    }
+    for (auto &scaler : scalers) {
+        auto task = scaler->ScheduleFrame(buffer, acquireFence, timestamp);
+        if (task != nullptr) {
+            entry->scaleTasks.push_back(task);
+        }
+    }
+
     {
         std::unique_lock<std::mutex> lock(bufferMutex_);
         if (availBuffers_.size() > MAX_BUFFER_SIZE) {
             MEDIA_LOGE("consume slow, drop video frame");
+            frameSkipStatistics_.slowConsumerDropCount++;
+            // the consumer never sees this picture, its changes must come with one of the next frames
+            hasPendingDamage_ = hasPendingDamage_ || !IsEmptyDamage(damage);
+            lock.unlock();
+            entry->WaitScaleTasks();
             consumer_->ReleaseBuffer(buffer, flushFence);
             return;
         }
-        availBuffers_.push(std::make_unique<SurfaceBufferEntry>(buffer, flushFence, timestamp, damage));
+        availBuffers_.push(std::move(entry));
+        frameSkipStatistics_.deliveredCount++;
+        // pacing only counts frames that really reached the queue
+        lastDeliveredTimeNs_ = nowNs;
+        hasPendingDamage_ = false;
     }
     bufferCond_.notify_all();
 
@@ -2392,10 +2504,14 @@ int32_t ScreenCapBufferConsumerListener::ReleaseVideoBuffer()
         FAKE_POINTER(this));
     CHECK_AND_RETURN_RET_LOG(!availBuffers_.empty(), MSERR_OK, "buffer queue is empty, no video frame to release");
 
+    std::unique_ptr<SurfaceBufferEntry> entry = std::move(availBuffers_.front());
+    availBuffers_.pop();
+    lock.unlock();
+    // scalers normally finished long before the app is done with the frame
+    entry->WaitScaleTasks();
     if (consumer_ != nullptr) {
-        consumer_->ReleaseBuffer(availBuffers_.front()->buffer, availBuffers_.front()->flushFence);
+        consumer_->ReleaseBuffer(entry->buffer, entry->flushFence);
     }
-    availBuffers_.pop();
     MEDIA_LOGD("ScreenCapBufferConsumerListener: 0x%{public}06" PRIXPTR "ReleaseVideoBuffer end.", FAKE_POINTER(this));
     return MSERR_OK;
 }
@@ -2407,6 +2523,60 @@ int32_t ScreenCapBufferConsumerListener::Release()
     return ReleaseBuffer();
 }
 
+void ScreenCapBufferConsumerListener::SetFramePacing(const FramePacingInfo &framePacingInfo)
+{
+    std::unique_lock<std::mutex> lock(bufferMutex_);
+    framePacingInfo_ = framePacingInfo;
+    lastDeliveredTimeNs_ = -1;
+    hasPendingDamage_ = false;
+}
+
+void ScreenCapBufferConsumerListener::SetOutputScalers(
+    const std::vector<std::shared_ptr<ScreenCaptureScaler>> &scalers)
+{
+    std::unique_lock<std::mutex> lock(bufferMutex_);
+    scalers_ = scalers;
+}
+
+FrameSkipStatistics ScreenCapBufferConsumerListener::GetFrameSkipStatistics()
+{
+    std::unique_lock<std::mutex> lock(bufferMutex_);
+    return frameSkipStatistics_;
+}
+
+bool ScreenCapBufferConsumerListener::IsEmptyDamage(const OHOS::Rect &damage)
+{
+    return damage.w <= 0 || damage.h <= 0;
+}
+
+bool ScreenCapBufferConsumerListener::ShouldSkipFrame(const OHOS::Rect &damage, int64_t nowNs)
+{
+    if (lastDeliveredTimeNs_ < 0) {
+        return false;
+    }
+    int64_t elapsedNs = nowNs - lastDeliveredTimeNs_;
+    bool isStaticFrame = IsEmptyDamage(damage) && !hasPendingDamage_;
+    // An empty damage means nothing changed since the last delivered frame, the consumer already holds
+    // this picture. Still repeat it now and then, so that the stream downstream does not look stalled.
+    if (framePacingInfo_.skipStaticFrame && isStaticFrame && elapsedNs < STATIC_FRAME_REPEAT_INTERVAL_NS) {
+        frameSkipStatistics_.staticSkipCount++;
+        MEDIA_LOGD("skip static video frame");
+        return true;
+    }
+    if (framePacingInfo_.maxFrameRate > 0) {
+        // allow a quarter of the interval as jitter, so the output rate does not fall below the target
+        int64_t frameIntervalNs = 1000000000 / framePacingInfo_.maxFrameRate;
+        if (elapsedNs < frameIntervalNs - frameIntervalNs / 4) {
+            // the changes of a dropped frame must reach the consumer with one of the next frames
+            hasPendingDamage_ = hasPendingDamage_ || !isStaticFrame;
+            frameSkipStatistics_.pacingSkipCount++;
+            MEDIA_LOGD("skip video frame above max frame rate");
+            return true;
+        }
+    }
+    return false;
+}
+
 void ScreenRendererAudioStateChangeCallback::SetAudioSource(std::shared_ptr<AudioDataSource> audioSource)
 {
     audioSource_ = audioSource;
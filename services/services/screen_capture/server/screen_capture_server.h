@@ -54,6 +54,7 @@
 #include "meta/meta.h"
 #include "audio_stream_manager.h"
 #include "screen_capture_monitor_server.h"
+#include "screen_capture_scaler.h"
 
 namespace OHOS {
 namespace Media {
@@ -122,6 +123,16 @@ struct SurfaceBufferEntry {
     int32_t flushFence;
     int64_t timeStamp = 0;
     OHOS::Rect damageRect = {0, 0, 0, 0};
+    // scaled outputs still reading the buffer
+    std::vector<std::shared_ptr<TaskHandler<void>>> scaleTasks;
+
+    void WaitScaleTasks()
+    {
+        for (auto &task : scaleTasks) {
+            (void)task->GetResult();
+        }
+        scaleTasks.clear();
+    }
 };
 
 struct StatisticalEventInfo {
@@ -136,6 +147,18 @@ struct StatisticalEventInfo {
     int32_t startLatency = -1;
 };
 
+struct FramePacingInfo {
+    bool skipStaticFrame = false;
+    int32_t maxFrameRate = 0;
+};
+
+struct FrameSkipStatistics {
+    uint64_t deliveredCount = 0;
+    uint64_t staticSkipCount = 0;
+    uint64_t pacingSkipCount = 0;
+    uint64_t slowConsumerDropCount = 0;
+};
+
 class ScreenCapBufferConsumerListener : public IBufferConsumerListener {
 public:
     ScreenCapBufferConsumerListener(
@@ -152,11 +175,18 @@ public:
         OHOS::Rect &damage);
     int32_t ReleaseVideoBuffer();
     int32_t Release();
+    void SetFramePacing(const FramePacingInfo &framePacingInfo);
+    FrameSkipStatistics GetFrameSkipStatistics();
+    void SetOutputScalers(const std::vector<std::shared_ptr<ScreenCaptureScaler>> &scalers);
 
 private:
+    static bool IsEmptyDamage(const OHOS::Rect &damage);
+    bool ShouldSkipFrame(const OHOS::Rect &damage, int64_t nowNs);
+
     int32_t ReleaseBuffer()
     {
         while (!availBuffers_.empty()) {
+            availBuffers_.front()->WaitScaleTasks();
             if (consumer_ != nullptr) {
                 consumer_->ReleaseBuffer(availBuffers_.front()->buffer,
                     availBuffers_.front()->flushFence);
@@ -175,8 +205,16 @@ private:
     std::condition_variable bufferCond_;
     std::queue<std::unique_ptr<SurfaceBufferEntry>> availBuffers_;
 
+    /* frame skipping and pacing, guarded by bufferMutex_ */
+    FramePacingInfo framePacingInfo_;
+    FrameSkipStatistics frameSkipStatistics_;
+    int64_t lastDeliveredTimeNs_ = -1;
+    bool hasPendingDamage_ = false;
+    std::vector<std::shared_ptr<ScreenCaptureScaler>> scalers_;
+
     static constexpr uint32_t MAX_BUFFER_SIZE = 3;
     static constexpr uint32_t OPERATION_TIMEOUT_IN_MS = 1000; // 1000ms
+    static constexpr int64_t STATIC_FRAME_REPEAT_INTERVAL_NS = 1000000000; // deliver a static frame at least every 1s
 };
 
 class ScreenCaptureObserverCallBack : public InCallObserverCallBack {
@@ -269,6 +307,7 @@ public:
     int32_t SetCanvasRotation(bool canvasRotation) override;
     void Release() override;
     int32_t ExcludeContent(ScreenCaptureContentFilter &contentFilter) override;
+    int32_t AddOutputProfile(sptr<Surface> surface, const ScreenCaptureOutputProfile &profile) override;
 
     void SetSessionId(int32_t sessionId);
     int32_t OnReceiveUserPrivacyAuthority(bool isAllowed);
@@ -301,6 +340,7 @@ private:
     int32_t StopMicAudioCapture();
     int32_t StartVideoCapture();
     int32_t StartHomeVideoCapture();
+    bool IsCropInCaptureSize(const OHOS::Rect &cropRect);
     int32_t StopScreenCaptureInner(AVScreenCaptureStateCode stateCode);
     void PostStopScreenCapture(AVScreenCaptureStateCode stateCode);
     int32_t StopAudioCapture();
@@ -315,6 +355,8 @@ private:
     void CloseFd();
     void ReleaseInner();
     void GetDumpFlag();
+    void GetFramePacingParam();
+    void ReportFrameSkipStatistics();
 
     VirtualScreenOption InitVirtualScreenOption(const std::string &name, sptr<OHOS::Surface> consumer);
     int32_t GetMissionIds(std::vector<uint64_t> &missionIds);
@@ -368,6 +410,8 @@ private:
     sptr<OHOS::Surface> consumer_ = nullptr;
     bool isConsumerStart_ = false;
     bool isDump_ = false;
+    FramePacingInfo framePacingInfo_;
+    std::vector<std::shared_ptr<ScreenCaptureScaler>> outputScalers_;
     ScreenId screenId_ = SCREEN_ID_INVALID;
     std::vector<uint64_t> missionIds_;
     ScreenCaptureContentFilter contentFilter_;
@@ -417,6 +461,7 @@ private:
     static constexpr int32_t VIDEO_FRAME_RATE_MAX = 60;
     static constexpr int32_t VIDEO_FRAME_WIDTH_MAX = 10240;
     static constexpr int32_t VIDEO_FRAME_HEIGHT_MAX = 4320;
+    static constexpr size_t OUTPUT_PROFILE_COUNT_MAX = 4;
     static constexpr int32_t SESSION_ID_INVALID = -1;
 };
 } // namespace Media
@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "transcoder_job_scheduler.h"
+#include <algorithm>
+#include <cinttypes>
+#include <vector>
+#include "media_log.h"
+#include "param_wrapper.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_PLAYER, "TransCoderJobScheduler"};
+    constexpr int32_t DEFAULT_MAX_CODEC_SLOTS = 2;
+    constexpr int32_t MAX_CODEC_SLOTS = 16;
+    constexpr int32_t DEFAULT_MEMORY_BUDGET_MB = 192;
+    constexpr int32_t MAX_MEMORY_BUDGET_MB = 4096;
+    constexpr uint64_t MB_TO_BYTES = 1024 * 1024;
+}
+
+namespace OHOS {
+namespace Media {
+TransCoderJobScheduler &TransCoderJobScheduler::GetInstance()
+{
+    static TransCoderJobScheduler instance(
+        OHOS::system::GetIntParameter("sys.media.transcoder.maxCodecSlots", DEFAULT_MAX_CODEC_SLOTS, 1,
+            MAX_CODEC_SLOTS),
+        static_cast<uint64_t>(OHOS::system::GetIntParameter("sys.media.transcoder.memoryBudgetMb",
+            DEFAULT_MEMORY_BUDGET_MB, 1, MAX_MEMORY_BUDGET_MB)) * MB_TO_BYTES);
+    return instance;
+}
+
+TransCoderJobScheduler::TransCoderJobScheduler(int32_t maxCodecSlots, uint64_t memoryBudget)
+    : maxCodecSlots_(maxCodecSlots > 0 ? maxCodecSlots : DEFAULT_MAX_CODEC_SLOTS), memoryBudget_(memoryBudget)
+{
+    MEDIA_LOGI("max codec slots %{public}d, memory budget %{public}" PRIu64, maxCodecSlots_, memoryBudget_);
+}
+
+uint64_t TransCoderJobScheduler::AddJob(int32_t pid, const TransCoderJobCost &cost,
+    const TransCoderJobRecalls &recalls)
+{
+    uint64_t jobId = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        JobInfo job;
+        job.jobId = nextJobId_++;
+        job.pid = pid;
+        job.cost = cost;
+        job.recalls = recalls;
+        job.isForeground = IsForeground(pid);
+        jobId = job.jobId;
+        auto result = jobs_.emplace(jobId, job);
+        MEDIA_LOGI("job %{public}" PRIu64 " added, pid %{public}d, foreground %{public}d, slots %{public}d, "
+            "memory %{public}" PRIu64, jobId, pid, job.isForeground, cost.codecSlots, cost.memoryBytes);
+        Dispatch();
+        ReportHeld(result.first->second);
+    }
+    RunPendingRecalls();
+    return jobId;
+}
+
+void TransCoderJobScheduler::RemoveJob(uint64_t jobId)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // the recalls hold on to the job's owner, which may be gone once this returns. A recall that removes its
+        // own job runs on this thread and must not be waited for
+        recallCond_.wait(lock, [this, jobId]() {
+            return runningRecallJobId_ != jobId || recallThreadId_ == std::this_thread::get_id();
+        });
+        pendingRecalls_.erase(std::remove_if(pendingRecalls_.begin(), pendingRecalls_.end(),
+            [jobId](const PendingRecall &pending) { return pending.jobId == jobId; }), pendingRecalls_.end());
+        auto it = jobs_.find(jobId);
+        CHECK_AND_RETURN(it != jobs_.end());
+        if (it->second.isRunning) {
+            usedCodecSlots_ -= it->second.cost.codecSlots;
+            runningCount_--;
+        }
+        if (it->second.isStarted) {
+            usedMemory_ -= it->second.cost.memoryBytes;
+        }
+        jobs_.erase(it);
+        MEDIA_LOGI("job %{public}" PRIu64 " removed, %{public}d running", jobId, runningCount_);
+        Dispatch();
+    }
+    RunPendingRecalls();
+}
+
+void TransCoderJobScheduler::PauseJob(uint64_t jobId)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = jobs_.find(jobId);
+        CHECK_AND_RETURN(it != jobs_.end() && !it->second.isUserPaused);
+        it->second.isUserPaused = true;
+        if (it->second.isRunning) {
+            StopRunning(it->second);
+            Dispatch();
+        }
+    }
+    RunPendingRecalls();
+}
+
+void TransCoderJobScheduler::ResumeJob(uint64_t jobId)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = jobs_.find(jobId);
+        CHECK_AND_RETURN(it != jobs_.end() && it->second.isUserPaused);
+        it->second.isUserPaused = false;
+        Dispatch();
+        ReportHeld(it->second);
+    }
+    RunPendingRecalls();
+}
+
+void TransCoderJobScheduler::OnAppStateChanged(int32_t pid, bool isForeground)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        appForeground_[pid] = isForeground;
+        bool isChanged = false;
+        for (auto &item : jobs_) {
+            if (item.second.pid == pid && item.second.isForeground != isForeground) {
+                item.second.isForeground = isForeground;
+                isChanged = true;
+            }
+        }
+        if (isChanged) {
+            MEDIA_LOGI("jobs of pid %{public}d turned %{public}s", pid, isForeground ? "foreground" : "background");
+            Dispatch();
+        }
+    }
+    RunPendingRecalls();
+}
+
+void TransCoderJobScheduler::RunPendingRecalls()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    // one thread at a time delivers, so a job never sees a resume before the suspend that was decided first
+    if (isRunningRecalls_) {
+        return;
+    }
+    isRunningRecalls_ = true;
+    recallThreadId_ = std::this_thread::get_id();
+    while (!pendingRecalls_.empty()) {
+        PendingRecall pending = std::move(pendingRecalls_.front());
+        pendingRecalls_.pop_front();
+        runningRecallJobId_ = pending.jobId;
+        lock.unlock();
+        pending.recall();
+        lock.lock();
+        runningRecallJobId_ = 0;
+        recallCond_.notify_all();
+    }
+    isRunningRecalls_ = false;
+    recallThreadId_ = std::thread::id();
+}
+
+TransCoderJobState TransCoderJobScheduler::GetJobState(uint64_t jobId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(jobId);
+    if (it == jobs_.end() || !it->second.isStarted) {
+        return TransCoderJobState::JOB_WAITING;
+    }
+    return it->second.isRunning ? TransCoderJobState::JOB_RUNNING : TransCoderJobState::JOB_SUSPENDED;
+}
+
+void TransCoderJobScheduler::DumpInfo(std::string &dumpString)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    dumpString += "TransCoderJobScheduler jobs: " + std::to_string(jobs_.size()) +
+        ", running: " + std::to_string(runningCount_) +
+        ", codec slots: " + std::to_string(usedCodecSlots_) + "/" + std::to_string(maxCodecSlots_) +
+        ", memory: " + std::to_string(usedMemory_) + "/" + std::to_string(memoryBudget_) +
+        ", preempted: " + std::to_string(preemptCount_) + "\n";
+}
+
+bool TransCoderJobScheduler::IsForeground(int32_t pid) const
+{
+    // an app the memory manager has not reported yet is the one that just asked, it counts as foreground
+    auto it = appForeground_.find(pid);
+    return it == appForeground_.end() || it->second;
+}
+
+bool TransCoderJobScheduler::IsFit(const JobInfo &job) const
+{
+    // with nothing running the head job always starts, a job bigger than the limits must not wait forever
+    if (runningCount_ == 0) {
+        return true;
+    }
+    uint64_t memory = job.isStarted ? 0 : job.cost.memoryBytes;
+    return usedCodecSlots_ + job.cost.codecSlots <= maxCodecSlots_ && usedMemory_ + memory <= memoryBudget_;
+}
+
+void TransCoderJobScheduler::StopRunning(JobInfo &job)
+{
+    job.isRunning = false;
+    usedCodecSlots_ -= job.cost.codecSlots;
+    runningCount_--;
+    if (job.recalls.suspendRecall != nullptr) {
+        pendingRecalls_.push_back({ job.jobId, job.recalls.suspendRecall });
+    }
+}
+
+void TransCoderJobScheduler::ReportHeld(JobInfo &job)
+{
+    if (job.isRunning || job.isUserPaused || job.isHeld) {
+        return;
+    }
+    job.isHeld = true;
+    QueueStateRecall(job, job.isStarted ? TransCoderJobState::JOB_SUSPENDED : TransCoderJobState::JOB_WAITING);
+}
+
+void TransCoderJobScheduler::QueueStateRecall(const JobInfo &job, TransCoderJobState state)
+{
+    if (job.recalls.stateRecall != nullptr) {
+        pendingRecalls_.push_back({ job.jobId, std::bind(job.recalls.stateRecall, state) });
+    }
+}
+
+bool TransCoderJobScheduler::PreemptFor(const JobInfo &job)
+{
+    // suspending only frees codec slots, a paused pipeline keeps its memory
+    uint64_t memory = job.isStarted ? 0 : job.cost.memoryBytes;
+    if (usedMemory_ + memory > memoryBudget_) {
+        return false;
+    }
+    int32_t freeableSlots = 0;
+    for (const auto &item : jobs_) {
+        if (item.second.isRunning && !item.second.isForeground) {
+            freeableSlots += item.second.cost.codecSlots;
+        }
+    }
+    if (usedCodecSlots_ - freeableSlots + job.cost.codecSlots > maxCodecSlots_) {
+        return false;
+    }
+    // the newest background jobs have the least progress to hold on to
+    for (auto it = jobs_.rbegin(); it != jobs_.rend() && !IsFit(job); ++it) {
+        if (it->second.isRunning && !it->second.isForeground) {
+            MEDIA_LOGI("job %{public}" PRIu64 " suspended for job %{public}" PRIu64, it->first, job.jobId);
+            StopRunning(it->second);
+            ReportHeld(it->second);
+            preemptCount_++;
+        }
+    }
+    return IsFit(job);
+}
+
+void TransCoderJobScheduler::Dispatch()
+{
+    std::vector<JobInfo *> candidates;
+    for (auto &item : jobs_) {
+        if (!item.second.isRunning && !item.second.isUserPaused) {
+            candidates.push_back(&item.second);
+        }
+    }
+    // foreground first, then in the order added, stable_sort keeps the job id order within a priority
+    std::stable_sort(candidates.begin(), candidates.end(), [](const JobInfo *lhs, const JobInfo *rhs) {
+        return lhs->isForeground && !rhs->isForeground;
+    });
+    for (JobInfo *job : candidates) {
+        // jobs start strictly in line, letting small jobs pass would starve a big one
+        if (!IsFit(*job) && !(job->isForeground && PreemptFor(*job))) {
+            break;
+        }
+        job->isRunning = true;
+        usedCodecSlots_ += job->cost.codecSlots;
+        runningCount_++;
+        TransCoderJobRecall recall;
+        if (job->isStarted) {
+            recall = job->recalls.resumeRecall;
+        } else {
+            job->isStarted = true;
+            usedMemory_ += job->cost.memoryBytes;
+            recall = job->recalls.startRecall;
+        }
+        MEDIA_LOGI("job %{public}" PRIu64 " running, %{public}d running", job->jobId, runningCount_);
+        if (recall != nullptr) {
+            pendingRecalls_.push_back({ job->jobId, recall });
+        }
+        if (job->isHeld) {
+            job->isHeld = false;
+            QueueStateRecall(*job, TransCoderJobState::JOB_RUNNING);
+        }
+    }
+}
+} // namespace Media
+} // namespace OHOS
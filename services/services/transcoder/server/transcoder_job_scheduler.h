@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRANSCODER_JOB_SCHEDULER_H
+#define TRANSCODER_JOB_SCHEDULER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace OHOS {
+namespace Media {
+enum class TransCoderJobState : int32_t {
+    JOB_WAITING = 0,
+    JOB_RUNNING,
+    JOB_SUSPENDED,
+};
+
+using TransCoderJobRecall = std::function<void()>;
+using TransCoderJobStateRecall = std::function<void(TransCoderJobState)>;
+// the scheduler drives a job only through these. They are called after its lock is released, in the order the
+// decisions were made, so they may ask the scheduler for state but must not wait for the pipeline. None of them
+// runs once RemoveJob returned
+struct TransCoderJobRecalls {
+    TransCoderJobRecall startRecall;
+    TransCoderJobRecall suspendRecall;
+    TransCoderJobRecall resumeRecall;
+    // JOB_WAITING or JOB_SUSPENDED when a job that should run is held back by other jobs, JOB_RUNNING once it runs
+    // again after that, a user pause is not reported
+    TransCoderJobStateRecall stateRecall;
+};
+
+struct TransCoderJobCost {
+    int32_t codecSlots = 1;
+    uint64_t memoryBytes = 0;
+};
+
+/**
+ * Service wide queue of transcode jobs. A job holds codec slots only while it runs and holds its memory from its
+ * first start until it is removed, because a paused pipeline keeps its buffers. Jobs of foreground apps come first
+ * and may suspend running background jobs to get codec slots, a suspended job resumes once it is first in line
+ * again. Jobs of the same priority start in the order they were added.
+ */
+class TransCoderJobScheduler {
+public:
+    static TransCoderJobScheduler &GetInstance();
+    TransCoderJobScheduler(int32_t maxCodecSlots, uint64_t memoryBudget);
+    ~TransCoderJobScheduler() = default;
+
+    uint64_t AddJob(int32_t pid, const TransCoderJobCost &cost, const TransCoderJobRecalls &recalls);
+    // drops the job's undelivered recalls and waits for one of them that is running on another thread
+    void RemoveJob(uint64_t jobId);
+    // user pause and resume, a paused job is never started or resumed by the scheduler
+    void PauseJob(uint64_t jobId);
+    void ResumeJob(uint64_t jobId);
+    void OnAppStateChanged(int32_t pid, bool isForeground);
+    TransCoderJobState GetJobState(uint64_t jobId);
+    void DumpInfo(std::string &dumpString);
+
+private:
+    struct JobInfo {
+        uint64_t jobId = 0;
+        int32_t pid = 0;
+        TransCoderJobCost cost;
+        TransCoderJobRecalls recalls;
+        bool isForeground = true;
+        bool isStarted = false;
+        bool isRunning = false;
+        bool isUserPaused = false;
+        bool isHeld = false;
+    };
+    struct PendingRecall {
+        uint64_t jobId = 0;
+        TransCoderJobRecall recall;
+    };
+    void Dispatch();
+    bool IsFit(const JobInfo &job) const;
+    bool PreemptFor(const JobInfo &job);
+    void StopRunning(JobInfo &job);
+    void ReportHeld(JobInfo &job);
+    void QueueStateRecall(const JobInfo &job, TransCoderJobState state);
+    bool IsForeground(int32_t pid) const;
+    void RunPendingRecalls();
+
+    std::mutex mutex_;
+    int32_t maxCodecSlots_;
+    uint64_t memoryBudget_;
+    int32_t usedCodecSlots_ = 0;
+    uint64_t usedMemory_ = 0;
+    int32_t runningCount_ = 0;
+    uint64_t nextJobId_ = 1;
+    uint64_t preemptCount_ = 0;
+    // ordered by job id, which is also the order the jobs were added
+    std::map<uint64_t, JobInfo> jobs_;
+    std::unordered_map<int32_t, bool> appForeground_;
+    std::deque<PendingRecall> pendingRecalls_;
+    bool isRunningRecalls_ = false;
+    // 0 while no recall runs, job ids start at 1
+    uint64_t runningRecallJobId_ = 0;
+    std::thread::id recallThreadId_;
+    std::condition_variable recallCond_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // TRANSCODER_JOB_SCHEDULER_H
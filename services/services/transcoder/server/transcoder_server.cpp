@@ -33,6 +33,10 @@ namespace {
         {OHOS::Media::TransCoderServer::REC_PAUSED, "paused"},
         {OHOS::Media::TransCoderServer::REC_ERROR, "error"},
     };
+    constexpr int32_t DEFAULT_JOB_WIDTH = 1920;
+    constexpr int32_t DEFAULT_JOB_HEIGHT = 1080;
+    // decoder output, encoder input surface and encoder output queues together
+    constexpr uint64_t JOB_FRAME_BUFFERS = 16;
 }
 
 namespace OHOS {
@@ -58,6 +62,7 @@ TransCoderServer::TransCoderServer()
 TransCoderServer::~TransCoderServer()
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
+    RemoveScheduledJob();
     {
         std::lock_guard<std::mutex> lock(mutex_);
         auto task = std::make_shared<TaskHandler<void>>([&, this] {
@@ -93,6 +98,7 @@ int32_t TransCoderServer::Init()
     auto result = task->GetResult();
     CHECK_AND_RETURN_RET_LOG(result.Value() == MSERR_OK, result.Value(), "Result failed");
 
+    appPid_ = appPid;
     status_ = REC_INITIALIZED;
     BehaviorEventWrite(GetStatusDescription(status_), "TransCoder");
     return MSERR_OK;
@@ -110,6 +116,7 @@ const std::string& TransCoderServer::GetStatusDescription(OHOS::Media::TransCode
 void TransCoderServer::OnError(TransCoderErrorType errorType, int32_t errorCode)
 {
     (void)errorType;
+    RemoveScheduledJob();
     std::lock_guard<std::mutex> lock(cbMutex_);
     lastErrMsg_ = MSErrorToExtErrorString(static_cast<MediaServiceErrCode>(errorCode));
     FaultEventWrite(lastErrMsg_, "TransCoder");
@@ -119,11 +126,79 @@ void TransCoderServer::OnError(TransCoderErrorType errorType, int32_t errorCode)
 
 void TransCoderServer::OnInfo(TransCoderOnInfoType type, int32_t extra)
 {
+    if (type == INFO_TYPE_TRANSCODER_COMPLETED) {
+        RemoveScheduledJob();
+    }
     std::lock_guard<std::mutex> lock(cbMutex_);
     CHECK_AND_RETURN(transCoderCb_ != nullptr);
     transCoderCb_->OnInfo(type, extra);
 }
 
+TransCoderJobCost TransCoderServer::GetJobCost() const
+{
+    TransCoderJobCost cost;
+    bool hasSize = config_.width > 0 && config_.height > 0;
+    uint64_t width = static_cast<uint64_t>(hasSize ? config_.width : DEFAULT_JOB_WIDTH);
+    uint64_t height = static_cast<uint64_t>(hasSize ? config_.height : DEFAULT_JOB_HEIGHT);
+    cost.memoryBytes = width * height * 3 / 2 * JOB_FRAME_BUFFERS; // 3 / 2: yuv420 frame
+    return cost;
+}
+
+void TransCoderServer::RemoveScheduledJob()
+{
+    std::lock_guard<std::mutex> jobLock(jobMutex_);
+    CHECK_AND_RETURN(jobId_ != 0);
+    TransCoderJobScheduler::GetInstance().RemoveJob(jobId_);
+    jobId_ = 0;
+}
+
+void TransCoderServer::OnJobStart()
+{
+    auto task = std::make_shared<TaskHandler<void>>([this] {
+        CHECK_AND_RETURN(transCoderEngine_ != nullptr);
+        // a failed start is reported by the engine through OnError, which gives the job up
+        int32_t ret = transCoderEngine_->Start();
+        CHECK_AND_RETURN_LOG(ret == MSERR_OK, "start scheduled job failed, ret %{public}d", ret);
+    });
+    (void)taskQue_.EnqueueTask(task);
+}
+
+void TransCoderServer::OnJobSuspend()
+{
+    auto task = std::make_shared<TaskHandler<void>>([this] {
+        CHECK_AND_RETURN(transCoderEngine_ != nullptr);
+        int32_t ret = transCoderEngine_->Pause();
+        CHECK_AND_RETURN_LOG(ret == MSERR_OK, "suspend scheduled job failed, ret %{public}d", ret);
+    });
+    (void)taskQue_.EnqueueTask(task);
+}
+
+void TransCoderServer::OnJobResume()
+{
+    auto task = std::make_shared<TaskHandler<void>>([this] {
+        CHECK_AND_RETURN(transCoderEngine_ != nullptr);
+        int32_t ret = transCoderEngine_->Resume();
+        CHECK_AND_RETURN_LOG(ret == MSERR_OK, "resume scheduled job failed, ret %{public}d", ret);
+    });
+    (void)taskQue_.EnqueueTask(task);
+}
+
+void TransCoderServer::OnJobStateChanged(TransCoderJobState state)
+{
+    TransCoderScheduleState scheduleState = SCHEDULE_STATE_RUNNING;
+    if (state == TransCoderJobState::JOB_WAITING) {
+        scheduleState = SCHEDULE_STATE_QUEUED;
+    } else if (state == TransCoderJobState::JOB_SUSPENDED) {
+        scheduleState = SCHEDULE_STATE_SUSPENDED;
+    }
+    // queued behind the start, suspend and resume tasks so the app hears about them in the order they happen
+    auto task = std::make_shared<TaskHandler<void>>([this, scheduleState] {
+        MEDIA_LOGI("0x%{public}06" PRIXPTR " schedule state %{public}d", FAKE_POINTER(this), scheduleState);
+        OnInfo(INFO_TYPE_SCHEDULE_STATE_CHANGE, scheduleState);
+    });
+    (void)taskQue_.EnqueueTask(task);
+}
+
 int32_t TransCoderServer::SetVideoEncoder(VideoCodecFormat encoder)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -326,17 +401,21 @@ int32_t TransCoderServer::Start()
     CHECK_AND_RETURN_RET_LOG(status_ == REC_PREPARED, MSERR_INVALID_OPERATION,
         "invalid status, current status is %{public}s", GetStatusDescription(status_).c_str());
     CHECK_AND_RETURN_RET_LOG(transCoderEngine_ != nullptr, MSERR_NO_MEMORY, "engine is nullptr");
-    auto task = std::make_shared<TaskHandler<int32_t>>([&, this] {
-        return transCoderEngine_->Start();
-    });
-    int32_t ret = taskQue_.EnqueueTask(task);
-    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "EnqueueTask failed");
-
-    auto result = task->GetResult();
-    ret = result.Value();
-    status_ = (ret == MSERR_OK ? REC_TRANSCODERING : REC_ERROR);
+    // the scheduler starts the engine on this task queue once codecs and memory allow it, a start that fails
+    // there is reported through OnError. The recalls hold this, RemoveScheduledJob in the destructor drops the
+    // undelivered ones and waits for a running one
+    TransCoderJobRecalls recalls;
+    recalls.startRecall = [this]() { OnJobStart(); };
+    recalls.suspendRecall = [this]() { OnJobSuspend(); };
+    recalls.resumeRecall = [this]() { OnJobResume(); };
+    recalls.stateRecall = [this](TransCoderJobState state) { OnJobStateChanged(state); };
+    {
+        std::lock_guard<std::mutex> jobLock(jobMutex_);
+        jobId_ = TransCoderJobScheduler::GetInstance().AddJob(appPid_, GetJobCost(), recalls);
+    }
+    status_ = REC_TRANSCODERING;
     BehaviorEventWrite(GetStatusDescription(status_), "TransCoder");
-    return ret;
+    return MSERR_OK;
 }
 
 int32_t TransCoderServer::Pause()
@@ -347,17 +426,14 @@ int32_t TransCoderServer::Pause()
     CHECK_AND_RETURN_RET_LOG(status_ == REC_TRANSCODERING, MSERR_INVALID_OPERATION,
         "invalid status, current status is %{public}s", GetStatusDescription(status_).c_str());
     CHECK_AND_RETURN_RET_LOG(transCoderEngine_ != nullptr, MSERR_NO_MEMORY, "engine is nullptr");
-    auto task = std::make_shared<TaskHandler<int32_t>>([&, this] {
-        return transCoderEngine_->Pause();
-    });
-    int32_t ret = taskQue_.EnqueueTask(task);
-    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "EnqueueTask failed");
-
-    auto result = task->GetResult();
-    ret = result.Value();
-    status_ = (ret == MSERR_OK ? REC_PAUSED : REC_ERROR);
+    {
+        // a job still waiting for its turn is only held back, a running one is paused by the scheduler
+        std::lock_guard<std::mutex> jobLock(jobMutex_);
+        TransCoderJobScheduler::GetInstance().PauseJob(jobId_);
+    }
+    status_ = REC_PAUSED;
     BehaviorEventWrite(GetStatusDescription(status_), "TransCoder");
-    return ret;
+    return MSERR_OK;
 }
 
 int32_t TransCoderServer::Resume()
@@ -368,17 +444,13 @@ int32_t TransCoderServer::Resume()
     CHECK_AND_RETURN_RET_LOG(status_ == REC_TRANSCODERING || status_ == REC_PAUSED, MSERR_INVALID_OPERATION,
         "invalid status, current status is %{public}s", GetStatusDescription(status_).c_str());
     CHECK_AND_RETURN_RET_LOG(transCoderEngine_ != nullptr, MSERR_NO_MEMORY, "engine is nullptr");
-    auto task = std::make_shared<TaskHandler<int32_t>>([&, this] {
-        return transCoderEngine_->Resume();
-    });
-    int32_t ret = taskQue_.EnqueueTask(task);
-    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "EnqueueTask failed");
-
-    auto result = task->GetResult();
-    ret = result.Value();
-    status_ = (ret == MSERR_OK ? REC_TRANSCODERING : REC_ERROR);
+    {
+        std::lock_guard<std::mutex> jobLock(jobMutex_);
+        TransCoderJobScheduler::GetInstance().ResumeJob(jobId_);
+    }
+    status_ = REC_TRANSCODERING;
     BehaviorEventWrite(GetStatusDescription(status_), "TransCoder");
-    return ret;
+    return MSERR_OK;
 }
 
 int32_t TransCoderServer::Cancel()
@@ -386,6 +458,7 @@ int32_t TransCoderServer::Cancel()
     std::lock_guard<std::mutex> lock(mutex_);
     MediaTrace trace("TransCoderServer::Cancel");
     CHECK_AND_RETURN_RET_LOG(transCoderEngine_ != nullptr, MSERR_NO_MEMORY, "engine is nullptr");
+    RemoveScheduledJob();
     auto task = std::make_shared<TaskHandler<int32_t>>([&, this] {
         return transCoderEngine_->Cancel();
     });
@@ -401,6 +474,7 @@ int32_t TransCoderServer::Cancel()
 
 int32_t TransCoderServer::Release()
 {
+    RemoveScheduledJob();
     {
         std::lock_guard<std::mutex> lock(mutex_);
         auto task = std::make_shared<TaskHandler<void>>([&, this] {
@@ -412,6 +486,14 @@ int32_t TransCoderServer::Release()
     return MSERR_OK;
 }
 
+int32_t TransCoderServer::GetStageStats(std::vector<TransCoderStageStats> &stats)
+{
+    // read on the caller's thread, the counters are atomics and a busy task queue must not hold the query up
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(transCoderEngine_ != nullptr, MSERR_INVALID_OPERATION, "engine is nullptr");
+    return transCoderEngine_->GetStageStats(stats);
+}
+
 int32_t TransCoderServer::DumpInfo(int32_t fd)
 {
     std::string dumpString;
@@ -427,7 +509,13 @@ int32_t TransCoderServer::DumpInfo(int32_t fd)
     dumpString += "TransCoderServer bitRate is: " + std::to_string(config_.videoBitRate) + "\n";
     dumpString += "TransCoderServer audioBitRate is: " + std::to_string(config_.audioBitRate) + "\n";
     dumpString += "TransCoderServer format is: " + std::to_string(config_.format) + "\n";
+    TransCoderJobScheduler::GetInstance().DumpInfo(dumpString);
     write(fd, dumpString.c_str(), dumpString.size());
+    // Release resets the engine under the lock, the dump must not race it
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (transCoderEngine_ != nullptr) {
+        transCoderEngine_->OnDumpInfo(fd);
+    }
 
     return MSERR_OK;
 }
@@ -22,6 +22,7 @@
 #include "task_queue.h"
 #include "watchdog.h"
 #include "uri_helper.h"
+#include "transcoder_job_scheduler.h"
 
 namespace OHOS {
 namespace Media {
@@ -67,10 +68,17 @@ public:
     void OnInfo(TransCoderOnInfoType type, int32_t extra) override;
 
     int32_t DumpInfo(int32_t fd);
+    int32_t GetStageStats(std::vector<TransCoderStageStats> &stats);
 
 private:
     int32_t Init();
     const std::string &GetStatusDescription(OHOS::Media::TransCoderServer::RecStatus status);
+    TransCoderJobCost GetJobCost() const;
+    void RemoveScheduledJob();
+    void OnJobStart();
+    void OnJobSuspend();
+    void OnJobResume();
+    void OnJobStateChanged(TransCoderJobState state);
 
     std::unique_ptr<ITransCoderEngine> transCoderEngine_ = nullptr;
     std::shared_ptr<TransCoderCallback> transCoderCb_ = nullptr;
@@ -81,8 +89,8 @@ private:
     struct ConfigInfo {
         VideoCodecFormat videoCodec;
         AudioCodecFormat audioCodec;
-        int32_t width;
-        int32_t height;
+        int32_t width = 0;
+        int32_t height = 0;
         int32_t videoBitRate;
         int32_t audioBitRate;
         OutputFormatType format;
@@ -97,6 +105,10 @@ private:
     std::shared_ptr<UriHelper> uriHelper_;
 
     std::atomic<bool> watchdogPause_ = false;
+    int32_t appPid_ = 0;
+    // the engine runs once the service wide scheduler starts the job, 0 while none is scheduled
+    std::mutex jobMutex_;
+    uint64_t jobId_ = 0;
 };
 } // namespace Media
 } // namespace OHOS
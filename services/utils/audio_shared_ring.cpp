@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "audio_shared_ring.h"
+#include <algorithm>
+#include <chrono>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "buffer/avsharedmemorybase.h"
+#include "securec.h"
+
+namespace {
+constexpr uint32_t RING_MAGIC = 0x52494e47; // "RING"
+constexpr uint32_t MIN_CAPACITY = 64;
+constexpr uint32_t MAX_CAPACITY = 1u << 26;
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring positions must be lock free in shared memory");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "ring flags must be lock free in shared memory");
+
+uint32_t RoundUpPowerOfTwo(uint32_t size)
+{
+    uint32_t capacity = MIN_CAPACITY;
+    while (capacity < size && capacity < MAX_CAPACITY) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+}
+
+namespace OHOS {
+namespace Media {
+std::shared_ptr<AudioSharedRing> AudioSharedRing::Create(uint32_t capacity, uint32_t periodSize,
+    const std::string &name)
+{
+    uint32_t size = GetMemorySize(capacity);
+    auto memory = AVSharedMemoryBase::CreateFromLocal(static_cast<int32_t>(size), AVSharedMemory::FLAGS_READ_WRITE,
+        name);
+    if (memory == nullptr || memory->GetBase() == nullptr) {
+        return nullptr;
+    }
+    int32_t eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (eventFd < 0) {
+        return nullptr;
+    }
+    auto ring = std::make_shared<AudioSharedRing>(memory->GetBase(), size, eventFd, true);
+    ring->memory_ = memory;
+    ring->SetPeriodSize(periodSize);
+    return ring;
+}
+
+std::shared_ptr<AudioSharedRing> AudioSharedRing::Attach(const std::shared_ptr<AVSharedMemory> &memory,
+    int32_t eventFd)
+{
+    if (memory == nullptr || memory->GetBase() == nullptr || memory->GetSize() <= 0) {
+        if (eventFd >= 0) {
+            (void)close(eventFd);
+        }
+        return nullptr;
+    }
+    auto ring = std::make_shared<AudioSharedRing>(memory->GetBase(), static_cast<uint32_t>(memory->GetSize()),
+        eventFd, false);
+    if (!ring->IsValid()) {
+        return nullptr;
+    }
+    ring->memory_ = memory;
+    return ring;
+}
+
+uint32_t AudioSharedRing::GetMemorySize(uint32_t capacity)
+{
+    return DATA_OFFSET + RoundUpPowerOfTwo(capacity);
+}
+
+AudioSharedRing::AudioSharedRing(uint8_t *base, uint32_t size, int32_t eventFd, bool isOwner)
+    : eventFd_(eventFd)
+{
+    if (base == nullptr || size <= DATA_OFFSET) {
+        return;
+    }
+    header_ = reinterpret_cast<Header *>(base);
+    data_ = base + DATA_OFFSET;
+    if (isOwner) {
+        header_->magic = RING_MAGIC;
+        // the largest power of two that fits, so positions can be masked instead of divided
+        header_->capacity = RoundUpPowerOfTwo(size - DATA_OFFSET);
+        if (header_->capacity > size - DATA_OFFSET) {
+            header_->capacity >>= 1;
+        }
+        header_->periodSize.store(0);
+        header_->writePos.store(0);
+        header_->readPos.store(0);
+        header_->isReaderWaiting.store(0);
+        header_->isClosed.store(0);
+        header_->overrunCount.store(0);
+        header_->overrunBytes.store(0);
+    }
+    uint32_t capacity = header_->capacity;
+    // the peer controls the header, nothing in it is trusted beyond what the mapping can hold
+    bool isValid = header_->magic == RING_MAGIC && capacity >= MIN_CAPACITY && (capacity & (capacity - 1)) == 0 &&
+        capacity <= size - DATA_OFFSET;
+    if (!isValid) {
+        header_ = nullptr;
+        data_ = nullptr;
+        return;
+    }
+    capacity_ = capacity;
+}
+
+AudioSharedRing::~AudioSharedRing()
+{
+    if (eventFd_ >= 0) {
+        (void)close(eventFd_);
+        eventFd_ = -1;
+    }
+}
+
+bool AudioSharedRing::IsValid() const
+{
+    return header_ != nullptr;
+}
+
+bool AudioSharedRing::Write(const uint8_t *data, uint32_t size)
+{
+    if (header_ == nullptr || data == nullptr || size == 0) {
+        return false;
+    }
+    uint64_t writePos = header_->writePos.load(std::memory_order_relaxed);
+    uint64_t readPos = header_->readPos.load(std::memory_order_acquire);
+    uint64_t freeSize = capacity_ - std::min<uint64_t>(writePos - readPos, capacity_);
+    if (size > freeSize) {
+        header_->overrunCount.fetch_add(1, std::memory_order_relaxed);
+        header_->overrunBytes.fetch_add(size, std::memory_order_relaxed);
+        return false;
+    }
+    uint32_t offset = static_cast<uint32_t>(writePos & (capacity_ - 1));
+    uint32_t firstPart = std::min(size, capacity_ - offset);
+    (void)memcpy_s(data_ + offset, capacity_ - offset, data, firstPart);
+    if (firstPart < size) {
+        (void)memcpy_s(data_, capacity_, data + firstPart, size - firstPart);
+    }
+    // paired with the reader raising isReaderWaiting before its last check, one of the two sees the other
+    header_->writePos.store(writePos + size, std::memory_order_seq_cst);
+    if (header_->isReaderWaiting.load(std::memory_order_seq_cst) != 0) {
+        Notify();
+    }
+    return true;
+}
+
+uint32_t AudioSharedRing::Read(uint8_t *data, uint32_t size)
+{
+    if (header_ == nullptr || data == nullptr || size == 0) {
+        return 0;
+    }
+    uint64_t readPos = header_->readPos.load(std::memory_order_relaxed);
+    uint64_t writePos = header_->writePos.load(std::memory_order_acquire);
+    uint32_t readSize = static_cast<uint32_t>(std::min<uint64_t>({writePos - readPos, size, capacity_}));
+    if (readSize == 0) {
+        return 0;
+    }
+    uint32_t offset = static_cast<uint32_t>(readPos & (capacity_ - 1));
+    uint32_t firstPart = std::min(readSize, capacity_ - offset);
+    (void)memcpy_s(data, size, data_ + offset, firstPart);
+    if (firstPart < readSize) {
+        (void)memcpy_s(data + firstPart, size - firstPart, data_, readSize - firstPart);
+    }
+    header_->readPos.store(readPos + readSize, std::memory_order_release);
+    return readSize;
+}
+
+bool AudioSharedRing::WaitReadable(uint32_t size, int32_t timeoutMs)
+{
+    if (header_ == nullptr || size > capacity_) {
+        return false;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (true) {
+        if (GetReadableSize() >= size) {
+            return true;
+        }
+        if (IsClosed() || eventFd_ < 0) {
+            return false;
+        }
+        header_->isReaderWaiting.store(1, std::memory_order_seq_cst);
+        bool isReady = GetReadableSize() >= size || IsClosed();
+        int64_t leftMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (!isReady && leftMs > 0) {
+            struct pollfd pfd = { eventFd_, POLLIN, 0 };
+            (void)poll(&pfd, 1, static_cast<int>(leftMs));
+        }
+        header_->isReaderWaiting.store(0, std::memory_order_relaxed);
+        eventfd_t count = 0;
+        (void)eventfd_read(eventFd_, &count);
+        if (!isReady && leftMs <= 0) {
+            return GetReadableSize() >= size;
+        }
+    }
+}
+
+void AudioSharedRing::Close()
+{
+    if (header_ == nullptr) {
+        return;
+    }
+    header_->isClosed.store(1, std::memory_order_seq_cst);
+    Notify();
+}
+
+bool AudioSharedRing::IsClosed() const
+{
+    return header_ != nullptr && header_->isClosed.load(std::memory_order_acquire) != 0;
+}
+
+void AudioSharedRing::Notify()
+{
+    if (eventFd_ >= 0) {
+        (void)eventfd_write(eventFd_, 1);
+    }
+}
+
+uint32_t AudioSharedRing::GetReadableSize() const
+{
+    if (header_ == nullptr) {
+        return 0;
+    }
+    uint64_t writePos = header_->writePos.load(std::memory_order_acquire);
+    uint64_t readPos = header_->readPos.load(std::memory_order_acquire);
+    return static_cast<uint32_t>(std::min<uint64_t>(writePos - readPos, capacity_));
+}
+
+uint32_t AudioSharedRing::GetCapacity() const
+{
+    return capacity_;
+}
+
+void AudioSharedRing::SetPeriodSize(uint32_t periodSize)
+{
+    if (header_ != nullptr) {
+        header_->periodSize.store(std::min(periodSize, capacity_), std::memory_order_relaxed);
+    }
+}
+
+uint32_t AudioSharedRing::GetPeriodSize() const
+{
+    if (header_ == nullptr) {
+        return 0;
+    }
+    uint32_t periodSize = header_->periodSize.load(std::memory_order_relaxed);
+    return periodSize == 0 || periodSize > capacity_ ? capacity_ / 4 : periodSize; // 4: a quarter of the ring
+}
+
+uint64_t AudioSharedRing::GetOverrunCount() const
+{
+    return header_ == nullptr ? 0 : header_->overrunCount.load(std::memory_order_relaxed);
+}
+
+uint64_t AudioSharedRing::GetOverrunBytes() const
+{
+    return header_ == nullptr ? 0 : header_->overrunBytes.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<AVSharedMemory> AudioSharedRing::GetMemory() const
+{
+    return memory_;
+}
+
+int32_t AudioSharedRing::GetEventFd() const
+{
+    return eventFd_;
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bundle_name_cache.h"
+#include "common_event_manager.h"
+#include "common_event_support.h"
+#include "iservice_registry.h"
+#include "media_log.h"
+#include "system_ability_definition.h"
+#include "want.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_PLAYER, "BundleNameCache"};
+const std::string PACKAGE_EVENT_UID = "uid";
+}
+
+namespace OHOS {
+namespace Media {
+namespace {
+class BundleMgrDeathRecipient : public IRemoteObject::DeathRecipient {
+public:
+    void OnRemoteDied(const wptr<IRemoteObject> &remote) override
+    {
+        (void)remote;
+        MEDIA_LOGW("bundle manager died");
+        BundleNameCache::GetInstance().OnBundleMgrDied();
+    }
+};
+
+class PackageEventSubscriber : public EventFwk::CommonEventSubscriber {
+public:
+    explicit PackageEventSubscriber(const EventFwk::CommonEventSubscribeInfo &subscribeInfo)
+        : EventFwk::CommonEventSubscriber(subscribeInfo)
+    {
+    }
+
+    void OnReceiveEvent(const EventFwk::CommonEventData &eventData) override
+    {
+        const AAFwk::Want &want = eventData.GetWant();
+        int32_t uid = want.GetIntParam(PACKAGE_EVENT_UID, -1);
+        MEDIA_LOGD("receive action %{public}s, uid %{public}d", want.GetAction().c_str(), uid);
+        if (uid >= 0) {
+            BundleNameCache::GetInstance().InvalidateUid(uid);
+        }
+        BundleNameCache::GetInstance().InvalidateBundle(want.GetElement().GetBundleName());
+    }
+};
+}
+
+BundleNameCache &BundleNameCache::GetInstance()
+{
+    static BundleNameCache instance;
+    return instance;
+}
+
+sptr<AppExecFwk::IBundleMgr> BundleNameCache::GetBundleMgr()
+{
+    sptr<AppExecFwk::IBundleMgr> bms = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(proxyMutex_);
+        bms = bundleMgr_;
+    }
+    if (bms != nullptr) {
+        (void)SubscribePackageEvents();
+        return bms;
+    }
+    auto samgr = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    CHECK_AND_RETURN_RET_LOG(samgr != nullptr, nullptr, "Get ability manager failed");
+    sptr<IRemoteObject> object = samgr->GetSystemAbility(BUNDLE_MGR_SERVICE_SYS_ABILITY_ID);
+    CHECK_AND_RETURN_RET_LOG(object != nullptr, nullptr, "object is NULL.");
+    bms = iface_cast<AppExecFwk::IBundleMgr>(object);
+    CHECK_AND_RETURN_RET_LOG(bms != nullptr, nullptr, "bundle manager service is NULL.");
+
+    {
+        std::lock_guard<std::mutex> lock(proxyMutex_);
+        if (bundleMgr_ != nullptr) {
+            return bundleMgr_;
+        }
+        sptr<IRemoteObject::DeathRecipient> deathRecipient = new(std::nothrow) BundleMgrDeathRecipient();
+        if (deathRecipient == nullptr || !object->AddDeathRecipient(deathRecipient)) {
+            // without the death notification the proxy can not be reused safely
+            MEDIA_LOGW("failed to watch the bundle manager, proxy is not cached");
+            return bms;
+        }
+        deathRecipient_ = deathRecipient;
+        bundleMgr_ = bms;
+    }
+    (void)SubscribePackageEvents();
+    return bms;
+}
+
+bool BundleNameCache::SubscribePackageEvents()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (isSubscribed_) {
+            return true;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (hasSubscribeFailed_ && now - lastSubscribeTime_ <
+            std::chrono::milliseconds(SUBSCRIBE_RETRY_INTERVAL_MS)) {
+            return false;
+        }
+        lastSubscribeTime_ = now;
+    }
+    EventFwk::MatchingSkills matchingSkills;
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_ADDED);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_FULLY_REMOVED);
+    EventFwk::CommonEventSubscribeInfo subscribeInfo(matchingSkills);
+    auto subscriber = std::make_shared<PackageEventSubscriber>(subscribeInfo);
+    bool ret = EventFwk::CommonEventManager::NewSubscribeCommonEvent(subscriber) == ERR_OK;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    hasSubscribeFailed_ = !ret;
+    CHECK_AND_RETURN_RET_LOG(ret, false, "failed to subscribe package events, bundle names are not cached");
+    if (isSubscribed_) {
+        (void)EventFwk::CommonEventManager::NewUnSubscribeCommonEvent(subscriber);
+        return true;
+    }
+    packageSubscriber_ = subscriber;
+    isSubscribed_ = true;
+    return true;
+}
+
+bool BundleNameCache::Lookup(int32_t uid, std::string &bundleName, uint64_t &generation)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(uid);
+    if (iter == entries_.end()) {
+        generation = generation_;
+        return false;
+    }
+    lruList_.splice(lruList_.begin(), lruList_, iter->second);
+    bundleName = iter->second->second;
+    return true;
+}
+
+void BundleNameCache::Insert(int32_t uid, const std::string &bundleName, uint64_t generation)
+{
+    CHECK_AND_RETURN(!bundleName.empty());
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN(isSubscribed_);
+    // an invalidation since the miss may have been for this very uid, the name resolved may already be stale
+    CHECK_AND_RETURN_LOG(generation == generation_, "cache invalidated while resolving uid %{public}d", uid);
+    auto iter = entries_.find(uid);
+    if (iter != entries_.end()) {
+        iter->second->second = bundleName;
+        lruList_.splice(lruList_.begin(), lruList_, iter->second);
+        return;
+    }
+    lruList_.emplace_front(uid, bundleName);
+    entries_[uid] = lruList_.begin();
+    if (lruList_.size() > MAX_ENTRY_COUNT) {
+        entries_.erase(lruList_.back().first);
+        lruList_.pop_back();
+    }
+}
+
+void BundleNameCache::InvalidateUid(int32_t uid)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_++;
+    auto iter = entries_.find(uid);
+    CHECK_AND_RETURN(iter != entries_.end());
+    lruList_.erase(iter->second);
+    entries_.erase(iter);
+}
+
+void BundleNameCache::InvalidateBundle(const std::string &bundleName)
+{
+    CHECK_AND_RETURN(!bundleName.empty());
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_++;
+    for (auto iter = lruList_.begin(); iter != lruList_.end();) {
+        if (iter->second == bundleName) {
+            entries_.erase(iter->first);
+            iter = lruList_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void BundleNameCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_++;
+    lruList_.clear();
+    entries_.clear();
+}
+
+void BundleNameCache::OnBundleMgrDied()
+{
+    {
+        std::lock_guard<std::mutex> lock(proxyMutex_);
+        bundleMgr_ = nullptr;
+        deathRecipient_ = nullptr;
+    }
+    // package events sent while the bundle manager restarts may be lost
+    Clear();
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_SHARED_RING_H
+#define AUDIO_SHARED_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "buffer/avsharedmemory.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Single producer single consumer ring of PCM bytes living in one shared memory block, so an audio data source in
+ * the client process hands its data to the recorder service without a binder call per buffer. The control header
+ * sits at the start of the block, the positions count bytes ever written and read and only grow. The consumer is
+ * woken through an eventfd, and only while it is waiting, so a producer running ahead makes no syscall at all.
+ */
+class __attribute__((visibility("default"))) AudioSharedRing {
+public:
+    // producer side, allocates the block and the eventfd; capacity is rounded up to a power of two and
+    // periodSize is the chunk the consumer reads at once
+    static std::shared_ptr<AudioSharedRing> Create(uint32_t capacity, uint32_t periodSize, const std::string &name);
+    // consumer side, eventFd is owned by the ring from now on
+    static std::shared_ptr<AudioSharedRing> Attach(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd);
+    static uint32_t GetMemorySize(uint32_t capacity);
+
+    // base must stay valid for the lifetime of the ring, isOwner initialises the header
+    AudioSharedRing(uint8_t *base, uint32_t size, int32_t eventFd, bool isOwner);
+    ~AudioSharedRing();
+
+    bool IsValid() const;
+    // writes all of size or nothing, a chunk that does not fit is dropped and counted as an overrun
+    bool Write(const uint8_t *data, uint32_t size);
+    // reads up to size, returns the bytes read
+    uint32_t Read(uint8_t *data, uint32_t size);
+    // true once size bytes are readable, false on timeout or when the producer closed the ring first
+    bool WaitReadable(uint32_t size, int32_t timeoutMs);
+    // producer is done, a waiting consumer returns right away
+    void Close();
+    bool IsClosed() const;
+
+    uint32_t GetReadableSize() const;
+    uint32_t GetCapacity() const;
+    void SetPeriodSize(uint32_t periodSize);
+    uint32_t GetPeriodSize() const;
+    uint64_t GetOverrunCount() const;
+    uint64_t GetOverrunBytes() const;
+    std::shared_ptr<AVSharedMemory> GetMemory() const;
+    int32_t GetEventFd() const;
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t capacity;
+        std::atomic<uint32_t> periodSize;
+        alignas(64) std::atomic<uint64_t> writePos;
+        alignas(64) std::atomic<uint64_t> readPos;
+        std::atomic<uint32_t> isReaderWaiting;
+        std::atomic<uint32_t> isClosed;
+        std::atomic<uint64_t> overrunCount;
+        std::atomic<uint64_t> overrunBytes;
+    };
+    static constexpr uint32_t DATA_OFFSET = (sizeof(Header) + 63) & ~63u;
+
+    void Notify();
+
+    Header *header_ = nullptr;
+    uint8_t *data_ = nullptr;
+    uint32_t capacity_ = 0;
+    int32_t eventFd_ = -1;
+    std::shared_ptr<AVSharedMemory> memory_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // AUDIO_SHARED_RING_H
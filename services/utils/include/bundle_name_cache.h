@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BUNDLE_NAME_CACHE_H
+#define BUNDLE_NAME_CACHE_H
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "bundle_mgr_interface.h"
+#include "common_event_subscriber.h"
+#include "iremote_object.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Process-wide LRU cache of uid to bundle name, plus the bundle manager proxy it is resolved with.
+ * Entries of a package are dropped when it is added or removed, everything is dropped when the bundle manager dies.
+ * Nothing is cached while the package events can not be received, so a stale name is never returned. A name
+ * resolved over IPC is only inserted when no invalidation ran since the miss it was resolved for.
+ */
+class BundleNameCache {
+public:
+    static BundleNameCache &GetInstance();
+
+    sptr<AppExecFwk::IBundleMgr> GetBundleMgr();
+    // on a miss generation is set to what Insert has to be passed for the name resolved afterwards
+    bool Lookup(int32_t uid, std::string &bundleName, uint64_t &generation);
+    void Insert(int32_t uid, const std::string &bundleName, uint64_t generation);
+    void InvalidateUid(int32_t uid);
+    void InvalidateBundle(const std::string &bundleName);
+    void Clear();
+    void OnBundleMgrDied();
+    // retried from GetBundleMgr at most once per SUBSCRIBE_RETRY_INTERVAL_MS until it succeeds
+    bool SubscribePackageEvents();
+
+    static constexpr size_t MAX_ENTRY_COUNT = 128;
+    static constexpr int64_t SUBSCRIBE_RETRY_INTERVAL_MS = 5000;
+
+private:
+    BundleNameCache() = default;
+    ~BundleNameCache() = default;
+
+    std::mutex mutex_;
+    std::list<std::pair<int32_t, std::string>> lruList_;
+    std::unordered_map<int32_t, std::list<std::pair<int32_t, std::string>>::iterator> entries_;
+    uint64_t generation_ = 0;
+    bool isSubscribed_ = false;
+    std::chrono::steady_clock::time_point lastSubscribeTime_ {};
+    bool hasSubscribeFailed_ = false;
+    std::shared_ptr<EventFwk::CommonEventSubscriber> packageSubscriber_ = nullptr;
+
+    std::mutex proxyMutex_;
+    sptr<AppExecFwk::IBundleMgr> bundleMgr_ = nullptr;
+    sptr<IRemoteObject::DeathRecipient> deathRecipient_ = nullptr;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // BUNDLE_NAME_CACHE_H
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "meta/meta.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Fixed-size log-linear latency histogram. Values below SUB_BUCKET_COUNT are counted exactly, larger values
+ * fall into SUB_BUCKET_COUNT linear buckets per power of two, so a percentile is off by at most 1/SUB_BUCKET_COUNT.
+ * Recording is O(1) and never allocates.
+ */
+class __attribute__((visibility("default"))) LatencyHistogram {
+public:
+    explicit LatencyHistogram(const std::string &name);
+    ~LatencyHistogram() = default;
+
+    void Record(int64_t value);
+    void Reset();
+    uint64_t GetCount();
+    int64_t GetMax();
+    // percentile in (0, 100], returns the upper bound of the bucket holding it, -1 if empty
+    int64_t GetPercentile(double percentile);
+
+    // sets <name>_count, <name>_p50, <name>_p95, <name>_p99 and <name>_max
+    void AppendToMeta(const std::shared_ptr<Meta> &meta);
+    // summary line followed by one line per non-empty bucket
+    std::string ToString();
+
+    static size_t GetBucketIndex(int64_t value);
+    static int64_t GetBucketLowerBound(size_t index);
+    static int64_t GetBucketUpperBound(size_t index);
+
+    static constexpr uint32_t SUB_BUCKET_BITS = 3;
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr uint32_t OCTAVE_COUNT = 28;
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKET_COUNT * OCTAVE_COUNT;
+
+private:
+    int64_t GetPercentileLocked(double percentile);
+
+    std::mutex mutex_;
+    std::string name_;
+    std::array<uint32_t, BUCKET_COUNT> buckets_ {};
+    uint64_t count_ = 0;
+    int64_t max_ = 0;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // LATENCY_HISTOGRAM_H
@@ -21,6 +21,7 @@
 #include <memory>
 #include <map>
 #include <string>
+#include <vector>
 #include <refbase.h>
 #include "nocopyable.h"
 #include "hisysevent.h"
@@ -51,6 +52,18 @@ enum CallType {
     SCREEN_CAPTRUER,
     AVTRANSCODER
 };
+
+/**
+ * Statistics of one instance, kept flat until it is reported: values are converted to their reported text when
+ * appended and keys are ids into a process-wide key table, see GetMediaInfoKeyName.
+ */
+struct MediaStatisticsRecord {
+    uint64_t instanceId = 0;
+    int32_t uid = 0;
+    CallType callType = AVPLAYER;
+    std::vector<std::pair<uint16_t, std::string>> fields;
+};
+
 class __attribute__((visibility("default"))) MediaEvent : public NoCopyable {
 public:
     MediaEvent() = default;
@@ -69,13 +82,13 @@ public:
         const std::string& appName, uint64_t instanceId, int8_t captureMode, int8_t dataMode, int32_t errorCode,
         const std::string& errMsg);
     void CommonStatisicsEventWrite(CallType callType, OHOS::HiviewDFX::HiSysEvent::EventType type,
-        const std::map<int32_t, std::list<std::pair<uint64_t, std::shared_ptr<Meta>>>>& infoMap);
+        const std::map<int32_t, std::vector<MediaStatisticsRecord>>& infoMap);
+    // writes [{"appName":...,"mediaEvents":[{...},...]}] with the fields of every record sorted by key
+    static void SerializeStatistics(const std::string &appName, const std::vector<MediaStatisticsRecord> &records,
+        std::string &out);
 private:
     void StatisicsHiSysEventWrite(CallType callType, OHOS::HiviewDFX::HiSysEvent::EventType type,
         const std::vector<std::string>& infoArr);
-#ifdef SUPPORT_JSON
-    void ParseOneEvent(const std::pair<uint64_t, std::shared_ptr<OHOS::Media::Meta>> &listPair, json& metaInfoJson);
-#endif
     std::string msg_;
 };
 
@@ -93,6 +106,7 @@ __attribute__((visibility("default"))) void FaultScreenCaptureEventWrite(const s
 __attribute__((visibility("default"))) int32_t CreateMediaInfo(CallType callType, int32_t uid, uint64_t instanceId);
 __attribute__((visibility("default"))) int32_t AppendMediaInfo(const std::shared_ptr<Meta>& meta, uint64_t instanceId);
 __attribute__((visibility("default"))) int32_t ReportMediaInfo(uint64_t instanceId);
+__attribute__((visibility("default"))) const std::string &GetMediaInfoKeyName(uint16_t keyId);
 
 class __attribute__((visibility("default"))) MediaTrace : public NoCopyable {
 public:
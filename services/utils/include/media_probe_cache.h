@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MEDIA_PROBE_CACHE_H
+#define MEDIA_PROBE_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "meta/meta.h"
+
+namespace OHOS {
+namespace Media {
+struct MediaProbeInfo {
+    std::shared_ptr<Meta> globalMeta;
+    std::vector<std::shared_ptr<Meta>> trackMetas;
+    std::shared_ptr<Meta> userMeta;
+    // false when the prober of the source does not expose the user meta
+    bool hasUserMeta = false;
+};
+
+/**
+ * Process-wide LRU cache of container probe results, keyed by UriHelper::FileIdentity.
+ * Entries are deep copies, so neither the inserting demuxer nor the readers can change a cached entry.
+ * The player and the transcoder feed it once their source is prepared, metadata helpers read it.
+ */
+class __attribute__((visibility("default"))) MediaProbeCache {
+public:
+    static MediaProbeCache &GetInstance();
+    bool Lookup(const std::string &key, MediaProbeInfo &info);
+    void Insert(const std::string &key, const MediaProbeInfo &info);
+    // refreshes the entry like Lookup without copying it out or counting a hit
+    bool Contains(const std::string &key);
+    void Clear();
+    int32_t Dump(int32_t fd);
+
+    static constexpr size_t MAX_ENTRY_COUNT = 64;
+
+private:
+    MediaProbeCache() = default;
+    ~MediaProbeCache() = default;
+    static MediaProbeInfo CopyProbeInfo(const MediaProbeInfo &info);
+
+    using LruList = std::list<std::pair<std::string, MediaProbeInfo>>;
+    std::mutex mutex_;
+    LruList lruList_;
+    std::unordered_map<std::string, LruList::iterator> entries_;
+    uint64_t hitCount_ = 0;
+    uint64_t missCount_ = 0;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // MEDIA_PROBE_CACHE_H
@@ -50,6 +50,8 @@ public:
     uint8_t UriType() const;
     std::string FormattedUri() const;
     bool AccessCheck(uint8_t flag) const;
+    // dev, inode, size and mtime of the file plus the offset and length of the range, empty if not a local file
+    std::string FileIdentity() const;
 
 private:
     void FormatMeForUri(const std::string_view &uri) noexcept;
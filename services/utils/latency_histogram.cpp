@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double PERCENTILE_MAX = 100.0;
+constexpr double P50 = 50.0;
+constexpr double P95 = 95.0;
+constexpr double P99 = 99.0;
+constexpr int32_t MSB_OF_INT64 = 63;
+}
+
+namespace OHOS {
+namespace Media {
+LatencyHistogram::LatencyHistogram(const std::string &name) : name_(name)
+{
+}
+
+size_t LatencyHistogram::GetBucketIndex(int64_t value)
+{
+    if (value < static_cast<int64_t>(SUB_BUCKET_COUNT)) {
+        return value < 0 ? 0 : static_cast<size_t>(value);
+    }
+    uint32_t msb = static_cast<uint32_t>(MSB_OF_INT64 - __builtin_clzll(static_cast<uint64_t>(value)));
+    uint32_t octave = msb - SUB_BUCKET_BITS + 1;
+    if (octave >= OCTAVE_COUNT) {
+        return BUCKET_COUNT - 1;
+    }
+    uint32_t subBucket = static_cast<uint32_t>(value >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+    return static_cast<size_t>(octave) * SUB_BUCKET_COUNT + subBucket;
+}
+
+int64_t LatencyHistogram::GetBucketLowerBound(size_t index)
+{
+    size_t octave = index / SUB_BUCKET_COUNT;
+    int64_t subBucket = static_cast<int64_t>(index % SUB_BUCKET_COUNT);
+    if (octave == 0) {
+        return subBucket;
+    }
+    return (static_cast<int64_t>(SUB_BUCKET_COUNT) + subBucket) << (octave - 1);
+}
+
+int64_t LatencyHistogram::GetBucketUpperBound(size_t index)
+{
+    size_t octave = index / SUB_BUCKET_COUNT;
+    if (octave == 0) {
+        return static_cast<int64_t>(index);
+    }
+    return GetBucketLowerBound(index) + (static_cast<int64_t>(1) << (octave - 1)) - 1;
+}
+
+void LatencyHistogram::Record(int64_t value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    value = std::max<int64_t>(value, 0);
+    buckets_[GetBucketIndex(value)]++;
+    count_++;
+    max_ = std::max(max_, value);
+}
+
+void LatencyHistogram::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    buckets_.fill(0);
+    count_ = 0;
+    max_ = 0;
+}
+
+uint64_t LatencyHistogram::GetCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+}
+
+int64_t LatencyHistogram::GetMax()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_;
+}
+
+int64_t LatencyHistogram::GetPercentile(double percentile)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetPercentileLocked(percentile);
+}
+
+int64_t LatencyHistogram::GetPercentileLocked(double percentile)
+{
+    if (count_ == 0) {
+        return -1;
+    }
+    percentile = std::clamp(percentile, 0.0, PERCENTILE_MAX);
+    uint64_t target = static_cast<uint64_t>(std::ceil(static_cast<double>(count_) * percentile / PERCENTILE_MAX));
+    target = std::max<uint64_t>(target, 1);
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        accumulated += buckets_[i];
+        if (accumulated >= target) {
+            return std::min(GetBucketUpperBound(i), max_);
+        }
+    }
+    return max_;
+}
+
+void LatencyHistogram::AppendToMeta(const std::shared_ptr<Meta> &meta)
+{
+    if (meta == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (count_ == 0) {
+        return;
+    }
+    meta->SetData(name_ + "_count", static_cast<int32_t>(std::min<uint64_t>(count_, INT32_MAX)));
+    meta->SetData(name_ + "_p50", static_cast<int32_t>(GetPercentileLocked(P50)));
+    meta->SetData(name_ + "_p95", static_cast<int32_t>(GetPercentileLocked(P95)));
+    meta->SetData(name_ + "_p99", static_cast<int32_t>(GetPercentileLocked(P99)));
+    meta->SetData(name_ + "_max", static_cast<int32_t>(max_));
+}
+
+std::string LatencyHistogram::ToString()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string result = name_ + ": count " + std::to_string(count_);
+    if (count_ == 0) {
+        return result + "\n";
+    }
+    result += ", p50 " + std::to_string(GetPercentileLocked(P50)) +
+        ", p95 " + std::to_string(GetPercentileLocked(P95)) +
+        ", p99 " + std::to_string(GetPercentileLocked(P99)) +
+        ", max " + std::to_string(max_) + "\n";
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        if (buckets_[i] == 0) {
+            continue;
+        }
+        result += "    [" + std::to_string(GetBucketLowerBound(i)) + ", " + std::to_string(GetBucketUpperBound(i)) +
+            "]: " + std::to_string(buckets_[i]) + "\n";
+    }
+    return result;
+}
+} // namespace Media
+} // namespace OHOS
@@ -24,7 +24,10 @@
 #include "common/log.h"
 #include "common/media_core.h"
 #include "meta/any.h"
+#include <algorithm>
 #include <cstdint>
+#include <deque>
+#include <unordered_map>
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_ONLY_PRERELEASE, LOG_DOMAIN_SYSTEM_PLAYER, "HiStreamer" };
@@ -32,65 +35,145 @@ namespace {
     constexpr uint32_t MAX_STRING_SIZE = 256;
     constexpr int64_t HOURS_BETWEEN_REPORTS = 4;
     constexpr int64_t MAX_MAP_SIZE = 100;
+    // live instances are spread over shards so players of different apps do not contend on one lock
+    constexpr size_t SHARD_COUNT = 16;
+    constexpr size_t MAX_KEY_COUNT = UINT16_MAX;
+    constexpr uint32_t CONTROL_CHAR_MAX = 0x20;
+
+    struct MediaInfoShard {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, OHOS::Media::MediaStatisticsRecord> records;
+    };
+    MediaInfoShard g_mediaInfoShards[SHARD_COUNT];
 
-    std::mutex collectMut_;
     std::mutex reportMut_;
-    std::map<OHOS::Media::CallType,
-        std::map<int32_t, std::list<std::pair<uint64_t, std::shared_ptr<OHOS::Media::Meta>>>>> mediaInfoMap_;
-    std::map<OHOS::Media::CallType,
-        std::map<int32_t, std::list<std::pair<uint64_t, std::shared_ptr<OHOS::Media::Meta>>>>> reportMediaInfoMap_;
-    std::map<uint64_t, std::pair<OHOS::Media::CallType, int32_t>> idMap_;
+    std::map<OHOS::Media::CallType, std::map<int32_t, std::vector<OHOS::Media::MediaStatisticsRecord>>>
+        reportMediaInfoMap_;
     std::chrono::system_clock::time_point currentTime_ = std::chrono::system_clock::now();
     bool g_reachMaxMapSize {false};
 
+    std::mutex keyMutex_;
+    std::deque<std::string> keyNames_;
+    std::unordered_map<std::string, uint16_t> keyIds_;
+
+    MediaInfoShard &GetShard(uint64_t instanceId)
+    {
+        return g_mediaInfoShards[instanceId % SHARD_COUNT];
+    }
+
+    bool GetKeyId(const std::string &key, uint16_t &keyId)
+    {
+        std::lock_guard<std::mutex> lock(keyMutex_);
+        auto it = keyIds_.find(key);
+        if (it != keyIds_.end()) {
+            keyId = it->second;
+            return true;
+        }
+        if (keyNames_.size() >= MAX_KEY_COUNT) {
+            return false;
+        }
+        keyId = static_cast<uint16_t>(keyNames_.size());
+        keyNames_.push_back(key);
+        keyIds_[key] = keyId;
+        return true;
+    }
+
+    // converts one meta value to the text it is reported with, the type is probed once here instead of per report
+    bool ToReportValue(const std::shared_ptr<OHOS::Media::Meta> &meta, const std::string &key,
+        const OHOS::Media::Any &value, std::string &reportValue)
+    {
+        using namespace OHOS::Media;
+        Any valueType = GetDefaultAnyValue(key);
+        if (Any::IsSameTypeWith<int32_t>(valueType)) {
+            int32_t intVal;
+            FALSE_RETURN_V(meta->GetData(key, intVal), false);
+            reportValue = std::to_string(intVal);
+        } else if (Any::IsSameTypeWith<uint32_t>(valueType)) {
+            uint32_t uintVal;
+            FALSE_RETURN_V(meta->GetData(key, uintVal), false);
+            reportValue = std::to_string(uintVal);
+        } else if (Any::IsSameTypeWith<uint64_t>(valueType)) {
+            uint64_t uintVal;
+            FALSE_RETURN_V(meta->GetData(key, uintVal), false);
+            reportValue = std::to_string(uintVal);
+        } else if (Any::IsSameTypeWith<std::string>(valueType)) {
+            if (Any::IsSameTypeWith<std::string>(value)) {
+                reportValue = AnyCast<std::string>(value);
+            } else if (Any::IsSameTypeWith<int32_t>(value)) {
+                // keys without a registered tag type, such as the player startup phases
+                reportValue = std::to_string(AnyCast<int32_t>(value));
+            } else {
+                return false;
+            }
+        } else if (Any::IsSameTypeWith<int8_t>(valueType)) {
+            int8_t intVal;
+            FALSE_RETURN_V(meta->GetData(key, intVal), false);
+            reportValue = std::to_string(intVal);
+        } else if (Any::IsSameTypeWith<bool>(valueType)) {
+            bool isTrue;
+            FALSE_RETURN_V(meta->GetData(key, isTrue), false);
+            reportValue = isTrue ? "true" : "false";
+        } else {
+            MEDIA_LOG_I("not found type matched with key: %{public}s", key.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    void AppendJsonString(const std::string &str, std::string &out)
+    {
+        static const char hexDigits[] = "0123456789abcdef";
+        out += '"';
+        for (char ch : str) {
+            switch (ch) {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\r':
+                    out += "\\r";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(ch) < CONTROL_CHAR_MAX) {
+                        out += "\\u00";
+                        out += hexDigits[(static_cast<unsigned char>(ch) >> 4) & 0xf]; // 4: high nibble
+                        out += hexDigits[static_cast<unsigned char>(ch) & 0xf];
+                    } else {
+                        out += ch;
+                    }
+                    break;
+            }
+        }
+        out += '"';
+    }
+
     bool CollectReportMediaInfo(uint64_t instanceId)
     {
-        OHOS::Media::CallType ct;
-        int32_t uid;
-        std::pair<uint64_t, std::shared_ptr<OHOS::Media::Meta>> metaAppIdPair;
+        OHOS::Media::MediaStatisticsRecord record;
         {
-            std::lock_guard<std::mutex> lock(collectMut_);
+            MediaInfoShard &shard = GetShard(instanceId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
             MEDIA_LOG_I("CollectReportMediaInfo, instanceId is : %{public}" PRIu64, instanceId);
-            auto idMapIt = idMap_.find(instanceId);
-            if (idMapIt == idMap_.end()) {
+            auto it = shard.records.find(instanceId);
+            if (it == shard.records.end()) {
                 MEDIA_LOG_W("Not found instanceId in idMap, instanceId is : %{public}" PRIu64, instanceId);
                 return false;
             }
-            ct = idMapIt->second.first;
-            uid = idMapIt->second.second;
-            idMap_.erase(idMapIt);
-            auto ctUidToMediaInfo = mediaInfoMap_.find(ct);
-            if (ctUidToMediaInfo == mediaInfoMap_.end()) {
-                MEDIA_LOG_W("Not found calltype, calltype is : %{public}d", static_cast<OHOS::Media::CallType>(ct));
-                return false;
-            }
-            auto uidToMediaInfo = ctUidToMediaInfo->second.find(uid);
-            if (uidToMediaInfo == ctUidToMediaInfo->second.end()) {
-                MEDIA_LOG_W("Not found uid in mediaInfoMap_, uid is : %{public}" PRId32, uid);
-                return false;
-            }
-            auto& instanceList = uidToMediaInfo->second;
-            for (const auto& instancePair : instanceList) {
-                if (instancePair.first == instanceId) {
-                    metaAppIdPair = instancePair;
-                    instanceList.remove(instancePair);
-                    break;
-                }
-            }
+            record = std::move(it->second);
+            shard.records.erase(it);
         }
         std::lock_guard<std::mutex> lock(reportMut_);
-        auto reportCtUidToMediaInfo  = reportMediaInfoMap_.find(ct);
-        if (reportCtUidToMediaInfo != reportMediaInfoMap_.end()) {
-            auto it = reportCtUidToMediaInfo->second.find(uid);
-            if (it != reportCtUidToMediaInfo->second.end()) {
-                it->second.push_back(metaAppIdPair);
-            } else {
-                reportCtUidToMediaInfo->second[uid].push_back(metaAppIdPair);
-            }
-        } else {
-            reportMediaInfoMap_[ct][uid].push_back(metaAppIdPair);
-        }
-        g_reachMaxMapSize = (reportMediaInfoMap_[ct].size() >= MAX_MAP_SIZE);
+        auto &uidToRecords = reportMediaInfoMap_[record.callType];
+        uidToRecords[record.uid].push_back(std::move(record));
+        g_reachMaxMapSize = (uidToRecords.size() >= MAX_MAP_SIZE);
         return true;
     }
 
@@ -198,7 +281,7 @@ void MediaEvent::ScreenCaptureEventWrite(const std::string& eventName, OHOS::Hiv
 }
 
 void MediaEvent::CommonStatisicsEventWrite(CallType callType, OHOS::HiviewDFX::HiSysEvent::EventType type,
-    const std::map<int32_t, std::list<std::pair<uint64_t, std::shared_ptr<Meta>>>>& infoMap)
+    const std::map<int32_t, std::vector<MediaStatisticsRecord>>& infoMap)
 {
     MEDIA_LOG_I("MediaEvent::CommonStatisicsEventWrite");
     if (infoMap.empty()) {
@@ -207,64 +290,44 @@ void MediaEvent::CommonStatisicsEventWrite(CallType callType, OHOS::HiviewDFX::H
     }
     std::vector<std::string> infoArr;
 #ifdef SUPPORT_JSON
+    infoArr.reserve(infoMap.size());
     for (const auto& kv : infoMap) {
-        json jsonArray;
-        json eventInfoJson;
-        json mediaEvents;
-        for (const auto& listPair : kv.second) {
-            json metaInfoJson;
-            ParseOneEvent(listPair, metaInfoJson);
-            mediaEvents.push_back(metaInfoJson);
-        }
-        eventInfoJson["appName"] = GetClientBundleName(kv.first);
-        eventInfoJson["mediaEvents"] = mediaEvents;
-        jsonArray.push_back(eventInfoJson);
-        infoArr.push_back(jsonArray.dump());
+        std::string eventInfo;
+        SerializeStatistics(GetClientBundleName(kv.first), kv.second, eventInfo);
+        infoArr.push_back(std::move(eventInfo));
     }
 #endif
     StatisicsHiSysEventWrite(callType, type, infoArr);
 }
 
-
-#ifdef SUPPORT_JSON
-void MediaEvent::ParseOneEvent(const std::pair<uint64_t, std::shared_ptr<OHOS::Media::Meta>> &listPair,
-    json& metaInfoJson)
+void MediaEvent::SerializeStatistics(const std::string &appName, const std::vector<MediaStatisticsRecord> &records,
+    std::string &out)
 {
-    for (auto it = listPair.second->begin(); it != listPair.second->end(); ++it) {
-        Any valueType = OHOS::Media::GetDefaultAnyValue(it->first);
-        if (Any::IsSameTypeWith<int32_t>(valueType)) {
-            int32_t intVal;
-            if (listPair.second->GetData(it->first, intVal)) {
-                metaInfoJson[it->first] = std::to_string(intVal);
-            }
-        } else if (Any::IsSameTypeWith<uint32_t>(valueType)) {
-            uint32_t uintVal;
-            if (listPair.second->GetData(it->first, uintVal)) {
-                metaInfoJson[it->first] = std::to_string(uintVal);
-            }
-        } else if (Any::IsSameTypeWith<uint64_t>(valueType)) {
-            uint64_t uintVal;
-            if (listPair.second->GetData(it->first, uintVal)) {
-                metaInfoJson[it->first] = std::to_string(uintVal);
-            }
-        } else if (Any::IsSameTypeWith<std::string>(valueType)) {
-            metaInfoJson[it->first] = AnyCast<std::string>(it->second);
-        } else if (Any::IsSameTypeWith<int8_t>(valueType)) {
-            int8_t intVal;
-            if (listPair.second->GetData(it->first, intVal)) {
-                metaInfoJson[it->first] = std::to_string(intVal);
-            }
-        } else if (Any::IsSameTypeWith<bool>(valueType)) {
-            bool isTrue;
-            if (listPair.second->GetData(it->first, isTrue)) {
-                metaInfoJson[it->first] = isTrue ? "true" : "false";
+    out += "[{\"appName\":";
+    AppendJsonString(appName, out);
+    out += ",\"mediaEvents\":[";
+    std::vector<std::pair<const std::string *, const std::string *>> sortedFields;
+    for (size_t index = 0; index < records.size(); index++) {
+        out += index == 0 ? "{" : ",{";
+        sortedFields.clear();
+        for (const auto &field : records[index].fields) {
+            sortedFields.emplace_back(&GetMediaInfoKeyName(field.first), &field.second);
+        }
+        std::sort(sortedFields.begin(), sortedFields.end(), [](const auto &lhs, const auto &rhs) {
+            return *lhs.first < *rhs.first;
+        });
+        for (size_t field = 0; field < sortedFields.size(); field++) {
+            if (field != 0) {
+                out += ",";
             }
-        } else {
-            MEDIA_LOG_I("not found type matched with it->first: %{public}s", it->first.c_str());
+            AppendJsonString(*sortedFields[field].first, out);
+            out += ":";
+            AppendJsonString(*sortedFields[field].second, out);
         }
+        out += "}";
     }
+    out += "]}]";
 }
-#endif
 
 void MediaEvent::StatisicsHiSysEventWrite(CallType callType, OHOS::HiviewDFX::HiSysEvent::EventType type,
     const std::vector<std::string>& infoArr)
@@ -344,74 +407,63 @@ void FaultScreenCaptureEventWrite(const std::string& appName, uint64_t instanceI
 int32_t CreateMediaInfo(CallType callType, int32_t uid, uint64_t instanceId)
 {
     MEDIA_LOG_I("CreateMediaInfo uid is: %{public}" PRId32 " instanceId is: %{public}" PRIu64, uid, instanceId);
-    std::lock_guard<std::mutex> lock(collectMut_);
-    auto instanceIdMap = idMap_.find(instanceId);
-    if (instanceIdMap != idMap_.end()) {
+    MediaInfoShard &shard = GetShard(instanceId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.records.find(instanceId) != shard.records.end()) {
         MEDIA_LOG_I("instanceId already exists id idMap_");
         return MSERR_INVALID_VAL;
-    } else {
-        MEDIA_LOG_I("CreateMediaInfo not found instanceId in idMap_, add the instanceId to idMap_");
-        std::pair<CallType, int32_t> insertToMapPair(callType, uid);
-        idMap_[instanceId] = insertToMapPair;
-    }
-    std::shared_ptr<Meta> meta = std::make_shared<Meta>();
-    std::pair<uint64_t, std::shared_ptr<Meta>> metaAppIdPair(instanceId, meta);
-    auto ctUidToMediaInfo = mediaInfoMap_.find(callType);
-    if (ctUidToMediaInfo != mediaInfoMap_.end()) {
-        auto it = ctUidToMediaInfo->second.find(uid);
-        if (it != ctUidToMediaInfo->second.end()) {
-            it->second.push_back(metaAppIdPair);
-            MEDIA_LOG_I("CreateMediaInfo: Successfully inserted metaAppIdPair for uid ");
-        } else {
-            ctUidToMediaInfo->second[uid].push_back(metaAppIdPair);
-            MEDIA_LOG_I("CreateMediaInfo: Successfully created new list for uid and inserted metaAppIdPair.");
-        }
-    } else {
-        mediaInfoMap_[callType][uid].push_back(metaAppIdPair);
-        MEDIA_LOG_I("CreateMediaInfo: Successfully created new list for callType and uid ");
     }
+    MediaStatisticsRecord &record = shard.records[instanceId];
+    record.instanceId = instanceId;
+    record.uid = uid;
+    record.callType = callType;
     return MSERR_OK;
 }
 
 int32_t AppendMediaInfo(const std::shared_ptr<Meta>& meta, uint64_t instanceId)
 {
-    MEDIA_LOG_I("AppendMediaInfo.");
+    MEDIA_LOG_D("AppendMediaInfo.");
     if (meta == nullptr || meta->Empty()) {
         MEDIA_LOG_I("Insert meta is empty.");
         return MSERR_INVALID_OPERATION;
     }
-    std::lock_guard<std::mutex> lock(collectMut_);
-    auto idMapIt = idMap_.find(instanceId);
-    if (idMapIt == idMap_.end()) {
+    // converted before taking the shard lock, the lock only covers the merge
+    std::vector<std::pair<uint16_t, std::string>> fields;
+    for (auto it = meta->begin(); it != meta->end(); ++it) {
+        uint16_t keyId = 0;
+        std::string value;
+        if (ToReportValue(meta, it->first, it->second, value) && GetKeyId(it->first, keyId)) {
+            fields.emplace_back(keyId, std::move(value));
+        }
+    }
+    MediaInfoShard &shard = GetShard(instanceId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto recordIt = shard.records.find(instanceId);
+    if (recordIt == shard.records.end()) {
         MEDIA_LOG_I("Not found instanceId when append meta, instanceId is : %{public}" PRIu64, instanceId);
         return MSERR_INVALID_VAL;
     }
-    CallType ct = idMapIt->second.first;
-    int32_t uid = idMapIt->second.second;
-    auto ctUidToMediaInfo = mediaInfoMap_.find(ct);
-    if (ctUidToMediaInfo == mediaInfoMap_.end()) {
-        MEDIA_LOG_I("Not found calltype when append meta, calltype is : %{public}d", static_cast<CallType>(ct));
-        return MSERR_INVALID_OPERATION;
-    }
-    auto it = ctUidToMediaInfo->second.find(uid);
-    if (it == ctUidToMediaInfo->second.end()) {
-        MEDIA_LOG_I("Not found uid when append meta, uid is : %{public}" PRId32, uid);
-        return MSERR_INVALID_OPERATION;
-    }
-    auto& instanceList = it->second;
-    for (const auto& instancePair : instanceList) {
-        if (instancePair.first == instanceId) {
-            auto arg = meta->begin();
-            while (arg != meta->end()) {
-                instancePair.second->SetData(arg->first, arg->second);
-                ++arg;
-            }
-            break;
+    auto &recordFields = recordIt->second.fields;
+    for (auto &field : fields) {
+        auto fieldIt = std::find_if(recordFields.begin(), recordFields.end(),
+            [&field](const std::pair<uint16_t, std::string> &item) { return item.first == field.first; });
+        if (fieldIt != recordFields.end()) {
+            fieldIt->second = std::move(field.second);
+        } else {
+            recordFields.push_back(std::move(field));
         }
     }
     return MSERR_OK;
 }
 
+const std::string &GetMediaInfoKeyName(uint16_t keyId)
+{
+    static const std::string emptyKey = "";
+    std::lock_guard<std::mutex> lock(keyMutex_);
+    // keys are never removed and a deque keeps references valid while it grows
+    return keyId < keyNames_.size() ? keyNames_[keyId] : emptyKey;
+}
+
 int32_t ReportMediaInfo(uint64_t instanceId)
 {
     MEDIA_LOG_I("Report.");
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "media_probe_cache.h"
+#include <unistd.h>
+#include "media_errors.h"
+#include "media_log.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_METADATA, "MediaProbeCache"};
+}
+
+namespace OHOS {
+namespace Media {
+MediaProbeCache &MediaProbeCache::GetInstance()
+{
+    static MediaProbeCache instance;
+    return instance;
+}
+
+MediaProbeInfo MediaProbeCache::CopyProbeInfo(const MediaProbeInfo &info)
+{
+    MediaProbeInfo copy;
+    copy.globalMeta = info.globalMeta == nullptr ? nullptr : std::make_shared<Meta>(*info.globalMeta);
+    copy.trackMetas.reserve(info.trackMetas.size());
+    for (const auto &trackMeta : info.trackMetas) {
+        copy.trackMetas.push_back(trackMeta == nullptr ? nullptr : std::make_shared<Meta>(*trackMeta));
+    }
+    copy.userMeta = info.userMeta == nullptr ? nullptr : std::make_shared<Meta>(*info.userMeta);
+    copy.hasUserMeta = info.hasUserMeta;
+    return copy;
+}
+
+bool MediaProbeCache::Lookup(const std::string &key, MediaProbeInfo &info)
+{
+    CHECK_AND_RETURN_RET(!key.empty(), false);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(key);
+    if (iter == entries_.end()) {
+        missCount_++;
+        return false;
+    }
+    hitCount_++;
+    lruList_.splice(lruList_.begin(), lruList_, iter->second);
+    info = CopyProbeInfo(iter->second->second);
+    return true;
+}
+
+void MediaProbeCache::Insert(const std::string &key, const MediaProbeInfo &info)
+{
+    CHECK_AND_RETURN(!key.empty() && info.globalMeta != nullptr);
+    MediaProbeInfo copy = CopyProbeInfo(info);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(key);
+    if (iter != entries_.end()) {
+        iter->second->second = std::move(copy);
+        lruList_.splice(lruList_.begin(), lruList_, iter->second);
+        return;
+    }
+    lruList_.emplace_front(key, std::move(copy));
+    entries_[key] = lruList_.begin();
+    if (lruList_.size() > MAX_ENTRY_COUNT) {
+        entries_.erase(lruList_.back().first);
+        lruList_.pop_back();
+    }
+}
+
+bool MediaProbeCache::Contains(const std::string &key)
+{
+    CHECK_AND_RETURN_RET(!key.empty(), false);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(key);
+    CHECK_AND_RETURN_RET(iter != entries_.end(), false);
+    lruList_.splice(lruList_.begin(), lruList_, iter->second);
+    return true;
+}
+
+void MediaProbeCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    lruList_.clear();
+    entries_.clear();
+}
+
+int32_t MediaProbeCache::Dump(int32_t fd)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string dumpString = "------------------MediaProbeCache------------------\n";
+    dumpString += "entries: " + std::to_string(lruList_.size()) + "/" + std::to_string(MAX_ENTRY_COUNT) +
+        ", hit: " + std::to_string(hitCount_) + ", miss: " + std::to_string(missCount_) + "\n";
+    if (fd != -1) {
+        write(fd, dumpString.c_str(), dumpString.size());
+    }
+    return MSERR_OK;
+}
+} // namespace Media
+} // namespace OHOS
@@ -17,9 +17,8 @@
 #include <media_errors.h>
 #include "common/log.h"
 #include "media_utils.h"
-#include "iservice_registry.h"
 #include "bundle_mgr_interface.h"
-#include "system_ability_definition.h"
+#include "bundle_name_cache.h"
 #include <unordered_set>
 #include "parameter.h"
 
@@ -62,19 +61,12 @@ std::string __attribute__((visibility("default"))) GetClientBundleName(int32_t u
         return "bootanimation";
     }
     std::string bundleName = "";
-    auto samgr = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
-    if (samgr == nullptr) {
-        MEDIA_LOG_E("Get ability manager failed");
+    uint64_t generation = 0;
+    if (BundleNameCache::GetInstance().Lookup(uid, bundleName, generation)) {
         return bundleName;
     }
 
-    sptr<IRemoteObject> object = samgr->GetSystemAbility(BUNDLE_MGR_SERVICE_SYS_ABILITY_ID);
-    if (object == nullptr) {
-        MEDIA_LOG_E("object is NULL.");
-        return bundleName;
-    }
-
-    sptr<OHOS::AppExecFwk::IBundleMgr> bms = iface_cast<OHOS::AppExecFwk::IBundleMgr>(object);
+    sptr<OHOS::AppExecFwk::IBundleMgr> bms = BundleNameCache::GetInstance().GetBundleMgr();
     if (bms == nullptr) {
         MEDIA_LOG_E("bundle manager service is NULL.");
         return bundleName;
@@ -85,26 +77,17 @@ std::string __attribute__((visibility("default"))) GetClientBundleName(int32_t u
         MEDIA_LOG_E("Error GetBundleNameForUid fail");
         return "";
     }
-    MEDIA_LOG_I("bundle name is %{public}s ", bundleName.c_str());
+    if (shouldLog) {
+        MEDIA_LOG_I("bundle name is %{public}s ", bundleName.c_str());
+    }
+    BundleNameCache::GetInstance().Insert(uid, bundleName, generation);
 
     return bundleName;
 }
 
 std::string __attribute__((visibility("default"))) GetBundleResourceLabel(std::string bundleName)
 {
-    auto samgr = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
-    if (samgr == nullptr) {
-        MEDIA_LOG_E("Get ability manager failed");
-        return bundleName;
-    }
-
-    sptr<IRemoteObject> object = samgr->GetSystemAbility(BUNDLE_MGR_SERVICE_SYS_ABILITY_ID);
-    if (object == nullptr) {
-        MEDIA_LOG_E("object is NULL.");
-        return bundleName;
-    }
-
-    sptr<OHOS::AppExecFwk::IBundleMgr> bms = iface_cast<OHOS::AppExecFwk::IBundleMgr>(object);
+    sptr<OHOS::AppExecFwk::IBundleMgr> bms = BundleNameCache::GetInstance().GetBundleMgr();
     if (bms == nullptr) {
         MEDIA_LOG_E("bundle manager service is NULL.");
         return bundleName;
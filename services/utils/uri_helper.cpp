@@ -224,6 +224,26 @@ bool UriHelper::AccessCheck(uint8_t flag) const
     return true; // Not implemented, defaultly return true.
 }
 
+std::string UriHelper::FileIdentity() const
+{
+    struct stat64 st;
+    int64_t offset = 0;
+    int64_t size = 0;
+    if (type_ == URI_TYPE_FILE) {
+        CHECK_AND_RETURN_RET(!rawFileUri_.empty() && stat64(std::string(rawFileUri_).c_str(), &st) == 0, "");
+        size = static_cast<int64_t>(st.st_size);
+    } else if (type_ == URI_TYPE_FD) {
+        CHECK_AND_RETURN_RET(fd_ > 0 && fstat64(fd_, &st) == 0, "");
+        offset = offset_;
+        size = size_;
+    } else {
+        return "";
+    }
+    return std::to_string(st.st_dev) + ":" + std::to_string(st.st_ino) + ":" + std::to_string(st.st_size) + ":" +
+        std::to_string(st.st_mtim.tv_sec) + "." + std::to_string(st.st_mtim.tv_nsec) + ":" +
+        std::to_string(offset) + ":" + std::to_string(size);
+}
+
 bool UriHelper::ParseFdUri(std::string_view uri)
 {
     static constexpr std::string_view::size_type delim1Len = std::string_view("?offset=").size();
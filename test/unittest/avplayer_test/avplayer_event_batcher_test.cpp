@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "avplayer_event_batcher.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    const std::string TIME_UPDATE_KEY = "timeUpdate";
+    const std::string BUFFERING_PERCENT_KEY = "bufferingUpdate_2";
+    constexpr int32_t POSITION_INTERVAL_US = 1000;
+    constexpr int32_t PLAYBACK_DURATION_MS = 500;
+    constexpr int32_t JS_FRAME_COST_US = 8000;
+    constexpr int32_t MS_PER_SECOND = 1000;
+}
+
+namespace OHOS {
+namespace Media {
+/**
+ * Stands in for the uv loop of the JS thread, each flush it runs is one wakeup.
+ */
+class FakeJsThread {
+public:
+    explicit FakeJsThread(int32_t frameCostUs) : frameCostUs_(frameCostUs)
+    {
+        thread_ = std::thread([this] { Loop(); });
+    }
+
+    ~FakeJsThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            isStopped_ = true;
+        }
+        cond_.notify_all();
+        thread_.join();
+    }
+
+    bool Schedule(const std::function<void()> &flush)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(flush);
+        }
+        cond_.notify_all();
+        return true;
+    }
+
+    void WaitIdle()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return tasks_.empty() && !isRunning_; });
+    }
+
+    uint64_t GetWakeupCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return wakeupCount_;
+    }
+
+private:
+    void Loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cond_.wait(lock, [this] { return isStopped_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            auto task = tasks_.front();
+            tasks_.pop_front();
+            isRunning_ = true;
+            wakeupCount_++;
+            lock.unlock();
+            task();
+            // js is busy with the rest of its frame, events keep arriving meanwhile
+            std::this_thread::sleep_for(std::chrono::microseconds(frameCostUs_));
+            lock.lock();
+            isRunning_ = false;
+            cond_.notify_all();
+        }
+    }
+
+    int32_t frameCostUs_ = 0;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::function<void()>> tasks_;
+    bool isRunning_ = false;
+    bool isStopped_ = false;
+    uint64_t wakeupCount_ = 0;
+};
+
+class AVPlayerEventBatcherTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void)
+    {
+        pendingFlushes_.clear();
+        batcher_ = std::make_shared<AVPlayerEventBatcher>([this](const std::function<void()> &flush) {
+            pendingFlushes_.push_back(flush);
+            return true;
+        });
+    };
+    void TearDown(void)
+    {
+        batcher_ = nullptr;
+        pendingFlushes_.clear();
+    };
+
+    void RunPendingFlushes()
+    {
+        auto flushes = std::move(pendingFlushes_);
+        pendingFlushes_.clear();
+        for (auto &flush : flushes) {
+            flush();
+        }
+    }
+
+protected:
+    std::shared_ptr<AVPlayerEventBatcher> batcher_ = nullptr;
+    std::vector<std::function<void()>> pendingFlushes_;
+};
+
+HWTEST_F(AVPlayerEventBatcherTest, ONE_HOP_PER_BATCH, TestSize.Level1)
+{
+    std::vector<std::string> delivered;
+    batcher_->Post([&delivered] { delivered.push_back("prepared"); });
+    batcher_->Post([&delivered] { delivered.push_back("playing"); });
+    batcher_->Post([&delivered] { delivered.push_back("error"); });
+    EXPECT_EQ(pendingFlushes_.size(), 1);
+    RunPendingFlushes();
+    EXPECT_EQ(delivered, std::vector<std::string>({"prepared", "playing", "error"}));
+    EXPECT_EQ(batcher_->GetFlushCount(), 1);
+
+    batcher_->Post([&delivered] { delivered.push_back("paused"); });
+    EXPECT_EQ(pendingFlushes_.size(), 1);
+    RunPendingFlushes();
+    EXPECT_EQ(delivered.back(), "paused");
+    EXPECT_EQ(batcher_->GetFlushCount(), 2);
+}
+
+HWTEST_F(AVPlayerEventBatcherTest, COALESCE_KEEPS_LATEST, TestSize.Level1)
+{
+    std::vector<std::string> delivered;
+    batcher_->Post([&delivered] { delivered.push_back("time_100"); }, TIME_UPDATE_KEY);
+    batcher_->Post([&delivered] { delivered.push_back("buffering_10"); }, BUFFERING_PERCENT_KEY);
+    batcher_->Post([&delivered] { delivered.push_back("time_200"); }, TIME_UPDATE_KEY);
+    batcher_->Post([&delivered] { delivered.push_back("buffering_20"); }, BUFFERING_PERCENT_KEY);
+    batcher_->Post([&delivered] { delivered.push_back("time_300"); }, TIME_UPDATE_KEY);
+    RunPendingFlushes();
+    EXPECT_EQ(delivered, std::vector<std::string>({"buffering_20", "time_300"}));
+    EXPECT_EQ(batcher_->GetPostCount(), 5);
+    EXPECT_EQ(batcher_->GetCoalescedCount(), 3);
+}
+
+HWTEST_F(AVPlayerEventBatcherTest, COALESCE_NEVER_REORDERS_STATE, TestSize.Level1)
+{
+    std::vector<std::string> delivered;
+    batcher_->Post([&delivered] { delivered.push_back("time_100"); }, TIME_UPDATE_KEY);
+    batcher_->Post([&delivered] { delivered.push_back("seekDone"); });
+    batcher_->Post([&delivered] { delivered.push_back("time_200"); }, TIME_UPDATE_KEY);
+    batcher_->Post([&delivered] { delivered.push_back("completed"); });
+    RunPendingFlushes();
+    // the newer position moves behind seekDone, it is never delivered before an event posted ahead of it
+    EXPECT_EQ(delivered, std::vector<std::string>({"seekDone", "time_200", "completed"}));
+}
+
+HWTEST_F(AVPlayerEventBatcherTest, RETRY_AFTER_SCHEDULE_FAILURE, TestSize.Level1)
+{
+    bool canSchedule = false;
+    std::vector<std::function<void()>> flushes;
+    auto batcher = std::make_shared<AVPlayerEventBatcher>([&](const std::function<void()> &flush) {
+        if (!canSchedule) {
+            return false;
+        }
+        flushes.push_back(flush);
+        return true;
+    });
+    std::vector<std::string> delivered;
+    batcher->Post([&delivered] { delivered.push_back("prepared"); });
+    EXPECT_TRUE(flushes.empty());
+    canSchedule = true;
+    batcher->Post([&delivered] { delivered.push_back("playing"); });
+    ASSERT_EQ(flushes.size(), 1);
+    flushes.front()();
+    EXPECT_EQ(delivered, std::vector<std::string>({"prepared", "playing"}));
+}
+
+HWTEST_F(AVPlayerEventBatcherTest, PENDING_EVENTS_OUTLIVE_OWNER, TestSize.Level1)
+{
+    std::vector<std::string> delivered;
+    batcher_->Post([&delivered] { delivered.push_back("released"); });
+    batcher_ = nullptr;
+    RunPendingFlushes();
+    EXPECT_EQ(delivered, std::vector<std::string>({"released"}));
+}
+
+/**
+ * Plays for PLAYBACK_DURATION_MS with a position update every POSITION_INTERVAL_US and a buffering progress update
+ * every tenth tick, while the js thread spends JS_FRAME_COST_US on every wakeup. Without batching every update is
+ * one wakeup, with batching the wakeup rate is bounded by the js frame rate.
+ */
+HWTEST_F(AVPlayerEventBatcherTest, JS_WAKEUPS_PER_SECOND, TestSize.Level1)
+{
+    FakeJsThread jsThread(JS_FRAME_COST_US);
+    auto batcher = std::make_shared<AVPlayerEventBatcher>([&jsThread](const std::function<void()> &flush) {
+        return jsThread.Schedule(flush);
+    });
+    std::atomic<int32_t> lastPosition = -1;
+    std::atomic<int32_t> stateEvents = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::milliseconds(PLAYBACK_DURATION_MS);
+    int32_t position = 0;
+    batcher->Post([&stateEvents] { stateEvents++; });
+    while (std::chrono::steady_clock::now() < deadline) {
+        position++;
+        batcher->Post([&lastPosition, position] { lastPosition = position; }, TIME_UPDATE_KEY);
+        if (position % 10 == 0) {
+            batcher->Post([] {}, BUFFERING_PERCENT_KEY);
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(POSITION_INTERVAL_US));
+    }
+    batcher->Post([&stateEvents] { stateEvents++; });
+    jsThread.WaitIdle();
+    double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t wakeups = jsThread.GetWakeupCount();
+    uint64_t posts = batcher->GetPostCount();
+    std::cout << "events posted: " << posts << ", coalesced: " << batcher->GetCoalescedCount()
+        << ", js wakeups: " << wakeups << ", wakeups per second: " << wakeups / elapsedSec
+        << ", unbatched wakeups per second: " << posts / elapsedSec << std::endl;
+
+    EXPECT_EQ(lastPosition.load(), position);
+    EXPECT_EQ(stateEvents.load(), 2);
+    EXPECT_EQ(wakeups, batcher->GetFlushCount());
+    EXPECT_LT(wakeups, posts);
+    EXPECT_LE(wakeups / elapsedSec, static_cast<double>(MS_PER_SECOND * MS_PER_SECOND / JS_FRAME_COST_US) + 1);
+}
+} // namespace Media
+} // namespace OHOS
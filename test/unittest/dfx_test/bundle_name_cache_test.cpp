@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include "gtest/gtest.h"
+#include "bundle_name_cache.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr int32_t TEST_UID_BASE = 20990000;
+    const std::string TEST_BUNDLE_PREFIX = "com.test.bundle_name_cache.";
+}
+
+namespace OHOS {
+namespace Media {
+class BundleNameCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void)
+    {
+        // nothing is cached without the package events
+        ASSERT_TRUE(BundleNameCache::GetInstance().SubscribePackageEvents());
+        BundleNameCache::GetInstance().Clear();
+    };
+    void TearDown(void)
+    {
+        BundleNameCache::GetInstance().Clear();
+    };
+
+    static void MissAndInsert(int32_t uid, const std::string &bundleName)
+    {
+        std::string cached;
+        uint64_t generation = 0;
+        ASSERT_FALSE(BundleNameCache::GetInstance().Lookup(uid, cached, generation));
+        BundleNameCache::GetInstance().Insert(uid, bundleName, generation);
+    }
+
+    static bool IsCached(int32_t uid, const std::string &bundleName)
+    {
+        std::string cached;
+        uint64_t generation = 0;
+        return BundleNameCache::GetInstance().Lookup(uid, cached, generation) && cached == bundleName;
+    }
+};
+
+HWTEST_F(BundleNameCacheTest, EVICT_LEAST_RECENTLY_USED, TestSize.Level1)
+{
+    for (size_t i = 0; i < BundleNameCache::MAX_ENTRY_COUNT; i++) {
+        MissAndInsert(TEST_UID_BASE + static_cast<int32_t>(i), TEST_BUNDLE_PREFIX + std::to_string(i));
+    }
+    // touch the oldest entry so the second oldest becomes the eviction candidate
+    ASSERT_TRUE(IsCached(TEST_UID_BASE, TEST_BUNDLE_PREFIX + "0"));
+
+    int32_t extraUid = TEST_UID_BASE + static_cast<int32_t>(BundleNameCache::MAX_ENTRY_COUNT);
+    MissAndInsert(extraUid, TEST_BUNDLE_PREFIX + "extra");
+    ASSERT_TRUE(IsCached(extraUid, TEST_BUNDLE_PREFIX + "extra"));
+    ASSERT_TRUE(IsCached(TEST_UID_BASE, TEST_BUNDLE_PREFIX + "0"));
+    ASSERT_FALSE(IsCached(TEST_UID_BASE + 1, TEST_BUNDLE_PREFIX + "1"));
+    for (size_t i = 2; i < BundleNameCache::MAX_ENTRY_COUNT; i++) {
+        ASSERT_TRUE(IsCached(TEST_UID_BASE + static_cast<int32_t>(i), TEST_BUNDLE_PREFIX + std::to_string(i)));
+    }
+}
+
+HWTEST_F(BundleNameCacheTest, INVALIDATE_UID_AND_BUNDLE, TestSize.Level1)
+{
+    const std::string sharedBundle = TEST_BUNDLE_PREFIX + "shared";
+    MissAndInsert(TEST_UID_BASE, TEST_BUNDLE_PREFIX + "0");
+    MissAndInsert(TEST_UID_BASE + 1, sharedBundle);
+    MissAndInsert(TEST_UID_BASE + 2, sharedBundle);
+
+    BundleNameCache::GetInstance().InvalidateUid(TEST_UID_BASE);
+    ASSERT_FALSE(IsCached(TEST_UID_BASE, TEST_BUNDLE_PREFIX + "0"));
+    ASSERT_TRUE(IsCached(TEST_UID_BASE + 1, sharedBundle));
+
+    BundleNameCache::GetInstance().InvalidateBundle(sharedBundle);
+    ASSERT_FALSE(IsCached(TEST_UID_BASE + 1, sharedBundle));
+    ASSERT_FALSE(IsCached(TEST_UID_BASE + 2, sharedBundle));
+
+    MissAndInsert(TEST_UID_BASE, TEST_BUNDLE_PREFIX + "0");
+    BundleNameCache::GetInstance().Clear();
+    ASSERT_FALSE(IsCached(TEST_UID_BASE, TEST_BUNDLE_PREFIX + "0"));
+}
+
+HWTEST_F(BundleNameCacheTest, INSERT_AFTER_INVALIDATION_IS_SKIPPED, TestSize.Level1)
+{
+    std::string cached;
+    uint64_t generation = 0;
+    ASSERT_FALSE(BundleNameCache::GetInstance().Lookup(TEST_UID_BASE, cached, generation));
+    // the package is removed while its name is resolved, the name resolved before must not be cached
+    BundleNameCache::GetInstance().InvalidateUid(TEST_UID_BASE);
+    BundleNameCache::GetInstance().Insert(TEST_UID_BASE, TEST_BUNDLE_PREFIX + "0", generation);
+    ASSERT_FALSE(IsCached(TEST_UID_BASE, TEST_BUNDLE_PREFIX + "0"));
+
+    MissAndInsert(TEST_UID_BASE, TEST_BUNDLE_PREFIX + "0");
+    ASSERT_TRUE(IsCached(TEST_UID_BASE, TEST_BUNDLE_PREFIX + "0"));
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "dfx_log_ring.h"
+#include "securec.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    const char *TEST_LEVEL = "LOGI";
+    const char *TEST_TAG = "DfxLogRingTest";
+    constexpr int32_t BENCHMARK_THREAD_COUNT = 16;
+    constexpr int32_t BENCHMARK_LINE_COUNT = 20000;
+    constexpr size_t BENCHMARK_RING_CAPACITY = 1024 * 1024;
+    constexpr uint32_t MAX_LOG_LEN = 1024;
+}
+
+namespace OHOS {
+namespace Media {
+class DfxLogRingTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void) {};
+    void TearDown(void) {};
+
+    static bool WriteLog(DfxLogRing &ring, const char *fmt, ...)
+    {
+        va_list ap;
+        va_start(ap, fmt);
+        bool ret = ring.Write(TEST_LEVEL, TEST_TAG, fmt, ap);
+        va_end(ap);
+        return ret;
+    }
+
+    static std::string DrainMessage(DfxLogRing &ring)
+    {
+        std::string out;
+        EXPECT_EQ(ring.Drain(out), 1u);
+        std::string prefix = std::string(TEST_TAG) + ":";
+        size_t pos = out.find(prefix);
+        EXPECT_NE(pos, std::string::npos);
+        return out.substr(pos + prefix.size());
+    }
+};
+
+/**
+ * The logging path the ring replaced: one process-wide lock around format rewriting, vsnprintf and the append.
+ */
+class LockedLogBaseline {
+public:
+    void SaveLog(const char *fmt, ...)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        std::string temp = "";
+        std::string fmtStr = fmt;
+        size_t srcPos = 0;
+        auto dtsPos = fmtStr.find("{public}", srcPos);
+        const size_t pubLen = 8;
+        while (dtsPos != std::string::npos) {
+            temp += fmtStr.substr(srcPos, dtsPos - srcPos);
+            srcPos = dtsPos + pubLen;
+            dtsPos = fmtStr.find("{public}", srcPos);
+        }
+        temp += fmtStr.substr(srcPos);
+
+        va_list ap;
+        va_start(ap, fmt);
+        char logBuf[MAX_LOG_LEN];
+        auto ret = vsnprintf_s(logBuf, MAX_LOG_LEN, MAX_LOG_LEN - 1, temp.c_str(), ap);
+        va_end(ap);
+        logString_ += TEST_TAG;
+        logString_ += ret < 0 ? "dump log error" : logBuf;
+        logString_ += "\n";
+    }
+
+private:
+    std::mutex mutex_;
+    std::string logString_;
+};
+
+HWTEST_F(DfxLogRingTest, FORMAT_ON_DRAIN, TestSize.Level1)
+{
+    DfxLogRing ring;
+    char name[] = "player";
+    ASSERT_TRUE(WriteLog(ring, "{%s():%d} %{public}s state %{public}d, pos %{public}" PRId64 ", speed %.2f %u%%",
+        __FUNCTION__, __LINE__, name, 3, static_cast<int64_t>(-5), 1.5, 7u));
+    // the string is copied when logged, changing the source afterwards does not change the line
+    name[0] = 'X';
+    std::string message = DrainMessage(ring);
+    EXPECT_NE(message.find("player state 3, pos -5, speed 1.50 7%\n"), std::string::npos);
+    EXPECT_EQ(message.find("{public}"), std::string::npos);
+}
+
+HWTEST_F(DfxLogRingTest, FORMAT_TYPES, TestSize.Level1)
+{
+    DfxLogRing ring;
+    ASSERT_TRUE(WriteLog(ring, "%zu %lu %llx %c %5.1f %s %{private}s", static_cast<size_t>(42),
+        static_cast<unsigned long>(7), static_cast<unsigned long long>(255), 'a', 2.5, nullptr, "hidden"));
+    EXPECT_EQ(DrainMessage(ring), "42 7 ff a   2.5 (null) <private>\n");
+}
+
+HWTEST_F(DfxLogRingTest, PRIVATE_ARGS_HIDDEN, TestSize.Level1)
+{
+    DfxLogRing ring;
+    ASSERT_TRUE(WriteLog(ring, "uri %{private}s fd %{private}d, state %{public}d %s", "file:///data/secret.mp4",
+        5, 3, "done"));
+    EXPECT_EQ(DrainMessage(ring), "uri <private> fd <private>, state 3 done\n");
+
+    // a format that can not be captured is kept unformatted rather than leaking its private argument
+    ASSERT_TRUE(WriteLog(ring, "%*d|%{private}s", 4, 1, "secret"));
+    EXPECT_EQ(DrainMessage(ring), "%*d|%s\n");
+}
+
+HWTEST_F(DfxLogRingTest, UNSUPPORTED_FORMAT_FALLBACK, TestSize.Level1)
+{
+    const DfxLogFormat *format = DfxLogFormat::Get("%*d|%{public}s");
+    ASSERT_NE(format, nullptr);
+    EXPECT_FALSE(format->IsSupported());
+    EXPECT_EQ(format->GetStripped(), "%*d|%s");
+    EXPECT_EQ(DfxLogFormat::Get("%*d|%{public}s"), DfxLogFormat::Get("%*d|%{public}s"));
+
+    DfxLogRing ring;
+    ASSERT_TRUE(WriteLog(ring, "%*d|%{public}s", 4, 1, "abc"));
+    EXPECT_EQ(DrainMessage(ring), "   1|abc\n");
+}
+
+HWTEST_F(DfxLogRingTest, LONG_STRING_TRUNCATED, TestSize.Level1)
+{
+    DfxLogRing ring;
+    std::string longStr(DfxLogRing::MAX_RECORD_SIZE * 2, 'a');
+    ASSERT_TRUE(WriteLog(ring, "%s|%d", longStr.c_str(), 1));
+    std::string message = DrainMessage(ring);
+    EXPECT_EQ(message, std::string(DfxLogRing::MAX_STRING_LEN, 'a') + "|1\n");
+}
+
+HWTEST_F(DfxLogRingTest, WRAP_AND_DROP, TestSize.Level1)
+{
+    DfxLogRing ring(0);
+    uint32_t written = 0;
+    while (WriteLog(ring, "line %d", static_cast<int32_t>(written))) {
+        written++;
+    }
+    EXPECT_GT(written, 0u);
+    EXPECT_EQ(ring.TakeDroppedCount(), 1u);
+    EXPECT_EQ(ring.TakeDroppedCount(), 0u);
+
+    std::string out;
+    EXPECT_EQ(ring.Drain(out), written);
+    EXPECT_EQ(ring.GetUsedSize(), 0u);
+    // keep writing across the end of the buffer, every line comes out once and in order
+    for (int32_t round = 0; round < 10; round++) {
+        for (int32_t line = 0; line < 3; line++) {
+            ASSERT_TRUE(WriteLog(ring, "round %d line %d", round, line));
+        }
+        out.clear();
+        ASSERT_EQ(ring.Drain(out), 3u);
+        EXPECT_NE(out.find("round " + std::to_string(round) + " line 2"), std::string::npos);
+    }
+}
+
+/**
+ * Logging cost per line seen by 16 logging threads, old locked path versus the per-thread rings, with a writer
+ * thread draining the rings concurrently as DfxLogDump does.
+ */
+HWTEST_F(DfxLogRingTest, LOG_COST_16_THREADS, TestSize.Level1)
+{
+    auto runThreads = [](const std::function<void(int32_t)> &body) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int32_t index = 0; index < BENCHMARK_THREAD_COUNT; index++) {
+            threads.emplace_back(body, index);
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        // every thread logs BENCHMARK_LINE_COUNT lines in parallel, so this is the wall time one line costs a thread
+        auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        return static_cast<double>(cost.count()) / BENCHMARK_LINE_COUNT;
+    };
+
+    LockedLogBaseline baseline;
+    double lockedCost = runThreads([&baseline](int32_t index) {
+        for (int32_t line = 0; line < BENCHMARK_LINE_COUNT; line++) {
+            baseline.SaveLog("{%s():%d} thread %{public}d line %{public}d name %{public}s", __FUNCTION__, __LINE__,
+                index, line, "benchmark");
+        }
+    });
+
+    std::vector<std::unique_ptr<DfxLogRing>> rings;
+    for (int32_t index = 0; index < BENCHMARK_THREAD_COUNT; index++) {
+        rings.push_back(std::make_unique<DfxLogRing>(BENCHMARK_RING_CAPACITY));
+    }
+    std::atomic<bool> isDone = false;
+    uint64_t drained = 0;
+    std::thread writer([&rings, &isDone, &drained] {
+        std::string out;
+        while (!isDone.load()) {
+            for (auto &ring : rings) {
+                drained += ring->Drain(out);
+            }
+            out.clear();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        for (auto &ring : rings) {
+            drained += ring->Drain(out);
+        }
+    });
+    double ringCost = runThreads([&rings](int32_t index) {
+        for (int32_t line = 0; line < BENCHMARK_LINE_COUNT; line++) {
+            WriteLog(*rings[index], "{%s():%d} thread %{public}d line %{public}d name %{public}s", __FUNCTION__,
+                __LINE__, index, line, "benchmark");
+        }
+    });
+    isDone = true;
+    writer.join();
+    uint64_t dropped = 0;
+    for (auto &ring : rings) {
+        dropped += ring->TakeDroppedCount();
+    }
+
+    std::cout << "log cost per line with " << BENCHMARK_THREAD_COUNT << " threads, locked: " << lockedCost
+        << " ns, ring: " << ringCost << " ns, dropped: " << dropped << std::endl;
+    EXPECT_EQ(drained + dropped, static_cast<uint64_t>(BENCHMARK_THREAD_COUNT) * BENCHMARK_LINE_COUNT);
+}
+} // namespace Media
+} // namespace OHOS
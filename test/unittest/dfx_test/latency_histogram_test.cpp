@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include "gtest/gtest.h"
+#include "latency_histogram.h"
+#include "meta/meta.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr int64_t TEST_SAMPLE_COUNT = 100;
+    constexpr int64_t TEST_OUTLIER = 5000;
+}
+
+namespace OHOS {
+namespace Media {
+class LatencyHistogramTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void) {};
+    void TearDown(void) {};
+};
+
+HWTEST_F(LatencyHistogramTest, BUCKET_BOUNDS, TestSize.Level1)
+{
+    for (int64_t value = 0; value < TEST_OUTLIER * TEST_SAMPLE_COUNT; value++) {
+        size_t index = LatencyHistogram::GetBucketIndex(value);
+        ASSERT_LE(LatencyHistogram::GetBucketLowerBound(index), value);
+        ASSERT_GE(LatencyHistogram::GetBucketUpperBound(index), value);
+    }
+    for (size_t index = 0; index + 1 < LatencyHistogram::BUCKET_COUNT; index++) {
+        ASSERT_EQ(LatencyHistogram::GetBucketUpperBound(index) + 1, LatencyHistogram::GetBucketLowerBound(index + 1));
+    }
+    ASSERT_EQ(LatencyHistogram::GetBucketIndex(-1), 0u);
+    ASSERT_EQ(LatencyHistogram::GetBucketIndex(INT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+HWTEST_F(LatencyHistogramTest, PERCENTILE, TestSize.Level1)
+{
+    LatencyHistogram histogram("test_latency");
+    ASSERT_EQ(histogram.GetPercentile(50.0), -1);
+    for (int64_t value = 1; value <= TEST_SAMPLE_COUNT; value++) {
+        histogram.Record(value);
+    }
+    ASSERT_EQ(histogram.GetCount(), static_cast<uint64_t>(TEST_SAMPLE_COUNT));
+    ASSERT_EQ(histogram.GetMax(), TEST_SAMPLE_COUNT);
+    // buckets above SUB_BUCKET_COUNT have a relative width of at most 1 / SUB_BUCKET_COUNT
+    ASSERT_GE(histogram.GetPercentile(50.0), 50);
+    ASSERT_LE(histogram.GetPercentile(50.0), 50 + 50 / LatencyHistogram::SUB_BUCKET_COUNT);
+    ASSERT_GE(histogram.GetPercentile(99.0), 99);
+    ASSERT_LE(histogram.GetPercentile(99.0), TEST_SAMPLE_COUNT);
+
+    histogram.Record(TEST_OUTLIER);
+    ASSERT_EQ(histogram.GetMax(), TEST_OUTLIER);
+    ASSERT_LE(histogram.GetPercentile(95.0), TEST_SAMPLE_COUNT);
+    ASSERT_EQ(histogram.GetPercentile(100.0), TEST_OUTLIER);
+
+    histogram.Reset();
+    ASSERT_EQ(histogram.GetCount(), 0u);
+    ASSERT_EQ(histogram.GetMax(), 0);
+}
+
+HWTEST_F(LatencyHistogramTest, APPEND_TO_META, TestSize.Level1)
+{
+    LatencyHistogram histogram("test_latency");
+    std::shared_ptr<Meta> meta = std::make_shared<Meta>();
+    histogram.AppendToMeta(meta);
+    int32_t value = 0;
+    ASSERT_FALSE(meta->GetData("test_latency_p50", value));
+
+    histogram.Record(TEST_OUTLIER);
+    histogram.AppendToMeta(meta);
+    ASSERT_TRUE(meta->GetData("test_latency_count", value));
+    ASSERT_EQ(value, 1);
+    ASSERT_TRUE(meta->GetData("test_latency_p99", value));
+    ASSERT_EQ(value, TEST_OUTLIER);
+    ASSERT_FALSE(histogram.ToString().empty());
+}
+}
+}
@@ -94,6 +94,35 @@ HWTEST_F(MediaDfxTest, CREATE_MEDIA_INFO_2, TestSize.Level1)
     ASSERT_EQ(ret, MSERR_INVALID_OPERATION);
 }
 
+HWTEST_F(MediaDfxTest, SERIALIZE_STATISTICS, TestSize.Level1)
+{
+    uint64_t instanceId = 2;
+    ASSERT_EQ(CreateMediaInfo(CallType::SCREEN_CAPTRUER, TEST_UID_ID_1, instanceId), MSERR_OK);
+    std::shared_ptr<Meta> meta = std::make_shared<Meta>();
+    meta->SetData(Tag::SCREEN_CAPTURE_ERR_MSG, "quote\" slash\\ line\n");
+    meta->SetData(Tag::SCREEN_CAPTURE_ERR_CODE, ERROR_CODE);
+    ASSERT_EQ(AppendMediaInfo(meta, instanceId), MSERR_OK);
+
+    MediaStatisticsRecord record;
+    std::string errCodeKey = Tag::SCREEN_CAPTURE_ERR_CODE;
+    std::string errMsgKey = Tag::SCREEN_CAPTURE_ERR_MSG;
+    for (uint16_t keyId = 0; !GetMediaInfoKeyName(keyId).empty(); keyId++) {
+        if (GetMediaInfoKeyName(keyId) == errMsgKey) {
+            record.fields.emplace_back(keyId, "quote\" slash\\ line\n");
+        } else if (GetMediaInfoKeyName(keyId) == errCodeKey) {
+            record.fields.emplace_back(keyId, std::to_string(ERROR_CODE));
+        }
+    }
+    ASSERT_EQ(record.fields.size(), 2u);
+    std::string out;
+    MediaEvent::SerializeStatistics("app", { record, MediaStatisticsRecord() }, out);
+    std::string errCode = "\"" + errCodeKey + "\":\"5\"";
+    std::string errMsg = "\"" + errMsgKey + "\":\"quote\\\" slash\\\\ line\\n\"";
+    std::string fields = errCodeKey < errMsgKey ? errCode + "," + errMsg : errMsg + "," + errCode;
+    ASSERT_EQ(out, "[{\"appName\":\"app\",\"mediaEvents\":[{" + fields + "},{}]}]");
+    ASSERT_EQ(ReportMediaInfo(instanceId), MSERR_OK);
+}
+
 HWTEST_F(MediaDfxTest, FAULT_SOURCE_EVENT, TestSize.Level1)
 {
     std::string appName = "appName";
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include "gtest/gtest.h"
+#include "media_probe_cache.h"
+#include "meta/meta.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    const std::string TEST_KEY_PREFIX = "test_probe_key_";
+    const std::string TEST_META_KEY = "test_probe_value";
+}
+
+namespace OHOS {
+namespace Media {
+class MediaProbeCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void)
+    {
+        MediaProbeCache::GetInstance().Clear();
+    };
+    void TearDown(void)
+    {
+        MediaProbeCache::GetInstance().Clear();
+    };
+
+    static MediaProbeInfo CreateProbeInfo(int32_t value)
+    {
+        MediaProbeInfo info;
+        info.globalMeta = std::make_shared<Meta>();
+        info.globalMeta->SetData(TEST_META_KEY, value);
+        info.trackMetas.push_back(std::make_shared<Meta>());
+        return info;
+    }
+};
+
+HWTEST_F(MediaProbeCacheTest, LOOKUP_RETURNS_COPY, TestSize.Level1)
+{
+    MediaProbeInfo info = CreateProbeInfo(1);
+    MediaProbeCache::GetInstance().Insert(TEST_KEY_PREFIX, info);
+    info.globalMeta->SetData(TEST_META_KEY, 2);
+
+    MediaProbeInfo cached;
+    ASSERT_TRUE(MediaProbeCache::GetInstance().Lookup(TEST_KEY_PREFIX, cached));
+    ASSERT_NE(cached.globalMeta, nullptr);
+    ASSERT_EQ(cached.trackMetas.size(), 1u);
+    int32_t value = 0;
+    ASSERT_TRUE(cached.globalMeta->GetData(TEST_META_KEY, value));
+    ASSERT_EQ(value, 1);
+
+    ASSERT_FALSE(MediaProbeCache::GetInstance().Lookup("", cached));
+    ASSERT_FALSE(MediaProbeCache::GetInstance().Lookup(TEST_KEY_PREFIX + "missing", cached));
+}
+
+HWTEST_F(MediaProbeCacheTest, EVICT_LEAST_RECENTLY_USED, TestSize.Level1)
+{
+    for (size_t i = 0; i < MediaProbeCache::MAX_ENTRY_COUNT; i++) {
+        MediaProbeCache::GetInstance().Insert(TEST_KEY_PREFIX + std::to_string(i),
+            CreateProbeInfo(static_cast<int32_t>(i)));
+    }
+    MediaProbeInfo cached;
+    // touch the oldest entry so the second oldest becomes the eviction candidate
+    ASSERT_TRUE(MediaProbeCache::GetInstance().Lookup(TEST_KEY_PREFIX + "0", cached));
+    MediaProbeCache::GetInstance().Insert(TEST_KEY_PREFIX + "new", CreateProbeInfo(0));
+
+    ASSERT_TRUE(MediaProbeCache::GetInstance().Lookup(TEST_KEY_PREFIX + "0", cached));
+    ASSERT_FALSE(MediaProbeCache::GetInstance().Lookup(TEST_KEY_PREFIX + "1", cached));
+    ASSERT_TRUE(MediaProbeCache::GetInstance().Lookup(TEST_KEY_PREFIX + "new", cached));
+}
+
+HWTEST_F(MediaProbeCacheTest, CONTAINS_REFRESHES_ENTRY, TestSize.Level1)
+{
+    for (size_t i = 0; i < MediaProbeCache::MAX_ENTRY_COUNT; i++) {
+        MediaProbeCache::GetInstance().Insert(TEST_KEY_PREFIX + std::to_string(i),
+            CreateProbeInfo(static_cast<int32_t>(i)));
+    }
+    ASSERT_FALSE(MediaProbeCache::GetInstance().Contains(""));
+    ASSERT_FALSE(MediaProbeCache::GetInstance().Contains(TEST_KEY_PREFIX + "missing"));
+    // a feeding engine finding its source cached keeps the entry alive like a reader would
+    ASSERT_TRUE(MediaProbeCache::GetInstance().Contains(TEST_KEY_PREFIX + "0"));
+    MediaProbeCache::GetInstance().Insert(TEST_KEY_PREFIX + "new", CreateProbeInfo(0));
+
+    ASSERT_TRUE(MediaProbeCache::GetInstance().Contains(TEST_KEY_PREFIX + "0"));
+    ASSERT_FALSE(MediaProbeCache::GetInstance().Contains(TEST_KEY_PREFIX + "1"));
+}
+}
+}
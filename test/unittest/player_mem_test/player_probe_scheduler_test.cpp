@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thread>
+#include "gtest/gtest.h"
+#include "player_probe_scheduler.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr std::chrono::hours FAR_AWAY(1);
+    constexpr std::chrono::seconds OVERDUE(1);
+    int g_playerA = 0;
+    int g_playerB = 0;
+}
+
+namespace OHOS {
+namespace Media {
+class PlayerProbeSchedulerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void) {};
+    void TearDown(void) {};
+};
+
+HWTEST_F(PlayerProbeSchedulerTest, DUE_PLAYERS_COME_EARLIEST_FIRST, TestSize.Level1)
+{
+    PlayerProbeScheduler scheduler;
+    scheduler.Start();
+    auto now = std::chrono::steady_clock::now();
+    scheduler.Schedule(PlayerProbeTarget {1, 10, &g_playerB}, now - OVERDUE);
+    scheduler.Schedule(PlayerProbeTarget {1, 10, &g_playerA}, now - OVERDUE * 2); // 2: due before player B
+
+    PlayerProbeTarget target;
+    ASSERT_TRUE(scheduler.WaitForDue(target));
+    EXPECT_EQ(target.signAddr, &g_playerA);
+    ASSERT_TRUE(scheduler.WaitForDue(target));
+    EXPECT_EQ(target.signAddr, &g_playerB);
+    EXPECT_EQ(target.uid, 1);
+    EXPECT_EQ(target.pid, 10); // 10: pid of player B
+    // a handed out player keeps no deadline until it is scheduled again
+    std::chrono::steady_clock::time_point deadline;
+    EXPECT_FALSE(scheduler.GetDeadline(&g_playerB, deadline));
+}
+
+HWTEST_F(PlayerProbeSchedulerTest, A_PLAYER_HAS_ONE_DEADLINE, TestSize.Level1)
+{
+    PlayerProbeScheduler scheduler;
+    auto now = std::chrono::steady_clock::now();
+    scheduler.Schedule(PlayerProbeTarget {1, 10, &g_playerA}, now);
+    scheduler.Schedule(PlayerProbeTarget {1, 10, &g_playerA}, now + FAR_AWAY);
+    std::chrono::steady_clock::time_point deadline;
+    ASSERT_TRUE(scheduler.GetDeadline(&g_playerA, deadline));
+    EXPECT_EQ(deadline, now + FAR_AWAY);
+
+    scheduler.Cancel(&g_playerA);
+    EXPECT_FALSE(scheduler.GetDeadline(&g_playerA, deadline));
+}
+
+HWTEST_F(PlayerProbeSchedulerTest, EARLIER_DEADLINE_WAKES_THE_WAITER, TestSize.Level1)
+{
+    PlayerProbeScheduler scheduler;
+    scheduler.Start();
+    scheduler.Schedule(PlayerProbeTarget {1, 10, &g_playerA}, std::chrono::steady_clock::now() + FAR_AWAY);
+    PlayerProbeTarget target;
+    bool isDue = false;
+    std::thread waiter([&] {
+        isDue = scheduler.WaitForDue(target);
+    });
+    scheduler.Schedule(PlayerProbeTarget {2, 20, &g_playerB}, std::chrono::steady_clock::now());
+    waiter.join();
+    EXPECT_TRUE(isDue);
+    EXPECT_EQ(target.signAddr, &g_playerB);
+}
+
+HWTEST_F(PlayerProbeSchedulerTest, STOP_RELEASES_THE_WAITER, TestSize.Level1)
+{
+    PlayerProbeScheduler scheduler;
+    PlayerProbeTarget target;
+    // never started, nothing is handed out
+    EXPECT_FALSE(scheduler.WaitForDue(target));
+
+    scheduler.Start();
+    bool isDue = true;
+    std::thread waiter([&] {
+        isDue = scheduler.WaitForDue(target);
+    });
+    scheduler.Stop();
+    waiter.join();
+    EXPECT_FALSE(isDue);
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include "gtest/gtest.h"
+#include "player_recovery_snapshot.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr int32_t POSITION_MS = 5000;
+    constexpr int32_t DURATION_MS = 60000;
+    constexpr int32_t SHORT_POSITION_MS = 300;
+}
+
+namespace OHOS {
+namespace Media {
+class PlayerRecoverySnapshotTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void) {};
+    void TearDown(void) {};
+};
+
+HWTEST_F(PlayerRecoverySnapshotTest, VIDEO_RECOVERS_TO_KEY_FRAME, TestSize.Level1)
+{
+    PlayerRecoverySnapshot snapshot;
+    snapshot.positionMs = POSITION_MS;
+    snapshot.durationMs = DURATION_MS;
+    snapshot.audioIndex = 1;
+    snapshot.videoIndex = 0;
+    snapshot.isPlaying = true;
+    EXPECT_TRUE(snapshot.NeedSeek());
+
+    PlayerRecoverySeek seek = snapshot.GetRecoverSeek(true);
+    EXPECT_EQ(seek.positionMs, POSITION_MS);
+    EXPECT_TRUE(seek.toKeyFrame);
+    // with the key frame seek switched off the player decodes forward to the exact position
+    EXPECT_FALSE(snapshot.GetRecoverSeek(false).toKeyFrame);
+
+    std::string dump;
+    snapshot.Dump(dump);
+    EXPECT_NE(dump.find("position 5000 ms, duration 60000 ms"), std::string::npos);
+    EXPECT_NE(dump.find("tracks audio 1 video 0 text -1"), std::string::npos);
+}
+
+HWTEST_F(PlayerRecoverySnapshotTest, PAUSED_VIDEO_RECOVERS_EXACTLY, TestSize.Level1)
+{
+    PlayerRecoverySnapshot snapshot;
+    snapshot.positionMs = POSITION_MS;
+    snapshot.durationMs = DURATION_MS;
+    snapshot.videoIndex = 0;
+    // the sync frame may be a whole GOP back, a paused player would show the wrong frame
+    EXPECT_FALSE(snapshot.GetRecoverSeek(true).toKeyFrame);
+
+    // right after the start the rewind can only be short
+    snapshot.positionMs = SHORT_POSITION_MS;
+    EXPECT_TRUE(snapshot.GetRecoverSeek(true).toKeyFrame);
+}
+
+HWTEST_F(PlayerRecoverySnapshotTest, AUDIO_ONLY_RECOVERS_EXACTLY, TestSize.Level1)
+{
+    PlayerRecoverySnapshot snapshot;
+    EXPECT_FALSE(snapshot.NeedSeek());
+
+    snapshot.positionMs = DURATION_MS + POSITION_MS;
+    snapshot.durationMs = DURATION_MS;
+    snapshot.audioIndex = 0;
+    PlayerRecoverySeek seek = snapshot.GetRecoverSeek(true);
+    EXPECT_EQ(seek.positionMs, DURATION_MS);
+    EXPECT_FALSE(seek.toKeyFrame);
+}
+} // namespace Media
+} // namespace OHOS
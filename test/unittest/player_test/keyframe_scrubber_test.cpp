@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "keyframe_scrubber.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr int64_t GOP_MS = 2000;
+    constexpr int32_t PREVIEW_WAIT_MS = 1000;
+    constexpr int32_t IDLE_WAIT_MS = 50; // lets the worker serve a position that needs no preview
+    const std::string GROUP_ID = "KeyFrameScrubberTest";
+}
+
+namespace OHOS {
+namespace Media {
+class KeyFrameScrubberTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void)
+    {
+        scrubber_ = std::make_shared<KeyFrameScrubber>(nullptr,
+            [this](const std::shared_ptr<SeekAgent> &seekAgent, int64_t seekMs, int64_t &keyFramePos) {
+                return Preview(seekMs, keyFramePos);
+            },
+            [this]() { return Capture(); },
+            [this](const sptr<SurfaceBuffer> &frame, int64_t keyFramePos) { return Present(keyFramePos); },
+            GROUP_ID);
+    }
+    void TearDown(void)
+    {
+        scrubber_->Release();
+        scrubber_ = nullptr;
+    }
+
+protected:
+    // every GOP_MS there is a sync sample
+    Status Preview(int64_t seekMs, int64_t &keyFramePos)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        previews_.push_back(seekMs);
+        cond_.notify_all();
+        if (failNextPreview_) {
+            failNextPreview_ = false;
+            return Status::ERROR_UNKNOWN;
+        }
+        keyFramePos = seekMs / GOP_MS * GOP_MS;
+        return Status::OK;
+    }
+
+    sptr<SurfaceBuffer> Capture()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return captureEnabled_ ? SurfaceBuffer::Create() : nullptr;
+    }
+
+    Status Present(int64_t keyFramePos)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        presents_.push_back(keyFramePos);
+        cond_.notify_all();
+        return Status::OK;
+    }
+
+    bool WaitPresentCount(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(PREVIEW_WAIT_MS),
+            [this, count] { return presents_.size() >= count; });
+    }
+
+    std::vector<int64_t> GetPresents()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return presents_;
+    }
+
+    bool WaitPreviewCount(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(PREVIEW_WAIT_MS),
+            [this, count] { return previews_.size() >= count; });
+    }
+
+    std::vector<int64_t> GetPreviews()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return previews_;
+    }
+
+    std::shared_ptr<KeyFrameScrubber> scrubber_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<int64_t> previews_;
+    std::vector<int64_t> presents_;
+    bool failNextPreview_ = false;
+    bool captureEnabled_ = true;
+};
+
+HWTEST_F(KeyFrameScrubberTest, DISPLAYED_GOP_NEEDS_NO_PREVIEW, TestSize.Level1)
+{
+    captureEnabled_ = false;
+    scrubber_->UpdateSeekPos(1000);
+    ASSERT_TRUE(WaitPreviewCount(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_WAIT_MS));
+
+    // 500 lies between the key frame on screen and a position already resolved to it
+    scrubber_->UpdateSeekPos(500);
+    std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_WAIT_MS));
+    scrubber_->UpdateSeekPos(4500);
+    ASSERT_TRUE(WaitPreviewCount(2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_WAIT_MS));
+
+    // without a picture to keep, dragging back to an earlier gop previews it again
+    scrubber_->UpdateSeekPos(500);
+    ASSERT_TRUE(WaitPreviewCount(3));
+    EXPECT_EQ(GetPreviews(), std::vector<int64_t>({1000, 4500, 500}));
+    EXPECT_TRUE(GetPresents().empty());
+}
+
+HWTEST_F(KeyFrameScrubberTest, REVISITED_GOP_IS_SERVED_FROM_CACHE, TestSize.Level1)
+{
+    scrubber_->UpdateSeekPos(1000);
+    ASSERT_TRUE(WaitPreviewCount(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_WAIT_MS));
+    scrubber_->UpdateSeekPos(4500);
+    ASSERT_TRUE(WaitPreviewCount(2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_WAIT_MS));
+    EXPECT_FALSE(scrubber_->IsServedFromCache());
+
+    // both gops were left behind once, going back to either of them only puts the kept picture on screen
+    scrubber_->UpdateSeekPos(500);
+    ASSERT_TRUE(WaitPresentCount(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_WAIT_MS));
+    scrubber_->UpdateSeekPos(4200);
+    ASSERT_TRUE(WaitPresentCount(2));
+    EXPECT_EQ(GetPresents(), std::vector<int64_t>({0, 4000}));
+    EXPECT_EQ(GetPreviews(), std::vector<int64_t>({1000, 4500}));
+    EXPECT_TRUE(scrubber_->IsServedFromCache());
+}
+
+HWTEST_F(KeyFrameScrubberTest, CACHED_FRAMES_ARE_BOUNDED, TestSize.Level1)
+{
+    // more gops are left behind than the cache holds, the first one falls out
+    size_t gopCount = KeyFrameScrubber::MAX_CACHED_FRAME_COUNT + 2;
+    for (size_t i = 0; i < gopCount; i++) {
+        scrubber_->UpdateSeekPos(static_cast<int64_t>(i) * GOP_MS);
+        ASSERT_TRUE(WaitPreviewCount(i + 1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_WAIT_MS));
+    }
+    scrubber_->UpdateSeekPos(0);
+    ASSERT_TRUE(WaitPreviewCount(gopCount + 1));
+    EXPECT_TRUE(GetPresents().empty());
+}
+
+HWTEST_F(KeyFrameScrubberTest, FAILED_PREVIEW_IS_RETRIED, TestSize.Level1)
+{
+    failNextPreview_ = true;
+    scrubber_->UpdateSeekPos(1000);
+    ASSERT_TRUE(WaitPreviewCount(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_WAIT_MS));
+
+    scrubber_->UpdateSeekPos(1000);
+    ASSERT_TRUE(WaitPreviewCount(2));
+    EXPECT_EQ(GetPreviews(), std::vector<int64_t>({1000, 1000}));
+}
+
+HWTEST_F(KeyFrameScrubberTest, NO_PREVIEW_AFTER_RELEASE, TestSize.Level1)
+{
+    scrubber_->Release();
+    scrubber_->UpdateSeekPos(1000);
+    EXPECT_FALSE(WaitPreviewCount(1));
+}
+} // namespace Media
+} // namespace OHOS
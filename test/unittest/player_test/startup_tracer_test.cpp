@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include "gtest/gtest.h"
+#include "startup_tracer.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr int32_t PHASE_SLEEP_MS = 20;
+}
+
+namespace OHOS {
+namespace Media {
+class StartupTracerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void) {};
+    void TearDown(void) {};
+};
+
+HWTEST_F(StartupTracerTest, UNTOUCHED_PHASES_ARE_EMPTY, TestSize.Level1)
+{
+    StartupTracer tracer;
+    std::string dump = tracer.ToString();
+    EXPECT_EQ(dump.find("Startup phases (ms):\n"), 0u);
+    EXPECT_NE(dump.find("  init: -\n"), std::string::npos);
+    EXPECT_NE(dump.find("  first_video_frame: -\n"), std::string::npos);
+
+    // an end without a begin is ignored
+    tracer.EndPhase(StartupPhase::SET_SOURCE);
+    EXPECT_NE(tracer.ToString().find("  set_source: -\n"), std::string::npos);
+}
+
+HWTEST_F(StartupTracerTest, BEGUN_PHASE_IS_RUNNING, TestSize.Level1)
+{
+    StartupTracer tracer;
+    tracer.BeginPhase(StartupPhase::PIPELINE_PREPARE);
+    EXPECT_NE(tracer.ToString().find("  pipeline_prepare: running\n"), std::string::npos);
+
+    tracer.EndPhase(StartupPhase::PIPELINE_PREPARE);
+    std::string dump = tracer.ToString();
+    EXPECT_EQ(dump.find("  pipeline_prepare: running\n"), std::string::npos);
+    EXPECT_EQ(dump.find("  pipeline_prepare: -\n"), std::string::npos);
+}
+
+HWTEST_F(StartupTracerTest, FIRST_OCCURRENCE_IS_KEPT, TestSize.Level1)
+{
+    StartupTracer tracer;
+    {
+        ScopedStartupPhase scoped(tracer, StartupPhase::LINK_AUDIO_DECODER);
+    }
+    EXPECT_NE(tracer.ToString().find("  link_audio_decoder: 0."), std::string::npos);
+
+    // a track switch runs the phase again, which must not overwrite the startup value
+    tracer.BeginPhase(StartupPhase::LINK_AUDIO_DECODER);
+    std::this_thread::sleep_for(std::chrono::milliseconds(PHASE_SLEEP_MS));
+    tracer.EndPhase(StartupPhase::LINK_AUDIO_DECODER);
+    EXPECT_NE(tracer.ToString().find("  link_audio_decoder: 0."), std::string::npos);
+}
+
+HWTEST_F(StartupTracerTest, PHASE_COST_IS_MEASURED, TestSize.Level1)
+{
+    StartupTracer tracer;
+    tracer.BeginPhase(StartupPhase::FIRST_VIDEO_FRAME);
+    std::this_thread::sleep_for(std::chrono::milliseconds(PHASE_SLEEP_MS));
+    tracer.EndPhase(StartupPhase::FIRST_VIDEO_FRAME);
+
+    std::string dump = tracer.ToString();
+    const std::string key = "  first_video_frame: ";
+    size_t pos = dump.find(key);
+    ASSERT_NE(pos, std::string::npos);
+    EXPECT_GE(std::stol(dump.substr(pos + key.size())), PHASE_SLEEP_MS);
+}
+
+HWTEST_F(StartupTracerTest, RESET_CLEARS_ALL_PHASES, TestSize.Level1)
+{
+    StartupTracer tracer;
+    tracer.BeginPhase(StartupPhase::INIT);
+    tracer.EndPhase(StartupPhase::INIT);
+    tracer.BeginPhase(StartupPhase::SET_SOURCE);
+    tracer.Reset();
+
+    std::string dump = tracer.ToString();
+    EXPECT_NE(dump.find("  init: -\n"), std::string::npos);
+    EXPECT_NE(dump.find("  set_source: -\n"), std::string::npos);
+
+    // after a reset the next startup is recorded again
+    tracer.BeginPhase(StartupPhase::INIT);
+    EXPECT_NE(tracer.ToString().find("  init: running\n"), std::string::npos);
+}
+} // namespace Media
+} // namespace OHOS
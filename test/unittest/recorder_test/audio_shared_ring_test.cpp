@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "audio_shared_ring.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr uint32_t TEST_CAPACITY = 256;
+    constexpr uint32_t TEST_CHUNK = 96;
+    constexpr uint32_t TEST_ROUNDS = 20;
+    constexpr int32_t TEST_WAIT_MS = 1000;
+}
+
+namespace OHOS {
+namespace Media {
+class AudioSharedRingTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void)
+    {
+        memory_.assign(AudioSharedRing::GetMemorySize(TEST_CAPACITY) / sizeof(uint64_t), 0);
+    };
+    void TearDown(void) {};
+
+    uint8_t *GetBase()
+    {
+        return reinterpret_cast<uint8_t *>(memory_.data());
+    }
+
+    uint32_t GetSize()
+    {
+        return static_cast<uint32_t>(memory_.size() * sizeof(uint64_t));
+    }
+
+    // uint64_t keeps the block aligned for the atomics of the header
+    std::vector<uint64_t> memory_;
+};
+
+HWTEST_F(AudioSharedRingTest, WRAP_AROUND_KEEPS_ORDER, TestSize.Level1)
+{
+    AudioSharedRing producer(GetBase(), GetSize(), -1, true);
+    AudioSharedRing consumer(GetBase(), GetSize(), -1, false);
+    ASSERT_TRUE(producer.IsValid());
+    ASSERT_TRUE(consumer.IsValid());
+    ASSERT_EQ(consumer.GetCapacity(), TEST_CAPACITY);
+    EXPECT_EQ(consumer.GetPeriodSize(), TEST_CAPACITY / 4); // 4: default when the producer set none
+    producer.SetPeriodSize(TEST_CHUNK);
+    EXPECT_EQ(consumer.GetPeriodSize(), TEST_CHUNK);
+
+    std::vector<uint8_t> chunk(TEST_CHUNK);
+    std::vector<uint8_t> out(TEST_CHUNK);
+    for (uint32_t round = 0; round < TEST_ROUNDS; round++) {
+        for (uint32_t i = 0; i < TEST_CHUNK; i++) {
+            chunk[i] = static_cast<uint8_t>(round * TEST_CHUNK + i);
+        }
+        ASSERT_TRUE(producer.Write(chunk.data(), TEST_CHUNK));
+        ASSERT_EQ(consumer.GetReadableSize(), TEST_CHUNK);
+        ASSERT_EQ(consumer.Read(out.data(), TEST_CHUNK), TEST_CHUNK);
+        ASSERT_EQ(out, chunk);
+    }
+    EXPECT_EQ(consumer.Read(out.data(), TEST_CHUNK), 0u);
+    EXPECT_EQ(producer.GetOverrunCount(), 0u);
+}
+
+HWTEST_F(AudioSharedRingTest, OVERRUN_DROPS_WHOLE_CHUNK, TestSize.Level1)
+{
+    AudioSharedRing ring(GetBase(), GetSize(), -1, true);
+    std::vector<uint8_t> chunk(TEST_CHUNK, 1);
+    ASSERT_TRUE(ring.Write(chunk.data(), TEST_CHUNK));
+    ASSERT_TRUE(ring.Write(chunk.data(), TEST_CHUNK));
+    // 64 bytes are left, the third chunk does not fit and nothing of it is written
+    EXPECT_FALSE(ring.Write(chunk.data(), TEST_CHUNK));
+    EXPECT_EQ(ring.GetReadableSize(), TEST_CHUNK * 2); // 2: chunks written
+    EXPECT_EQ(ring.GetOverrunCount(), 1u);
+    EXPECT_EQ(ring.GetOverrunBytes(), TEST_CHUNK);
+
+    std::vector<uint8_t> out(TEST_CAPACITY);
+    EXPECT_EQ(ring.Read(out.data(), TEST_CAPACITY), TEST_CHUNK * 2); // 2: chunks written
+    EXPECT_TRUE(ring.Write(chunk.data(), TEST_CHUNK));
+}
+
+HWTEST_F(AudioSharedRingTest, REJECTS_BAD_HEADER, TestSize.Level1)
+{
+    AudioSharedRing unset(GetBase(), GetSize(), -1, false);
+    EXPECT_FALSE(unset.IsValid());
+    {
+        AudioSharedRing owner(GetBase(), GetSize(), -1, true);
+        ASSERT_TRUE(owner.IsValid());
+    }
+    // a header claiming more than the mapping holds is refused
+    AudioSharedRing smaller(GetBase(), GetSize() - TEST_CAPACITY / 2, -1, false); // 2: half the data area
+    EXPECT_FALSE(smaller.IsValid());
+    AudioSharedRing tooSmall(GetBase(), 16, -1, true); // 16: less than the header
+    EXPECT_FALSE(tooSmall.IsValid());
+    EXPECT_FALSE(tooSmall.Write(GetBase(), 1));
+}
+
+HWTEST_F(AudioSharedRingTest, WAIT_IS_WOKEN_BY_PRODUCER, TestSize.Level1)
+{
+    int32_t eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    ASSERT_GE(eventFd, 0);
+    AudioSharedRing producer(GetBase(), GetSize(), -1, true);
+    // both sides share one eventfd as they would after it crossed the binder
+    AudioSharedRing consumer(GetBase(), GetSize(), eventFd, false);
+    AudioSharedRing producerWithFd(GetBase(), GetSize(), dup(eventFd), false);
+    EXPECT_FALSE(consumer.WaitReadable(TEST_CHUNK, 10)); // 10: short timeout, nothing written
+
+    std::thread writer([&producerWithFd]() {
+        std::vector<uint8_t> chunk(TEST_CHUNK / 2, 1); // 2: the wait needs two writes
+        for (int32_t i = 0; i < 2; i++) { // 2: writes
+            std::this_thread::sleep_for(std::chrono::milliseconds(5)); // 5: let the consumer block
+            producerWithFd.Write(chunk.data(), static_cast<uint32_t>(chunk.size()));
+        }
+    });
+    EXPECT_TRUE(consumer.WaitReadable(TEST_CHUNK, TEST_WAIT_MS));
+    writer.join();
+
+    std::thread closer([&producerWithFd]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5)); // 5: let the consumer block
+        producerWithFd.Close();
+    });
+    EXPECT_FALSE(consumer.WaitReadable(TEST_CHUNK * 2, TEST_WAIT_MS)); // 2: more than is left
+    closer.join();
+    EXPECT_TRUE(consumer.IsClosed());
+    EXPECT_EQ(producer.GetReadableSize(), TEST_CHUNK);
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "file_split_controller.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr int64_t START_MS = 1000;
+    constexpr int64_t SEGMENT_MS = 500;
+}
+
+namespace OHOS {
+namespace Media {
+class FileSplitControllerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void) {};
+    void TearDown(void) {};
+
+    static int32_t OpenFd()
+    {
+        return open("/dev/null", O_WRONLY);
+    }
+
+    static bool IsOpen(int32_t fd)
+    {
+        return fcntl(fd, F_GETFD) != -1;
+    }
+};
+
+HWTEST_F(FileSplitControllerTest, ONE_SHOT_SPLIT, TestSize.Level1)
+{
+    FileSplitController controller;
+    int32_t nextFd = OpenFd();
+    ASSERT_GE(nextFd, 0);
+    controller.AddNextFd(nextFd);
+    int32_t fd = -1;
+    EXPECT_EQ(controller.Poll(START_MS, fd), FileSplitAction::NONE);
+    EXPECT_EQ(controller.GetDelayMs(START_MS), -1);
+
+    ASSERT_TRUE(controller.Arm(START_MS, SEGMENT_MS, 0));
+    EXPECT_EQ(controller.GetDelayMs(START_MS + 100), SEGMENT_MS - 100); // 100: elapsed ms
+    EXPECT_EQ(controller.Poll(START_MS + SEGMENT_MS - 1, fd), FileSplitAction::NONE);
+    EXPECT_EQ(controller.Poll(START_MS + SEGMENT_MS, fd), FileSplitAction::SWITCH);
+    EXPECT_EQ(fd, nextFd);
+    EXPECT_FALSE(controller.IsArmed());
+    EXPECT_EQ(controller.GetNextFdCount(), 0);
+    (void)close(fd);
+}
+
+HWTEST_F(FileSplitControllerTest, PERIODIC_SPLIT_KEEPS_CADENCE, TestSize.Level1)
+{
+    FileSplitController controller;
+    ASSERT_TRUE(controller.Arm(START_MS, SEGMENT_MS, SEGMENT_MS));
+    int32_t fds[3] = { OpenFd(), OpenFd(), OpenFd() }; // 3: segments after the first file
+    for (int32_t nextFd : fds) {
+        controller.AddNextFd(nextFd);
+    }
+    int32_t fd = -1;
+    for (int32_t index = 0; index < 3; index++) { // 3: one boundary per file
+        // a check that runs late still leaves the next boundary on the original grid
+        int64_t nowMs = START_MS + SEGMENT_MS * (index + 1) + 20; // 20: late check
+        ASSERT_EQ(controller.Poll(nowMs, fd), FileSplitAction::SWITCH);
+        EXPECT_EQ(fd, fds[index]);
+        EXPECT_EQ(controller.GetDelayMs(nowMs), SEGMENT_MS - 20); // 20: late check
+        (void)close(fd);
+    }
+    EXPECT_TRUE(controller.IsArmed());
+}
+
+HWTEST_F(FileSplitControllerTest, MISSING_NEXT_FD, TestSize.Level1)
+{
+    FileSplitController controller;
+    ASSERT_TRUE(controller.Arm(START_MS, 0, SEGMENT_MS));
+    int32_t fd = -1;
+    EXPECT_EQ(controller.Poll(START_MS, fd), FileSplitAction::NO_NEXT_FD);
+    // reported once, the boundary stays due until a file arrives
+    EXPECT_EQ(controller.Poll(START_MS + 10, fd), FileSplitAction::NONE); // 10: later check
+    EXPECT_EQ(controller.GetDelayMs(START_MS + 10), 0); // 10: later check
+
+    int32_t nextFd = OpenFd();
+    controller.AddNextFd(nextFd);
+    int64_t lateMs = START_MS + SEGMENT_MS * 3; // 3: file arrived after several segments
+    ASSERT_EQ(controller.Poll(lateMs, fd), FileSplitAction::SWITCH);
+    EXPECT_EQ(fd, nextFd);
+    // the late segment still gets a full period
+    EXPECT_EQ(controller.GetDelayMs(lateMs), SEGMENT_MS);
+    (void)close(fd);
+}
+
+HWTEST_F(FileSplitControllerTest, PAUSE_MOVES_BOUNDARY, TestSize.Level1)
+{
+    FileSplitController controller;
+    controller.AddNextFd(OpenFd());
+    ASSERT_TRUE(controller.Arm(START_MS, SEGMENT_MS, 0));
+    controller.Pause(START_MS + 100); // 100: recorded before the pause
+    int32_t fd = -1;
+    EXPECT_EQ(controller.GetDelayMs(START_MS + SEGMENT_MS), -1);
+    EXPECT_EQ(controller.Poll(START_MS + SEGMENT_MS, fd), FileSplitAction::NONE);
+    int64_t resumeMs = START_MS + 2000; // 2000: paused for a while
+    controller.Resume(resumeMs);
+    EXPECT_EQ(controller.GetDelayMs(resumeMs), SEGMENT_MS - 100); // 100: recorded before the pause
+    EXPECT_EQ(controller.Poll(resumeMs + SEGMENT_MS - 100, fd), FileSplitAction::SWITCH); // 100: as above
+    (void)close(fd);
+}
+
+HWTEST_F(FileSplitControllerTest, RESET_CLOSES_PENDING_FDS, TestSize.Level1)
+{
+    int32_t nextFd = OpenFd();
+    {
+        FileSplitController controller;
+        controller.AddNextFd(nextFd);
+        controller.AddNextFd(-1);
+        EXPECT_EQ(controller.GetNextFdCount(), 1);
+        EXPECT_FALSE(controller.Arm(START_MS, -1, 0));
+        ASSERT_TRUE(controller.Arm(START_MS, SEGMENT_MS, SEGMENT_MS));
+        controller.Reset();
+        EXPECT_FALSE(controller.IsArmed());
+        EXPECT_EQ(controller.GetNextFdCount(), 0);
+        EXPECT_FALSE(IsOpen(nextFd));
+    }
+    int32_t ownedFd = OpenFd();
+    {
+        FileSplitController controller;
+        controller.AddNextFd(ownedFd);
+    }
+    EXPECT_FALSE(IsOpen(ownedFd));
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "mp4_fragment_scanner.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr uint32_t BOX_HEADER_SIZE = 8;
+    constexpr uint32_t FRAGMENT_COUNT = 3;
+    constexpr size_t MDAT_PAYLOAD_SIZE = 100;
+}
+
+namespace OHOS {
+namespace Media {
+class Mp4FragmentScannerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void) {};
+    void TearDown(void) {};
+
+    static void AppendUint32(std::vector<uint8_t> &data, uint32_t value)
+    {
+        for (int32_t shift = 24; shift >= 0; shift -= 8) { // 24, 8: big endian bytes
+            data.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    static std::vector<uint8_t> MakeBox(const char *type, const std::vector<uint8_t> &payload)
+    {
+        std::vector<uint8_t> box;
+        AppendUint32(box, static_cast<uint32_t>(BOX_HEADER_SIZE + payload.size()));
+        box.insert(box.end(), type, type + 4); // 4: fourcc
+        box.insert(box.end(), payload.begin(), payload.end());
+        return box;
+    }
+
+    static std::vector<uint8_t> MakeLargeBox(const char *type, const std::vector<uint8_t> &payload)
+    {
+        std::vector<uint8_t> box;
+        AppendUint32(box, 1);
+        box.insert(box.end(), type, type + 4); // 4: fourcc
+        uint64_t size = 16 + payload.size(); // 16: header with 64 bit size
+        AppendUint32(box, static_cast<uint32_t>(size >> 32)); // 32: high word
+        AppendUint32(box, static_cast<uint32_t>(size));
+        box.insert(box.end(), payload.begin(), payload.end());
+        return box;
+    }
+
+    static void Append(std::vector<uint8_t> &data, const std::vector<uint8_t> &box)
+    {
+        data.insert(data.end(), box.begin(), box.end());
+    }
+
+    static std::vector<uint8_t> MakeInitSegment(bool isFragmented)
+    {
+        std::vector<uint8_t> file = MakeBox("ftyp", std::vector<uint8_t>(16, 0)); // 16: brands
+        std::vector<uint8_t> moov = MakeBox("mvhd", std::vector<uint8_t>(100, 0)); // 100: version 0 mvhd
+        if (isFragmented) {
+            Append(moov, MakeBox("mvex", MakeBox("trex", std::vector<uint8_t>(24, 0)))); // 24: trex body
+        }
+        Append(file, MakeBox("moov", moov));
+        return file;
+    }
+
+    static std::vector<uint8_t> MakeFragment(bool isLargeMdat)
+    {
+        std::vector<uint8_t> fragment = MakeBox("moof", MakeBox("mfhd", std::vector<uint8_t>(8, 0))); // 8: mfhd
+        std::vector<uint8_t> payload(MDAT_PAYLOAD_SIZE, 0x5a); // 0x5a: sample bytes
+        Append(fragment, isLargeMdat ? MakeLargeBox("mdat", payload) : MakeBox("mdat", payload));
+        return fragment;
+    }
+
+    static Mp4FragmentScanner::ReadFunc MakeReader(const std::vector<uint8_t> &data)
+    {
+        return [&data](uint64_t offset, uint8_t *buffer, size_t size) {
+            if (offset > data.size() || data.size() - offset < size) {
+                return false;
+            }
+            (void)memcpy(buffer, data.data() + offset, size);
+            return true;
+        };
+    }
+};
+
+HWTEST_F(Mp4FragmentScannerTest, SCAN_COMPLETE_FILE, TestSize.Level1)
+{
+    std::vector<uint8_t> file = MakeInitSegment(true);
+    uint64_t initEnd = file.size();
+    for (uint32_t index = 0; index < FRAGMENT_COUNT; index++) {
+        Append(file, MakeFragment(false));
+    }
+    Mp4FragmentLayout layout;
+    ASSERT_TRUE(Mp4FragmentScanner::Scan(MakeReader(file), file.size(), layout));
+    EXPECT_EQ(layout.initSegmentEnd, initEnd);
+    ASSERT_EQ(layout.fragments.size(), FRAGMENT_COUNT);
+    EXPECT_EQ(layout.fragments[0].first, initEnd);
+    EXPECT_EQ(layout.playableSize, file.size());
+}
+
+HWTEST_F(Mp4FragmentScannerTest, SCAN_INTERRUPTED_FILE, TestSize.Level1)
+{
+    std::vector<uint8_t> file = MakeInitSegment(true);
+    for (uint32_t index = 0; index < FRAGMENT_COUNT - 1; index++) {
+        Append(file, MakeFragment(false));
+    }
+    uint64_t completeEnd = file.size();
+    Append(file, MakeFragment(false));
+    file.resize(file.size() - MDAT_PAYLOAD_SIZE / 2); // 2: cut in the middle of the last mdat
+
+    Mp4FragmentLayout layout;
+    ASSERT_TRUE(Mp4FragmentScanner::Scan(MakeReader(file), file.size(), layout));
+    EXPECT_EQ(layout.fragments.size(), FRAGMENT_COUNT - 1);
+    EXPECT_EQ(layout.playableSize, completeEnd);
+
+    // a moof without its mdat is not playable either
+    file.resize(completeEnd + BOX_HEADER_SIZE * 4); // 4: moof and mfhd headers plus mfhd body
+    ASSERT_TRUE(Mp4FragmentScanner::Scan(MakeReader(file), file.size(), layout));
+    EXPECT_EQ(layout.playableSize, completeEnd);
+}
+
+HWTEST_F(Mp4FragmentScannerTest, SCAN_LARGE_SIZE_BOX, TestSize.Level1)
+{
+    std::vector<uint8_t> file = MakeInitSegment(true);
+    Append(file, MakeFragment(true));
+    Append(file, MakeFragment(false));
+    Mp4FragmentLayout layout;
+    ASSERT_TRUE(Mp4FragmentScanner::Scan(MakeReader(file), file.size(), layout));
+    EXPECT_EQ(layout.fragments.size(), 2); // 2: both fragments found
+    EXPECT_EQ(layout.playableSize, file.size());
+}
+
+HWTEST_F(Mp4FragmentScannerTest, SCAN_NOT_FRAGMENTED, TestSize.Level1)
+{
+    std::vector<uint8_t> file = MakeInitSegment(false);
+    Append(file, MakeBox("mdat", std::vector<uint8_t>(MDAT_PAYLOAD_SIZE, 0)));
+    Mp4FragmentLayout layout;
+    EXPECT_FALSE(Mp4FragmentScanner::Scan(MakeReader(file), file.size(), layout));
+    EXPECT_TRUE(layout.fragments.empty());
+
+    std::vector<uint8_t> empty;
+    EXPECT_FALSE(Mp4FragmentScanner::Scan(MakeReader(empty), empty.size(), layout));
+}
+
+HWTEST_F(Mp4FragmentScannerTest, SCAN_OPEN_ENDED_MDAT, TestSize.Level1)
+{
+    std::vector<uint8_t> file = MakeInitSegment(true);
+    Append(file, MakeFragment(false));
+    uint64_t completeEnd = file.size();
+    // the muxer was killed before it patched the size of the last mdat, its length is unknown
+    std::vector<uint8_t> fragment = MakeFragment(false);
+    size_t mdatOffset = fragment.size() - BOX_HEADER_SIZE - MDAT_PAYLOAD_SIZE;
+    (void)memset(fragment.data() + mdatOffset, 0, sizeof(uint32_t));
+    Append(file, fragment);
+
+    Mp4FragmentLayout layout;
+    ASSERT_TRUE(Mp4FragmentScanner::Scan(MakeReader(file), file.size(), layout));
+    EXPECT_EQ(layout.fragments.size(), 1);
+    EXPECT_EQ(layout.playableSize, completeEnd);
+}
+
+HWTEST_F(Mp4FragmentScannerTest, TRIM_TO_PLAYABLE, TestSize.Level1)
+{
+    std::vector<uint8_t> file = MakeInitSegment(true);
+    Append(file, MakeFragment(false));
+    uint64_t completeEnd = file.size();
+    Append(file, MakeFragment(false));
+    file.resize(file.size() - 1);
+
+    FILE *tmpFile = tmpfile();
+    ASSERT_NE(tmpFile, nullptr);
+    int32_t fd = fileno(tmpFile);
+    ASSERT_EQ(write(fd, file.data(), file.size()), static_cast<ssize_t>(file.size()));
+    EXPECT_EQ(Mp4FragmentScanner::TrimToPlayable(fd), static_cast<int64_t>(file.size() - completeEnd));
+    struct stat fileStat;
+    ASSERT_EQ(fstat(fd, &fileStat), 0);
+    EXPECT_EQ(static_cast<uint64_t>(fileStat.st_size), completeEnd);
+    // a file that is already complete is left alone
+    EXPECT_EQ(Mp4FragmentScanner::TrimToPlayable(fd), 0);
+    (void)fclose(tmpFile);
+    EXPECT_EQ(Mp4FragmentScanner::TrimToPlayable(-1), -1);
+}
+
+HWTEST_F(Mp4FragmentScannerTest, TRIM_WRITE_ONLY_FD, TestSize.Level1)
+{
+    std::vector<uint8_t> file = MakeInitSegment(true);
+    Append(file, MakeFragment(false));
+    uint64_t completeEnd = file.size();
+    Append(file, MakeFragment(false));
+    file.resize(file.size() - 1);
+
+    FILE *tmpFile = tmpfile();
+    ASSERT_NE(tmpFile, nullptr);
+    ASSERT_EQ(write(fileno(tmpFile), file.data(), file.size()), static_cast<ssize_t>(file.size()));
+    // the recorder gets its output file opened for writing only
+    std::string path = "/proc/self/fd/" + std::to_string(fileno(tmpFile));
+    int32_t fd = open(path.c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    EXPECT_EQ(Mp4FragmentScanner::TrimToPlayable(fd), static_cast<int64_t>(file.size() - completeEnd));
+    struct stat fileStat;
+    ASSERT_EQ(fstat(fd, &fileStat), 0);
+    EXPECT_EQ(static_cast<uint64_t>(fileStat.st_size), completeEnd);
+    (void)close(fd);
+    (void)fclose(tmpFile);
+}
+} // namespace Media
+} // namespace OHOS
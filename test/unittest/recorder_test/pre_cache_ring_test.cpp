@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+#include "pre_cache_ring.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr int32_t VIDEO_TRACK = 0;
+    constexpr int32_t AUDIO_TRACK = 1;
+    constexpr int64_t FRAME_US = 100000;
+    constexpr int32_t GOP_FRAMES = 5;
+    constexpr size_t FRAME_SIZE = 100;
+    constexpr uint64_t NO_BYTE_LIMIT = 1024 * 1024;
+}
+
+namespace OHOS {
+namespace Media {
+class PreCacheRingTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void) {};
+    void TearDown(void) {};
+
+    // pushes video frames from firstFrame on, every GOP_FRAMES-th one is a key frame
+    static void PushVideo(PreCacheRing &ring, int32_t firstFrame, int32_t count)
+    {
+        std::vector<uint8_t> frame(FRAME_SIZE, 0);
+        for (int32_t index = firstFrame; index < firstFrame + count; index++) {
+            ring.Push(VIDEO_TRACK, index * FRAME_US, index % GOP_FRAMES == 0, frame.data(), frame.size(), 0);
+        }
+    }
+};
+
+HWTEST_F(PreCacheRingTest, STARTS_AT_KEY_FRAME, TestSize.Level1)
+{
+    PreCacheRing ring(10 * FRAME_US, NO_BYTE_LIMIT); // 10: frames
+    ring.SetAnchorTrack(VIDEO_TRACK);
+    PushVideo(ring, 3, 4); // 3, 4: two frames before the first key frame, then 5 and 6
+    ASSERT_EQ(ring.GetSampleCount(), 2);
+    std::vector<std::shared_ptr<const PreCacheSample>> samples;
+    ASSERT_TRUE(ring.Collect(FRAME_US, samples));
+    ASSERT_EQ(samples.size(), 2);
+    EXPECT_TRUE(samples[0]->isKeyFrame);
+    EXPECT_EQ(samples[0]->ptsUs, 5 * FRAME_US); // 5: first key frame
+}
+
+HWTEST_F(PreCacheRingTest, DURATION_DROPS_WHOLE_GOPS, TestSize.Level1)
+{
+    PreCacheRing ring(7 * FRAME_US, NO_BYTE_LIMIT); // 7: frames, between one and two GOPs
+    ring.SetAnchorTrack(VIDEO_TRACK);
+    PushVideo(ring, 0, 30); // 30: six GOPs
+    // at least the configured duration is kept, and never more than one extra GOP
+    EXPECT_GE(ring.GetDurationUs(), 7 * FRAME_US); // 7: configured frames
+    EXPECT_LT(ring.GetDurationUs(), (7 + GOP_FRAMES) * FRAME_US); // 7: configured frames
+    std::vector<std::shared_ptr<const PreCacheSample>> samples;
+    ASSERT_TRUE(ring.Collect(100 * FRAME_US, samples)); // 100: more than is held
+    ASSERT_FALSE(samples.empty());
+    EXPECT_TRUE(samples[0]->isKeyFrame);
+    EXPECT_EQ(samples.size(), ring.GetSampleCount());
+}
+
+HWTEST_F(PreCacheRingTest, BYTE_LIMIT_IS_HARD, TestSize.Level1)
+{
+    uint64_t maxBytes = FRAME_SIZE * 8; // 8: less than two GOPs
+    PreCacheRing ring(100 * FRAME_US, maxBytes); // 100: duration never binds
+    ring.SetAnchorTrack(VIDEO_TRACK);
+    for (int32_t gop = 0; gop < 4; gop++) { // 4: GOPs pushed
+        PushVideo(ring, gop * GOP_FRAMES, GOP_FRAMES);
+        EXPECT_LE(ring.GetBytes(), maxBytes);
+    }
+    std::vector<std::shared_ptr<const PreCacheSample>> samples;
+    ASSERT_TRUE(ring.Collect(100 * FRAME_US, samples)); // 100: everything held
+    EXPECT_TRUE(samples[0]->isKeyFrame);
+    EXPECT_EQ(samples[0]->ptsUs, 3 * GOP_FRAMES * FRAME_US); // 3: only the last GOP fits
+}
+
+HWTEST_F(PreCacheRingTest, COLLECT_STARTS_AT_LAST_KEY_FRAME_BEFORE_TARGET, TestSize.Level1)
+{
+    PreCacheRing ring(100 * FRAME_US, NO_BYTE_LIMIT); // 100: nothing is dropped
+    ring.SetAnchorTrack(VIDEO_TRACK);
+    PushVideo(ring, 0, 20); // 20: frames 0..19, key frames at 0, 5, 10 and 15
+    std::vector<std::shared_ptr<const PreCacheSample>> samples;
+    // newest is 19, 7 frames back is 12, so the save begins at key frame 10
+    ASSERT_TRUE(ring.Collect(7 * FRAME_US, samples)); // 7: frames requested
+    EXPECT_EQ(samples[0]->ptsUs, 10 * FRAME_US); // 10: key frame at or before the target
+    EXPECT_EQ(samples.size(), 10); // 10: frames 10..19
+    // shorter than a GOP still yields a decodable start
+    ASSERT_TRUE(ring.Collect(FRAME_US, samples));
+    EXPECT_EQ(samples[0]->ptsUs, 15 * FRAME_US); // 15: last key frame
+}
+
+HWTEST_F(PreCacheRingTest, CODEC_CONFIG_COMES_FIRST, TestSize.Level1)
+{
+    PreCacheRing ring(2 * FRAME_US, NO_BYTE_LIMIT); // 2: frames
+    ring.SetAnchorTrack(VIDEO_TRACK);
+    std::vector<uint8_t> config = { 1, 2, 3 };
+    ring.SetCodecConfig(VIDEO_TRACK, config.data(), config.size(), 1);
+    ring.SetCodecConfig(AUDIO_TRACK, config.data(), config.size(), 1);
+    PushVideo(ring, 0, 30); // 30: enough to evict the early samples
+    std::vector<std::shared_ptr<const PreCacheSample>> samples;
+    ASSERT_TRUE(ring.Collect(FRAME_US, samples));
+    ASSERT_GE(samples.size(), 3); // 3: two configs and at least one frame
+    EXPECT_EQ(samples[0]->trackId, VIDEO_TRACK);
+    EXPECT_EQ(samples[0]->data, config);
+    EXPECT_EQ(samples[1]->trackId, AUDIO_TRACK);
+    EXPECT_TRUE(samples[2]->isKeyFrame); // 2: first frame after the configs
+    ring.Clear();
+    EXPECT_FALSE(ring.Collect(FRAME_US, samples));
+    EXPECT_EQ(ring.GetBytes(), 0);
+}
+
+HWTEST_F(PreCacheRingTest, AUDIO_ONLY_AND_MIXED, TestSize.Level1)
+{
+    std::vector<uint8_t> frame(FRAME_SIZE, 0);
+    PreCacheRing audioRing(5 * FRAME_US, NO_BYTE_LIMIT); // 5: frames
+    for (int32_t index = 0; index < 20; index++) { // 20: frames pushed
+        audioRing.Push(AUDIO_TRACK, index * FRAME_US, false, frame.data(), frame.size(), 0);
+    }
+    // without a video track every sample can start a file, the trim is exact
+    EXPECT_EQ(audioRing.GetDurationUs(), 5 * FRAME_US); // 5: configured frames
+    std::vector<std::shared_ptr<const PreCacheSample>> samples;
+    ASSERT_TRUE(audioRing.Collect(2 * FRAME_US, samples)); // 2: frames requested
+    EXPECT_EQ(samples.size(), 3); // 3: frames 17..19
+
+    PreCacheRing mixedRing(100 * FRAME_US, NO_BYTE_LIMIT); // 100: nothing is dropped
+    mixedRing.SetAnchorTrack(VIDEO_TRACK);
+    mixedRing.Push(AUDIO_TRACK, 0, false, frame.data(), frame.size(), 0);
+    EXPECT_EQ(mixedRing.GetSampleCount(), 0);
+    PushVideo(mixedRing, 0, 1);
+    mixedRing.Push(AUDIO_TRACK, FRAME_US, false, frame.data(), frame.size(), 0);
+    EXPECT_EQ(mixedRing.GetSampleCount(), 2); // 2: key frame and the audio after it
+}
+
+HWTEST_F(PreCacheRingTest, PUSH_CREATED_SAMPLE, TestSize.Level1)
+{
+    std::vector<uint8_t> frame(FRAME_SIZE, 7); // 7: payload byte
+    EXPECT_EQ(PreCacheRing::CreateSample(VIDEO_TRACK, 0, true, nullptr, 0, 0), nullptr);
+    auto keyFrame = PreCacheRing::CreateSample(VIDEO_TRACK, 0, true, frame.data(), frame.size(), 0);
+    ASSERT_NE(keyFrame, nullptr);
+    EXPECT_EQ(keyFrame->data, frame);
+
+    PreCacheRing ring(10 * FRAME_US, FRAME_SIZE * 2); // 10: frames, 2: frames that fit the byte limit
+    ring.SetAnchorTrack(VIDEO_TRACK);
+    ring.Push(PreCacheRing::CreateSample(VIDEO_TRACK, -FRAME_US, false, frame.data(), frame.size(), 0));
+    EXPECT_EQ(ring.GetSampleCount(), 0);
+    ring.Push(keyFrame);
+    std::vector<uint8_t> tooLarge(FRAME_SIZE * 3, 0); // 3: above the byte limit
+    ring.Push(PreCacheRing::CreateSample(VIDEO_TRACK, FRAME_US, false, tooLarge.data(), tooLarge.size(), 0));
+    ASSERT_EQ(ring.GetSampleCount(), 1);
+    std::vector<std::shared_ptr<const PreCacheSample>> samples;
+    ASSERT_TRUE(ring.Collect(FRAME_US, samples));
+    // the ring keeps the sample it was handed, no second copy is made
+    EXPECT_EQ(samples[0], keyFrame);
+}
+} // namespace Media
+} // namespace OHOS
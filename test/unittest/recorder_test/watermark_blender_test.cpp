@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <climits>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "watermark_blender.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr int32_t RGBA_PIXEL_SIZE = 4;
+    constexpr int32_t FRAME_WIDTH = 64;
+    constexpr int32_t FRAME_HEIGHT = 48;
+    constexpr int32_t FRAME_STRIDE = FRAME_WIDTH * RGBA_PIXEL_SIZE + 32;
+    constexpr uint8_t FRAME_VALUE = 10;
+    constexpr uint8_t BLACK_Y = 16;
+    constexpr uint8_t WHITE_Y = 235;
+    constexpr uint8_t NEUTRAL_UV = 128;
+}
+
+namespace OHOS {
+namespace Media {
+class WatermarkBlenderTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void) {};
+    void TearDown(void) {};
+
+    static std::vector<uint8_t> CreateWatermark(int32_t width, int32_t height, uint8_t value, uint8_t alpha)
+    {
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * RGBA_PIXEL_SIZE, value);
+        for (size_t index = 3; index < pixels.size(); index += RGBA_PIXEL_SIZE) { // 3: alpha channel
+            pixels[index] = alpha;
+        }
+        return pixels;
+    }
+
+    static uint8_t ReferenceBlend(uint8_t dst, uint8_t src, uint8_t alpha)
+    {
+        uint32_t value = src * alpha + dst * (255 - alpha); // 255: opaque
+        return static_cast<uint8_t>((value + 127) / 255); // 127, 255: rounded division
+    }
+};
+
+HWTEST_F(WatermarkBlenderTest, BLEND_ROW_MATCHES_REFERENCE, TestSize.Level1)
+{
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int32_t> byte(0, 255); // 255: max byte
+    // lengths around the vector width so both the simd body and the scalar tail are covered
+    for (int32_t count : { 1, 15, 16, 17, 33, 100 }) {
+        std::vector<uint8_t> dst(count);
+        std::vector<uint8_t> src(count);
+        std::vector<uint8_t> alpha(count);
+        for (int32_t index = 0; index < count; index++) {
+            dst[index] = static_cast<uint8_t>(byte(random));
+            src[index] = static_cast<uint8_t>(byte(random));
+            alpha[index] = static_cast<uint8_t>(byte(random));
+        }
+        alpha[0] = 0;
+        alpha[count - 1] = 255; // 255: opaque
+        std::vector<uint8_t> expected(count);
+        for (int32_t index = 0; index < count; index++) {
+            expected[index] = ReferenceBlend(dst[index], src[index], alpha[index]);
+        }
+        WatermarkBlender::BlendRow(dst.data(), src.data(), alpha.data(), count);
+        EXPECT_EQ(dst, expected) << "count " << count;
+    }
+}
+
+HWTEST_F(WatermarkBlenderTest, INVALID_WATERMARK, TestSize.Level1)
+{
+    WatermarkBlender blender;
+    std::vector<uint8_t> pixels = CreateWatermark(4, 4, 255, 255); // 4, 255: small opaque white
+    EXPECT_FALSE(blender.SetWatermark(nullptr, 16, 4, 4, { 0, 0, 4, 4 })); // 16, 4: stride and size
+    EXPECT_FALSE(blender.SetWatermark(pixels.data(), 8, 4, 4, { 0, 0, 4, 4 })); // 8: stride shorter than a row
+    EXPECT_FALSE(blender.SetWatermark(pixels.data(), 16, 4, 4, { -1, 0, 4, 4 })); // 16, -1: negative position
+    EXPECT_FALSE(blender.SetWatermark(pixels.data(), 16, 4, 4, { 0, 0, 0, 4 })); // 16: empty width
+    EXPECT_FALSE(blender.SetWatermark(pixels.data(), 16, 4, 4, { 0, 0, 5, 4 })); // 5: wider than the image
+    EXPECT_FALSE(blender.SetWatermark(pixels.data(), 16, 4, 4, { 0, 0, 4, 5 })); // 5: taller than the image
+    // a row of INT32_MAX / 2 pixels is negative once counted in bytes, it must not pass as a short row
+    EXPECT_FALSE(blender.SetWatermark(pixels.data(), 16, INT32_MAX / 2, 4, // 2, 4: overflowing width
+        { 0, 0, INT32_MAX / 2, 4 }));
+    EXPECT_FALSE(blender.SetWatermark(pixels.data(), 16, 4, 4, { INT32_MAX - 2, 0, 4, 4 })); // 2: past INT32_MAX
+    EXPECT_FALSE(blender.IsEnabled());
+    EXPECT_TRUE(blender.SetWatermark(pixels.data(), 16, 4, 4, { 0, 0, 4, 4 })); // 16, 4: stride and size
+    EXPECT_TRUE(blender.IsEnabled());
+    blender.Reset();
+    EXPECT_FALSE(blender.IsEnabled());
+}
+
+HWTEST_F(WatermarkBlenderTest, BLEND_RGBA_ONLY_COVERED_RECT, TestSize.Level1)
+{
+    WatermarkRect rect = { 5, 7, 20, 9 }; // 5, 7, 20, 9: odd sized rect
+    std::vector<uint8_t> pixels = CreateWatermark(rect.width, rect.height, 200, 128); // 200, 128: half alpha
+    WatermarkBlender blender;
+    ASSERT_TRUE(blender.SetWatermark(pixels.data(), rect.width * RGBA_PIXEL_SIZE, rect.width, rect.height, rect));
+
+    std::vector<uint8_t> frame(static_cast<size_t>(FRAME_STRIDE) * FRAME_HEIGHT, FRAME_VALUE);
+    blender.BlendRgba(frame.data(), FRAME_STRIDE, FRAME_WIDTH, FRAME_HEIGHT);
+    uint8_t blended = ReferenceBlend(FRAME_VALUE, 200, 128); // 200, 128: watermark color and alpha
+    for (int32_t y = 0; y < FRAME_HEIGHT; y++) {
+        for (int32_t x = 0; x < FRAME_STRIDE; x++) {
+            bool isCovered = y >= rect.top && y < rect.top + rect.height && x >= rect.left * RGBA_PIXEL_SIZE &&
+                x < (rect.left + rect.width) * RGBA_PIXEL_SIZE && x % RGBA_PIXEL_SIZE != 3; // 3: alpha is kept
+            ASSERT_EQ(frame[static_cast<size_t>(y) * FRAME_STRIDE + x], isCovered ? blended : FRAME_VALUE)
+                << "x " << x << " y " << y;
+        }
+    }
+}
+
+HWTEST_F(WatermarkBlenderTest, BLEND_CLIPPED_AT_FRAME_EDGE, TestSize.Level1)
+{
+    WatermarkRect rect = { FRAME_WIDTH - 3, FRAME_HEIGHT - 2, 8, 8 }; // 3, 2, 8: partly outside the frame
+    std::vector<uint8_t> pixels = CreateWatermark(rect.width, rect.height, 255, 255); // 255: opaque white
+    WatermarkBlender blender;
+    ASSERT_TRUE(blender.SetWatermark(pixels.data(), rect.width * RGBA_PIXEL_SIZE, rect.width, rect.height, rect));
+
+    std::vector<uint8_t> frame(static_cast<size_t>(FRAME_STRIDE) * FRAME_HEIGHT, FRAME_VALUE);
+    blender.BlendRgba(frame.data(), FRAME_STRIDE, FRAME_WIDTH, FRAME_HEIGHT);
+    EXPECT_EQ(frame[static_cast<size_t>(FRAME_HEIGHT - 1) * FRAME_STRIDE + (FRAME_WIDTH - 1) * RGBA_PIXEL_SIZE], 255);
+    // the stride padding after the last pixel is not written
+    EXPECT_EQ(frame[static_cast<size_t>(FRAME_HEIGHT - 1) * FRAME_STRIDE + FRAME_WIDTH * RGBA_PIXEL_SIZE],
+        FRAME_VALUE);
+
+    std::vector<uint8_t> yPlane(static_cast<size_t>(FRAME_WIDTH) * FRAME_HEIGHT, BLACK_Y);
+    std::vector<uint8_t> uvPlane(static_cast<size_t>(FRAME_WIDTH) * FRAME_HEIGHT / 2, NEUTRAL_UV); // 2: subsampled
+    blender.BlendNv12(yPlane.data(), FRAME_WIDTH, uvPlane.data(), FRAME_WIDTH, FRAME_WIDTH, FRAME_HEIGHT);
+    EXPECT_EQ(yPlane.back(), WHITE_Y);
+    EXPECT_EQ(yPlane[static_cast<size_t>(FRAME_HEIGHT - 1) * FRAME_WIDTH + rect.left - 1], BLACK_Y);
+}
+
+HWTEST_F(WatermarkBlenderTest, BLEND_NV12_ODD_POSITION, TestSize.Level1)
+{
+    WatermarkRect rect = { 3, 5, 4, 2 }; // 3, 5, 4, 2: starts in the middle of a chroma block
+    std::vector<uint8_t> pixels = CreateWatermark(rect.width, rect.height, 0, 255); // 0, 255: opaque black
+    for (size_t index = 0; index < pixels.size(); index += RGBA_PIXEL_SIZE) {
+        pixels[index] = 255; // 255: full red
+    }
+    WatermarkBlender blender;
+    ASSERT_TRUE(blender.SetWatermark(pixels.data(), rect.width * RGBA_PIXEL_SIZE, rect.width, rect.height, rect));
+
+    int32_t uvHeight = FRAME_HEIGHT / 2; // 2: subsampled
+    std::vector<uint8_t> yPlane(static_cast<size_t>(FRAME_WIDTH) * FRAME_HEIGHT, BLACK_Y);
+    std::vector<uint8_t> uvPlane(static_cast<size_t>(FRAME_WIDTH) * uvHeight, NEUTRAL_UV);
+    blender.BlendNv12(yPlane.data(), FRAME_WIDTH, uvPlane.data(), FRAME_WIDTH, FRAME_WIDTH, FRAME_HEIGHT);
+
+    uint8_t redY = 82; // 82: BT.601 luma of full red
+    for (int32_t y = 0; y < FRAME_HEIGHT; y++) {
+        for (int32_t x = 0; x < FRAME_WIDTH; x++) {
+            bool isCovered = y >= rect.top && y < rect.top + rect.height && x >= rect.left &&
+                x < rect.left + rect.width;
+            ASSERT_EQ(yPlane[static_cast<size_t>(y) * FRAME_WIDTH + x], isCovered ? redY : BLACK_Y);
+        }
+    }
+    // rows 5 and 6 fall in chroma rows 2 and 3, each block there is half covered
+    for (int32_t row = 0; row < uvHeight; row++) {
+        for (int32_t block = 0; block < FRAME_WIDTH / 2; block++) { // 2: one uv pair per block
+            uint8_t v = uvPlane[static_cast<size_t>(row) * FRAME_WIDTH + block * 2 + 1]; // 2, 1: v byte
+            bool isTouched = (row == 2 || row == 3) && block >= 1 && block <= 3; // 2, 3, 1: covered blocks
+            if (isTouched) {
+                EXPECT_GT(v, NEUTRAL_UV) << "row " << row << " block " << block;
+                EXPECT_LT(v, 240) << "row " << row << " block " << block; // 240: v of full red
+            } else {
+                ASSERT_EQ(v, NEUTRAL_UV) << "row " << row << " block " << block;
+            }
+        }
+    }
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_errors.h"
+#include "screen_capture_scaler.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr int32_t PIXEL_SIZE = 4;
+}
+
+namespace OHOS {
+namespace Media {
+class ScreenCaptureScalerUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void) {};
+    void TearDown(void) {};
+
+    static ScalerImage MakeImage(std::vector<uint8_t> &pixels, int32_t width, int32_t height)
+    {
+        pixels.assign(static_cast<size_t>(width * height * PIXEL_SIZE), 0);
+        return { pixels.data(), width, height, width * PIXEL_SIZE };
+    }
+
+    static void FillPixel(const ScalerImage &image, int32_t x, int32_t y, uint8_t value)
+    {
+        uint8_t *pixel = image.addr + y * image.stride + x * PIXEL_SIZE;
+        for (int32_t c = 0; c < PIXEL_SIZE; c++) {
+            pixel[c] = value;
+        }
+    }
+
+    static uint8_t GetPixel(const ScalerImage &image, int32_t x, int32_t y)
+    {
+        return image.addr[y * image.stride + x * PIXEL_SIZE];
+    }
+};
+
+HWTEST_F(ScreenCaptureScalerUnitTest, DOWNSCALE_AVERAGES_BOXES, TestSize.Level1)
+{
+    std::vector<uint8_t> srcPixels;
+    std::vector<uint8_t> dstPixels;
+    ScalerImage src = MakeImage(srcPixels, 4, 4); // 4: source size
+    ScalerImage dst = MakeImage(dstPixels, 2, 2); // 2: half size
+    for (int32_t y = 0; y < src.height; y++) {
+        for (int32_t x = 0; x < src.width; x++) {
+            FillPixel(src, x, y, static_cast<uint8_t>((y * src.width + x) * 10)); // 10: distinct values
+        }
+    }
+    ASSERT_EQ(ScreenCaptureScaler::ScaleRgba(src, {0, 0, 0, 0}, dst), MSERR_OK);
+    EXPECT_EQ(GetPixel(dst, 0, 0), 25); // 25: average of 0, 10, 40 and 50
+    EXPECT_EQ(GetPixel(dst, 1, 0), 45); // 45: average of 20, 30, 60 and 70
+    EXPECT_EQ(GetPixel(dst, 0, 1), 105); // 105: average of 80, 90, 120 and 130
+    EXPECT_EQ(GetPixel(dst, 1, 1), 125); // 125: average of 100, 110, 140 and 150
+}
+
+HWTEST_F(ScreenCaptureScalerUnitTest, CROP_AND_UPSCALE, TestSize.Level1)
+{
+    std::vector<uint8_t> srcPixels;
+    std::vector<uint8_t> dstPixels;
+    ScalerImage src = MakeImage(srcPixels, 4, 4); // 4: source size
+    ScalerImage dst = MakeImage(dstPixels, 2, 2); // 2: twice the crop size
+    FillPixel(src, 3, 3, 200); // 200: the only pixel inside the crop rect
+    ASSERT_EQ(ScreenCaptureScaler::ScaleRgba(src, {3, 3, 1, 1}, dst), MSERR_OK);
+    for (int32_t y = 0; y < dst.height; y++) {
+        for (int32_t x = 0; x < dst.width; x++) {
+            EXPECT_EQ(GetPixel(dst, x, y), 200); // 200: nearest source pixel
+        }
+    }
+}
+
+HWTEST_F(ScreenCaptureScalerUnitTest, REJECT_INVALID_INPUT, TestSize.Level1)
+{
+    std::vector<uint8_t> srcPixels;
+    std::vector<uint8_t> dstPixels;
+    ScalerImage src = MakeImage(srcPixels, 4, 4); // 4: source size
+    ScalerImage dst = MakeImage(dstPixels, 2, 2); // 2: destination size
+    EXPECT_EQ(ScreenCaptureScaler::ScaleRgba(src, {2, 2, 4, 4}, dst), MSERR_INVALID_VAL);
+    ScalerImage narrowDst = dst;
+    narrowDst.stride = PIXEL_SIZE;
+    EXPECT_EQ(ScreenCaptureScaler::ScaleRgba(src, {0, 0, 0, 0}, narrowDst), MSERR_INVALID_VAL);
+    ScalerImage emptySrc = src;
+    emptySrc.addr = nullptr;
+    EXPECT_EQ(ScreenCaptureScaler::ScaleRgba(emptySrc, {0, 0, 0, 0}, dst), MSERR_INVALID_VAL);
+}
+} // namespace Media
+} // namespace OHOS
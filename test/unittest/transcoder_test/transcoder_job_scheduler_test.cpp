@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "transcoder_job_scheduler.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr int32_t FRONT_PID = 100;
+    constexpr int32_t BACK_PID = 200;
+    constexpr int32_t MAX_CODEC_SLOTS = 2;
+    constexpr uint64_t MEMORY_BUDGET = 100;
+    constexpr uint64_t JOB_MEMORY = 30;
+}
+
+namespace OHOS {
+namespace Media {
+class TransCoderJobSchedulerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void)
+    {
+        events_.clear();
+        states_.clear();
+    };
+    void TearDown(void) {};
+
+    // stands in for a transcoder pipeline, it only records what the scheduler asked of it
+    uint64_t AddJob(TransCoderJobScheduler &scheduler, int32_t pid, const std::string &name,
+        uint64_t memory = JOB_MEMORY)
+    {
+        TransCoderJobCost cost;
+        cost.memoryBytes = memory;
+        TransCoderJobRecalls recalls;
+        recalls.startRecall = [this, name]() { events_.push_back("start " + name); };
+        recalls.suspendRecall = [this, name]() { events_.push_back("suspend " + name); };
+        recalls.resumeRecall = [this, name]() { events_.push_back("resume " + name); };
+        recalls.stateRecall = [this, name](TransCoderJobState state) {
+            states_.push_back(name + " " + std::to_string(static_cast<int32_t>(state)));
+        };
+        return scheduler.AddJob(pid, cost, recalls);
+    }
+
+    std::vector<std::string> events_;
+    // what the app is told, "<job> <TransCoderJobState>"
+    std::vector<std::string> states_;
+};
+
+HWTEST_F(TransCoderJobSchedulerTest, CAPS_RUNNING_JOBS_BY_CODEC_SLOTS, TestSize.Level1)
+{
+    TransCoderJobScheduler scheduler(MAX_CODEC_SLOTS, MEMORY_BUDGET);
+    uint64_t jobA = AddJob(scheduler, FRONT_PID, "a");
+    uint64_t jobB = AddJob(scheduler, FRONT_PID, "b");
+    uint64_t jobC = AddJob(scheduler, FRONT_PID, "c");
+    EXPECT_EQ(scheduler.GetJobState(jobA), TransCoderJobState::JOB_RUNNING);
+    EXPECT_EQ(scheduler.GetJobState(jobB), TransCoderJobState::JOB_RUNNING);
+    EXPECT_EQ(scheduler.GetJobState(jobC), TransCoderJobState::JOB_WAITING);
+
+    scheduler.RemoveJob(jobA);
+    EXPECT_EQ(scheduler.GetJobState(jobC), TransCoderJobState::JOB_RUNNING);
+    std::vector<std::string> expected = { "start a", "start b", "start c" };
+    EXPECT_EQ(events_, expected);
+}
+
+HWTEST_F(TransCoderJobSchedulerTest, CAPS_STARTED_JOBS_BY_MEMORY, TestSize.Level1)
+{
+    TransCoderJobScheduler scheduler(MAX_CODEC_SLOTS * 2, MEMORY_BUDGET); // 2: codec slots never bind
+    uint64_t jobA = AddJob(scheduler, FRONT_PID, "a", MEMORY_BUDGET / 2); // 2: half the budget
+    uint64_t jobB = AddJob(scheduler, FRONT_PID, "b", MEMORY_BUDGET);
+    EXPECT_EQ(scheduler.GetJobState(jobA), TransCoderJobState::JOB_RUNNING);
+    EXPECT_EQ(scheduler.GetJobState(jobB), TransCoderJobState::JOB_WAITING);
+    // a job bigger than the whole budget still runs once it is alone
+    scheduler.RemoveJob(jobA);
+    EXPECT_EQ(scheduler.GetJobState(jobB), TransCoderJobState::JOB_RUNNING);
+}
+
+HWTEST_F(TransCoderJobSchedulerTest, FOREGROUND_PREEMPTS_BACKGROUND, TestSize.Level1)
+{
+    TransCoderJobScheduler scheduler(MAX_CODEC_SLOTS, MEMORY_BUDGET);
+    scheduler.OnAppStateChanged(BACK_PID, false);
+    uint64_t jobA = AddJob(scheduler, BACK_PID, "a");
+    uint64_t jobB = AddJob(scheduler, BACK_PID, "b");
+    uint64_t jobC = AddJob(scheduler, FRONT_PID, "c");
+    // the newest background job gives its slot up
+    EXPECT_EQ(scheduler.GetJobState(jobA), TransCoderJobState::JOB_RUNNING);
+    EXPECT_EQ(scheduler.GetJobState(jobB), TransCoderJobState::JOB_SUSPENDED);
+    EXPECT_EQ(scheduler.GetJobState(jobC), TransCoderJobState::JOB_RUNNING);
+
+    scheduler.RemoveJob(jobC);
+    EXPECT_EQ(scheduler.GetJobState(jobB), TransCoderJobState::JOB_RUNNING);
+    std::vector<std::string> expected = { "start a", "start b", "suspend b", "start c", "resume b" };
+    EXPECT_EQ(events_, expected);
+
+    std::string dump;
+    scheduler.DumpInfo(dump);
+    EXPECT_NE(dump.find("preempted: 1"), std::string::npos);
+}
+
+HWTEST_F(TransCoderJobSchedulerTest, FOREGROUND_DOES_NOT_PREEMPT_FOREGROUND, TestSize.Level1)
+{
+    TransCoderJobScheduler scheduler(MAX_CODEC_SLOTS, MEMORY_BUDGET);
+    AddJob(scheduler, FRONT_PID, "a");
+    AddJob(scheduler, FRONT_PID, "b");
+    uint64_t jobC = AddJob(scheduler, FRONT_PID, "c");
+    EXPECT_EQ(scheduler.GetJobState(jobC), TransCoderJobState::JOB_WAITING);
+
+    // once its app goes to the background a job can be preempted by a waiting foreground job
+    scheduler.OnAppStateChanged(BACK_PID, false);
+    uint64_t jobD = AddJob(scheduler, BACK_PID, "d");
+    scheduler.OnAppStateChanged(FRONT_PID, false);
+    EXPECT_EQ(scheduler.GetJobState(jobD), TransCoderJobState::JOB_WAITING);
+    scheduler.OnAppStateChanged(BACK_PID, true);
+    EXPECT_EQ(scheduler.GetJobState(jobD), TransCoderJobState::JOB_RUNNING);
+    EXPECT_EQ(events_.back(), "start d");
+}
+
+HWTEST_F(TransCoderJobSchedulerTest, USER_PAUSE_FREES_THE_SLOT, TestSize.Level1)
+{
+    TransCoderJobScheduler scheduler(1, MEMORY_BUDGET);
+    uint64_t jobA = AddJob(scheduler, FRONT_PID, "a");
+    uint64_t jobB = AddJob(scheduler, FRONT_PID, "b");
+    scheduler.PauseJob(jobA);
+    EXPECT_EQ(scheduler.GetJobState(jobB), TransCoderJobState::JOB_RUNNING);
+    // resumed by the user, the job still waits for its turn
+    scheduler.ResumeJob(jobA);
+    EXPECT_EQ(scheduler.GetJobState(jobA), TransCoderJobState::JOB_SUSPENDED);
+    scheduler.RemoveJob(jobB);
+    EXPECT_EQ(scheduler.GetJobState(jobA), TransCoderJobState::JOB_RUNNING);
+
+    // a job paused before it ever ran is skipped
+    scheduler.PauseJob(jobA);
+    uint64_t jobC = AddJob(scheduler, FRONT_PID, "c");
+    uint64_t jobD = AddJob(scheduler, FRONT_PID, "d");
+    scheduler.PauseJob(jobC);
+    EXPECT_EQ(scheduler.GetJobState(jobD), TransCoderJobState::JOB_RUNNING);
+    std::vector<std::string> expected = { "start a", "suspend a", "start b", "resume a", "suspend a", "start c",
+        "suspend c", "start d" };
+    EXPECT_EQ(events_, expected);
+}
+
+HWTEST_F(TransCoderJobSchedulerTest, REPORTS_HELD_JOBS, TestSize.Level1)
+{
+    TransCoderJobScheduler scheduler(1, MEMORY_BUDGET);
+    scheduler.OnAppStateChanged(BACK_PID, false);
+    uint64_t jobA = AddJob(scheduler, BACK_PID, "a");
+    uint64_t jobB = AddJob(scheduler, FRONT_PID, "b");
+    uint64_t jobC = AddJob(scheduler, FRONT_PID, "c");
+    // a is preempted by b, c waits behind b
+    std::vector<std::string> expected = { "a 2", "c 0" }; // 2: JOB_SUSPENDED, 0: JOB_WAITING
+    EXPECT_EQ(states_, expected);
+
+    // a user pause is not reported, and a held job is reported once until it runs
+    scheduler.PauseJob(jobB);
+    scheduler.ResumeJob(jobB);
+    expected.push_back("c 1"); // 1: JOB_RUNNING
+    expected.push_back("b 2");
+    EXPECT_EQ(states_, expected);
+    scheduler.RemoveJob(jobC);
+    scheduler.RemoveJob(jobB);
+    EXPECT_EQ(scheduler.GetJobState(jobA), TransCoderJobState::JOB_RUNNING);
+    expected.push_back("b 1");
+    expected.push_back("a 1");
+    EXPECT_EQ(states_, expected);
+}
+
+HWTEST_F(TransCoderJobSchedulerTest, RECALLS_RUN_WITHOUT_THE_LOCK, TestSize.Level1)
+{
+    TransCoderJobScheduler scheduler(1, MEMORY_BUDGET);
+    uint64_t jobA = 0;
+    TransCoderJobState stateInRecall = TransCoderJobState::JOB_WAITING;
+    TransCoderJobRecalls recalls;
+    // asking for state from inside a recall would deadlock if the scheduler still held its lock
+    recalls.startRecall = [&scheduler, &jobA, &stateInRecall]() { stateInRecall = scheduler.GetJobState(jobA); };
+    jobA = 1; // 1: the first job id
+    EXPECT_EQ(scheduler.AddJob(FRONT_PID, TransCoderJobCost(), recalls), jobA);
+    EXPECT_EQ(stateInRecall, TransCoderJobState::JOB_RUNNING);
+
+    // a recall that changes the queue has its own recalls delivered after it returns, in order
+    uint64_t jobB = AddJob(scheduler, FRONT_PID, "b");
+    TransCoderJobRecalls removing;
+    removing.stateRecall = [this, &scheduler, jobA](TransCoderJobState state) {
+        states_.push_back("d " + std::to_string(static_cast<int32_t>(state)));
+        if (state == TransCoderJobState::JOB_WAITING) {
+            scheduler.RemoveJob(jobA);
+        }
+    };
+    scheduler.AddJob(FRONT_PID, TransCoderJobCost(), removing);
+    EXPECT_EQ(scheduler.GetJobState(jobB), TransCoderJobState::JOB_RUNNING);
+    std::vector<std::string> expected = { "b 0", "d 0", "b 1" };
+    EXPECT_EQ(states_, expected);
+    expected = { "start b" };
+    EXPECT_EQ(events_, expected);
+}
+
+HWTEST_F(TransCoderJobSchedulerTest, REMOVED_JOB_GETS_NO_RECALLS, TestSize.Level1)
+{
+    TransCoderJobScheduler scheduler(1, MEMORY_BUDGET);
+    scheduler.OnAppStateChanged(BACK_PID, false);
+    uint64_t jobB = 2; // 2: the second job id
+    TransCoderJobRecalls recalls;
+    recalls.startRecall = [this]() { events_.push_back("start a"); };
+    // delivered ahead of the start of the job that preempted a, which is removed before it ever hears of it
+    recalls.suspendRecall = [this, &scheduler, jobB]() {
+        events_.push_back("suspend a");
+        scheduler.RemoveJob(jobB);
+    };
+    uint64_t jobA = scheduler.AddJob(BACK_PID, TransCoderJobCost(), recalls);
+    EXPECT_EQ(AddJob(scheduler, FRONT_PID, "b"), jobB);
+    EXPECT_EQ(scheduler.GetJobState(jobA), TransCoderJobState::JOB_RUNNING);
+    std::vector<std::string> expected = { "start a", "suspend a" };
+    EXPECT_EQ(events_, expected);
+    EXPECT_TRUE(states_.empty());
+
+    // a recall may remove its own job, it is not waited for
+    TransCoderJobScheduler other(1, MEMORY_BUDGET);
+    uint64_t jobC = 1; // 1: the first job id
+    TransCoderJobRecalls removing;
+    removing.startRecall = [&other, jobC]() { other.RemoveJob(jobC); };
+    EXPECT_EQ(other.AddJob(FRONT_PID, TransCoderJobCost(), removing), jobC);
+    std::string dump;
+    other.DumpInfo(dump);
+    EXPECT_NE(dump.find("jobs: 0"), std::string::npos);
+}
+} // namespace Media
+} // namespace OHOS
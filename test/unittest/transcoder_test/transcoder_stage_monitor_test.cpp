@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "transcoder_stage_monitor.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media;
+
+namespace {
+    constexpr int64_t FRAME_US = 10000;
+    constexpr int64_t STALL_US = 100000;
+    constexpr int64_t HAND_OFF_US = 500;
+}
+
+namespace OHOS {
+namespace Media {
+class TransCoderStageMonitorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void) {};
+    void TearDown(void) {};
+
+    static const TransCoderStageStats *FindStage(const std::vector<TransCoderStageStats> &stats,
+        TransCoderStage stage)
+    {
+        for (const auto &stageStats : stats) {
+            if (stageStats.stage == stage) {
+                return &stageStats;
+            }
+        }
+        return nullptr;
+    }
+};
+
+HWTEST_F(TransCoderStageMonitorTest, VIDEO_ONLY_REPORTS_VIDEO_STAGES, TestSize.Level1)
+{
+    TransCoderStageMonitor monitor;
+    monitor.EnableLink(TransCoderLink::DEMUXER_TO_VIDEO_DECODER);
+    monitor.EnableLink(TransCoderLink::VIDEO_ENCODER_TO_MUXER);
+    for (int32_t i = 0; i < 10; i++) { // 10: frames demuxed
+        monitor.OnBuffer(TransCoderLink::DEMUXER_TO_VIDEO_DECODER, i * FRAME_US, 0);
+    }
+    for (int32_t i = 0; i < 6; i++) { // 6: frames encoded
+        monitor.OnBuffer(TransCoderLink::VIDEO_ENCODER_TO_MUXER, i * FRAME_US, HAND_OFF_US);
+    }
+    std::vector<TransCoderStageStats> stats;
+    monitor.GetStageStats(stats);
+    ASSERT_EQ(stats.size(), 3u); // 3: demuxer, video codec and muxer
+    EXPECT_EQ(FindStage(stats, TransCoderStage::AUDIO_DECODER), nullptr);
+
+    const TransCoderStageStats *codec = FindStage(stats, TransCoderStage::VIDEO_CODEC);
+    ASSERT_NE(codec, nullptr);
+    EXPECT_EQ(codec->framesIn, 10u); // 10: frames demuxed
+    EXPECT_EQ(codec->framesOut, 6u); // 6: frames encoded
+    EXPECT_EQ(codec->queueDepth, 4); // 4: still inside the codecs
+    EXPECT_EQ(codec->maxQueueDepth, 10); // 10: all frames were in before the first came out
+    EXPECT_EQ(codec->handOffUs, 6 * HAND_OFF_US); // 6: frames encoded
+
+    const TransCoderStageStats *muxer = FindStage(stats, TransCoderStage::MUXER);
+    ASSERT_NE(muxer, nullptr);
+    EXPECT_EQ(muxer->framesIn, 6u); // 6: frames encoded
+    EXPECT_EQ(muxer->framesOut, 6u); // 6: frames encoded
+}
+
+HWTEST_F(TransCoderStageMonitorTest, STALLS_COUNT_AS_INPUT_WAIT, TestSize.Level1)
+{
+    TransCoderStageMonitor monitor;
+    monitor.EnableLink(TransCoderLink::DEMUXER_TO_AUDIO_DECODER);
+    monitor.EnableLink(TransCoderLink::AUDIO_DECODER_TO_AUDIO_ENCODER);
+    int64_t nowUs = 0;
+    monitor.OnBuffer(TransCoderLink::DEMUXER_TO_AUDIO_DECODER, nowUs, 0);
+    nowUs += FRAME_US;
+    monitor.OnBuffer(TransCoderLink::DEMUXER_TO_AUDIO_DECODER, nowUs, 0);
+    // the demuxer stalls, the decoder waits for it
+    nowUs += STALL_US;
+    monitor.OnBuffer(TransCoderLink::DEMUXER_TO_AUDIO_DECODER, nowUs, 0);
+    monitor.OnBuffer(TransCoderLink::AUDIO_DECODER_TO_AUDIO_ENCODER, nowUs, HAND_OFF_US);
+
+    std::vector<TransCoderStageStats> stats;
+    monitor.GetStageStats(stats);
+    const TransCoderStageStats *decoder = FindStage(stats, TransCoderStage::AUDIO_DECODER);
+    ASSERT_NE(decoder, nullptr);
+    EXPECT_EQ(decoder->inputWaitUs, STALL_US);
+    EXPECT_EQ(decoder->handOffUs, HAND_OFF_US);
+    EXPECT_EQ(decoder->queueDepth, 2); // 2: three in, one out
+    const TransCoderStageStats *encoder = FindStage(stats, TransCoderStage::AUDIO_ENCODER);
+    ASSERT_NE(encoder, nullptr);
+    EXPECT_EQ(encoder->framesIn, 1u);
+    EXPECT_EQ(encoder->inputWaitUs, 0);
+
+    std::string dump;
+    monitor.Dump(dump);
+    EXPECT_NE(dump.find("TransCoder stage audio decoder: in 3, out 1"), std::string::npos);
+    EXPECT_NE(dump.find("input wait 100 ms"), std::string::npos);
+    EXPECT_NE(dump.find(", hand-off "), std::string::npos);
+}
+} // namespace Media
+} // namespace OHOS